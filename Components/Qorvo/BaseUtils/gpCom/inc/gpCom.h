@@ -159,6 +159,12 @@
 typedef UInt32 gpCom_CommunicationId_t;
 
 typedef void (*gpCom_HandleCallback_t) ( UInt16 length , UInt8* pData, gpCom_CommunicationId_t commId);
+
+/** @brief One piece of a packet passed to gpCom_DataRequestV() */
+typedef struct {
+    UInt16 length;
+    UInt8* pData;
+} gpCom_DataSegment_t;
 typedef UInt16 (*gpCom_cbActivateTx_t) ( UInt16 overFlowCounter, gpCom_CommunicationId_t commId);
 
 #define gpCom_ProtocolSyn        1
@@ -197,6 +203,19 @@ void gpCom_Init(void);
 */
 Bool gpCom_DataRequest(UInt8 moduleID, UInt16 length, UInt8* pData, gpCom_CommunicationId_t commId);
 
+/**
+* @brief Send a packet made of several data segments over a specified communication channel
+*
+* The segments are sent back to back as one packet, without first gathering them in a single buffer.
+*
+* @param moduleID       SW component ID that will handle the data
+* @param nrOfSegments   Number of entries in pSegments
+* @param pSegments      Data segments making up the packet payload, in order
+* @param commId         Communication channel to use for transmission (if available). Can be UART/USB/...
+* @return status        Returns True if request was executed.
+*/
+Bool gpCom_DataRequestV(UInt8 moduleID, UInt8 nrOfSegments, const gpCom_DataSegment_t* pSegments, gpCom_CommunicationId_t commId);
+
 /**
 * @brief Send data over a specified communication channel and wait for a specific ACK packet
 *
@@ -112,10 +112,19 @@ void gpCom_Init(void)
 }
 
 Bool gpCom_DataRequest(UInt8 moduleID, UInt16 length, UInt8* pData, gpCom_CommunicationId_t commId)
+{
+    gpCom_DataSegment_t segment;
+
+    segment.length = length;
+    segment.pData  = pData;
+    return gpCom_DataRequestV(moduleID, 1, &segment, commId);
+}
+
+Bool gpCom_DataRequestV(UInt8 moduleID, UInt8 nrOfSegments, const gpCom_DataSegment_t* pSegments, gpCom_CommunicationId_t commId)
 {
     Bool ret = false;
 #if defined(GP_DIVERSITY_LINUXKERNEL)
-    //GP_LOG_SYSTEM_PRINTF("TX m=%02x l=%d d=%02x...",0,moduleID, length, pData[0]);
+    //GP_LOG_SYSTEM_PRINTF("TX m=%02x l=%d d=%02x...",0,moduleID, pSegments[0].length, pSegments[0].pData[0]);
 #endif
 #if defined(GP_DIVERSITY_COM_UART) || defined(GP_COM_DIVERSITY_SERIAL_SPI)
     if(GP_COMM_ID_CARRIED_BY(commId,GP_COM_COMM_ID_UART1)
@@ -124,7 +133,7 @@ Bool gpCom_DataRequest(UInt8 moduleID, UInt16 length, UInt8* pData, gpCom_Commun
     || GP_COMM_ID_CARRIED_BY(commId,GP_COM_COMM_ID_SPI)
     || GP_COMM_ID_CARRIED_BY(commId,GP_COM_COMM_ID_USB))
     {
-        ret = gpComSerial_DataRequest(moduleID, length, pData, commId);
+        ret = gpComSerial_DataRequestV(moduleID, nrOfSegments, pSegments, commId);
     }
     else
 #endif
@@ -146,7 +155,7 @@ Bool gpCom_DataRequest(UInt8 moduleID, UInt16 length, UInt8* pData, gpCom_Commun
 #if defined(GP_COMPONENT_ID_QVOT) 
         && (moduleID != GP_COMPONENT_ID_QVOT)
 #endif
-        && !(moduleID == GP_COMPONENT_ID_COM && pData[0] == 0xfe && pData[2] == 0x08 /*gpComLinkEvent_Ping_CmdId*/ )
+        && !(moduleID == GP_COMPONENT_ID_COM && pSegments[0].pData[0] == 0xfe && pSegments[0].pData[2] == 0x08 /*gpComLinkEvent_Ping_CmdId*/ )
     )
     {
         GP_ASSERT_SYSTEM(ret);
@@ -65,6 +65,31 @@
 #endif //GP_DIVERSITY_COM_SHMEM && !defined(GP_COM_DIVERSITY_MULTIPLE_COM)
 #endif //GP_COM_RX_PACKET_BUFFERS
 
+/* Pending queue size: GP_COM_RX_PACKET_BUFFERS rounded up to a power of 2, so free running indexes can be masked */
+#if   GP_COM_RX_PACKET_BUFFERS <= 1
+#define COM_RX_QUEUE_SIZE 1
+#elif GP_COM_RX_PACKET_BUFFERS <= 2
+#define COM_RX_QUEUE_SIZE 2
+#elif GP_COM_RX_PACKET_BUFFERS <= 4
+#define COM_RX_QUEUE_SIZE 4
+#elif GP_COM_RX_PACKET_BUFFERS <= 8
+#define COM_RX_QUEUE_SIZE 8
+#elif GP_COM_RX_PACKET_BUFFERS <= 16
+#define COM_RX_QUEUE_SIZE 16
+#elif GP_COM_RX_PACKET_BUFFERS <= 32
+#define COM_RX_QUEUE_SIZE 32
+#elif GP_COM_RX_PACKET_BUFFERS <= 64
+#define COM_RX_QUEUE_SIZE 64
+#elif GP_COM_RX_PACKET_BUFFERS <= 128
+#define COM_RX_QUEUE_SIZE 128
+#else
+#error "GP_COM_RX_PACKET_BUFFERS > 128 not supported"
+#endif
+#define COM_RX_QUEUE_ENTRY(index)   gpCom_PacketHandlingQueue[(index) & (COM_RX_QUEUE_SIZE-1)]
+
+/* Free packet bitmap - bit set means buffer is free */
+#define COM_RX_FREE_WORDS           ((GP_COM_RX_PACKET_BUFFERS+31)/32)
+
 #define GP_COM_UNKNOWN_MODULE_ID                   0
 #ifndef GP_COM_MAX_NUMBER_OF_MODULE_IDS
 #define GP_COM_MAX_NUMBER_OF_MODULE_IDS            2 //16
@@ -83,9 +108,14 @@ typedef struct gpCom_ModuleIDCallbackEntry {
  *                    Static Data Definitions
  *****************************************************************************/
 
-static gpCom_Packet_t*     gpCom_PacketHandlingQueue[GP_COM_RX_PACKET_BUFFERS];
+/* Pending packets, in order of reception.
+ * Single producer (Com_cbPacketReceived) adds at the tail without locking,
+ * consumers take packets from the head under Com_RxMutex. */
+static gpCom_Packet_t*     gpCom_PacketHandlingQueue[COM_RX_QUEUE_SIZE];
+static volatile UInt8      gpCom_PacketHandlingQueueHead;
+static volatile UInt8      gpCom_PacketHandlingQueueTail;
 static gpCom_Packet_t gpCom_PacketBuffer[GP_COM_RX_PACKET_BUFFERS] GP_EXTRAM_SECTION_ATTR;
-static UInt8 gpCom_PacketBufferClaimed[(GP_COM_RX_PACKET_BUFFERS-1)/8+1];
+static UInt32 gpCom_PacketBufferFree[COM_RX_FREE_WORDS];
 
 static gpCom_ModuleIDCallbackEntry_t gpCom_ModuleIDCallbackTable[GP_COM_MAX_NUMBER_OF_MODULE_IDS];
 
@@ -119,7 +149,7 @@ void Com_ExecuteAndFreePacket(gpCom_Packet_t* pPacket, Bool blockingWait, UInt8
 /*****************************************************************************
  *                    Static Function Prototypes
  *****************************************************************************/
-static void Com_ShiftHandlingQueue(UInt8 startIndex);
+static void Com_InitPacketBufferFree(void);
 static gpCom_Packet_t* Com_GetPendingPacketWithCmdId(UInt8 cmdId);
 static gpCom_Packet_t* Com_GetPendingPacket(void);
 
@@ -133,33 +163,41 @@ void Com_DumpRxBuffers(void)
     for (i=0; i < GP_COM_RX_PACKET_BUFFERS; i++)
     {
         gpCom_Packet_t* pPacket = &gpCom_PacketBuffer[i];
-        GP_LOG_SYSTEM_PRINTF("mem- %i:%i id:%x l:%i comm:%lu [%x",0,i, BIT_TST(gpCom_PacketBufferClaimed[i/8],i%8),
+        GP_LOG_SYSTEM_PRINTF("mem- %i:%i id:%x l:%i comm:%lu [%x",0,i, !BIT_TST(gpCom_PacketBufferFree[i/32],i%32),
                                                       pPacket->moduleID,
                                                       pPacket->length,
                                                       (unsigned long)pPacket->commId,
                                                       pPacket->packet[0]);
         gpLog_Flush();
     }
-    for (i=0; i < GP_COM_RX_PACKET_BUFFERS; i++)
+    for (i=gpCom_PacketHandlingQueueHead; i != gpCom_PacketHandlingQueueTail; i = (UInt8)(i+1))
     {
-        if(gpCom_PacketHandlingQueue[i])
-        {
-            gpCom_Packet_t* pPacket = gpCom_PacketHandlingQueue[i];
+        gpCom_Packet_t* pPacket = COM_RX_QUEUE_ENTRY(i);
 
-            GP_LOG_SYSTEM_PRINTF("que- %i:id:%x l:%i comm:%lu [%x",0,i, pPacket->moduleID,
-                                                      pPacket->length,
-                                                      (unsigned long)pPacket->commId,
-                                                      pPacket->packet[0]);
-            gpLog_Flush();
-        }
+        GP_LOG_SYSTEM_PRINTF("que- %i:id:%x l:%i comm:%lu [%x",0,i, pPacket->moduleID,
+                                                  pPacket->length,
+                                                  (unsigned long)pPacket->commId,
+                                                  pPacket->packet[0]);
+        gpLog_Flush();
     }
 }
 #endif
 
+static void Com_InitPacketBufferFree(void)
+{
+    UIntLoop i;
+
+    MEMSET(gpCom_PacketBufferFree, 0x0, sizeof(gpCom_PacketBufferFree));
+    for (i=0; i < GP_COM_RX_PACKET_BUFFERS; i++)
+    {
+        BIT_SET(gpCom_PacketBufferFree[i/32], i%32);
+    }
+}
+
 //Memory Claim/Free
 gpCom_Packet_t* Com_GetFreePacket(void)
 {
-    UIntLoop i;
+    UIntLoop w;
     gpCom_Packet_t *pPacket = NULL;
 
     if(!HAL_VALID_MUTEX(Com_RxMutex))
@@ -169,13 +207,16 @@ gpCom_Packet_t* Com_GetFreePacket(void)
     }
 
     HAL_ACQUIRE_MUTEX(Com_RxMutex);
-    for(i=0; i < GP_COM_RX_PACKET_BUFFERS; i++)
+    for(w=0; w < COM_RX_FREE_WORDS; w++)
     {
-        if(!BIT_TST(gpCom_PacketBufferClaimed[i/8], i%8))
+        if(gpCom_PacketBufferFree[w] != 0)
         {
-            GP_LOG_PRINTF("G %i",0,i);
-            BIT_SET(gpCom_PacketBufferClaimed[i/8], i%8);
-            pPacket = &(gpCom_PacketBuffer[i]);
+            //Claim the highest free buffer of this word
+            UInt8 bit = 31 - __CLZ(gpCom_PacketBufferFree[w]);
+
+            GP_LOG_PRINTF("G %i",0,w*32+bit);
+            BIT_CLR(gpCom_PacketBufferFree[w], bit);
+            pPacket = &(gpCom_PacketBuffer[w*32+bit]);
             break;
         }
     }
@@ -193,7 +234,7 @@ gpCom_Packet_t* Com_GetFreePacket(void)
 
 void Com_FreePacket(gpCom_Packet_t* pPacket)
 {
-    UIntLoop i;
+    UIntLoop i = GP_COM_RX_PACKET_BUFFERS;
 
     if(!HAL_VALID_MUTEX(Com_RxMutex))
     {
@@ -201,46 +242,30 @@ void Com_FreePacket(gpCom_Packet_t* pPacket)
         return;
     }
 
-    HAL_ACQUIRE_MUTEX(Com_RxMutex);
-    for(i=0; i < GP_COM_RX_PACKET_BUFFERS; i++)
+    //Index straight from the address
+    if((pPacket >= &(gpCom_PacketBuffer[0])) && (pPacket < &(gpCom_PacketBuffer[GP_COM_RX_PACKET_BUFFERS])))
     {
-        if(pPacket == &(gpCom_PacketBuffer[i]))
-        {
-            GP_LOG_PRINTF("Fr %i",0,i);
-            BIT_CLR(gpCom_PacketBufferClaimed[i/8], i%8);
-            break;
-        }
+        i = (UIntLoop)(pPacket - gpCom_PacketBuffer);
     }
-    HAL_RELEASE_MUTEX(Com_RxMutex);
-
-    if(i == GP_COM_RX_PACKET_BUFFERS)
+    if((i == GP_COM_RX_PACKET_BUFFERS) || (pPacket != &(gpCom_PacketBuffer[i])))
     {
         GP_LOG_PRINTF("F: packet not found: id:%x l:%i comm:%lu",0,pPacket->moduleID,
                                                                   pPacket->length,
                                                                   (unsigned long)pPacket->commId);
         GP_ASSERT_DEV_EXT(false);
+        return;
     }
-}
 
-//Handling queue - preserve in order execution
-static void Com_ShiftHandlingQueue(UInt8 startIndex)
-{
-    // always called from inside mutex, so no mutex here !
-#if GP_COM_RX_PACKET_BUFFERS > 1
-    UIntLoop i;
-    GP_ASSERT_DEV_INT(startIndex < GP_COM_RX_PACKET_BUFFERS);
-    //Shift to front and add NULL at the end
-    for(i = startIndex; i < GP_COM_RX_PACKET_BUFFERS-1; i++)
-    {
-        gpCom_PacketHandlingQueue[i] = gpCom_PacketHandlingQueue[i+1];
-    }
-#endif //GP_COM_RX_PACKET_BUFFERS > 1
-    gpCom_PacketHandlingQueue[GP_COM_RX_PACKET_BUFFERS-1] = NULL;
+    GP_LOG_PRINTF("Fr %i",0,(UInt16)i);
+    HAL_ACQUIRE_MUTEX(Com_RxMutex);
+    BIT_SET(gpCom_PacketBufferFree[i/32], i%32);
+    HAL_RELEASE_MUTEX(Com_RxMutex);
 }
 
+//Handling queue - preserve in order execution
 Bool Com_AddPendingPacket(gpCom_Packet_t* pPacket)
 {
-    UIntLoop i;
+    UInt8 tail = gpCom_PacketHandlingQueueTail;
 
     if(!HAL_VALID_MUTEX(Com_RxMutex))
     {
@@ -248,24 +273,25 @@ Bool Com_AddPendingPacket(gpCom_Packet_t* pPacket)
         return false;
     }
 
-    HAL_ACQUIRE_MUTEX(Com_RxMutex);
-    for(i=0; i < GP_COM_RX_PACKET_BUFFERS; i++)
+    // Only producer - no mutex needed, a consumer can only make more room
+    if((UInt8)(tail - gpCom_PacketHandlingQueueHead) >= COM_RX_QUEUE_SIZE)
     {
-        if(gpCom_PacketHandlingQueue[i] == NULL)
-        {
-            GP_LOG_PRINTF("Add %i",0, i);
-            gpCom_PacketHandlingQueue[i] = pPacket;
-            break;
-        }
+        return false;
     }
-    HAL_RELEASE_MUTEX(Com_RxMutex);
 
-    return i != GP_COM_RX_PACKET_BUFFERS;
+    GP_LOG_PRINTF("Add %i",0, tail);
+    COM_RX_QUEUE_ENTRY(tail) = pPacket;
+    // Entry must be written before it is published
+    __DMB();
+    gpCom_PacketHandlingQueueTail = (UInt8)(tail + 1);
+
+    return true;
 }
 
 static gpCom_Packet_t* Com_GetPendingPacket(void)
 {
     gpCom_Packet_t *pPacket = NULL;
+    UInt8 head;
 
     if(!HAL_VALID_MUTEX(Com_RxMutex))
     {
@@ -275,10 +301,11 @@ static gpCom_Packet_t* Com_GetPendingPacket(void)
 
     Com_FlushRx();
     HAL_ACQUIRE_MUTEX(Com_RxMutex);
-    pPacket = gpCom_PacketHandlingQueue[0];
-    if(pPacket != NULL)
+    head = gpCom_PacketHandlingQueueHead;
+    if(head != gpCom_PacketHandlingQueueTail)
     {
-        Com_ShiftHandlingQueue(0);
+        pPacket = COM_RX_QUEUE_ENTRY(head);
+        gpCom_PacketHandlingQueueHead = (UInt8)(head + 1);
     }
     HAL_RELEASE_MUTEX(Com_RxMutex);
 
@@ -287,7 +314,9 @@ static gpCom_Packet_t* Com_GetPendingPacket(void)
 
 static gpCom_Packet_t* Com_GetPendingPacketWithCmdId(UInt8 cmdId)
 {
-    UIntLoop i;
+    UInt8 i;
+    UInt8 head;
+    UInt8 tail;
     gpCom_Packet_t *pPacket = NULL;
 
     if(!HAL_VALID_MUTEX(Com_RxMutex))
@@ -298,13 +327,21 @@ static gpCom_Packet_t* Com_GetPendingPacketWithCmdId(UInt8 cmdId)
 
     Com_FlushRx();
     HAL_ACQUIRE_MUTEX(Com_RxMutex);
-    for(i=0; i < GP_COM_RX_PACKET_BUFFERS; i++)
+    head = gpCom_PacketHandlingQueueHead;
+    tail = gpCom_PacketHandlingQueueTail;
+    for(i = head; i != tail; i = (UInt8)(i+1))
     {
-        if((gpCom_PacketHandlingQueue[i] != NULL)
-        && (gpCom_PacketHandlingQueue[i]->packet[0] == cmdId))
+        if(COM_RX_QUEUE_ENTRY(i)->packet[0] == cmdId)
         {
-            pPacket = gpCom_PacketHandlingQueue[i];
-            Com_ShiftHandlingQueue(i);
+            pPacket = COM_RX_QUEUE_ENTRY(i);
+            //Close the gap by moving the older entries one place towards the tail,
+            //the producer only touches entries at or after the tail
+            for(; i != head; i = (UInt8)(i-1))
+            {
+                COM_RX_QUEUE_ENTRY(i) = COM_RX_QUEUE_ENTRY((UInt8)(i-1));
+            }
+            __DMB();
+            gpCom_PacketHandlingQueueHead = (UInt8)(head + 1);
             break;
         }
     }
@@ -321,11 +358,13 @@ void Com_InitRx(void)
         gpCom_ModuleIDCallbackTable[i].moduleID       = GP_COM_UNKNOWN_MODULE_ID;
         gpCom_ModuleIDCallbackTable[i].handleCallback = NULL;
     }
-    for (i=0; i < GP_COM_RX_PACKET_BUFFERS; i++)
+    for (i=0; i < COM_RX_QUEUE_SIZE; i++)
     {
         gpCom_PacketHandlingQueue[i] = NULL;
     }
-    MEMSET(gpCom_PacketBufferClaimed, 0x0, sizeof(gpCom_PacketBufferClaimed));
+    gpCom_PacketHandlingQueueHead = 0;
+    gpCom_PacketHandlingQueueTail = 0;
+    Com_InitPacketBufferFree();
     HAL_CREATE_MUTEX(&Com_RxMutex);
     HAL_CREATE_MUTEX(&Com_MultiThreadingMutex);
 #if defined(GP_COM_DIVERSITY_UNLOCK_TX_AFTER_RX)
@@ -447,7 +486,7 @@ Bool gpCom_DeRegisterModule(UInt8 moduleID)
 
 Bool gpCom_IsReceivedPacketPending(void)
 {
-    return (NULL != gpCom_PacketHandlingQueue[0]);
+    return (gpCom_PacketHandlingQueueHead != gpCom_PacketHandlingQueueTail);
 }
 
 void gpCom_HandleRx(void)
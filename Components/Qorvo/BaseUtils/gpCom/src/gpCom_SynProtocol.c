@@ -48,6 +48,13 @@
  *                    Macro Definitions
  *****************************************************************************/
 
+/* GP_COM_DIVERSITY_SERIAL_SYN_BLOCK_PARSE: handle the RX buffer in blocks instead of byte by byte:
+ * - padding in front of a packet is skipped with memchr
+ * - a packet that is completely inside the buffer is validated with a single CRC pass and copied at once
+ * - payload that is split over several buffers is copied and CRC'd per buffer
+ * Packets are delivered exactly as with the byte wise state machine, which remains in use for
+ * headers/footers split over buffers and for error reporting. */
+
 /*****************************************************************************
  *                    Type Definitions
  *****************************************************************************/
@@ -81,6 +88,57 @@ typedef UInt8 gpCom_ProtocolFooter_t;
  *                    Static Function Definitions
  *****************************************************************************/
 
+#ifdef GP_COM_DIVERSITY_SERIAL_SYN_BLOCK_PARSE
+/* Try to handle a complete packet starting at the 'S' in rxbuf[0].
+ * Returns the number of bytes consumed, or 0 if the byte wise parser needs to take over
+ * (packet not complete in this buffer, invalid header, CRC mismatch, no RX packet available). */
+static UInt16 ComSynProtocol_ParseFullPacket(UInt8 *rxbuf, UInt16 rxbuf_size, gpCom_ProtocolState_t* state)
+{
+    UInt16 length;
+    UInt16 crc = 0x0000;
+    gpCom_Packet_t* pPacket;
+
+    if (rxbuf_size < (GP_COM_PACKET_HEADER_LENGTH + GP_COM_PACKET_FOOTER_LENGTH))
+    {
+        return 0;
+    }
+    if ((rxbuf[gpCom_ProtocolHeaderY] != 'Y') || (rxbuf[gpCom_ProtocolHeaderN] != 'N'))
+    {
+        return 0;
+    }
+
+    length = rxbuf[gpCom_ProtocolHeaderLength] + ((UInt16)(rxbuf[gpCom_ProtocolHeaderFrameControl] & 0x0F) << 8);
+    if ((length == 0) ||
+        (length > GP_COM_MAX_PACKET_PAYLOAD_SIZE) ||
+        (rxbuf_size < (GP_COM_PACKET_HEADER_LENGTH + length + GP_COM_PACKET_FOOTER_LENGTH)))
+    {
+        return 0;
+    }
+
+    gpUtils_CalculatePartialCrc(&crc, rxbuf, GP_COM_PACKET_HEADER_LENGTH + length);
+    if ((rxbuf[GP_COM_PACKET_HEADER_LENGTH + length + gpCom_ProtocolFooterCRCByteLSB] != (UInt8)(crc >> 0)) ||
+        (rxbuf[GP_COM_PACKET_HEADER_LENGTH + length + gpCom_ProtocolFooterCRCByteMSB] != (UInt8)(crc >> 8)))
+    {
+        return 0;
+    }
+
+    pPacket = Com_GetFreePacket();
+    if (NULL == pPacket)
+    {
+        return 0;
+    }
+
+    MEMCPY(pPacket->packet, &rxbuf[GP_COM_PACKET_HEADER_LENGTH], length);
+    pPacket->length   = length;
+    pPacket->moduleID = rxbuf[gpCom_ProtocolHeaderModule];
+    pPacket->commId   = state->commId;
+
+    Com_cbPacketReceived(pPacket);
+
+    return GP_COM_PACKET_HEADER_LENGTH + length + GP_COM_PACKET_FOOTER_LENGTH;
+}
+#endif //GP_COM_DIVERSITY_SERIAL_SYN_BLOCK_PARSE
+
 //RX only function
 gpCom_ProtocolStatus_t ComSynProtocol_ParseByte(UInt8 rxbyte, gpCom_ProtocolState_t* state)
 {
@@ -89,13 +147,16 @@ gpCom_ProtocolStatus_t ComSynProtocol_ParseByte(UInt8 rxbyte, gpCom_ProtocolStat
 
 gpCom_ProtocolStatus_t ComSynProtocol_ParseBuffer(UInt8 *rxbuf, UInt16 rxbuf_size, gpCom_ProtocolState_t* state)
 {
-    Bool error = false;
+    Bool error;
     gpCom_ProtocolStatus_t status = gpCom_ProtocolContinue;
     UInt16 rxbuf_idx;
 
     for (rxbuf_idx = 0; rxbuf_idx < rxbuf_size; rxbuf_idx++)
     {
         UInt8 rxbyte = rxbuf[rxbuf_idx];
+
+        //Each byte starts error free, a previous error already reset the state machine
+        error = false;
         switch (state->partOfPacket) {
         // Header section
         case gpCom_ProtocolPacketHeader:
@@ -104,6 +165,32 @@ gpCom_ProtocolStatus_t ComSynProtocol_ParseBuffer(UInt8 *rxbuf, UInt16 rxbuf_siz
             switch (state->counter)
             {
                 case gpCom_ProtocolHeaderS:
+#ifdef GP_COM_DIVERSITY_SERIAL_SYN_BLOCK_PARSE
+                    if (rxbyte != 'S')
+                    {
+                        /* fast forward to the next start of a packet */
+                        UInt8* pSyn = memchr(&rxbuf[rxbuf_idx], 'S', rxbuf_size - rxbuf_idx);
+                        if (pSyn == NULL)
+                        {
+                            rxbuf_idx = rxbuf_size;
+                            continue;
+                        }
+                        rxbuf_idx = (UInt16)(pSyn - rxbuf);
+                        rxbyte = 'S';
+                    }
+                    {
+                        UInt16 consumed = ComSynProtocol_ParseFullPacket(&rxbuf[rxbuf_idx], rxbuf_size - rxbuf_idx, state);
+                        if (consumed != 0)
+                        {
+                            rxbuf_idx += consumed - 1;
+                            status = gpCom_ProtocolDone;
+                            continue;
+                        }
+                    }
+                    status = gpCom_ProtocolContinue;
+                    state->crc = 0x0000;
+                    break;
+#else
                     if (rxbyte != 'S')
                     {
                         /* we can't discard the entire buffer since it can contain multiple SPI transfers */
@@ -130,6 +217,7 @@ gpCom_ProtocolStatus_t ComSynProtocol_ParseBuffer(UInt8 *rxbuf, UInt16 rxbuf_siz
                         state->crc = 0x0000;
                     }
                     break;
+#endif //GP_COM_DIVERSITY_SERIAL_SYN_BLOCK_PARSE
                 case gpCom_ProtocolHeaderY :
                     if (rxbyte != 'Y')
                     {
@@ -204,9 +292,20 @@ gpCom_ProtocolStatus_t ComSynProtocol_ParseBuffer(UInt8 *rxbuf, UInt16 rxbuf_siz
             }
 
             //Fill in data
+#ifdef GP_COM_DIVERSITY_SERIAL_SYN_BLOCK_PARSE
+            {
+                UInt16 chunk = min(rxbuf_size - rxbuf_idx, state->length - state->counter);
+
+                MEMCPY(&state->pPacket->packet[state->counter], &rxbuf[rxbuf_idx], chunk);
+                gpUtils_CalculatePartialCrc(&(state->crc), &rxbuf[rxbuf_idx], chunk);
+                state->counter += chunk;
+                rxbuf_idx += chunk - 1;
+            }
+#else
             state->pPacket->packet[state->counter] = rxbyte;
             gpUtils_UpdateCrc(&(state->crc),(UInt8)rxbyte);
             state->counter++;
+#endif //GP_COM_DIVERSITY_SERIAL_SYN_BLOCK_PARSE
             if (state->counter >= state->length)
             {
                 state->partOfPacket = gpCom_ProtocolPacketFooter;
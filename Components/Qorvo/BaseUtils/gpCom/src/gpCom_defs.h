@@ -179,6 +179,7 @@ void ComSerial_ParseBuffer(UInt8 *buffer, UInt16 size, gpCom_CommunicationId_t c
 extern UInt16 gpComSerial_GetPacketSize(gpCom_CommunicationId_t commId, UInt16 payloadSize);
 extern void gpComSerial_Init(void);
 extern Bool gpComSerial_DataRequest(UInt8 moduleID, UInt16 length, UInt8* pData, gpCom_CommunicationId_t commId);
+extern Bool gpComSerial_DataRequestV(UInt8 moduleID, UInt8 nrOfSegments, const gpCom_DataSegment_t* pSegments, gpCom_CommunicationId_t commId);
 extern UInt16 gpComSerial_GetFreeSpace(gpCom_CommunicationId_t commId);
 extern Bool gpComSerial_GetTXEnable(void);
 extern void gpComSerial_HandleTx(void);
@@ -188,6 +189,7 @@ extern Bool gpComSerial_TXDataPending(void);
 extern void ComSerial_FlushRx(void);
 Bool Com_IsDataWaiting(gpCom_CommunicationId_t commId);
 UInt8 Com_GetData(gpCom_CommunicationId_t commId);
+UInt16 Com_GetDataBlock(gpCom_CommunicationId_t commId, UInt8* pData, UInt16 maxLength);
 #endif //defined( GP_DIVERSITY_COM_UART )  || defined( GP_DIVERSITY_COM_USB)
 
 #if defined( GP_DIVERSITY_COM_UART ) 
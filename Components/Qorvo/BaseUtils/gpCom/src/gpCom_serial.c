@@ -103,7 +103,7 @@ static UInt8 Com_TxBuf[GP_COM_NUM_UART][GP_COM_TX_BUFFER_SIZE] GP_EXTRAM_SECTION
  *****************************************************************************/
 
 // Static functions
-static Bool Com_WriteBlock(UInt16 length , UInt16 *sizeAvailable , UInt16 *sizeBlock , UInt8* pData, UInt8 uart,UInt16 *writeIdx);
+static void Com_WriteSegment(UInt16 length, UInt8* pData, UInt8 uart, UInt16* writeIdx);
 static void Com_ActivateTxBuffer(UInt8 uart);
 static void Com_CalculateSizes(UInt16* sizeAvailable, UInt16* sizeBlock, UInt8 uart);
 
@@ -266,45 +266,25 @@ UInt16 Com_CalculateSizeOfNewData(gpCom_CommunicationId_t commId, UInt16* sizeCo
     return sizeOfNewData;
 }
 
-// Com_Serial_Transmit_WriteBlock
-static Bool Com_WriteBlock(UInt16 length , UInt16 *sizeAvailable , UInt16 *sizeBlock , UInt8* pData, UInt8 uart, UInt16 *writeIdx)
+// Com_Serial_Transmit_WriteSegment
+// Space must have been checked by the caller.
+static void Com_WriteSegment(UInt16 length, UInt8* pData, UInt8 uart, UInt16* writeIdx)
 {
     GP_UTILS_STACK_TRACK();
-    if (length > *sizeAvailable)
+    while (length > 0)
     {
-        //Overrun detected
-        return true;
-    }
-    else
-    {
-        if (length > *sizeBlock)
-        {
-            UInt16 length_2block;
+        //Copy up to the end of the buffer, remaining piece from start of buffer
+        UInt16 sizeBlock = min(length, ComTxBufferSize - *writeIdx);
 
-            // Copy in 2 blocks
-            MEMCPY(&(gpCom_Buf(uart)[*writeIdx]), pData, *sizeBlock);
-            length_2block = length - *sizeBlock;
+        MEMCPY(&(gpCom_Buf(uart)[*writeIdx]), pData, sizeBlock);
 
-            //Remaining piece from start of buffer
-            MEMCPY(&(gpCom_Buf(uart)[0]), &pData[*sizeBlock], length_2block);
-            *writeIdx = length_2block;
+        *writeIdx += sizeBlock;
+        GP_ASSERT_DEV_INT((*writeIdx <= ComTxBufferSize));
+        if (*writeIdx >= ComTxBufferSize) *writeIdx = 0;
 
-            *sizeAvailable -= *sizeBlock + length_2block;
-            *sizeBlock      = *sizeAvailable;
-        }
-        else
-        {
-            // Copy in 1 block
-            MEMCPY(&(gpCom_Buf(uart)[*writeIdx]), pData, length);
-            *writeIdx += length;
-            GP_ASSERT_DEV_INT((*writeIdx <= ComTxBufferSize)); //Should be checked before
-            if (*writeIdx >= ComTxBufferSize) *writeIdx = 0;
-
-            *sizeAvailable -= length;
-            *sizeBlock     -= length;
-        }
+        pData  += sizeBlock;
+        length -= sizeBlock;
     }
-    return false;
 }
 
 
@@ -431,6 +411,36 @@ UInt8 Com_GetData(gpCom_CommunicationId_t commId)
     if ((unsigned int) ++gpCom_ReadPtr[uart] >= (unsigned int) ComTxBufferSize) gpCom_ReadPtr[uart] = 0;
     return returnValue;
 }
+
+// Copy up to maxLength pending bytes to pData - must be called with interrupts disabled, like Com_GetData()
+UInt16 Com_GetDataBlock(gpCom_CommunicationId_t commId, UInt8* pData, UInt16 maxLength)
+{
+    UInt16 sizeContinuous;
+    UInt16 sizeCopied = 0;
+    UInt8 uart;
+
+    if (!Com_IsDataWaiting(commId))
+    {
+        return 0;
+    }
+    uart = Com_CommIdToUartIndex(commId);
+
+    //Data can wrap around the end of the buffer - copy in at most 2 blocks
+    while ((sizeCopied < maxLength) && (gpCom_ReadPtr[uart] != gpCom_WritePtr[uart]))
+    {
+        UInt16 sizeBlock;
+
+        Com_CalculateSizeOfNewData(commId, &sizeContinuous);
+        sizeBlock = min(sizeContinuous, maxLength - sizeCopied);
+
+        MEMCPY(&pData[sizeCopied], &(gpCom_Buf(uart)[gpCom_ReadPtr[uart]]), sizeBlock);
+        sizeCopied += sizeBlock;
+
+        gpCom_ReadPtr[uart] += sizeBlock;
+        if (gpCom_ReadPtr[uart] >= ComTxBufferSize) gpCom_ReadPtr[uart] = 0;
+    }
+    return sizeCopied;
+}
 #endif
 
 
@@ -543,14 +553,25 @@ UInt16 gpComSerial_GetFreeSpace(gpCom_CommunicationId_t commId)
 }
 
 Bool gpComSerial_DataRequest(UInt8 moduleID, UInt16 length, UInt8* pData, gpCom_CommunicationId_t commId)
+{
+    gpCom_DataSegment_t segment;
+
+    segment.length = length;
+    segment.pData  = pData;
+    return gpComSerial_DataRequestV(moduleID, 1, &segment, commId);
+}
+
+Bool gpComSerial_DataRequestV(UInt8 moduleID, UInt8 nrOfSegments, const gpCom_DataSegment_t* pSegments, gpCom_CommunicationId_t commId)
 {
 #define GP_COM_DIVERSITY_SYN_SEQNUM
     UInt8  uart;
-    Bool   overrun     = false;
-    UInt16 sizeAvailable, sizeBlock;
+    UInt16 sizeAvailable;
+    UInt16 length = 0;
+    UIntLoop i;
 #ifndef GP_COM_DIVERSITY_SERIAL_NO_SYN_NO_CRC
     UInt16 checksumNew;
     UInt8  header[GP_COM_PACKET_HEADER_LENGTH];
+    UInt8  footer[GP_COM_PACKET_FOOTER_LENGTH];
 #if defined(GP_COM_DIVERSITY_SYN_SEQNUM)
     static UInt8 Com_SynSeqNum = 0;
 #endif
@@ -564,6 +585,11 @@ Bool gpComSerial_DataRequest(UInt8 moduleID, UInt16 length, UInt8* pData, gpCom_
     {
         return false;
     }
+
+    for (i = 0; i < nrOfSegments; i++)
+    {
+        length += pSegments[i].length;
+    }
 #ifndef GP_COM_DIVERSITY_SERIAL_NO_SYN_NO_CRC
     header[0] = 'S';
     header[1] = 'Y';
@@ -578,16 +604,19 @@ Bool gpComSerial_DataRequest(UInt8 moduleID, UInt16 length, UInt8* pData, gpCom_
 
     //calculate CRC before AtomicOn, since it takes a long time...
     checksumNew = 0;
-    gpUtils_CalculatePartialCrc(&checksumNew,  header, GP_COM_PACKET_HEADER_LENGTH);
-
-    gpUtils_CalculatePartialCrc(&checksumNew,  pData, length);
-
+    gpUtils_CalculatePartialCrc(&checksumNew, header, GP_COM_PACKET_HEADER_LENGTH);
+    for (i = 0; i < nrOfSegments; i++)
+    {
+        gpUtils_CalculatePartialCrc(&checksumNew, pSegments[i].pData, pSegments[i].length);
+    }
+    footer[0] = (UInt8)((checksumNew) >> 0);
+    footer[1] = (UInt8)((checksumNew) >> 8);
 #endif // GP_COM_DIVERSITY_SERIAL_NO_SYN_NO_CRC
 
     HAL_ACQUIRE_MUTEX(Com_SerialBufferMutex);
 
-    //Calculate available sizes
-    Com_CalculateSizes(&sizeAvailable,&sizeBlock, uart);
+    //Calculate available size - the complete packet is reserved at once
+    Com_CalculateSizes(&sizeAvailable, NULL, uart);
     if (gpComSerial_GetPacketSize(commId, length) > sizeAvailable)
     {
         gpComUart_DiscardTxHappening[uart] = true;
@@ -604,43 +633,28 @@ Bool gpComSerial_DataRequest(UInt8 moduleID, UInt16 length, UInt8* pData, gpCom_
     writeIdx = gpCom_WritePtr[uart];
 #ifndef GP_COM_DIVERSITY_SERIAL_NO_SYN_NO_CRC
     // Write new serial protocol header
-    overrun = Com_WriteBlock(GP_COM_PACKET_HEADER_LENGTH, &sizeAvailable, &sizeBlock, header, uart,&writeIdx);
+    Com_WriteSegment(GP_COM_PACKET_HEADER_LENGTH, header, uart, &writeIdx);
 #endif // GP_COM_DIVERSITY_SERIAL_NO_SYN_NO_CRC
     // Write data
-    if (!overrun)
+    for (i = 0; i < nrOfSegments; i++)
     {
-        overrun = Com_WriteBlock(length, &sizeAvailable, &sizeBlock, pData, uart,&writeIdx);
+        Com_WriteSegment(pSegments[i].length, pSegments[i].pData, uart, &writeIdx);
     }
-
 #ifndef GP_COM_DIVERSITY_SERIAL_NO_SYN_NO_CRC
-    // Write data
-    if (!overrun)
-    {
-      UInt8 footer[GP_COM_PACKET_FOOTER_LENGTH];
-        footer[0] = (UInt8)((checksumNew) >> 0);
-        footer[1] = (UInt8)((checksumNew) >> 8);
-        // Write additional new serial protocol header
-        overrun = Com_WriteBlock(GP_COM_PACKET_FOOTER_LENGTH, &sizeAvailable, &sizeBlock, footer, uart,&writeIdx);
-    }
+    // Write additional new serial protocol footer
+    Com_WriteSegment(GP_COM_PACKET_FOOTER_LENGTH, footer, uart, &writeIdx);
 #endif // GP_COM_DIVERSITY_SERIAL_NO_SYN_NO_CRC
-    if (!overrun)
-    {
-        /* To avoid the need for locking between an iothread and the current thread, */
-        /* only change the tx pointer once (and also only if message does fit) */
-        gpCom_WritePtr[uart] = writeIdx;
-    }
-    HAL_RELEASE_MUTEX(Com_SerialBufferMutex);
-
-    HAL_ACQUIRE_MUTEX(Com_SerialBufferMutex);
 
-    GP_ASSERT_DEV_INT(!overrun);
+    /* To avoid the need for locking between an iothread and the current thread, */
+    /* only change the tx pointer once (and also only if message does fit) */
+    gpCom_WritePtr[uart] = writeIdx;
 
     // Enable Tx interrupt immediately for continuous logging
     Com_TriggerTx(commId);
 
     HAL_RELEASE_MUTEX(Com_SerialBufferMutex);
 
-    return !overrun;
+    return true;
 }
 
 void gpComSerial_HandleTx(void)
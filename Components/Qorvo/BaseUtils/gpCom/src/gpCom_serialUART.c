@@ -160,6 +160,30 @@ static Int16 Com_cbUart2GetTxData(void)
     return Com_cbUartGetTxData(GP_COM_COMM_ID_UART2);
 }
 #endif
+
+#if defined(HAL_DIVERSITY_UART_TX_BUFFER_CALLBACK)
+static UInt16 Com_cbUartGetTxBuffer(gpCom_CommunicationId_t commId, UInt8* pData, UInt16 maxLength)
+{
+    UInt16 length;
+
+    HAL_DISABLE_GLOBAL_INT();
+    length = Com_GetDataBlock(commId, pData, maxLength);
+    HAL_ENABLE_GLOBAL_INT();
+
+    return length;
+}
+
+static UInt16 Com_cbUart1GetTxBuffer(UInt8* pData, UInt16 maxLength)
+{
+    return Com_cbUartGetTxBuffer(GP_COM_COMM_ID_UART1, pData, maxLength);
+}
+#if GP_COM_NUM_UART == 2
+static UInt16 Com_cbUart2GetTxBuffer(UInt8* pData, UInt16 maxLength)
+{
+    return Com_cbUartGetTxBuffer(GP_COM_COMM_ID_UART2, pData, maxLength);
+}
+#endif
+#endif //HAL_DIVERSITY_UART_TX_BUFFER_CALLBACK
 //RX only function
 #if defined(HAL_DIVERSITY_UART_RX_BUFFER_CALLBACK)
 static void Com_cbUartRx(UInt8 *buffer, UInt16 size)
@@ -358,6 +382,9 @@ void gpComUart_Init(void)
 #else
     HAL_UART_COM_START( Com_cbUartRx , Com_cbUart1GetTxData);
 #endif //GP_DIVERSITY_FREERTOS
+#if defined(HAL_DIVERSITY_UART_TX_BUFFER_CALLBACK)
+    hal_UartRegisterGetTxBufferCb(GP_BSP_UART_COM1, Com_cbUart1GetTxBuffer);
+#endif
 #if GP_COM_NUM_UART == 2 
 #ifdef GP_DIVERSITY_FREERTOS
     xStreamUart2RxBuff = xStreamBufferCreateStatic( sizeof( ucUart2RxBuffStorage ),
@@ -369,6 +396,9 @@ void gpComUart_Init(void)
 #else
     HAL_UART_COM2_START( Com_cbUart2Rx, Com_cbUart2GetTxData);
 #endif //GP_DIVERSITY_FREERTOS
+#if defined(HAL_DIVERSITY_UART_TX_BUFFER_CALLBACK)
+    hal_UartRegisterGetTxBufferCb(GP_BSP_UART_COM2, Com_cbUart2GetTxBuffer);
+#endif
 #endif //(GP_COM_NUM_UART == 2) && !defined(GP_COM_DIVERSITY_NO_RX) && !defined(GP_COM_DIVERSITY_UART2_DIRECT_TEST_MODE)
 
 }
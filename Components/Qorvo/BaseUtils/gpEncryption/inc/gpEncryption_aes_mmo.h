@@ -55,7 +55,8 @@ void gpEncryptionAesMmo_Start(void);
  *  be called any number of times (or can be skipped altogether) before gpEncryptionAesMmo_Finalize(). Only
  *  restriction is that message length has to be multiple of 16 bytes.
  *
- * @param msg       Input data buffer (either in system RAM or Flash) for which the hash value is computed
+ * @param msg       Input data buffer for which the hash value is computed. With the SSP (GP_ENCRYPTION_DIVERSITY_USE_AES_MMO_HW),
+ *                  data outside system RAM and Flash (ROM, UCRAM) is hashed from a copy in RAM.
  * @param nofBlocks Number of 16-byte blocks stored in msg buffer for which the AES MMO hashing is done.
  * @return
  *          - gpEncryption_ResultSuccess
@@ -70,7 +71,7 @@ gpEncryption_Result_t gpEncryptionAesMmo_Update(UInt8* msg, UInt32 nofBlocks);
  * Find AES MMO hash for input message over message length and copy hash value to output hash buffer.
  *
  * @param hash   Pointer to the buffer to which computed hash value is copied
- * @param msg    Input data buffer (either in system RAM or Flash) for which the hash value is computed
+ * @param msg    Input data buffer for which the hash value is computed, see gpEncryptionAesMmo_Update()
  * @param msglen Non-zero length of message (in bytes) stored in msg buffer.
  * @return
  *          - gpEncryption_ResultSuccess
@@ -45,6 +45,12 @@
 #include "gpAssert.h"
 #include "gpEncryption.h"
 #include "gpHal_SEC.h"
+#if defined(GP_COMP_SILEXCRYPTOSOC) && !defined(GP_ENCRYPTION_DIVERSITY_USE_AES_MMO_HW)
+#include "cryptolib_def.h"
+#include "cryptodma.h"
+#include "sx_aes.h"
+#include "sx_generic.h"
+#endif
 
 /*****************************************************************************
  *                    Macro Definitions
@@ -52,9 +58,16 @@
 
 /* Key size equal to block size - 128 bits */
 #define AES_BLOCK_SIZE_BYTES 16
+#define AES_BLOCK_SIZE_WORDS (AES_BLOCK_SIZE_BYTES / 4)
 
 #ifdef GP_ENCRYPTION_DIVERSITY_USE_AES_MMO_HW
 #define AESMMO_HW_MAX_NOF_INPUT_BLOCKS (0xFF / AES_BLOCK_SIZE_BYTES) //0xFF is the max msg len that can be passed to aesmmo hw
+
+/* Input the SSP can't read (ROM, UCRAM) is copied to RAM in chunks of this many blocks */
+#ifndef GP_ENCRYPTION_AES_MMO_BOUNCE_NOF_BLOCKS
+#define GP_ENCRYPTION_AES_MMO_BOUNCE_NOF_BLOCKS 4
+#endif //GP_ENCRYPTION_AES_MMO_BOUNCE_NOF_BLOCKS
+GP_COMPILE_TIME_VERIFY(GP_ENCRYPTION_AES_MMO_BOUNCE_NOF_BLOCKS > 0 && GP_ENCRYPTION_AES_MMO_BOUNCE_NOF_BLOCKS <= AESMMO_HW_MAX_NOF_INPUT_BLOCKS);
 #endif
 
 /*****************************************************************************
@@ -77,6 +90,9 @@ static AesMmoContext gpEncryption_AesMmoCtx LINKER_SECTION(".lower_ram_retain");
 static UInt8 paddedBlock1[AES_BLOCK_SIZE_BYTES] LINKER_SECTION(".lower_ram_retain");
 static UInt8 paddedBlock2[AES_BLOCK_SIZE_BYTES] LINKER_SECTION(".lower_ram_retain");
 static Bool gpEncryption_AesMmoInUse;
+#ifdef GP_ENCRYPTION_DIVERSITY_USE_AES_MMO_HW
+static UInt8 gpEncryption_AesMmoBounce[GP_ENCRYPTION_AES_MMO_BOUNCE_NOF_BLOCKS * AES_BLOCK_SIZE_BYTES];
+#endif
 
 /*****************************************************************************
  *                    Static functions
@@ -97,81 +113,153 @@ static void insertmsglen(UInt32 msgLenBits, UInt8* buf, UInt8 nbit)
     *buf++ = msgLenBits & 0xFF;
 }
 
-static gpEncryption_Result_t calcAesMmoHash(UInt32 nofblocks, UInt8 *msg, UInt8 *hash)
-{
 #ifndef GP_ENCRYPTION_DIVERSITY_USE_AES_MMO_HW
-    UInt8 i;
-    UInt32 blkidx;
-    UInt8 encrypted_data[AES_BLOCK_SIZE_BYTES];
-    UInt8 *pmsg;
-    gpEncryption_Result_t result;
+/* Encrypt one block with the running hash as key, out of place */
+static gpEncryption_Result_t aesMmoEncryptBlock(const UInt8* in, UInt8* key, UInt32* out)
+{
+#if defined(GP_COMP_SILEXCRYPTOSOC)
+    UInt32 bounce[AES_BLOCK_SIZE_WORDS];
+    UInt32 res;
+
+    // The crypto DMA fetches from system RAM only: input in flash or ROM is copied first
+    if(((UIntPtr)in < GP_MM_RAM_START) || (((UIntPtr)in + AES_BLOCK_SIZE_BYTES) > GP_MM_RAM_END))
+    {
+        memcpy(bounce, in, AES_BLOCK_SIZE_BYTES);
+        in = (const UInt8*)bounce;
+    }
+
+    res = sx_aes_blk(ECB, ENC, CTX_WHOLE,
+                     block_t_convert(key, AES_BLOCK_SIZE_BYTES),
+                     NULL_blk, // no xts key
+                     NULL_blk, // no iv
+                     block_t_convert(in, AES_BLOCK_SIZE_BYTES),
+                     block_t_convert(out, AES_BLOCK_SIZE_BYTES),
+                     NULL_blk, // no AAD
+                     NULL_blk, // no tag
+                     NULL_blk, // no ctx_ptr
+                     NULL_blk  // no nonce_len
+                     );
+    return (res == CRYPTOLIB_SUCCESS) ? gpEncryption_ResultSuccess : gpEncryption_ResultInvalidParameter;
+#else
     gpEncryption_AESOptions_t aesOptions;
+
     aesOptions.keylen = gpEncryption_AESKeyLen128;
     aesOptions.options = gpEncryption_KeyIdKeyPtr;
-    // take aes encryption of the msg blocks
-    for(blkidx = 0; blkidx < nofblocks; blkidx++)
+    // gpEncryption_AESEncrypt() works in place
+    memcpy(out, in, AES_BLOCK_SIZE_BYTES);
+    return gpEncryption_AESEncrypt((UInt8*)out, key, aesOptions);
+#endif //GP_COMP_SILEXCRYPTOSOC
+}
+
+/* hash = encrypted ^ msg, word by word when msg is aligned */
+static void aesMmoXorBlock(UInt8* hash, const UInt32* encrypted, const UInt8* msg)
+{
+    UIntLoop i;
+
+    if((((UIntPtr)hash | (UIntPtr)msg) & 0x3) == 0)
     {
-        pmsg = &msg[blkidx * AES_BLOCK_SIZE_BYTES];
-        /* Note: this can be further optimized if required by adding additional gpEncryption API
-        that takes separate input and output buffer (instead of inplace buffer) */
-        memcpy(encrypted_data, pmsg, AES_BLOCK_SIZE_BYTES);
-        result = gpEncryption_AESEncrypt(encrypted_data, hash, aesOptions);
-        GP_ASSERT_DEV_EXT(result == gpEncryption_ResultSuccess);
+        UInt32* hashWords = (UInt32*)hash;
+        const UInt32* msgWords = (const UInt32*)msg;
+
+        for(i = 0; i < AES_BLOCK_SIZE_WORDS; i++)
+        {
+            hashWords[i] = encrypted[i] ^ msgWords[i];
+        }
+    }
+    else
+    {
+        const UInt8* encryptedBytes = (const UInt8*)encrypted;
 
         for(i = 0; i < AES_BLOCK_SIZE_BYTES; i++)
         {
-            hash[i] = encrypted_data[i] ^ pmsg[i];
+            hash[i] = encryptedBytes[i] ^ msg[i];
         }
     }
+}
 #else
+/* Find the address of a buffer in the compressed address map, FALSE if the SSP can't read it */
+static Bool aesMmoCompressAddress(UIntPtr start, UInt32 length, UInt32* pCompressed)
+{
+    UIntPtr end = start + length;
 
-    UInt32 nofiter = nofblocks / AESMMO_HW_MAX_NOF_INPUT_BLOCKS;
-    UInt32 remblks = nofblocks % AESMMO_HW_MAX_NOF_INPUT_BLOCKS;
-    UInt32 iter;
-    UInt32 pmsgCompressed;
-    UInt32 pmsg, pmsgEnd;
-
-    pmsg = (UInt32)msg;
-    pmsgEnd = pmsg + nofblocks * AES_BLOCK_SIZE_BYTES;
-    /* Find msg address in compressed address map, depending on if data lies in Flash or System RAM */
-    if (pmsg >= GP_MM_FLASH_START && pmsgEnd < GP_MM_FLASH_ALT_START)
+    /* Depending on if data lies in Flash or System RAM */
+    if (start >= GP_MM_FLASH_START && end < GP_MM_FLASH_ALT_START)
     {
-        pmsgCompressed = GP_MM_FLASH_ADDR_TO_COMPRESSED(pmsg);
+        *pCompressed = GP_MM_FLASH_ADDR_TO_COMPRESSED(start);
     }
-    else if (pmsg >= GP_MM_FLASH_ALT_START && pmsgEnd < GP_MM_FLASH_ALT_END)
+    else if (start >= GP_MM_FLASH_ALT_START && end < GP_MM_FLASH_ALT_END)
     {
-        pmsgCompressed = GP_MM_FLASH_ALT_ADDR_TO_COMPRESSED(pmsg);
+        *pCompressed = GP_MM_FLASH_ALT_ADDR_TO_COMPRESSED(start);
     }
-    else if (pmsg >= GP_MM_RAM_START && pmsgEnd < GP_MM_RAM_END)
+    else if (start >= GP_MM_RAM_START && end < GP_MM_RAM_END)
     {
-        pmsgCompressed = GP_MM_RAM_ADDR_TO_COMPRESSED(pmsg);
+        *pCompressed = GP_MM_RAM_ADDR_TO_COMPRESSED(start);
     }
     else
     {
-        /* SSP cannot handle data located in ROM or UCRAM */
-        return gpEncryption_ResultInvalidParameter;
+        return false;
     }
+    return true;
+}
+#endif //GP_ENCRYPTION_DIVERSITY_USE_AES_MMO_HW
 
-    UInt32 maxAesMmoBytes = AESMMO_HW_MAX_NOF_INPUT_BLOCKS * AES_BLOCK_SIZE_BYTES;
-    for (iter = 0; iter < nofiter; iter++)
+static gpEncryption_Result_t calcAesMmoHash(UInt32 nofblocks, UInt8 *msg, UInt8 *hash)
+{
+#ifndef GP_ENCRYPTION_DIVERSITY_USE_AES_MMO_HW
+    UInt32 blkidx;
+    UInt32 encrypted_data[AES_BLOCK_SIZE_WORDS];
+    const UInt8 *pmsg;
+    gpEncryption_Result_t result = gpEncryption_ResultSuccess;
+
+#if defined(GP_COMP_SILEXCRYPTOSOC)
+    // One crypto accelerator session for all blocks
+    sx_enable_clock();
+#endif
+    // take aes encryption of the msg blocks, chaining the hash as key
+    for(blkidx = 0; blkidx < nofblocks; blkidx++)
     {
-        gpHalSec_SspAesMMO(pmsgCompressed,
-            GP_MM_RAM_ADDR_TO_COMPRESSED((UInt32)hash),
-            gpEncryption_AESKeyLen128,
-            maxAesMmoBytes);
-        pmsgCompressed += maxAesMmoBytes;
+        pmsg = &msg[blkidx * AES_BLOCK_SIZE_BYTES];
+        result = aesMmoEncryptBlock(pmsg, hash, encrypted_data);
+        if(result != gpEncryption_ResultSuccess)
+        {
+            break;
+        }
+        aesMmoXorBlock(hash, encrypted_data, pmsg);
     }
+#if defined(GP_COMP_SILEXCRYPTOSOC)
+    sx_disable_clock();
+#endif
+    GP_ASSERT_DEV_EXT(result == gpEncryption_ResultSuccess);
+    return result;
+#else
+    UInt32 pmsgCompressed;
+    UInt32 phashCompressed = GP_MM_RAM_ADDR_TO_COMPRESSED((UIntPtr)hash);
+    UInt32 chunkBlocks;
 
-     gpHalSec_SspAesMMO(pmsgCompressed,
-            GP_MM_RAM_ADDR_TO_COMPRESSED((UInt32)hash),
+    while(nofblocks > 0)
+    {
+        chunkBlocks = (nofblocks < AESMMO_HW_MAX_NOF_INPUT_BLOCKS) ? nofblocks : AESMMO_HW_MAX_NOF_INPUT_BLOCKS;
+        if(!aesMmoCompressAddress((UIntPtr)msg, chunkBlocks * AES_BLOCK_SIZE_BYTES, &pmsgCompressed))
+        {
+            /* SSP cannot handle data located in ROM or UCRAM, hash it from a copy in RAM */
+            if(chunkBlocks > GP_ENCRYPTION_AES_MMO_BOUNCE_NOF_BLOCKS)
+            {
+                chunkBlocks = GP_ENCRYPTION_AES_MMO_BOUNCE_NOF_BLOCKS;
+            }
+            memcpy(gpEncryption_AesMmoBounce, msg, chunkBlocks * AES_BLOCK_SIZE_BYTES);
+            pmsgCompressed = GP_MM_RAM_ADDR_TO_COMPRESSED((UIntPtr)gpEncryption_AesMmoBounce);
+        }
+        gpHalSec_SspAesMMO(pmsgCompressed,
+            phashCompressed,
             gpEncryption_AESKeyLen128,
-            remblks * AES_BLOCK_SIZE_BYTES);
-
+            chunkBlocks * AES_BLOCK_SIZE_BYTES);
+        msg += chunkBlocks * AES_BLOCK_SIZE_BYTES;
+        nofblocks -= chunkBlocks;
+    }
+    return gpEncryption_ResultSuccess;
 #endif
-     return gpEncryption_ResultSuccess;
 }
 
-
 static void fillPaddedBlocks(UInt8* msg, UInt32 msglenbytes, UInt32 totalMsgLengthBytes, UInt8 *isPaddedBlock2Present)
 {
     UInt8 indexPaddedBlock1;
@@ -453,12 +453,21 @@ gpNvm_Result_t gpNvm_PhysicalErasePool(gpNvm_PoolId_t poolId);
 void gpNvm_cbFailedCheckConsistency(void);
 
 
+#ifdef GP_NVM_DIVERSITY_IDLE_MAINTENANCE
 /** @brief Controls the automatic background defragmentation. To allow multiple usage a counter mechanism in implemented. The auto defragmentation is enabled by default.
 *
 *   @param enable                    false = disable defragmentation (counter is incremented), true = enable defragmentation (counter is decremented). The number of calls with true should match the number with calls with false to enable the background defragmentation.
 */
 void gpNvm_SetBackgroundDefragmentationMode(Bool enable);
 
+/** @brief Requests a flush of the NVM from the scheduler idle loop.
+*
+*   To be called after writes or removes, so the driver's deferred work does not land in a later foreground write.
+*   The flush is skipped while background defragmentation is disabled with gpNvm_SetBackgroundDefragmentationMode.
+*/
+void gpNvm_RequestIdleMaintenance(void);
+#endif //GP_NVM_DIVERSITY_IDLE_MAINTENANCE
+
 /* <CodeGenerator Placeholder> AdditionalPublicFunctionDefinitions */
 /**@ingroup GEN_NVM
  * @brief Registers a component to the NVM software block
@@ -70,6 +70,13 @@
 
 #define NVM_KEYMAP_TOKENLENGTH (2)
 
+#ifdef GP_NVM_DIVERSITY_IDLE_MAINTENANCE
+#if GP_SCHED_NR_OF_IDLE_CALLBACKS < 1
+#error GP_NVM_DIVERSITY_IDLE_MAINTENANCE needs an idle callback slot - increase GP_SCHED_NR_OF_IDLE_CALLBACKS
+#endif
+// The slot must not be used by another component (e.g. the BLE host), gpSched_RegisterOnIdleCallback asserts otherwise
+#endif //GP_NVM_DIVERSITY_IDLE_MAINTENANCE
+
 
 #define GP_NVM_ELEMENT_ACCESS_TYPE_BACKUP   0
 #define GP_NVM_ELEMENT_ACCESS_TYPE_RESTORE  1
@@ -123,6 +130,13 @@ static Bool Nvm_cbNvmTypeDefaultValueInitializer(const ROM void *pTag, UInt8* pB
 static const ROM gpNvm_IdentifiableTag_t * Nvm_Tags[GP_NVM_NBR_OF_UNIQUE_TAGS];
 static Int8 Nvm_registerElementEntryCounter = 0;
 
+#ifdef GP_NVM_DIVERSITY_IDLE_MAINTENANCE
+/* Set by writers, cleared by the idle callback */
+static volatile Bool Nvm_IdleMaintenancePending;
+/* Number of gpNvm_SetBackgroundDefragmentationMode(false) calls not yet matched by a call with true */
+static UInt8 Nvm_BackgroundDefragDisableCounter;
+#endif //GP_NVM_DIVERSITY_IDLE_MAINTENANCE
+
 //Storing type for consistency check
 UInt8 gpNvm_Type;
 const ROM gpNvm_IdentifiableTag_t gpNvm_NvmElement_NvmType FLASH_PROGMEM = {
@@ -394,6 +408,20 @@ void Nvm_Access(UInt8 componentId, UInt8 tagId, UInt8* pRamLocation, UInt8 acces
     }
     GP_ASSERT_DEV_EXT(tagFound);
 }
+#ifdef GP_NVM_DIVERSITY_IDLE_MAINTENANCE
+/* Runs from the scheduler idle loop - one flush per idle slot, so the deferred work of the
+   NVM driver is done outside of the writes that caused it */
+static void Nvm_OnIdleMaintenance(void)
+{
+    if(!Nvm_IdleMaintenancePending || (Nvm_BackgroundDefragDisableCounter > 0))
+    {
+        return;
+    }
+    Nvm_IdleMaintenancePending = false;
+    gpNvm_Flush();
+}
+#endif //GP_NVM_DIVERSITY_IDLE_MAINTENANCE
+
 /*****************************************************************************
  *                    Public Function Definitions
  *****************************************************************************/
@@ -414,6 +442,10 @@ void gpNvm_Init(void)
     gpNvm_Restore(GP_COMPONENT_ID, GP_NVM_TYPE_UNIQUE_TAG_ID, NULL);
 
     gpSched_ScheduleEvent(0, Nvm_CheckConsistency);
+
+#ifdef GP_NVM_DIVERSITY_IDLE_MAINTENANCE
+    gpSched_RegisterOnIdleCallback(Nvm_OnIdleMaintenance);
+#endif //GP_NVM_DIVERSITY_IDLE_MAINTENANCE
 }
 
 void gpNvm_DeInit(void)
@@ -493,6 +525,29 @@ void gpNvm_Flush(void)
     Nvm_Flush();
 }
 
+#ifdef GP_NVM_DIVERSITY_IDLE_MAINTENANCE
+void gpNvm_RequestIdleMaintenance(void)
+{
+    Nvm_IdleMaintenancePending = true;
+}
+
+void gpNvm_SetBackgroundDefragmentationMode(Bool enable)
+{
+    HAL_DISABLE_GLOBAL_INT();
+    if(enable)
+    {
+        GP_ASSERT_DEV_EXT(Nvm_BackgroundDefragDisableCounter > 0);
+        Nvm_BackgroundDefragDisableCounter--;
+    }
+    else
+    {
+        GP_ASSERT_DEV_EXT(Nvm_BackgroundDefragDisableCounter < 0xFF);
+        Nvm_BackgroundDefragDisableCounter++;
+    }
+    HAL_ENABLE_GLOBAL_INT();
+}
+#endif //GP_NVM_DIVERSITY_IDLE_MAINTENANCE
+
 void gpNvm_RegisterElement(const ROM gpNvm_IdentifiableTag_t* pTag)
 {
     gpNvm_KeyIndex_t i;
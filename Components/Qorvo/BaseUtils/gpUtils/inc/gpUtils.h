@@ -58,6 +58,9 @@
 
 #include "global.h"
 #include "hal.h"
+#ifdef GP_UTILS_DIVERSITY_PROFILER
+#include "gpUtils_Prof.h"
+#endif //GP_UTILS_DIVERSITY_PROFILER
 
 /*****************************************************************************
  *                    Macro Definitions
@@ -148,10 +151,20 @@
 #define POSTPROCESSING
 #define HOSTPROCESSING
 
+#if defined(GP_UTILS_DIVERSITY_PROFILER)
+#define GP_UTILS_CPUMON_INIT()                  gpUtils_ProfInit()
+#define GP_UTILS_CPUMON_NEW_SCHEDULER_LOOP()    gpUtils_ProfNewLoop()
+#define GP_UTILS_CPUMON_PROCDONE(x)             gpUtils_ProfProcDone(GP_UTILS_PROF_PROBE_##x)
+#else
 #define GP_UTILS_CPUMON_INIT()
 #define GP_UTILS_CPUMON_NEW_SCHEDULER_LOOP()
 #define GP_UTILS_CPUMON_PROCDONE(x)
 
+#define GP_UTILS_PROF_SCOPE(probe)
+#define GP_UTILS_PROF_START(name)
+#define GP_UTILS_PROF_STOP(name, probe)
+#endif //GP_UTILS_DIVERSITY_PROFILER
+
 #define GP_UTILS_CPUMON_IRQPROLOGUE()
 #define GP_UTILS_CPUMON_IRQEPILOGUE()
 
@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2026, Qorvo Inc
+ *
+ * gpUtils_Prof.h
+ *
+ * Hot path profiler behind the GP_UTILS_CPUMON hooks (GP_UTILS_DIVERSITY_PROFILER).
+ *
+ * This software is owned by Qorvo Inc
+ * and protected under applicable copyright laws.
+ * It is delivered under the terms of the license
+ * and is intended and supplied for use solely and
+ * exclusively with products manufactured by
+ * Qorvo Inc.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED IN AN "AS IS"
+ * CONDITION. NO WARRANTIES, WHETHER EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING, BUT NOT
+ * LIMITED TO, IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ * QORVO INC. SHALL NOT, IN ANY
+ * CIRCUMSTANCES, BE LIABLE FOR SPECIAL,
+ * INCIDENTAL OR CONSEQUENTIAL DAMAGES,
+ * FOR ANY REASON WHATSOEVER.
+ *
+ * $Header$
+ * $Change$
+ * $DateTime$
+ *
+ */
+
+#ifndef _GPUTILS_PROF_H_
+#define _GPUTILS_PROF_H_
+
+/**
+ * @file gpUtils_Prof.h
+ *
+ * Every probe aggregates the duration of the code it wraps: count, min, max, total and a log2 histogram.
+ * Durations are DWT cycles on target. A host build (GP_UTILS_DIVERSITY_PROFILER_HOST) uses clock_gettime()
+ * and counts nanoseconds, so the same probes can be compared with off-target benchmarks.
+ *
+ * Probes:
+ * - GP_UTILS_PROF_SCOPE(probe) measures until the end of the enclosing block, including early returns.
+ * - GP_UTILS_PROF_START(name) / GP_UTILS_PROF_STOP(name, probe) measure a few statements.
+ * - GP_UTILS_CPUMON_PROCDONE(x) attributes the time since the previous mark in the scheduler loop to phase x.
+ *   The radio interrupt, gpCom, LwIP and event phases are marked in the flash gpSched_Main_Body(), which is only
+ *   built when the ROM version needs the patch; with the ROM main body only the post processing phase is recorded.
+ *
+ * The statistics are dumped with gpUtils_ProfDump() or requested over gpCom (module GP_COMPONENT_ID_UTILS),
+ * see GP_UTILS_PROF_CMD_DUMP.
+*/
+
+/*****************************************************************************
+ *                    Includes Definitions
+ *****************************************************************************/
+
+#include "global.h"
+#include "hal.h"
+#if defined(GP_UTILS_DIVERSITY_PROFILER_HOST)
+#include <time.h>
+#endif //GP_UTILS_DIVERSITY_PROFILER_HOST
+
+/*****************************************************************************
+ *                    Macro Definitions
+ *****************************************************************************/
+
+/** @name gpUtils_ProfProbe_t */
+//@{
+/** @brief Handling of one scheduler wake up */
+#define gpUtils_ProfProbeSchedLoop          0
+/** @brief Scheduler phase: radio interrupt handling */
+#define gpUtils_ProfProbeRadioInt           1
+/** @brief Scheduler phase: gpCom TX/RX handling */
+#define gpUtils_ProfProbeGpComTxRx          2
+/** @brief Scheduler phase: LwIP handling */
+#define gpUtils_ProfProbeLwip               3
+/** @brief Scheduler phase: event execution */
+#define gpUtils_ProfProbeSchedEvent         4
+/** @brief Scheduler phase: post processing callbacks */
+#define gpUtils_ProfProbePostProcessing     5
+/** @brief gpHal_RCIInterrupt() */
+#define gpUtils_ProfProbeRciInterrupt       6
+/** @brief gpHal_PHYInterrupt() */
+#define gpUtils_ProfProbePhyInterrupt       7
+/** @brief gpHal_ESInterrupt() */
+#define gpUtils_ProfProbeEsInterrupt        8
+/** @brief qvCHIP_KvsGet() */
+#define gpUtils_ProfProbeKvsGet             9
+/** @brief qvCHIP_KvsPut() */
+#define gpUtils_ProfProbeKvsPut             10
+/** @brief qvCHIP_KvsDelete() */
+#define gpUtils_ProfProbeKvsDelete          11
+/** @brief NVM read issued by the KVS */
+#define gpUtils_ProfProbeNvmRead            12
+/** @brief NVM write issued by the KVS */
+#define gpUtils_ProfProbeNvmWrite           13
+/** @brief Crypto accelerator session, from the outermost sx_enable_clock() to its sx_disable_clock() */
+#define gpUtils_ProfProbeCrypto             14
+/** @brief Number of probes */
+#define gpUtils_ProfProbeNrOf               15
+/** @typedef gpUtils_ProfProbe_t
+ *  @brief Identifier of a profiler probe.
+*/
+typedef UInt8 gpUtils_ProfProbe_t;
+//@}
+
+// Scheduler phases as named by GP_UTILS_CPUMON_PROCDONE()
+#define GP_UTILS_PROF_PROBE_RADIO_INT       gpUtils_ProfProbeRadioInt
+#define GP_UTILS_PROF_PROBE_GPCOMTXRX       gpUtils_ProfProbeGpComTxRx
+#define GP_UTILS_PROF_PROBE_LWIP            gpUtils_ProfProbeLwip
+#define GP_UTILS_PROF_PROBE_SCHEDEVENT      gpUtils_ProfProbeSchedEvent
+#define GP_UTILS_PROF_PROBE_POSTPROCESSING  gpUtils_ProfProbePostProcessing
+
+/** @brief Number of histogram buckets per probe */
+#define GP_UTILS_PROF_HIST_NR_OF_BUCKETS    16
+
+/** @brief Durations below 2^(GP_UTILS_PROF_HIST_SHIFT+1) go into the first bucket, bucket i covers [2^(i+SHIFT), 2^(i+SHIFT+1)[.
+ *  The last bucket collects all longer durations. */
+#ifndef GP_UTILS_PROF_HIST_SHIFT
+#define GP_UTILS_PROF_HIST_SHIFT            4
+#endif //GP_UTILS_PROF_HIST_SHIFT
+
+/** @name gpUtils_ProfUnit_t */
+//@{
+/** @brief Durations are CPU cycles */
+#define gpUtils_ProfUnitCycles              0
+/** @brief Durations are nanoseconds */
+#define gpUtils_ProfUnitNs                  1
+typedef UInt8 gpUtils_ProfUnit_t;
+//@}
+
+/** @name gpCom commands (first byte of a request to GP_COMPONENT_ID_UTILS) */
+//@{
+/** @brief Dump all probes. Answered with one record per probe and an end record with probe 0xFF.
+ *  Record: cmd, probe, unit, count(4), min(4), max(4), total(8), histogram(GP_UTILS_PROF_HIST_NR_OF_BUCKETS*2),
+ *  all fields little endian. */
+#define GP_UTILS_PROF_CMD_DUMP              0x01
+/** @brief Clear all probes */
+#define GP_UTILS_PROF_CMD_RESET             0x02
+//@}
+
+/*****************************************************************************
+ *                    Functional Macro Definitions
+ *****************************************************************************/
+
+#if defined(GP_UTILS_DIVERSITY_PROFILER_HOST)
+#define GP_UTILS_PROF_UNIT                  gpUtils_ProfUnitNs
+#else
+#define GP_UTILS_PROF_UNIT                  gpUtils_ProfUnitCycles
+#endif //GP_UTILS_DIVERSITY_PROFILER_HOST
+
+#define GP_UTILS_PROF_SCOPE(probe) \
+    gpUtils_ProfScope_t gpUtils_ProfScope_##probe __attribute__((cleanup(gpUtils_ProfScopeEnd))) = { (probe), gpUtils_ProfGetTime() }
+
+#define GP_UTILS_PROF_START(name)           UInt32 gpUtils_ProfStart_##name = gpUtils_ProfGetTime()
+#define GP_UTILS_PROF_STOP(name, probe)     gpUtils_ProfRecord((probe), gpUtils_ProfGetTime() - gpUtils_ProfStart_##name)
+
+/*****************************************************************************
+ *                    Type Definitions
+ *****************************************************************************/
+
+/** @brief Statistics of one probe */
+typedef struct {
+    /** Number of measurements */
+    UInt32 count;
+    /** Shortest measurement */
+    UInt32 min;
+    /** Longest measurement */
+    UInt32 max;
+    /** Sum of all measurements, the average is total/count */
+    UInt64 total;
+    /** Log2 histogram, see GP_UTILS_PROF_HIST_SHIFT. Buckets saturate at 0xFFFF. */
+    UInt16 histogram[GP_UTILS_PROF_HIST_NR_OF_BUCKETS];
+} gpUtils_ProfStats_t;
+
+/** @brief State of a GP_UTILS_PROF_SCOPE() probe */
+typedef struct {
+    gpUtils_ProfProbe_t probe;
+    UInt32 start;
+} gpUtils_ProfScope_t;
+
+/*****************************************************************************
+ *                    Public Function Prototypes
+ *****************************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Current time of the profiler timebase (DWT cycles, or ns in a host build). Wraps around. */
+ALWAYS_INLINE UInt32 gpUtils_ProfGetTime(void)
+{
+#if defined(GP_UTILS_DIVERSITY_PROFILER_HOST)
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (UInt32)((UInt64)now.tv_sec * 1000000000UL + (UInt64)now.tv_nsec);
+#else
+    return GET_CYCLE_COUNT();
+#endif //GP_UTILS_DIVERSITY_PROFILER_HOST
+}
+
+/** @brief Start the timebase, clear all probes and register the gpCom request handler. */
+void gpUtils_ProfInit(void);
+
+/** @brief Clear all probes. */
+void gpUtils_ProfReset(void);
+
+/**
+ *  Add a measurement to a probe. Can be called from interrupt context.
+ *
+ *  @param probe     Probe identifier.
+ *  @param duration  Duration in the unit of the timebase.
+ */
+void gpUtils_ProfRecord(gpUtils_ProfProbe_t probe, UInt32 duration);
+
+/** @brief Cleanup handler of GP_UTILS_PROF_SCOPE(). */
+void gpUtils_ProfScopeEnd(gpUtils_ProfScope_t* pScope);
+
+/** @brief Start of a scheduler loop, resets the phase mark of GP_UTILS_CPUMON_PROCDONE(). */
+void gpUtils_ProfNewLoop(void);
+
+/** @brief End of a scheduler phase, the time since the previous mark is added to the phase probe. */
+void gpUtils_ProfProcDone(gpUtils_ProfProbe_t probe);
+
+/**
+ *  Get a copy of the statistics of a probe.
+ *
+ *  @param probe   Probe identifier.
+ *  @param pStats  Pointer to the structure where the statistics are copied to.
+ */
+void gpUtils_ProfGetStats(gpUtils_ProfProbe_t probe, gpUtils_ProfStats_t* pStats);
+
+/** @brief Name of a probe, for logging. */
+const char* gpUtils_ProfGetName(gpUtils_ProfProbe_t probe);
+
+/** @brief Log the statistics of all probes that have measurements. */
+void gpUtils_ProfDump(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* _GPUTILS_PROF_H_ */
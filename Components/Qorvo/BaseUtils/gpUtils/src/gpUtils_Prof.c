@@ -0,0 +1,292 @@
+/*
+ * Copyright (c) 2026, Qorvo Inc
+ *
+ * gpUtils_Prof.c
+ *
+ * This file contains the hot path profiler of the Utils component.
+ *
+ * This software is owned by Qorvo Inc
+ * and protected under applicable copyright laws.
+ * It is delivered under the terms of the license
+ * and is intended and supplied for use solely and
+ * exclusively with products manufactured by
+ * Qorvo Inc.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED IN AN "AS IS"
+ * CONDITION. NO WARRANTIES, WHETHER EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING, BUT NOT
+ * LIMITED TO, IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ * QORVO INC. SHALL NOT, IN ANY
+ * CIRCUMSTANCES, BE LIABLE FOR SPECIAL,
+ * INCIDENTAL OR CONSEQUENTIAL DAMAGES,
+ * FOR ANY REASON WHATSOEVER.
+ *
+ * Alternatively, this software may be distributed under the terms of the
+ * modified BSD License or the 3-clause BSD License as published by the Free
+ * Software Foundation @ https://directory.fsf.org/wiki/License:BSD-3-Clause
+ *
+ * $Header$
+ * $Change$
+ * $DateTime$
+ *
+ */
+
+/*****************************************************************************
+ *                    Includes Definitions
+ *****************************************************************************/
+
+#define GP_COMPONENT_ID GP_COMPONENT_ID_UTILS
+
+#include "gpUtils.h"
+#include "gpLog.h"
+#include "gpAssert.h"
+#ifdef GP_COMP_COM
+#include "gpCom.h"
+#endif //GP_COMP_COM
+
+#ifdef GP_UTILS_DIVERSITY_PROFILER
+
+/*****************************************************************************
+ *                    Macro Definitions
+ *****************************************************************************/
+
+#define UTILS_PROF_HIST_BUCKET_MAX      0xFFFF
+
+/* cmd, probe, unit, count, min, max, total, histogram */
+#define UTILS_PROF_RECORD_SIZE          (3 + 4 + 4 + 4 + 8 + 2 * GP_UTILS_PROF_HIST_NR_OF_BUCKETS)
+#define UTILS_PROF_RECORD_END_PROBE     0xFF
+
+#ifdef GP_COMP_COM
+GP_COMPILE_TIME_VERIFY(UTILS_PROF_RECORD_SIZE <= GP_COM_MAX_PACKET_PAYLOAD_SIZE);
+#endif //GP_COMP_COM
+
+/*****************************************************************************
+ *                    Static Data Definitions
+ *****************************************************************************/
+
+static gpUtils_ProfStats_t Utils_ProfStats[gpUtils_ProfProbeNrOf];
+
+/* End of the previous scheduler phase, see gpUtils_ProfProcDone() */
+static UInt32 Utils_ProfPhaseMark;
+
+static const char* const Utils_ProfNames[gpUtils_ProfProbeNrOf] = {
+    "SchedLoop",
+    "RadioInt",
+    "GpComTxRx",
+    "Lwip",
+    "SchedEvent",
+    "PostProc",
+    "RciInt",
+    "PhyInt",
+    "EsInt",
+    "KvsGet",
+    "KvsPut",
+    "KvsDelete",
+    "NvmRead",
+    "NvmWrite",
+    "Crypto",
+};
+
+/*****************************************************************************
+ *                    Static Function Definitions
+ *****************************************************************************/
+
+static UInt8 Utils_ProfGetBucket(UInt32 duration)
+{
+    UInt8 log2;
+
+    if(duration == 0)
+    {
+        return 0;
+    }
+    log2 = 31 - __builtin_clz(duration);
+    if(log2 <= GP_UTILS_PROF_HIST_SHIFT)
+    {
+        return 0;
+    }
+    log2 -= GP_UTILS_PROF_HIST_SHIFT;
+    return (log2 < GP_UTILS_PROF_HIST_NR_OF_BUCKETS) ? log2 : (GP_UTILS_PROF_HIST_NR_OF_BUCKETS - 1);
+}
+
+#ifdef GP_COMP_COM
+static UInt8* Utils_ProfWriteU32(UInt8* pData, UInt32 value)
+{
+    UIntLoop i;
+
+    for(i = 0; i < 4; i++)
+    {
+        *pData++ = (UInt8)(value >> (8 * i));
+    }
+    return pData;
+}
+
+static void Utils_ProfSendRecord(gpCom_CommunicationId_t commId, gpUtils_ProfProbe_t probe)
+{
+    UInt8 record[UTILS_PROF_RECORD_SIZE];
+    UInt8* pData = record;
+    gpUtils_ProfStats_t stats;
+    UIntLoop i;
+
+    *pData++ = GP_UTILS_PROF_CMD_DUMP;
+    *pData++ = probe;
+    *pData++ = GP_UTILS_PROF_UNIT;
+    if(probe == UTILS_PROF_RECORD_END_PROBE)
+    {
+        gpCom_DataRequest(GP_COMPONENT_ID, (UInt16)(pData - record), record, commId);
+        return;
+    }
+
+    gpUtils_ProfGetStats(probe, &stats);
+    pData = Utils_ProfWriteU32(pData, stats.count);
+    pData = Utils_ProfWriteU32(pData, stats.min);
+    pData = Utils_ProfWriteU32(pData, stats.max);
+    pData = Utils_ProfWriteU32(pData, (UInt32)stats.total);
+    pData = Utils_ProfWriteU32(pData, (UInt32)(stats.total >> 32));
+    for(i = 0; i < GP_UTILS_PROF_HIST_NR_OF_BUCKETS; i++)
+    {
+        *pData++ = (UInt8)stats.histogram[i];
+        *pData++ = (UInt8)(stats.histogram[i] >> 8);
+    }
+    gpCom_DataRequest(GP_COMPONENT_ID, (UInt16)(pData - record), record, commId);
+}
+
+static void Utils_ProfCbRxData(UInt16 length, UInt8* pData, gpCom_CommunicationId_t commId)
+{
+    gpUtils_ProfProbe_t probe;
+
+    if(length == 0)
+    {
+        return;
+    }
+
+    switch(pData[0])
+    {
+        case GP_UTILS_PROF_CMD_DUMP:
+        {
+            for(probe = 0; probe < gpUtils_ProfProbeNrOf; probe++)
+            {
+                Utils_ProfSendRecord(commId, probe);
+            }
+            Utils_ProfSendRecord(commId, UTILS_PROF_RECORD_END_PROBE);
+            break;
+        }
+        case GP_UTILS_PROF_CMD_RESET:
+        {
+            gpUtils_ProfReset();
+            break;
+        }
+        default:
+        {
+            GP_LOG_PRINTF("Prof: unknown cmd %x", 0, pData[0]);
+            break;
+        }
+    }
+}
+#endif //GP_COMP_COM
+
+/*****************************************************************************
+ *                    Public Function Definitions
+ *****************************************************************************/
+
+void gpUtils_ProfInit(void)
+{
+#if !defined(GP_UTILS_DIVERSITY_PROFILER_HOST)
+    INIT_CYCLE_COUNT();
+    RESUME_CYCLE_COUNT();
+#endif //GP_UTILS_DIVERSITY_PROFILER_HOST
+    gpUtils_ProfReset();
+    Utils_ProfPhaseMark = gpUtils_ProfGetTime();
+#ifdef GP_COMP_COM
+    gpCom_RegisterModule(GP_COMPONENT_ID, Utils_ProfCbRxData);
+#endif //GP_COMP_COM
+}
+
+void gpUtils_ProfReset(void)
+{
+    HAL_DISABLE_GLOBAL_INT();
+    MEMSET(Utils_ProfStats, 0, sizeof(Utils_ProfStats));
+    HAL_ENABLE_GLOBAL_INT();
+}
+
+void gpUtils_ProfRecord(gpUtils_ProfProbe_t probe, UInt32 duration)
+{
+    gpUtils_ProfStats_t* pStats;
+    UInt8 bucket;
+
+    GP_ASSERT_DEV_INT(probe < gpUtils_ProfProbeNrOf);
+
+    bucket = Utils_ProfGetBucket(duration);
+    pStats = &Utils_ProfStats[probe];
+
+    HAL_DISABLE_GLOBAL_INT();
+    if((pStats->count == 0) || (duration < pStats->min))
+    {
+        pStats->min = duration;
+    }
+    if(duration > pStats->max)
+    {
+        pStats->max = duration;
+    }
+    pStats->count++;
+    pStats->total += duration;
+    if(pStats->histogram[bucket] < UTILS_PROF_HIST_BUCKET_MAX)
+    {
+        pStats->histogram[bucket]++;
+    }
+    HAL_ENABLE_GLOBAL_INT();
+}
+
+void gpUtils_ProfScopeEnd(gpUtils_ProfScope_t* pScope)
+{
+    gpUtils_ProfRecord(pScope->probe, gpUtils_ProfGetTime() - pScope->start);
+}
+
+void gpUtils_ProfNewLoop(void)
+{
+    Utils_ProfPhaseMark = gpUtils_ProfGetTime();
+}
+
+void gpUtils_ProfProcDone(gpUtils_ProfProbe_t probe)
+{
+    UInt32 now = gpUtils_ProfGetTime();
+
+    gpUtils_ProfRecord(probe, now - Utils_ProfPhaseMark);
+    Utils_ProfPhaseMark = now;
+}
+
+void gpUtils_ProfGetStats(gpUtils_ProfProbe_t probe, gpUtils_ProfStats_t* pStats)
+{
+    GP_ASSERT_DEV_EXT(probe < gpUtils_ProfProbeNrOf);
+
+    HAL_DISABLE_GLOBAL_INT();
+    MEMCPY(pStats, &Utils_ProfStats[probe], sizeof(gpUtils_ProfStats_t));
+    HAL_ENABLE_GLOBAL_INT();
+}
+
+const char* gpUtils_ProfGetName(gpUtils_ProfProbe_t probe)
+{
+    return (probe < gpUtils_ProfProbeNrOf) ? Utils_ProfNames[probe] : "?";
+}
+
+void gpUtils_ProfDump(void)
+{
+    gpUtils_ProfProbe_t probe;
+    gpUtils_ProfStats_t stats;
+
+    GP_LOG_SYSTEM_PRINTF("Prof unit %u (0:cycles 1:ns) probe: n/min/avg/max", 0, (UInt16)GP_UTILS_PROF_UNIT);
+    for(probe = 0; probe < gpUtils_ProfProbeNrOf; probe++)
+    {
+        gpUtils_ProfGetStats(probe, &stats);
+        if(stats.count == 0)
+        {
+            continue;
+        }
+        GP_LOG_SYSTEM_PRINTF("%u: %lu/%lu/%lu/%lu", 0, (UInt16)probe, (unsigned long)stats.count,
+                             (unsigned long)stats.min, (unsigned long)(stats.total / stats.count), (unsigned long)stats.max);
+    }
+}
+
+#endif //GP_UTILS_DIVERSITY_PROFILER
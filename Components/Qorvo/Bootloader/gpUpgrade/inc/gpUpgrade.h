@@ -243,6 +243,9 @@ void gpUpgrade_StartWrite(void);
 
 /** @brief Application API: write chunk of data to external or internal storage device and update CRC.
 *
+*   With GP_UPGRADE_DIVERSITY_STREAM_WRITE, chunks are gathered per flash page and full pages are programmed from
+*   the scheduler. A write error of such a page is returned by a later call or by gpUpgrade_FlushWrite.
+*
 *   @param address                   Address location of where to write the data.
 *   @param length                    Number of bytes to write.
 *   @param dataChunk                 Pointer to the data to write.
@@ -250,6 +253,15 @@ void gpUpgrade_StartWrite(void);
 */
 gpUpgrade_Status_t gpUpgrade_WriteChunk(UInt32 address, UInt16 length, UInt8* dataChunk);
 
+/** @brief Application API: program the data of gpUpgrade_WriteChunk still held in RAM.
+*
+*   gpUpgrade_ReadChunk and gpUpgrade_SetPendingImage flush as well.
+*   Without GP_UPGRADE_DIVERSITY_STREAM_WRITE, chunks are written immediately and this does nothing.
+*
+*   @return result                   First write error since the previous flush, if any.
+*/
+gpUpgrade_Status_t gpUpgrade_FlushWrite(void);
+
 /** @brief Application API: read chunk of data from external or internal storage device.
 *
 *   @param address                   Address location of data to read.
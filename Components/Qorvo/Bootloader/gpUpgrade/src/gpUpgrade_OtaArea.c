@@ -48,10 +48,28 @@
 #include "gpExtStorage.h"
 #endif //GP_COMP_EXTSTORAGE
 
+#if defined(GP_UPGRADE_DIVERSITY_STREAM_WRITE) && !defined(GP_DIVERSITY_BOOTLOADER_BUILD)
+#include "gpSched.h"
+#endif //GP_UPGRADE_DIVERSITY_STREAM_WRITE
+
 /*****************************************************************************
  *                    Macro Definitions
  *****************************************************************************/
 
+#if defined(GP_UPGRADE_DIVERSITY_STREAM_WRITE) && !defined(GP_DIVERSITY_BOOTLOADER_BUILD)
+#if defined(GP_COMP_EXTSTORAGE) && !defined(GP_UPGRADE_DIVERSITY_USE_INTSTORAGE)
+#error GP_UPGRADE_DIVERSITY_STREAM_WRITE is only supported for OTA areas in internal flash
+#endif //GP_COMP_EXTSTORAGE
+#define UPGRADE_STREAM_WRITE
+#endif //GP_UPGRADE_DIVERSITY_STREAM_WRITE
+
+#ifdef UPGRADE_STREAM_WRITE
+/** @brief Number of sectors kept erased in front of the page being filled */
+#ifndef GP_UPGRADE_STREAM_ERASE_AHEAD_SECTORS
+#define GP_UPGRADE_STREAM_ERASE_AHEAD_SECTORS   2
+#endif //GP_UPGRADE_STREAM_ERASE_AHEAD_SECTORS
+#endif //UPGRADE_STREAM_WRITE
+
 /*****************************************************************************
  *                    Functional Macro Definitions
  *****************************************************************************/
@@ -59,6 +77,7 @@
 #define FLASH_ALIGN_SECTOR(address)                     ((address) - ((address) % FLASH_SECTOR_SIZE))
 #define FLASH_RANGE_IN_SINGLE_SECTOR(address, length)   ((length) <= (FLASH_SECTOR_SIZE - ((address) % FLASH_SECTOR_SIZE)))
 #define FLASH_TO_SECTOR_END(address)                    (FLASH_SECTOR_SIZE - ((address) % FLASH_SECTOR_SIZE))
+#define FLASH_ROUND_UP_WRITE_UNIT(length)               ((((length) + FLASH_WRITE_UNIT - 1) / FLASH_WRITE_UNIT) * FLASH_WRITE_UNIT)
 
 #if defined(GP_DIVERSITY_GPHAL_K8E)
 #ifdef GP_UPGRADE_DIVERSITY_COMPRESSION
@@ -108,6 +127,32 @@ const UInt32 GP_OTA_FLASH_START = (UInt32)&OTA_Start;
 const UInt32 GP_OTA_FLASH_END = (UInt32)&OTA_End;
 #endif
 #endif //GP_COMP_EXTSTORAGE
+
+#ifdef UPGRADE_STREAM_WRITE
+/* Streaming writer state
+ * Chunks are gathered per flash page. A full page is handed to a scheduled event for programming, while the next
+ * chunks fill the other buffer. The sectors in front of the stream are erased from scheduled events as well, so a
+ * page is programmed without an erase or read-back of its sector. */
+static UInt32 Upgrade_StreamBuffer[2][FLASH_PAGE_SIZE / sizeof(UInt32)];
+static UInt32 Upgrade_StreamPageAddress[2];
+/* Buffer being filled, its valid bytes and whether the other buffer holds a full page to program */
+static UInt8  Upgrade_StreamFill;
+static UInt16 Upgrade_StreamFillLength;
+static Bool   Upgrade_StreamPending;
+/* Address where the next chunk continues the stream, when active */
+static Bool   Upgrade_StreamActive;
+static UInt32 Upgrade_StreamNext;
+/* End of the data written in this session - a new stream only starts beyond it */
+static UInt32 Upgrade_StreamHighWater;
+/* Blank flash: [Upgrade_StreamErasedStart, Upgrade_StreamErasedEnd), the end is sector aligned */
+static Bool   Upgrade_StreamWindowValid;
+static UInt32 Upgrade_StreamErasedStart;
+static UInt32 Upgrade_StreamErasedEnd;
+/* First failure of a deferred page write, reported by the next write or flush */
+static gpUpgrade_Status_t Upgrade_StreamStatus = gpUpgrade_StatusSuccess;
+
+HAL_CRITICAL_SECTION_DEF(Upgrade_StreamMutex)
+#endif //UPGRADE_STREAM_WRITE
 /*****************************************************************************
  *                    Static Function Prototypes
  *****************************************************************************/
@@ -134,6 +179,30 @@ static gpUpgrade_Status_t Upgrade_WriteChunk(UInt32 address, UInt16 length, UInt
     }
     return otaResult;
 }
+
+/* Read-modify-write of the sectors holding the chunk */
+static gpUpgrade_Status_t Upgrade_ProgramChunk(UInt32 address, UInt16 length, UInt8* dataChunk)
+{
+    gpUpgrade_Status_t otaResult;
+
+    //split in 2 chunks
+    if(!FLASH_RANGE_IN_SINGLE_SECTOR(address, length))
+    {
+        UInt16 chunksize = FLASH_TO_SECTOR_END(address);
+        UInt16 leftsize = length - FLASH_TO_SECTOR_END(address);
+
+        otaResult = Upgrade_WriteChunk(address, chunksize, dataChunk);
+        if(otaResult == gpUpgrade_StatusSuccess)
+        {
+            otaResult = Upgrade_WriteChunk(address+chunksize, leftsize, &dataChunk[chunksize]);
+        }
+    }
+    else
+    {
+        otaResult = Upgrade_WriteChunk(address, length, dataChunk);
+    }
+    return otaResult;
+}
 #endif // !defined(GP_COMP_EXTSTORAGE) && !defined(GP_DIVERSITY_BOOTLOADER_BUILD)
 
 #ifndef GP_DIVERSITY_BOOTLOADER_BUILD
@@ -167,6 +236,279 @@ static Bool Upgrade_CheckValidAddressRange(UInt32 address)
     return retVal;
 }
 #endif // !GP_DIVERSITY_BOOTLOADER_BUILD
+
+#ifdef UPGRADE_STREAM_WRITE
+static void Upgrade_StreamLock(void)
+{
+#ifdef HAL_MUTEX_SUPPORTED
+    if(!HAL_VALID_MUTEX(Upgrade_StreamMutex))
+    {
+        HAL_CREATE_MUTEX(&Upgrade_StreamMutex);
+    }
+    HAL_ACQUIRE_MUTEX(Upgrade_StreamMutex);
+#endif //HAL_MUTEX_SUPPORTED
+}
+
+static void Upgrade_StreamUnlock(void)
+{
+#ifdef HAL_MUTEX_SUPPORTED
+    HAL_RELEASE_MUTEX(Upgrade_StreamMutex);
+#endif //HAL_MUTEX_SUPPORTED
+}
+
+static void Upgrade_StreamProgram(UInt8 buffer, UInt16 length)
+{
+    gpHal_FlashError_t result;
+
+    result = gpHal_FlashWrite(Upgrade_StreamPageAddress[buffer], length / sizeof(UInt32), Upgrade_StreamBuffer[buffer]);
+    if(result != gpHal_FlashError_Success)
+    {
+        GP_LOG_SYSTEM_PRINTF("OTA page write failed (error %x)", 0, result);
+        if(Upgrade_StreamStatus == gpUpgrade_StatusSuccess)
+        {
+            Upgrade_StreamStatus = gpUpgrade_StatusWriteError;
+        }
+    }
+}
+
+static void Upgrade_StreamProgramPending(void)
+{
+    if(Upgrade_StreamPending)
+    {
+        Upgrade_StreamProgram(Upgrade_StreamFill ^ 1, FLASH_PAGE_SIZE);
+        Upgrade_StreamPending = false;
+    }
+}
+
+/* Program the buffered data and end the stream, the next chunk starts a new one */
+static void Upgrade_StreamFlush(void)
+{
+    Upgrade_StreamProgramPending();
+    if(Upgrade_StreamActive && (Upgrade_StreamFillLength != 0))
+    {
+        UInt16 length = FLASH_ROUND_UP_WRITE_UNIT(Upgrade_StreamFillLength);
+
+        // Pad the tail of the last write unit with the erased value (0x00 on this flash), so it is left blank
+        MEMSET(((UInt8*)Upgrade_StreamBuffer[Upgrade_StreamFill]) + Upgrade_StreamFillLength, 0x00, length - Upgrade_StreamFillLength);
+        Upgrade_StreamProgram(Upgrade_StreamFill, length);
+        Upgrade_StreamFillLength = 0;
+    }
+    Upgrade_StreamActive = false;
+}
+
+static gpUpgrade_Status_t Upgrade_StreamTakeStatus(gpUpgrade_Status_t status)
+{
+    if(status == gpUpgrade_StatusSuccess)
+    {
+        status = Upgrade_StreamStatus;
+    }
+    Upgrade_StreamStatus = gpUpgrade_StatusSuccess;
+    return status;
+}
+
+static Bool Upgrade_StreamPageIsBlank(UInt32 pageAddress)
+{
+    return Upgrade_StreamWindowValid &&
+           (pageAddress >= Upgrade_StreamErasedStart) && (pageAddress < Upgrade_StreamErasedEnd);
+}
+
+/* Erase the sector of a page outside of the erased window, keeping the pages in front of it */
+static void Upgrade_StreamPrepareSector(UInt32 pageAddress)
+{
+    UInt32 sectorAddress = FLASH_ALIGN_SECTOR(pageAddress);
+    UInt32 prefix[(FLASH_SECTOR_SIZE - FLASH_PAGE_SIZE) / sizeof(UInt32)];
+    UInt32 prefixLength = pageAddress - sectorAddress;
+    UInt32 offset;
+    gpHal_FlashError_t result = gpHal_FlashError_Success;
+
+    // The pending page can be in front of this page in the same sector
+    Upgrade_StreamProgramPending();
+
+    if(prefixLength != 0)
+    {
+        result = gpHal_FlashRead(sectorAddress, prefixLength, (UInt8*)prefix);
+    }
+    if(result == gpHal_FlashError_Success)
+    {
+        result = gpHal_FlashEraseSector(sectorAddress);
+    }
+    for(offset = 0; (offset < prefixLength) && (result == gpHal_FlashError_Success); offset += FLASH_PAGE_SIZE)
+    {
+        result = gpHal_FlashWrite(sectorAddress + offset, FLASH_PAGE_SIZE / sizeof(UInt32), &prefix[offset / sizeof(UInt32)]);
+    }
+    if(result != gpHal_FlashError_Success)
+    {
+        GP_LOG_SYSTEM_PRINTF("OTA sector erase failed (error %x)", 0, result);
+        if(Upgrade_StreamStatus == gpUpgrade_StatusSuccess)
+        {
+            Upgrade_StreamStatus = gpUpgrade_StatusWriteError;
+        }
+    }
+
+    Upgrade_StreamWindowValid = true;
+    Upgrade_StreamErasedEnd = sectorAddress + FLASH_SECTOR_SIZE;
+}
+
+static Bool Upgrade_StreamEraseAheadNeeded(void)
+{
+    UInt32 sector = Upgrade_StreamErasedEnd;
+
+    return Upgrade_StreamWindowValid &&
+           (sector < FLASH_ALIGN_SECTOR(Upgrade_StreamErasedStart) + GP_UPGRADE_STREAM_ERASE_AHEAD_SECTORS * FLASH_SECTOR_SIZE) &&
+           Upgrade_CheckValidAddressRange(sector) && Upgrade_CheckValidAddressRange(sector + FLASH_SECTOR_SIZE - 1);
+}
+
+/* Scheduled: erase one sector in front of the stream per event */
+static void Upgrade_StreamEraseAhead(void)
+{
+    Bool more = false;
+
+    Upgrade_StreamLock();
+    if(Upgrade_StreamEraseAheadNeeded())
+    {
+        if(gpHal_FlashEraseSector(Upgrade_StreamErasedEnd) == gpHal_FlashError_Success)
+        {
+            Upgrade_StreamErasedEnd += FLASH_SECTOR_SIZE;
+            more = Upgrade_StreamEraseAheadNeeded();
+        }
+        else
+        {
+            // Leave the sector to the synchronous erase when the stream reaches it
+            GP_LOG_SYSTEM_PRINTF("OTA erase ahead failed at %lx", 0, (unsigned long)Upgrade_StreamErasedEnd);
+        }
+    }
+    Upgrade_StreamUnlock();
+
+    if(more)
+    {
+        gpSched_ScheduleEvent(0, Upgrade_StreamEraseAhead);
+    }
+}
+
+/* Scheduled: program the full page handed over by gpUpgrade_WriteChunk */
+static void Upgrade_StreamProgramEvent(void)
+{
+    Upgrade_StreamLock();
+    Upgrade_StreamProgramPending();
+    Upgrade_StreamUnlock();
+}
+
+static void Upgrade_StreamTrigger(void)
+{
+    if(Upgrade_StreamPending && !gpSched_ExistsEvent(Upgrade_StreamProgramEvent))
+    {
+        gpSched_ScheduleEvent(0, Upgrade_StreamProgramEvent);
+    }
+    if(Upgrade_StreamEraseAheadNeeded() && !gpSched_ExistsEvent(Upgrade_StreamEraseAhead))
+    {
+        gpSched_ScheduleEvent(0, Upgrade_StreamEraseAhead);
+    }
+}
+
+/* Start filling the page holding address - the buffer being filled is free */
+static void Upgrade_StreamOpenPage(UInt32 address)
+{
+    UInt32 pageAddress = FLASH_ALIGN_PAGE(address);
+    UInt16 prefixLength = address - pageAddress;
+
+    // Data in front of the stream in this page is kept: read it before a sector erase
+    if(prefixLength != 0)
+    {
+        if(gpHal_FlashRead(pageAddress, prefixLength, (UInt8*)Upgrade_StreamBuffer[Upgrade_StreamFill]) != gpHal_FlashError_Success)
+        {
+            MEMSET(Upgrade_StreamBuffer[Upgrade_StreamFill], 0, prefixLength);
+        }
+    }
+
+    if(!Upgrade_StreamPageIsBlank(pageAddress))
+    {
+        Upgrade_StreamPrepareSector(pageAddress);
+    }
+    Upgrade_StreamErasedStart = pageAddress + FLASH_PAGE_SIZE;
+
+    Upgrade_StreamPageAddress[Upgrade_StreamFill] = pageAddress;
+    Upgrade_StreamFillLength = prefixLength;
+    Upgrade_StreamActive = true;
+}
+
+/* Hand over the full page being filled and continue in the other buffer */
+static void Upgrade_StreamPageComplete(void)
+{
+    // No buffer left: program the previous page now
+    Upgrade_StreamProgramPending();
+
+    Upgrade_StreamPending = true;
+    Upgrade_StreamFill ^= 1;
+    Upgrade_StreamFillLength = 0;
+}
+
+static gpUpgrade_Status_t Upgrade_StreamWrite(UInt32 address, UInt16 length, UInt8* data)
+{
+    if(Upgrade_StreamActive && (address != Upgrade_StreamNext))
+    {
+        Upgrade_StreamFlush();
+    }
+
+    if(!Upgrade_StreamActive && (address < Upgrade_StreamHighWater))
+    {
+        // Rewriting data of this session: update in place, as the sectors hold data behind this chunk
+        UInt32 end = FLASH_ALIGN_SECTOR(address + length - 1) + FLASH_SECTOR_SIZE;
+        gpUpgrade_Status_t status = Upgrade_ProgramChunk(address, length, data);
+
+        if(Upgrade_StreamWindowValid && (Upgrade_StreamErasedStart < end))
+        {
+            Upgrade_StreamErasedStart = end;
+            Upgrade_StreamErasedEnd = max(Upgrade_StreamErasedEnd, end);
+        }
+        return Upgrade_StreamTakeStatus(status);
+    }
+
+    while(length > 0)
+    {
+        UInt16 size;
+
+        if(!Upgrade_StreamActive || (Upgrade_StreamFillLength == 0))
+        {
+            Upgrade_StreamOpenPage(address);
+        }
+
+        size = min(length, FLASH_PAGE_SIZE - Upgrade_StreamFillLength);
+        MEMCPY(((UInt8*)Upgrade_StreamBuffer[Upgrade_StreamFill]) + Upgrade_StreamFillLength, data, size);
+        Upgrade_StreamFillLength += size;
+        address += size;
+        data += size;
+        length -= size;
+
+        if(Upgrade_StreamFillLength == FLASH_PAGE_SIZE)
+        {
+            Upgrade_StreamPageComplete();
+        }
+    }
+    Upgrade_StreamNext = address;
+    Upgrade_StreamHighWater = max(Upgrade_StreamHighWater, address);
+
+    Upgrade_StreamTrigger();
+
+    return Upgrade_StreamTakeStatus(gpUpgrade_StatusSuccess);
+}
+
+static Bool Upgrade_StreamBuffered(UInt32 address, UInt16 length)
+{
+    UInt8 buffer;
+
+    for(buffer = 0; buffer < 2; buffer++)
+    {
+        Bool inUse = (buffer == Upgrade_StreamFill) ? (Upgrade_StreamActive && (Upgrade_StreamFillLength != 0)) : Upgrade_StreamPending;
+
+        if(inUse && (address < Upgrade_StreamPageAddress[buffer] + FLASH_PAGE_SIZE) &&
+           (address + length > Upgrade_StreamPageAddress[buffer]))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+#endif //UPGRADE_STREAM_WRITE
 /*****************************************************************************
  *                    Public Function Definitions
  *****************************************************************************/
@@ -237,6 +579,18 @@ void gpUpgrade_StartEraseOtaArea(gpUpgrade_cbEraseComplete_t cb)
 #if defined(GP_COMP_EXTSTORAGE) && !defined(GP_UPGRADE_DIVERSITY_USE_INTSTORAGE)
     gpExtStorage_EraseNoBlock(cb);
 #else // GP_COMP_EXTSTORAGE
+#ifdef UPGRADE_STREAM_WRITE
+    // Sectors are erased in front of the written data: start with the first sector of the image
+    Upgrade_StreamLock();
+    Upgrade_StreamFlush();
+    Upgrade_StreamHighWater = 0;
+    Upgrade_StreamWindowValid = true;
+    Upgrade_StreamErasedStart = FLASH_ALIGN_SECTOR(Upgrade_CheckValidAddressRange(gpUpgrade_GetJumptableOtaAreaStartAddress()) ?
+                                                   gpUpgrade_GetJumptableOtaAreaStartAddress() : GP_OTA_FLASH_START);
+    Upgrade_StreamErasedEnd = Upgrade_StreamErasedStart;
+    Upgrade_StreamTrigger();
+    Upgrade_StreamUnlock();
+#endif //UPGRADE_STREAM_WRITE
     if(cb)
     {
         cb();
@@ -296,6 +650,14 @@ void gpUpgrade_StartWrite(void)
 #else //GP_OTA_DIVERSITY_CLIENT
     gpUpgrade_Crc = 0xFFFFFFFF;
 #endif //GP_OTA_DIVERSITY_CLIENT
+
+#ifdef UPGRADE_STREAM_WRITE
+    Upgrade_StreamLock();
+    Upgrade_StreamFlush();
+    (void)Upgrade_StreamTakeStatus(gpUpgrade_StatusSuccess);
+    Upgrade_StreamHighWater = 0;
+    Upgrade_StreamUnlock();
+#endif //UPGRADE_STREAM_WRITE
 }
 
 
@@ -322,22 +684,13 @@ gpUpgrade_Status_t gpUpgrade_WriteChunk(UInt32 address, UInt16 length, UInt8* da
         return gpHal_FlashError_OutOfRange;
     }
 
-    //split in 2 chunks
-    if(!FLASH_RANGE_IN_SINGLE_SECTOR(address, length))
-    {
-        UInt16 chunksize = FLASH_TO_SECTOR_END(address);
-        UInt16 leftsize = length - FLASH_TO_SECTOR_END(address);
-
-        otaResult = Upgrade_WriteChunk(address, chunksize, dataChunk);
-        if(otaResult == gpUpgrade_StatusSuccess)
-        {
-            otaResult = Upgrade_WriteChunk(address+chunksize, leftsize, &dataChunk[chunksize]);
-        }
-    }
-    else
-    {
-        otaResult = Upgrade_WriteChunk(address, length, dataChunk);
-    }
+#ifdef UPGRADE_STREAM_WRITE
+    Upgrade_StreamLock();
+    otaResult = Upgrade_StreamWrite(address, length, dataChunk);
+    Upgrade_StreamUnlock();
+#else
+    otaResult = Upgrade_ProgramChunk(address, length, dataChunk);
+#endif //UPGRADE_STREAM_WRITE
 #endif //GP_COMP_EXTSTORAGE
 
 #if !defined(GP_OTA_DIVERSITY_CLIENT) || defined(GP_OTA_DIVERSITY_SERIAL_TEST) //OTA manager will do CRC checking, not needed to do it in the UMB
@@ -347,6 +700,22 @@ gpUpgrade_Status_t gpUpgrade_WriteChunk(UInt32 address, UInt16 length, UInt8* da
 
     return otaResult;
 }
+
+gpUpgrade_Status_t gpUpgrade_FlushWrite(void)
+{
+#ifdef UPGRADE_STREAM_WRITE
+    gpUpgrade_Status_t status;
+
+    Upgrade_StreamLock();
+    Upgrade_StreamFlush();
+    status = Upgrade_StreamTakeStatus(gpUpgrade_StatusSuccess);
+    Upgrade_StreamUnlock();
+    return status;
+#else
+    return gpUpgrade_StatusSuccess;
+#endif //UPGRADE_STREAM_WRITE
+}
+
 gpUpgrade_Status_t gpUpgrade_ReadChunk(UInt32 address, UInt16 length, UInt8* dataChunk)
 {
     gpUpgrade_Status_t status = gpUpgrade_StatusSuccess;
@@ -356,6 +725,16 @@ gpUpgrade_Status_t gpUpgrade_ReadChunk(UInt32 address, UInt16 length, UInt8* dat
         return gpUpgrade_StatusInvalidAddress;
     }
 
+#ifdef UPGRADE_STREAM_WRITE
+    // Data still in the page buffers is programmed first
+    Upgrade_StreamLock();
+    if(Upgrade_StreamBuffered(address, length))
+    {
+        Upgrade_StreamFlush();
+    }
+    Upgrade_StreamUnlock();
+#endif //UPGRADE_STREAM_WRITE
+
     //if using external flash, call spi flash read block function
 #if defined(GP_COMP_EXTSTORAGE) && !defined(GP_UPGRADE_DIVERSITY_USE_INTSTORAGE)
     switch(gpExtStorage_ReadBlock(address, length, dataChunk))
@@ -95,6 +95,12 @@ gpUpgrade_Status_t gpUpgrade_SetPendingImage(UInt32 swVer, UInt32 hwVer, UInt32
     UInt32 loadCompleteMW;
     UInt8 activeImagefreshnessCounter, pendingImagefreshnessCounter;
     UInt32 activeImageAddress, pendingImageAddress;
+
+    /* Program the end of the image still buffered by gpUpgrade_WriteChunk */
+    if(gpUpgrade_FlushWrite() != gpUpgrade_StatusSuccess)
+    {
+        return gpUpgrade_StatusWriteError;
+    }
 #if   defined(GP_COMP_EXTSTORAGE) || defined(GP_UPGRADE_DIVERSITY_COMPRESSION)
     /* Copy the license of the external image to internal flash */
     UInt8 upgLicense[LOADED_USER_LICENSE_TOTAL_SIZE+EXTENDED_USER_LICENSE_TOTAL_SIZE];
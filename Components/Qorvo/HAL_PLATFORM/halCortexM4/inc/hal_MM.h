@@ -45,6 +45,9 @@
 
 #include "global.h"
 #include "gpAssert.h"    //Assert in 24-bit write
+#if defined(HAL_DIVERSITY_MM_SIM)
+#include "hal_MMSim.h"
+#endif //HAL_DIVERSITY_MM_SIM
 
 /*****************************************************************************
  *                    Macro Definitions
@@ -76,11 +79,17 @@ typedef UIntPtr gpHal_Address_t;
  *
 */
 
+#if defined(HAL_DIVERSITY_MM_SIM)
+/* Host build: all accesses go to the simulated address space of hal_MMSim.c */
+#define GP_HAL_READ_REG(Register) hal_MMSimReadReg((UIntPtr) (Register))
+#define GP_HAL_WRITE_REG(Register,Data)  hal_MMSimWriteReg((UIntPtr) (Register), (Data))
+#else
 #define WBPTR(x) ((volatile UInt8 *) (x))
 #define REG(x)   (*WBPTR((UIntPtr) (x)))
 
 #define GP_HAL_READ_REG(Register) REG(Register)
 #define GP_HAL_WRITE_REG(Register,Data)  REG(Register) = (Data)
+#endif //HAL_DIVERSITY_MM_SIM
 //we use here inline functions as much as possible, because inline functions do type checking.
 
 ALWAYS_INLINE void GP_HAL_READMODIFYWRITE_REG(UIntPtr Register, UInt16 Mask, UInt16 Data)
@@ -99,6 +108,21 @@ ALWAYS_INLINE void GP_HAL_READMODIFYWRITE_REG(UIntPtr Register, UInt16 Mask, UIn
 #define GP_HAL_HAVE_WRITE_FOUR_BYTES
 //#define GP_HAL_HAVE_WRITE_EIGHT_BYTES
 
+#if defined(HAL_DIVERSITY_MM_SIM)
+ALWAYS_INLINE void GP_HAL_READ_TWO_BYTES(UIntPtr Address, UInt16 * pData)
+{
+    hal_MMSimRead(Address, pData, 2);
+}
+ALWAYS_INLINE void GP_HAL_READ_THREE_BYTES(UIntPtr Address, UInt32 * pData)
+{
+    *pData = 0;
+    hal_MMSimRead(Address, pData, 3);
+}
+ALWAYS_INLINE void GP_HAL_READ_FOUR_BYTES(UIntPtr Address, UInt32 * pData)
+{
+    hal_MMSimRead(Address, pData, 4);
+}
+#else
 ALWAYS_INLINE void GP_HAL_READ_TWO_BYTES(UIntPtr Address, UInt16 * pData)
 {
     *pData =  *((volatile UInt16 *) Address);
@@ -122,11 +146,27 @@ ALWAYS_INLINE void GP_HAL_READ_FOUR_BYTES(UIntPtr Address, UInt32 * pData)
 {
     *pData =  *((volatile UInt32 *) Address);
 }
+#endif //HAL_DIVERSITY_MM_SIM
 ALWAYS_INLINE void GP_HAL_READ_EIGHT_BYTES(UIntPtr Address, UInt64Struct_t * pData)
 {
     // not implemented
 }
 
+#if defined(HAL_DIVERSITY_MM_SIM)
+ALWAYS_INLINE void GP_HAL_WRITE_TWO_BYTES(UIntPtr Address, const UInt16 * pData)
+{
+    hal_MMSimWrite(Address, pData, 2);
+}
+ALWAYS_INLINE void GP_HAL_WRITE_THREE_BYTES(UIntPtr Address, const UInt32 * pData)
+{
+    GP_ASSERT_DEV_EXT(*pData < 0x1000000);
+    hal_MMSimWrite(Address, pData, 3);
+}
+ALWAYS_INLINE void GP_HAL_WRITE_FOUR_BYTES(UIntPtr Address, const UInt32 * pData)
+{
+    hal_MMSimWrite(Address, pData, 4);
+}
+#else
 ALWAYS_INLINE void GP_HAL_WRITE_TWO_BYTES(UIntPtr Address, const UInt16 * pData)
 {
     *((volatile UInt16 *) Address) = *pData;
@@ -151,6 +191,7 @@ ALWAYS_INLINE void GP_HAL_WRITE_FOUR_BYTES(UIntPtr Address, const UInt32 * pData
 {
     *((volatile UInt32 *) Address) = *pData;
 }
+#endif //HAL_DIVERSITY_MM_SIM
 
 ALWAYS_INLINE void GP_HAL_WRITE_EIGHT_BYTES(UIntPtr Address, const UInt64Struct_t * pData)
 {
@@ -167,6 +208,17 @@ ALWAYS_INLINE void GP_HAL_WRITE_EIGHT_BYTES(UIntPtr Address, const UInt64Struct_
  *
  */
 
+#if defined(HAL_DIVERSITY_MM_SIM)
+ALWAYS_INLINE void BLOCKREAD(UIntPtr Address, void * pBuffer, UInt16 Length)
+{
+    hal_MMSimRead(Address, pBuffer, Length);
+}
+
+ALWAYS_INLINE void BLOCKWRITE(UIntPtr Address, const void * pBuffer, UInt16 Length)
+{
+    hal_MMSimWrite(Address, pBuffer, Length);
+}
+#else
 ALWAYS_INLINE void BLOCKREAD(UIntPtr Address, void * pBuffer, UInt16 Length)
 {
     MEMCPY(pBuffer, (void *) Address, Length);
@@ -176,6 +228,7 @@ ALWAYS_INLINE void BLOCKWRITE(UIntPtr Address, const void * pBuffer, UInt16 Leng
 {
     MEMCPY((void *) Address, pBuffer, Length);
 }
+#endif //HAL_DIVERSITY_MM_SIM
 
 //helper macro
 #define WRITE_N_BYTES(Address, pData, type)                             \
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2026, Qorvo Inc
+ *
+ * hal_MMSim.h
+ *
+ * Simulated chip address space for host builds (HAL_DIVERSITY_MM_SIM).
+ * All register and chip memory accesses of hal_MM.h and gpHal_kx_MSI_basic.h are routed through here.
+ *
+ * This software is owned by Qorvo Inc
+ * and protected under applicable copyright laws.
+ * It is delivered under the terms of the license
+ * and is intended and supplied for use solely and
+ * exclusively with products manufactured by
+ * Qorvo Inc.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED IN AN "AS IS"
+ * CONDITION. NO WARRANTIES, WHETHER EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING, BUT NOT
+ * LIMITED TO, IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ * QORVO INC. SHALL NOT, IN ANY
+ * CIRCUMSTANCES, BE LIABLE FOR SPECIAL,
+ * INCIDENTAL OR CONSEQUENTIAL DAMAGES,
+ * FOR ANY REASON WHATSOEVER.
+ *
+ * $Header$
+ * $Change$
+ * $DateTime$
+ *
+ */
+
+#ifndef _HAL_MMSIM_H_
+#define _HAL_MMSIM_H_
+
+/**
+ * @file hal_MMSim.h
+ *
+ * The wishbone register space, the chip RAM and the AHB space are backed by host memory. Accesses to their
+ * bitband aliases are mapped on single bits of the backing memory.
+ * Any other address is a host address (e.g. a RAM table owned by gpHal) and is accessed directly.
+ * Every access is counted and can be reported to a trace callback.
+*/
+
+/*****************************************************************************
+ *                    Includes Definitions
+ *****************************************************************************/
+
+#include "global.h"
+
+/*****************************************************************************
+ *                    Type Definitions
+ *****************************************************************************/
+
+/** @brief Access counters of the simulated address space */
+typedef struct {
+    /** Read accesses to the simulated register and chip memory space */
+    UInt32 mmioReads;
+    /** Write accesses to the simulated register and chip memory space */
+    UInt32 mmioWrites;
+    /** Bytes read from the simulated space */
+    UInt32 mmioBytesRead;
+    /** Bytes written to the simulated space */
+    UInt32 mmioBytesWritten;
+    /** Read accesses through the register macros to host memory */
+    UInt32 hostReads;
+    /** Write accesses through the register macros to host memory */
+    UInt32 hostWrites;
+} hal_MMSimCounters_t;
+
+/** @brief Trace callback, called after every access.
+ *
+ *  @param write    true for a write access.
+ *  @param mmio     true if the access was done to the simulated space, false for host memory.
+ *  @param address  Accessed address.
+ *  @param pData    Data that was read or written.
+ *  @param length   Number of bytes.
+*/
+typedef void (*hal_MMSimTraceCallback_t)(Bool write, Bool mmio, UIntPtr address, const UInt8* pData, UInt16 length);
+
+/*****************************************************************************
+ *                    Public Function Prototypes
+ *****************************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  Clear the simulated space and the counters. The trace callback is kept.
+ */
+void hal_MMSimInit(void);
+
+/**
+ *  Read from the simulated space (or host memory).
+ *
+ *  @param address  Chip or host address.
+ *  @param pBuffer  Destination buffer.
+ *  @param length   Number of bytes.
+ */
+void hal_MMSimRead(UIntPtr address, void* pBuffer, UInt16 length);
+
+/**
+ *  Write to the simulated space (or host memory).
+ *
+ *  @param address  Chip or host address.
+ *  @param pBuffer  Source buffer.
+ *  @param length   Number of bytes.
+ */
+void hal_MMSimWrite(UIntPtr address, const void* pBuffer, UInt16 length);
+
+/** @brief Single byte read, used by GP_HAL_READ_REG */
+UInt8 hal_MMSimReadReg(UIntPtr address);
+
+/** @brief Single byte write, used by GP_HAL_WRITE_REG */
+void hal_MMSimWriteReg(UIntPtr address, UInt8 data);
+
+/**
+ *  Direct access to the backing memory of the simulated space, e.g. to model hardware responses.
+ *  Accesses through the returned pointer are not counted nor traced.
+ *
+ *  @param address  Chip address (no bitband alias).
+ *  @param length   Number of bytes that will be accessed.
+ *  @return         Host pointer, NULL if the range is not simulated.
+ */
+UInt8* hal_MMSimGetPointer(UIntPtr address, UInt16 length);
+
+/**
+ *  Get the access counters.
+ *
+ *  @param pCounters  Pointer to the structure where the counters are copied to.
+ */
+void hal_MMSimGetCounters(hal_MMSimCounters_t* pCounters);
+
+/**
+ *  Clear the access counters.
+ */
+void hal_MMSimResetCounters(void);
+
+/**
+ *  Set the trace callback, NULL to disable tracing.
+ */
+void hal_MMSimSetTraceCallback(hal_MMSimTraceCallback_t callback);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* _HAL_MMSIM_H_ */
@@ -59,6 +59,10 @@ typedef void (* hal_cbUartRx_t) (UInt8*, UInt16);
 typedef void (* hal_cbUartRx_t) (Int16);
 #endif
 typedef void (* hal_cbUartEot_t) (void);
+#if defined(HAL_DIVERSITY_UART_TX_BUFFER_CALLBACK)
+/* Copy up to maxLength bytes of pending TX data to pData, returns the number of bytes copied */
+typedef UInt16 (* hal_cbUartGetTxBuffer_t) (UInt8* pData, UInt16 maxLength);
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -75,6 +79,9 @@ void hal_UartEnable(UInt8 uart);
 void hal_UartTxNewData(UInt8 uart);
 void hal_UartWaitEndOfTransmission(UInt8 uart);
 void hal_UartRegisterOneShotEndOfTxCb(hal_cbUartEot_t cbEot);
+#if defined(HAL_DIVERSITY_UART_TX_BUFFER_CALLBACK)
+void hal_UartRegisterGetTxBufferCb(UInt8 uart, hal_cbUartGetTxBuffer_t cbGetTxBuffer);
+#endif
 
 void hal_UartComStart( hal_cbUartRx_t cbRx, hal_cbUartGetTxData_t cbTx, UInt8 uart);
 void hal_UartComStop(UInt8 uart);
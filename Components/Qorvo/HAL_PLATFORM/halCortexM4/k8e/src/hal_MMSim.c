@@ -0,0 +1,279 @@
+/*
+ * Copyright (c) 2026, Qorvo Inc
+ *
+ *  Simulated Kx address space, to run gpHal register level code in host builds (HAL_DIVERSITY_MM_SIM).
+ *
+ * This software is owned by Qorvo Inc
+ * and protected under applicable copyright laws.
+ * It is delivered under the terms of the license
+ * and is intended and supplied for use solely and
+ * exclusively with products manufactured by
+ * Qorvo Inc.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED IN AN "AS IS"
+ * CONDITION. NO WARRANTIES, WHETHER EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING, BUT NOT
+ * LIMITED TO, IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ * QORVO INC. SHALL NOT, IN ANY
+ * CIRCUMSTANCES, BE LIABLE FOR SPECIAL,
+ * INCIDENTAL OR CONSEQUENTIAL DAMAGES,
+ * FOR ANY REASON WHATSOEVER.
+ *
+ * $Header$
+ * $Change$
+ * $DateTime$
+ *
+ */
+
+/*****************************************************************************
+ *                    Includes Definitions
+ *****************************************************************************/
+
+#define GP_COMPONENT_ID GP_COMPONENT_ID_HALCORTEXM4
+
+#include "global.h"
+#include "gpAssert.h"
+#include "gpHal_kx_mm.h"
+#include "gpHal_kx_regprop_basic.h"
+#include "hal_MMSim.h"
+
+/*****************************************************************************
+ *                    Macro Definitions
+ *****************************************************************************/
+
+/* Simulated part of the wishbone register space, starting at GP_MM_WISHB_START: the whole register map,
+   up to the end of its last block (PWMS) */
+#ifndef HAL_MM_SIM_WISHB_SIZE
+#define HAL_MM_SIM_WISHB_SIZE (GP_WB_PWMS_BASE_ADDRESS + GP_WB_PWMS_SIZE - GP_MM_WISHB_START)
+#endif //HAL_MM_SIM_WISHB_SIZE
+
+/* Simulated part of the AHB space, starting at GP_MM_AHB_START */
+#ifndef HAL_MM_SIM_AHB_SIZE
+#define HAL_MM_SIM_AHB_SIZE 0x4000
+#endif //HAL_MM_SIM_AHB_SIZE
+
+/* Every bit of a byte is aliased by a word in the bitband regions */
+#define HAL_MM_SIM_BITBAND_BYTES_PER_BYTE  32
+#define HAL_MM_SIM_BITBAND_BYTES_PER_BIT   4
+
+GP_COMPILE_TIME_VERIFY(HAL_MM_SIM_WISHB_SIZE <= GP_MM_WISHB_SIZE);
+GP_COMPILE_TIME_VERIFY((GP_WB_SEC_PROC_CTRL_BASE_ADDRESS + GP_WB_SEC_PROC_CTRL_SIZE - GP_MM_WISHB_START) <= HAL_MM_SIM_WISHB_SIZE);
+GP_COMPILE_TIME_VERIFY(HAL_MM_SIM_AHB_SIZE <= GP_MM_AHB_SIZE);
+
+/*****************************************************************************
+ *                    Type Definitions
+ *****************************************************************************/
+
+typedef struct {
+    UIntPtr start;
+    UInt32  size;
+    UInt8*  pData;
+    /* start of the bitband alias, 0 if the window has none */
+    UIntPtr bitbandStart;
+} hal_MMSimWindow_t;
+
+/*****************************************************************************
+ *                    Static Data Definitions
+ *****************************************************************************/
+
+static UInt8 hal_MMSim_Wishb[HAL_MM_SIM_WISHB_SIZE];
+static UInt8 hal_MMSim_Ram[GP_MM_RAM_SIZE];
+static UInt8 hal_MMSim_Ahb[HAL_MM_SIM_AHB_SIZE];
+
+static const hal_MMSimWindow_t hal_MMSim_Windows[] = {
+    { GP_MM_WISHB_START, HAL_MM_SIM_WISHB_SIZE, hal_MMSim_Wishb, GP_MM_WISHB_BITBAND_START },
+    { GP_MM_RAM_START,   GP_MM_RAM_SIZE,        hal_MMSim_Ram,   GP_MM_RAM_BITBAND_START   },
+    { GP_MM_AHB_START,   HAL_MM_SIM_AHB_SIZE,   hal_MMSim_Ahb,   0                         },
+};
+
+#define HAL_MM_SIM_NR_OF_WINDOWS (sizeof(hal_MMSim_Windows) / sizeof(hal_MMSim_Windows[0]))
+
+static hal_MMSimCounters_t hal_MMSim_Counters;
+static hal_MMSimTraceCallback_t hal_MMSim_TraceCallback;
+
+/*****************************************************************************
+ *                    Static Function Definitions
+ *****************************************************************************/
+
+/* Host pointer for a range within one window, NULL if the start address is not simulated */
+static UInt8* hal_MMSimLookup(UIntPtr address, UInt16 length)
+{
+    UIntLoop i;
+
+    for(i = 0; i < HAL_MM_SIM_NR_OF_WINDOWS; i++)
+    {
+        const hal_MMSimWindow_t* pWindow = &hal_MMSim_Windows[i];
+
+        if((address >= pWindow->start) && (address < pWindow->start + pWindow->size))
+        {
+            /* An access is never split over the simulated and host memory */
+            GP_ASSERT_DEV_INT((address - pWindow->start) + length <= pWindow->size);
+            return &pWindow->pData[address - pWindow->start];
+        }
+    }
+    return NULL;
+}
+
+/* Map a bitband alias on the aliased byte, NULL if the address is not a simulated bitband alias */
+static UInt8* hal_MMSimLookupBitband(UIntPtr address, UInt8* pBit)
+{
+    UIntLoop i;
+
+    for(i = 0; i < HAL_MM_SIM_NR_OF_WINDOWS; i++)
+    {
+        const hal_MMSimWindow_t* pWindow = &hal_MMSim_Windows[i];
+        UIntPtr offset;
+
+        if((pWindow->bitbandStart == 0) || (address < pWindow->bitbandStart))
+        {
+            continue;
+        }
+        offset = address - pWindow->bitbandStart;
+        if(offset < (UIntPtr)pWindow->size * HAL_MM_SIM_BITBAND_BYTES_PER_BYTE)
+        {
+            *pBit = (offset / HAL_MM_SIM_BITBAND_BYTES_PER_BIT) % 8;
+            return &pWindow->pData[offset / HAL_MM_SIM_BITBAND_BYTES_PER_BYTE];
+        }
+    }
+    return NULL;
+}
+
+static void hal_MMSimAccess(Bool write, UIntPtr address, UInt8* pBuffer, UInt16 length)
+{
+    UInt8* pSim;
+    UInt8 bit;
+    Bool mmio = true;
+
+    pSim = hal_MMSimLookup(address, length);
+    if(pSim != NULL)
+    {
+        if(write)
+        {
+            MEMCPY(pSim, pBuffer, length);
+        }
+        else
+        {
+            MEMCPY(pBuffer, pSim, length);
+        }
+    }
+    else if((pSim = hal_MMSimLookupBitband(address, &bit)) != NULL)
+    {
+        /* A bitband word reads as 0 or 1, only bit 0 of a written value is used */
+        if(write)
+        {
+            if(pBuffer[0] & 0x1)
+            {
+                BIT_SET(*pSim, bit);
+            }
+            else
+            {
+                BIT_CLR(*pSim, bit);
+            }
+        }
+        else
+        {
+            MEMSET(pBuffer, 0, length);
+            pBuffer[0] = BIT_TST(*pSim, bit) ? 1 : 0;
+        }
+    }
+    else
+    {
+        mmio = false;
+        if(write)
+        {
+            MEMCPY((void*)address, pBuffer, length);
+        }
+        else
+        {
+            MEMCPY(pBuffer, (void*)address, length);
+        }
+    }
+
+    if(mmio)
+    {
+        if(write)
+        {
+            hal_MMSim_Counters.mmioWrites++;
+            hal_MMSim_Counters.mmioBytesWritten += length;
+        }
+        else
+        {
+            hal_MMSim_Counters.mmioReads++;
+            hal_MMSim_Counters.mmioBytesRead += length;
+        }
+    }
+    else
+    {
+        if(write)
+        {
+            hal_MMSim_Counters.hostWrites++;
+        }
+        else
+        {
+            hal_MMSim_Counters.hostReads++;
+        }
+    }
+
+    if(hal_MMSim_TraceCallback != NULL)
+    {
+        hal_MMSim_TraceCallback(write, mmio, address, pBuffer, length);
+    }
+}
+
+/*****************************************************************************
+ *                    Public Function Definitions
+ *****************************************************************************/
+
+void hal_MMSimInit(void)
+{
+    MEMSET(hal_MMSim_Wishb, 0, sizeof(hal_MMSim_Wishb));
+    MEMSET(hal_MMSim_Ram, 0, sizeof(hal_MMSim_Ram));
+    MEMSET(hal_MMSim_Ahb, 0, sizeof(hal_MMSim_Ahb));
+    hal_MMSimResetCounters();
+}
+
+void hal_MMSimRead(UIntPtr address, void* pBuffer, UInt16 length)
+{
+    hal_MMSimAccess(false, address, (UInt8*)pBuffer, length);
+}
+
+void hal_MMSimWrite(UIntPtr address, const void* pBuffer, UInt16 length)
+{
+    hal_MMSimAccess(true, address, (UInt8*)pBuffer, length);
+}
+
+UInt8 hal_MMSimReadReg(UIntPtr address)
+{
+    UInt8 data;
+
+    hal_MMSimAccess(false, address, &data, 1);
+    return data;
+}
+
+void hal_MMSimWriteReg(UIntPtr address, UInt8 data)
+{
+    hal_MMSimAccess(true, address, &data, 1);
+}
+
+UInt8* hal_MMSimGetPointer(UIntPtr address, UInt16 length)
+{
+    return hal_MMSimLookup(address, length);
+}
+
+void hal_MMSimGetCounters(hal_MMSimCounters_t* pCounters)
+{
+    *pCounters = hal_MMSim_Counters;
+}
+
+void hal_MMSimResetCounters(void)
+{
+    MEMSET(&hal_MMSim_Counters, 0, sizeof(hal_MMSim_Counters));
+}
+
+void hal_MMSimSetTraceCallback(hal_MMSimTraceCallback_t callback)
+{
+    hal_MMSim_TraceCallback = callback;
+}
@@ -118,6 +118,9 @@ static UInt8 halUart_TxEnabledMask = 0;
 static hal_cbUartGetTxData_t   hal_cbUartGetTxData[HAL_UART_NR_OF_UARTS] = { NULL, };
 #define hal_UartStoreGetTxData(uart, cb)  { hal_cbUartGetTxData[(uart)] = (cb); }
 #define hal_UartHandleGetTxData(uart)   ((hal_cbUartGetTxData[(uart)] == NULL)? -1 : hal_cbUartGetTxData[uart]())
+#if defined(HAL_DIVERSITY_UART_TX_BUFFER_CALLBACK)
+static hal_cbUartGetTxBuffer_t hal_cbUartGetTxBuffer[HAL_UART_NR_OF_UARTS] = { NULL, };
+#endif
 
 #if (HAL_UART_RX_DMA_MASK != 0)
 #if !defined(HAL_UART_NO_RX)
@@ -438,6 +441,29 @@ static UInt32 halUart_TxFillDmaBuffer(UInt8 uart, UInt32 fillLevel)
 
     writePtr = halUart_DmaTxWritePtr[dmaIndex];
 
+#if defined(HAL_DIVERSITY_UART_TX_BUFFER_CALLBACK)
+    if (hal_cbUartGetTxBuffer[uart] != NULL)
+    {
+        /* Block copy - the free space can wrap around the end of the circular DMA buffer */
+        UInt32 sizeBlock;
+        UInt32 sizeCopied;
+
+        i = 0U;
+        while (i < fillLevel)
+        {
+            bufferoffset = (writePtr.offset + i) % HAL_UART_TX_BUFFER_SIZE;
+            sizeBlock = min(fillLevel - i, HAL_UART_TX_BUFFER_SIZE - bufferoffset);
+            sizeCopied = hal_cbUartGetTxBuffer[uart](&halUart_DmaTxBuffer[dmaIndex][bufferoffset], sizeBlock);
+            i += sizeCopied;
+            if (sizeCopied < sizeBlock)
+            {
+                // No more data from upper layer
+                break;
+            }
+        }
+    }
+    else
+#endif //HAL_DIVERSITY_UART_TX_BUFFER_CALLBACK
     for (i = 0U; i < fillLevel; i++) {
         data = hal_UartHandleGetTxData(uart);
         if (data != -1) {
@@ -712,6 +738,9 @@ void hal_UartComStop(UInt8 uart)
 
     hal_UartStoreRx(uart, NULL);
     hal_UartStoreGetTxData(uart, NULL);
+#if defined(HAL_DIVERSITY_UART_TX_BUFFER_CALLBACK)
+    hal_cbUartGetTxBuffer[uart] = NULL;
+#endif
     hal_cbUartOneShotEndOfTx = (hal_cbUartEot_t) NULL;
 
     /* can't call hal_Dma Release -- not implemented */
@@ -951,6 +980,14 @@ void hal_UartWaitEndOfTransmission(UInt8 uart)
     }
 }
 
+#if defined(HAL_DIVERSITY_UART_TX_BUFFER_CALLBACK)
+void hal_UartRegisterGetTxBufferCb(UInt8 uart, hal_cbUartGetTxBuffer_t cbGetTxBuffer)
+{
+    GP_ASSERT_SYSTEM(uart < HAL_UART_NR_OF_UARTS);
+    hal_cbUartGetTxBuffer[uart] = cbGetTxBuffer;
+}
+#endif //HAL_DIVERSITY_UART_TX_BUFFER_CALLBACK
+
 void hal_UartRegisterOneShotEndOfTxCb(hal_cbUartEot_t cbEot)
 {
     GP_WB_WRITE_INT_CTRL_MASK_UART_0_TX_NOT_BUSY_INTERRUPT(false);
@@ -63,10 +63,36 @@ typedef struct {
     }attr;
 } gpPd_Descriptor_t;
 
+/** @struct gpPd_PoolStatistics_t
+ *  @brief Allocation statistics of the Pd pool of one buffer type.
+*/
+typedef struct gpPd_PoolStatistics_s {
+    /** @brief Pds currently claimed with gpPd_GetPd() or gpPd_GetCustomPd(). */
+    UInt8  inUse;
+    /** @brief Pds held back for this type, in the PBM size class of its regular buffer size. */
+    UInt8  reserved;
+    /** @brief Highest number of Pds in use since init or the last statistics reset. */
+    UInt8  highWaterMark;
+    /** @brief Requests refused because no Pd or no buffer of the requested size was left. */
+    UInt16 allocFailures;
+    /** @brief Requests refused because the remaining Pds are reserved for other buffer types. */
+    UInt16 reserveRejections;
+} gpPd_PoolStatistics_t;
+
 /*****************************************************************************
  *                    Public Function Definitions
  *****************************************************************************/
 
+/** @brief Get the allocation statistics of a buffer type.
+ *
+ *  @param type         Buffer type, see gpPd_BufferType_t.
+ *  @param pStatistics  Pointer to the structure where the statistics are copied to.
+*/
+void gpPd_GetPoolStatistics(gpPd_BufferType_t type, gpPd_PoolStatistics_t* pStatistics);
+
+/** @brief Clear the failure counters of all buffer types and restart the high water marks from the current use. */
+void gpPd_ResetPoolStatistics(void);
+
 #endif // _GPPD_PBM_H_
 
 
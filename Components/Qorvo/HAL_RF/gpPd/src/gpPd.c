@@ -132,6 +132,16 @@ gpPd_BufferType_t gpPd_GetPdType(gpPd_Handle_t pdHandle)
     return Pd_GetPdType(pdHandle);
 }
 
+void gpPd_GetPoolStatistics(gpPd_BufferType_t type, gpPd_PoolStatistics_t* pStatistics)
+{
+    Pd_GetPoolStatistics(type, pStatistics);
+}
+
+void gpPd_ResetPoolStatistics(void)
+{
+    Pd_ResetPoolStatistics();
+}
+
 UInt8 gpPd_ReadByte(gpPd_Handle_t pdHandle, gpPd_Offset_t offset)
 {
     return Pd_ReadByte( pdHandle, offset);
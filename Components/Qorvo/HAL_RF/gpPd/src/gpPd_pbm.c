@@ -45,10 +45,37 @@
  *                    Macro Definitions
  *****************************************************************************/
 
+// 802.15.4 sized Pds held back for 802.15.4 requests, BLE cannot claim these.
+// Off by default, so BLE can use all Pds as before.
+#ifndef GP_PD_RESERVED_PDS_ZIGBEE
+#define GP_PD_RESERVED_PDS_ZIGBEE       0
+#endif //GP_PD_RESERVED_PDS_ZIGBEE
+
+// BLE sized Pds held back for BLE requests
+#ifndef GP_PD_RESERVED_PDS_BLE
+#define GP_PD_RESERVED_PDS_BLE          0
+#endif //GP_PD_RESERVED_PDS_BLE
+
+// Pools follow the PBM size classes of gpHal, the software can claim all PBMs not handed to the RX MAC
+#define PD_POOL_CLASS_TYPE1             0
+#define PD_POOL_CLASS_TYPE2             1
+#define PD_POOL_NR_OF_CLASSES           2
+#define PD_POOL_CAPACITY_TYPE1          (GP_HAL_PBM_TYPE1_AMOUNT)
+#define PD_POOL_CAPACITY_TYPE2          (GP_HAL_PBM_TYPE2_AMOUNT - GP_HAL_NR_OF_RX_PBMS)
+
+// The in use counters of all buffer types and classes are packed in one word, one byte per counter
+#define PD_POOL_NR_OF_TYPES             gpPd_BufferTypeInvalid
+#define PD_POOL_COUNT_SHIFT(type, poolClass)    (8*((type)*PD_POOL_NR_OF_CLASSES + (poolClass)))
+
 /*****************************************************************************
  *                    Functional Macro Definitions
  *****************************************************************************/
 
+#define PD_POOL_GET_IN_USE(inUse, type, poolClass)  (((inUse) >> PD_POOL_COUNT_SHIFT(type, poolClass)) & 0xFF)
+#define PD_POOL_ONE(type, poolClass)                ((UInt32)1 << PD_POOL_COUNT_SHIFT(type, poolClass))
+#define PD_POOL_SIZE_TO_CLASS(size)                 (((size) > GP_HAL_PBM_TYPE1_SIZE) ? PD_POOL_CLASS_TYPE2 : PD_POOL_CLASS_TYPE1)
+#define PD_HANDLE_BM(pdHandle)                      ((UInt32)1 << (pdHandle))
+
 #define PD_CHECK_HANDLE_VALID(pdHandle)         GP_HAL_CHECK_PBM_VALID(pdHandle)
 #define PD_CHECK_HANDLE_IN_USE(pdHandle)        GP_HAL_IS_PBM_ALLOCATED(pdHandle)
 #define PD_CHECK_HANDLE_ACCESSIBLE(pdHandle)    (PD_CHECK_HANDLE_VALID(pdHandle) && PD_CHECK_HANDLE_IN_USE(pdHandle))
@@ -74,6 +101,29 @@ UInt8 Pd_BitMaskOfPbmsClaimedBySw = 0;
 UInt32 Pd_BitMaskOfPbmsClaimedBySw = 0;
 #endif
 
+// Pd pools - claimed and released with atomic updates only, so Pds can be taken from interrupt context
+// without disabling interrupts. Pd_PoolInUse is updated in a single compare-and-swap with the reservation check.
+static UInt32 Pd_PoolInUse;
+static UInt8  Pd_PoolClassOfHandle[GP_PD_NR_OF_HANDLES];
+static UInt8  Pd_PoolHighWaterMark[PD_POOL_NR_OF_TYPES];
+static UInt16 Pd_PoolAllocFailures[PD_POOL_NR_OF_TYPES];
+static UInt16 Pd_PoolReserveRejections[PD_POOL_NR_OF_TYPES];
+
+static const UInt8 Pd_PoolCapacity[PD_POOL_NR_OF_CLASSES] = {
+    PD_POOL_CAPACITY_TYPE1,
+    PD_POOL_CAPACITY_TYPE2
+};
+
+// Reservation of each buffer type, taken from the class of its regular buffer size
+static const UInt8 Pd_PoolReserved[PD_POOL_NR_OF_TYPES] = {
+    GP_PD_RESERVED_PDS_ZIGBEE,  // gpPd_BufferTypeZigBee
+    GP_PD_RESERVED_PDS_BLE      // gpPd_BufferTypeBle
+};
+static const UInt8 Pd_PoolReservedClass[PD_POOL_NR_OF_TYPES] = {
+    PD_POOL_SIZE_TO_CLASS(GP_PD_BUFFER_SIZE_ZIGBEE),
+    PD_POOL_SIZE_TO_CLASS(GP_PD_BUFFER_SIZE_BLE)
+};
+
 /*****************************************************************************
  *                    External Data Definition
  *****************************************************************************/
@@ -89,6 +139,15 @@ UInt32 Pd_BitMaskOfPbmsClaimedBySw = 0;
 static void    Pd_Init(void);
 static void    Pd_DeInit(void);
 
+//Pool handling
+static UInt8   Pd_PoolGetTypeInUse(UInt32 inUse, gpPd_BufferType_t type);
+static Bool    Pd_PoolClaim(gpPd_BufferType_t type, UInt8 poolClass);
+static void    Pd_PoolRelease(gpPd_BufferType_t type, UInt8 poolClass);
+static void    Pd_PoolUpdateHighWaterMark(gpPd_BufferType_t type, UInt8 inUse);
+static void    Pd_PoolCountFailure(UInt16* pCounter);
+static void    Pd_GetPoolStatistics(gpPd_BufferType_t type, gpPd_PoolStatistics_t* pStatistics);
+static void    Pd_ResetPoolStatistics(void);
+
 //Descriptor handling
 static gpPd_Handle_t        Pd_GetPd(gpPd_BufferType_t type, UInt16 size);
 static void                 Pd_FreePd(gpPd_Handle_t pdHandle);
@@ -125,12 +184,19 @@ static void Pd_Init(void)
     UIntLoop i;
 
     COMPILE_TIME_ASSERT((sizeof(Pd_BitMaskOfPbmsClaimedBySw)*8) >= GP_PD_NR_OF_HANDLES);
+    COMPILE_TIME_ASSERT((PD_POOL_NR_OF_TYPES*PD_POOL_NR_OF_CLASSES) <= sizeof(Pd_PoolInUse));
+    COMPILE_TIME_ASSERT(GP_HAL_PBM_TYPE2_AMOUNT >= GP_HAL_NR_OF_RX_PBMS);
+    COMPILE_TIME_ASSERT((PD_POOL_CAPACITY_TYPE1 <= 0xFF) && (PD_POOL_CAPACITY_TYPE2 <= 0xFF));
 
     for(i = 0; i<GP_PD_NR_OF_HANDLES; i++)
     {
         MEMSET(&gpPd_Descriptors[i], 0, sizeof(gpPd_Descriptor_t));
     }
     Pd_BitMaskOfPbmsClaimedBySw = 0;
+    Pd_PoolInUse = 0;
+    MEMSET(Pd_PoolHighWaterMark, 0, sizeof(Pd_PoolHighWaterMark));
+    MEMSET(Pd_PoolAllocFailures, 0, sizeof(Pd_PoolAllocFailures));
+    MEMSET(Pd_PoolReserveRejections, 0, sizeof(Pd_PoolReserveRejections));
 #ifdef GP_COMP_UNIT_TEST
     gpPd_InitUnit();
 #endif // GP_COMP_UNIT_TEST
@@ -149,11 +215,148 @@ static void Pd_DeInit(void)
     }
 }
 
+//------------------------------
+// Pools
+//------------------------------
+
+static UInt8 Pd_PoolGetTypeInUse(UInt32 inUse, gpPd_BufferType_t type)
+{
+    UIntLoop i;
+    UInt8 typeInUse = 0;
+
+    for(i = 0; i < PD_POOL_NR_OF_CLASSES; i++)
+    {
+        typeInUse += PD_POOL_GET_IN_USE(inUse, type, i);
+    }
+    return typeInUse;
+}
+
+// Take a Pd of the given class for the given type.
+// A type can use the Pds of a class as long as the unused reservations of the other types in that class stay available.
+static Bool Pd_PoolClaim(gpPd_BufferType_t type, UInt8 poolClass)
+{
+    UInt32 inUse = __atomic_load_n(&Pd_PoolInUse, __ATOMIC_RELAXED);
+    UInt32 newInUse;
+
+    do
+    {
+        UIntLoop i;
+        UInt8 classInUse = 0;
+        UInt8 reservedForOthers = 0;
+
+        for(i = 0; i < PD_POOL_NR_OF_TYPES; i++)
+        {
+            UInt8 typeInUse = PD_POOL_GET_IN_USE(inUse, i, poolClass);
+
+            classInUse += typeInUse;
+            if((i != type) && (Pd_PoolReservedClass[i] == poolClass) && (typeInUse < Pd_PoolReserved[i]))
+            {
+                reservedForOthers += Pd_PoolReserved[i] - typeInUse;
+            }
+        }
+
+        if(classInUse >= Pd_PoolCapacity[poolClass])
+        {
+            Pd_PoolCountFailure(&Pd_PoolAllocFailures[type]);
+            return false;
+        }
+        if(classInUse + reservedForOthers >= Pd_PoolCapacity[poolClass])
+        {
+            Pd_PoolCountFailure(&Pd_PoolReserveRejections[type]);
+            return false;
+        }
+
+        newInUse = inUse + PD_POOL_ONE(type, poolClass);
+    } while(!__atomic_compare_exchange_n(&Pd_PoolInUse, &inUse, newInUse, true, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED));
+
+    Pd_PoolUpdateHighWaterMark(type, Pd_PoolGetTypeInUse(newInUse, type));
+
+    return true;
+}
+
+static void Pd_PoolRelease(gpPd_BufferType_t type, UInt8 poolClass)
+{
+    GP_ASSERT_DEV_EXT(PD_POOL_GET_IN_USE(__atomic_load_n(&Pd_PoolInUse, __ATOMIC_RELAXED), type, poolClass) != 0);
+    __atomic_fetch_sub(&Pd_PoolInUse, PD_POOL_ONE(type, poolClass), __ATOMIC_RELEASE);
+}
+
+static void Pd_PoolUpdateHighWaterMark(gpPd_BufferType_t type, UInt8 inUse)
+{
+    UInt8 highWaterMark = __atomic_load_n(&Pd_PoolHighWaterMark[type], __ATOMIC_RELAXED);
+
+    while(inUse > highWaterMark)
+    {
+        if(__atomic_compare_exchange_n(&Pd_PoolHighWaterMark[type], &highWaterMark, inUse, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        {
+            break;
+        }
+    }
+}
+
+// Failure counters saturate instead of wrapping
+static void Pd_PoolCountFailure(UInt16* pCounter)
+{
+    UInt16 count = __atomic_load_n(pCounter, __ATOMIC_RELAXED);
+
+    while(count != 0xFFFF)
+    {
+        if(__atomic_compare_exchange_n(pCounter, &count, count + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        {
+            break;
+        }
+    }
+}
+
+static void Pd_GetPoolStatistics(gpPd_BufferType_t type, gpPd_PoolStatistics_t* pStatistics)
+{
+    GP_ASSERT_DEV_EXT(type < PD_POOL_NR_OF_TYPES);
+    GP_ASSERT_DEV_EXT(pStatistics != NULL);
+
+    pStatistics->inUse = Pd_PoolGetTypeInUse(__atomic_load_n(&Pd_PoolInUse, __ATOMIC_RELAXED), type);
+    pStatistics->reserved = Pd_PoolReserved[type];
+    pStatistics->highWaterMark = __atomic_load_n(&Pd_PoolHighWaterMark[type], __ATOMIC_RELAXED);
+    pStatistics->allocFailures = __atomic_load_n(&Pd_PoolAllocFailures[type], __ATOMIC_RELAXED);
+    pStatistics->reserveRejections = __atomic_load_n(&Pd_PoolReserveRejections[type], __ATOMIC_RELAXED);
+}
+
+static void Pd_ResetPoolStatistics(void)
+{
+    UInt32 inUse = __atomic_load_n(&Pd_PoolInUse, __ATOMIC_RELAXED);
+    UIntLoop i;
+
+    for(i = 0; i < PD_POOL_NR_OF_TYPES; i++)
+    {
+        // The high water mark restarts from the current use
+        __atomic_store_n(&Pd_PoolHighWaterMark[i], Pd_PoolGetTypeInUse(inUse, i), __ATOMIC_RELAXED);
+        __atomic_store_n(&Pd_PoolAllocFailures[i], 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&Pd_PoolReserveRejections[i], 0, __ATOMIC_RELAXED);
+    }
+}
+
+//------------------------------
+// Descriptors
+//------------------------------
+
 // for waking up the radio we only take PBM's into account claimed by the software
 // So pbm's claimed for outgoing packets. Pbms for incoming packets are related to interrupts.
+// Callable from interrupt context: the pool and the claimed mask are only changed with atomic operations.
 static gpPd_Handle_t Pd_GetPd(gpPd_BufferType_t type, UInt16 size)
 {
     UInt8 pdHandle;
+    UInt8 poolClass = PD_POOL_SIZE_TO_CLASS(size);
+
+    if(type >= PD_POOL_NR_OF_TYPES)
+    {
+        GP_ASSERT_DEV_EXT(false);
+        return GP_PD_INVALID_HANDLE;
+    }
+
+    if(!Pd_PoolClaim(type, poolClass))
+    {
+        GP_LOG_PRINTF("No Pd for type %i",0, (UInt16)type);
+        return GP_PD_INVALID_HANDLE;
+    }
+
 #if defined(GP_COMP_UNIT_TEST)
     if( Pd_BitMaskOfPbmsClaimedBySw == 0 )
     {
@@ -163,6 +366,9 @@ static gpPd_Handle_t Pd_GetPd(gpPd_BufferType_t type, UInt16 size)
     pdHandle = gpHal_GetHandle(size);
     if(!GP_HAL_CHECK_PBM_VALID(pdHandle))
     {
+        Pd_PoolRelease(type, poolClass);
+        // No PBM (memory) of the requested size left
+        Pd_PoolCountFailure(&Pd_PoolAllocFailures[type]);
 #if defined(GP_COMP_UNIT_TEST)
         if( Pd_BitMaskOfPbmsClaimedBySw == 0 )
         {
@@ -175,7 +381,8 @@ static gpPd_Handle_t Pd_GetPd(gpPd_BufferType_t type, UInt16 size)
 
     GP_ASSERT_DEV_EXT(pdHandle < GP_PD_NR_OF_HANDLES);
     gpPd_Descriptors[pdHandle].type = type;
-    BIT_SET(Pd_BitMaskOfPbmsClaimedBySw,pdHandle);
+    Pd_PoolClassOfHandle[pdHandle] = poolClass;
+    __atomic_fetch_or(&Pd_BitMaskOfPbmsClaimedBySw, PD_HANDLE_BM(pdHandle), __ATOMIC_RELEASE);
     GP_LOG_PRINTF("Get %i %lx",0, (UInt16)pdHandle, (unsigned long)Pd_BitMaskOfPbmsClaimedBySw);
 
 
@@ -184,14 +391,25 @@ static gpPd_Handle_t Pd_GetPd(gpPd_BufferType_t type, UInt16 size)
 
 static void Pd_FreePd(gpPd_Handle_t pdHandle)
 {
+    gpPd_BufferType_t type;
+    UInt8 poolClass;
+    UInt32 claimedBySw;
+
     GP_LOG_PRINTF("Free %i",0, (UInt16)pdHandle);
     GP_ASSERT_DEV_EXT(PD_CHECK_HANDLE_ACCESSIBLE(pdHandle));
+    type = gpPd_Descriptors[pdHandle].type;
+    poolClass = Pd_PoolClassOfHandle[pdHandle];
+
+    // Drop the handle from the mask before the PBM is returned, the PBM can be claimed again right after
+    claimedBySw = __atomic_fetch_and(&Pd_BitMaskOfPbmsClaimedBySw, ~PD_HANDLE_BM(pdHandle), __ATOMIC_ACQ_REL);
     gpHal_FreeHandle(pdHandle);
-    if( Pd_BitMaskOfPbmsClaimedBySw)
+
+    // Rx Pds are not taken from a pool
+    if(claimedBySw & PD_HANDLE_BM(pdHandle))
     {
-        BIT_CLR(Pd_BitMaskOfPbmsClaimedBySw,pdHandle);
+        Pd_PoolRelease(type, poolClass);
 #if defined(GP_COMP_UNIT_TEST)
-        if( Pd_BitMaskOfPbmsClaimedBySw == 0 )
+        if( claimedBySw == PD_HANDLE_BM(pdHandle) )
         {
             gpHal_GoToSleepWhenIdle(true);
         }
@@ -128,6 +128,18 @@ Bool gpHal_DPEntriesPending(void);
 
 /* JUMPTABLE_FLASH_FUNCTION_DEFINITIONS_END */
 
+/** @brief Make the list of data pending addresses of a stack equal to the given set, e.g. when restoring a child table
+*
+*   Entries already present are left untouched, missing ones are added and entries of the stack not in the set are removed.
+*
+*   @param  pAddressInfo  Array with the addresses for which a data packet is pending
+*   @param  nrOfEntries   Number of entries in pAddressInfo
+*   @param  id            The stack id which has the data packets pending
+*   @return result        gpHal_ResultBusy if not all entries fit, gpHal_ResultInvalidParameter on an invalid entry
+*
+*/
+gpHal_Result_t gpHal_DpSyncEntries(gpHal_AddressInfo_t* pAddressInfo, UInt8 nrOfEntries, UInt8 id);
+
 #ifdef __cplusplus
 }
 #endif
@@ -112,6 +112,14 @@ typedef struct gpHal_StatisticsMacCounter_s {
     UInt16 totalRx;
     /** @brief Count of HW PBM buffers depletion when issuing a Data Request. */
     UInt16 pbmOverflow;
+    /** @brief Count of CCA failures retried by the software CSMA/CA. */
+    UInt16 swCcaRetries;
+    /** @brief Count of missing acks retried by the software CSMA/CA. */
+    UInt16 swNoAckRetries;
+    /** @brief Highest number of CCA retries spent on a single packet. */
+    UInt8 maxCcaRetriesPerFrame;
+    /** @brief Highest number of no-ack retries spent on a single packet. */
+    UInt8 maxNoAckRetriesPerFrame;
 } gpHal_StatisticsMacCounter_t;
 
 
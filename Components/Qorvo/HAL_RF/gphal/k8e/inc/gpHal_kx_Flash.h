@@ -47,6 +47,21 @@ typedef enum {
     gpHal_FlashError_Locked,
 } gpHal_FlashError_t;
 
+#if defined(GP_DIVERSITY_GPHAL_FLASH_SIM)
+/** @brief Counters of the simulated flash (gpHal_FlashSim.c) */
+typedef struct {
+    UInt32 reads;               ///< number of gpHal_FlashRead calls
+    UInt32 bytesRead;
+    UInt32 writes;              ///< number of program operations
+    UInt32 bytesWritten;
+    UInt32 erases;              ///< number of sector erases
+    UInt32 maxEraseCount;       ///< highest erase count of a single sector
+    UInt32 rewriteViolations;   ///< programs of write units not blank since the last erase
+    UInt32 busyTimeUs;          ///< accumulated simulated erase and program time
+    UInt32 maxBusyTimeUs;       ///< longest single erase or program operation
+} gpHal_FlashSimStats_t;
+#endif //GP_DIVERSITY_GPHAL_FLASH_SIM
+
 
 /*****************************************************************************
  *                    Macro Definitions
@@ -54,7 +69,9 @@ typedef enum {
 
 #define FLASH_WORD_SIZE             (4)
 #define FLASH_PAGE_SIZE             (512U)
+#ifndef FLASH_PAGES_PER_SECTOR
 #define FLASH_PAGES_PER_SECTOR      (2U)
+#endif //FLASH_PAGES_PER_SECTOR
 #define FLASH_SECTOR_SIZE           (FLASH_PAGES_PER_SECTOR * FLASH_PAGE_SIZE)
 
 #define FLASH_ERASE_UNIT            FLASH_SECTOR_SIZE
@@ -257,6 +274,33 @@ void gpHal_FlashRemap_SwapUpperAndLowerFlashAreas(void);
  */
 Bool gpHal_FlashRemap_IsFlashSwapped(void);
 
+#if defined(GP_DIVERSITY_GPHAL_FLASH_SIM)
+/**
+ *  Reset the simulated flash to the erased state and clear all counters, including the erase counts.
+ */
+void gpHal_FlashSimInit(void);
+
+/**
+ *  Get the counters of the simulated flash.
+ *
+ *  @param pStats  Pointer to the structure where the counters are copied to.
+ */
+void gpHal_FlashSimGetStats(gpHal_FlashSimStats_t* pStats);
+
+/**
+ *  Clear the counters of the simulated flash. Erase counts of the sectors are kept.
+ */
+void gpHal_FlashSimResetStats(void);
+
+/**
+ *  Get the number of times a sector of the simulated flash was erased since gpHal_FlashSimInit.
+ *
+ *  @param sectorAddress  Absolute address within the sector.
+ *  @return               Erase count, 0 for an address outside the simulated flash.
+ */
+UInt32 gpHal_FlashSimGetEraseCount(FlashPtr sectorAddress);
+#endif //GP_DIVERSITY_GPHAL_FLASH_SIM
+
 #ifdef __cplusplus
 }
 #endif
@@ -7,6 +7,9 @@
 #ifdef GP_DIVERSITY_GPHAL_INTERN
 #include "gpHal_kx_mm.h"
 #endif
+#if defined(HAL_DIVERSITY_MM_SIM)
+#include "hal_MMSim.h"
+#endif //HAL_DIVERSITY_MM_SIM
 
 #if defined(__GNUC__)
 # define ALWAYS_INLINE static inline __attribute__((always_inline))
@@ -91,6 +94,92 @@ extern "C" {
 
 #ifdef GP_DIVERSITY_GPHAL_INTERN
 
+#if defined(HAL_DIVERSITY_MM_SIM)
+/* Host build: sized accesses go to the simulated address space of hal_MMSim.c, one access each as on target */
+ALWAYS_INLINE void GP_WB_WRITE_U8(UIntPtr address, UInt8 val)
+{
+    hal_MMSimWrite(address, &val, 1);
+}
+
+ALWAYS_INLINE void GP_WB_WRITE_U16(UIntPtr address, UInt16 val)
+{
+    hal_MMSimWrite(address, &val, 2);
+}
+
+ALWAYS_INLINE void GP_WB_WRITE_U24(UIntPtr address, UInt32 val)
+{
+    hal_MMSimWrite(address, &val, 3);
+}
+
+ALWAYS_INLINE void GP_WB_WRITE_U32(UIntPtr address, UInt32 val)
+{
+    hal_MMSimWrite(address, &val, 4);
+}
+
+ALWAYS_INLINE void GP_WB_WRITE_U40(UIntPtr address, UInt64 val)
+{
+    hal_MMSimWrite(address, &val, 5);
+}
+
+ALWAYS_INLINE void GP_WB_WRITE_U48(UIntPtr address, UInt64 val)
+{
+    hal_MMSimWrite(address, &val, 6);
+}
+
+ALWAYS_INLINE void GP_WB_WRITE_U64(UIntPtr address, UInt64 val)
+{
+    hal_MMSimWrite(address, &val, 8);
+}
+
+ALWAYS_INLINE UInt8 GP_WB_READ_U8(UIntPtr address)
+{
+    UInt8 val;
+    hal_MMSimRead(address, &val, 1);
+    return val;
+}
+
+ALWAYS_INLINE UInt16 GP_WB_READ_U16(UIntPtr address)
+{
+    UInt16 val;
+    hal_MMSimRead(address, &val, 2);
+    return val;
+}
+
+ALWAYS_INLINE UInt32 GP_WB_READ_U24(UIntPtr address)
+{
+    UInt32 val = 0;
+    hal_MMSimRead(address, &val, 3);
+    return val;
+}
+
+ALWAYS_INLINE UInt32 GP_WB_READ_U32(UIntPtr address)
+{
+    UInt32 val;
+    hal_MMSimRead(address, &val, 4);
+    return val;
+}
+
+ALWAYS_INLINE UInt64 GP_WB_READ_U40(UIntPtr address)
+{
+    UInt64 val = 0;
+    hal_MMSimRead(address, &val, 5);
+    return val;
+}
+
+ALWAYS_INLINE UInt64 GP_WB_READ_U48(UIntPtr address)
+{
+    UInt64 val = 0;
+    hal_MMSimRead(address, &val, 6);
+    return val;
+}
+
+ALWAYS_INLINE UInt64 GP_WB_READ_U64(UIntPtr address)
+{
+    UInt64 val;
+    hal_MMSimRead(address, &val, 8);
+    return val;
+}
+#else
 ALWAYS_INLINE void GP_WB_WRITE_U8(UIntPtr address, UInt8 val)
 {
     *((volatile UInt8 *) address) = val;
@@ -169,6 +258,7 @@ ALWAYS_INLINE UInt64 GP_WB_READ_U64(UIntPtr address)
 {
     return *((volatile UInt64 *) address);
 }
+#endif //HAL_DIVERSITY_MM_SIM
 
 ALWAYS_INLINE void GP_WB_MWRITE_U8(UIntPtr address, UInt8 mask, UInt8 val)
 {
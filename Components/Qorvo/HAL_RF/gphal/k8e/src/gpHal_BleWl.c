@@ -86,6 +86,15 @@ extern UInt32 gpChipEmu_GetGpMicroStructBleWhiteListStart(UInt32 gp_mm_ram_linea
 #define GPBLE_WHITELIST_SET_PROPERTY(prop, mask)  (prop |= mask)
 #define GPBLE_WHITELIST_CLR_PROPERTY(prop, mask)  (prop &= ~mask)
 
+//RAM index on top of the whitelist - hash on address + address type to a chain of entries
+#ifndef GPHAL_BLE_WL_HASH_SIZE
+#define GPHAL_BLE_WL_HASH_SIZE          16
+#endif //GPHAL_BLE_WL_HASH_SIZE
+#define GPHAL_BLE_WL_HASH_MASK          (GPHAL_BLE_WL_HASH_SIZE - 1)
+
+#define GPHAL_BLE_WL_BITMAP_WORDS       ((GP_HAL_BLE_MAX_NR_OF_WHITELIST_ENTRIES + 31) / 32)
+#define GPHAL_BLE_WL_IS_VALID(id)       ((gpHal_BleWl_Valid[(id) / 32] & (1UL << ((id) % 32))) != 0)
+
 /*****************************************************************************
  *                    Type Definitions
  *****************************************************************************/
@@ -107,6 +116,24 @@ GP_COMPILE_TIME_VERIFY(GP_HAL_BLE_WHITELIST_ENTRY_SIZE >= GP_WB_BLE_WHITELIST_EN
 COMPILER_ALIGNED(GP_WB_MAX_MEMBER_SIZE) static UInt8 gpHal_BleWl_WhitelistMemory[GP_HAL_BLE_WHITELIST_ENTRY_SIZE*GP_HAL_BLE_MAX_NR_OF_WHITELIST_ENTRIES] LINKER_SECTION(".lower_ram_retain_gpmicro_accessible");
 #endif // GP_COMP_CHIPEMU
 
+GP_COMPILE_TIME_VERIFY((GPHAL_BLE_WL_HASH_SIZE & GPHAL_BLE_WL_HASH_MASK) == 0);
+GP_COMPILE_TIME_VERIFY(GP_HAL_BLE_MAX_NR_OF_WHITELIST_ENTRIES < GP_HAL_BLE_WL_ID_INVALID);
+
+//Index on the whitelist: chain heads per hash bucket, next entry in chain and bitmap of valid entries
+//Address and address type are only stored in the whitelist itself, the index never needs to scan it
+static UInt8  gpHal_BleWl_HashHead[GPHAL_BLE_WL_HASH_SIZE];
+static UInt8  gpHal_BleWl_HashNext[GP_HAL_BLE_MAX_NR_OF_WHITELIST_ENTRIES];
+static UInt32 gpHal_BleWl_Valid[GPHAL_BLE_WL_BITMAP_WORDS];
+
+//Copy of the state bits of each entry, so state queries and bulk updates only access the entries they change
+static UInt8  gpHal_BleWl_StateMask[GP_HAL_BLE_MAX_NR_OF_WHITELIST_ENTRIES];
+//Number of entries with a regular and special (controller specific) state mask
+static UInt8  gpHal_BleWl_RegularCount;
+static UInt8  gpHal_BleWl_SpecialCount;
+
+//Kept in sync with BLEFILT_WHITELIST_LENGTH
+static UInt8  gpHal_BleWl_Length;
+
 /*****************************************************************************
  *                    Static Function Prototypes
  *****************************************************************************/
@@ -117,6 +144,115 @@ COMPILER_ALIGNED(GP_WB_MAX_MEMBER_SIZE) static UInt8 gpHal_BleWl_WhitelistMemory
  *                    Static Function Definitions
  *****************************************************************************/
 
+static UInt8 gpHal_BleWlHash(UInt8 addressType, const UInt8* pAddress)
+{
+    UIntLoop i;
+    UInt8 hash = addressType;
+
+    for(i = 0; i < sizeof(BtDeviceAddress_t); i++)
+    {
+        hash = (UInt8)((hash << 1) | (hash >> 7)) ^ pAddress[i];
+    }
+    hash ^= (hash >> 4);
+
+    return (hash & GPHAL_BLE_WL_HASH_MASK);
+}
+
+static UInt8 gpHal_BleWlHashEntry(UInt8 id)
+{
+    gpHal_Address_t offset = GPHAL_BLE_WHITELIST_ID_TO_OFFSET(id);
+    UInt64 wlAddress = GP_WB_READ_BLE_WHITELIST_ENTRY_DEVICE_ADDRESS(offset);
+    BtDeviceAddress_t address;
+
+    MEMCPY(address.addr, &wlAddress, sizeof(BtDeviceAddress_t));
+    return gpHal_BleWlHash(GPHAL_BLE_WHITELIST_MASK_TO_ADDRESS_TYPE(GP_WB_READ_BLE_WHITELIST_ENTRY_ADDRESS_TYPE(offset)), address.addr);
+}
+
+static void gpHal_BleWlLinkEntry(UInt8 id)
+{
+    UInt8 hash = gpHal_BleWlHashEntry(id);
+
+    gpHal_BleWl_HashNext[id] = gpHal_BleWl_HashHead[hash];
+    gpHal_BleWl_HashHead[hash] = id;
+    gpHal_BleWl_Valid[id / 32] |= (1UL << (id % 32));
+}
+
+//Must be called before the address of the entry is changed in the whitelist
+static void gpHal_BleWlUnlinkEntry(UInt8 id)
+{
+    UInt8* pLink = &gpHal_BleWl_HashHead[gpHal_BleWlHashEntry(id)];
+
+    while(*pLink != GP_HAL_BLE_WL_ID_INVALID)
+    {
+        if(*pLink == id)
+        {
+            *pLink = gpHal_BleWl_HashNext[id];
+            break;
+        }
+        pLink = &gpHal_BleWl_HashNext[*pLink];
+    }
+    gpHal_BleWl_Valid[id / 32] &= ~(1UL << (id % 32));
+}
+
+static void gpHal_BleWlSetStateMask(UInt8 id, UInt8 stateMask)
+{
+    UInt8 oldStateMask = gpHal_BleWl_StateMask[id];
+
+    if(oldStateMask != 0x00)
+    {
+        GP_HAL_BLE_IS_REGULAR_ENTRY(oldStateMask) ? gpHal_BleWl_RegularCount-- : gpHal_BleWl_SpecialCount--;
+    }
+    if(stateMask != 0x00)
+    {
+        GP_HAL_BLE_IS_REGULAR_ENTRY(stateMask) ? gpHal_BleWl_RegularCount++ : gpHal_BleWl_SpecialCount++;
+    }
+    gpHal_BleWl_StateMask[id] = stateMask;
+}
+
+//Write the state bits of an entry, keeping its address type
+static void gpHal_BleWlWriteStateMask(UInt8 id, UInt8 stateMask)
+{
+    gpHal_Address_t offset = GPHAL_BLE_WHITELIST_ID_TO_OFFSET(id);
+    UInt8 addrType = (GP_WB_READ_BLE_WHITELIST_ENTRY_VALID_STATE_MASK_ADDRESS_TYPE(offset) & GP_WB_BLE_WHITELIST_ENTRY_ADDRESS_TYPE_MASK);
+
+    GP_WB_WRITE_BLE_WHITELIST_ENTRY_VALID_STATE_MASK_ADDRESS_TYPE(offset, addrType | stateMask);
+    gpHal_BleWlSetStateMask(id, stateMask);
+}
+
+static UInt8 gpHal_BleWlFindFreeEntry(UInt8 rangeStart, UInt8 rangeStop)
+{
+    UInt16 i;
+
+    for(i = rangeStart; i <= rangeStop; i++)
+    {
+        if(((i % 32) == 0) && (gpHal_BleWl_Valid[i / 32] == 0xFFFFFFFF))
+        {
+            //Skip a fully used word
+            i += 31;
+            continue;
+        }
+        if(!GPHAL_BLE_WL_IS_VALID(i))
+        {
+            return i;
+        }
+    }
+    return GP_HAL_BLE_WL_ID_INVALID;
+}
+
+//Length of the whitelist when only entries below 'end' are considered
+static UInt8 gpHal_BleWlGetLengthBelow(UInt8 end)
+{
+    while(end > 0)
+    {
+        if(GPHAL_BLE_WL_IS_VALID(end - 1))
+        {
+            break;
+        }
+        end--;
+    }
+    return end;
+}
+
 Bool gpHal_CheckWhitelistRange(UInt8 rangeStart, UInt8 rangeStop)
 {
     if(rangeStart > rangeStop)
@@ -134,18 +270,23 @@ Bool gpHal_CheckWhitelistRange(UInt8 rangeStart, UInt8 rangeStop)
 
 UInt8 gpHal_BleFindWhiteListEntry(UInt8 addressType, BtDeviceAddress_t* pAddress, UInt8 start, UInt8 stop)
 {
-    UInt8 i;
+    UInt8 i = gpHal_BleWl_HashHead[gpHal_BleWlHash(addressType, pAddress->addr)];
+    UInt8 found = GP_HAL_BLE_WL_ID_INVALID;
 
-    for(i = start; i <= stop; i++)
+    //Walk the whole chain - the lowest matching index in range is returned
+    for(; i != GP_HAL_BLE_WL_ID_INVALID; i = gpHal_BleWl_HashNext[i])
     {
-        gpHal_Address_t offset = GPHAL_BLE_WHITELIST_ID_TO_OFFSET(i);
-        UInt64 wlAddress = GP_WB_READ_BLE_WHITELIST_ENTRY_DEVICE_ADDRESS(offset);
+        gpHal_Address_t offset;
+        UInt64 wlAddress;
 
-        if(!GPHAL_BLE_WHITELIST_ENTRY_VALID_OFFSET(offset))
+        if((i < start) || (i > stop) || (i >= found))
         {
             continue;
         }
 
+        offset = GPHAL_BLE_WHITELIST_ID_TO_OFFSET(i);
+        wlAddress = GP_WB_READ_BLE_WHITELIST_ENTRY_DEVICE_ADDRESS(offset);
+
         if(MEMCMP(pAddress->addr, &wlAddress, sizeof(BtDeviceAddress_t)) != 0)
         {
             continue;
@@ -156,9 +297,9 @@ UInt8 gpHal_BleFindWhiteListEntry(UInt8 addressType, BtDeviceAddress_t* pAddress
             continue;
         }
 
-        return i;
+        found = i;
     }
-    return GP_HAL_BLE_WL_ID_INVALID;
+    return found;
 }
 
 #ifdef GP_DIVERSITY_GPHAL_WHITELIST_UPDATE_CALLBACK
@@ -181,9 +322,11 @@ void gpHal_NotifyIndexUpdate(UInt8 index, Bool isValid)
 void gpHal_BleAddToWhiteList(UInt8 index, gpHal_WhiteListEntry_t* pEntry)
 {
     gpHal_Address_t offset = GPHAL_BLE_WHITELIST_ID_TO_OFFSET(index);
-    UInt8 wlLength;
 
-    wlLength = GP_WB_READ_BLEFILT_WHITELIST_LENGTH();
+    if(GPHAL_BLE_WL_IS_VALID(index))
+    {
+        gpHal_BleWlUnlinkEntry(index);
+    }
 
     // First write valid states (overwrites address type)
     GP_WB_WRITE_BLE_WHITELIST_ENTRY_VALID_STATE_MASK_ADDRESS_TYPE(offset, pEntry->stateMask);
@@ -194,10 +337,13 @@ void gpHal_BleAddToWhiteList(UInt8 index, gpHal_WhiteListEntry_t* pEntry)
 
     GP_HAL_WRITE_BYTE_STREAM(offset + GP_WB_BLE_WHITELIST_ENTRY_DEVICE_ADDRESS_ADDRESS, pEntry->address.addr, sizeof(BtDeviceAddress_t));
 
-    if(index >= wlLength)
+    gpHal_BleWlLinkEntry(index);
+    gpHal_BleWlSetStateMask(index, pEntry->stateMask & ~GP_WB_BLE_WHITELIST_ENTRY_ADDRESS_TYPE_MASK);
+
+    if(index >= gpHal_BleWl_Length)
     {
-        wlLength = (index + 1);
-        GP_WB_WRITE_BLEFILT_WHITELIST_LENGTH(wlLength);
+        gpHal_BleWl_Length = (index + 1);
+        GP_WB_WRITE_BLEFILT_WHITELIST_LENGTH(gpHal_BleWl_Length);
     }
 
 #ifdef GP_DIVERSITY_GPHAL_WHITELIST_UPDATE_CALLBACK
@@ -217,6 +363,7 @@ void gpHal_RemoveFromWhiteList(UInt8 index, gpHal_WhiteListEntry_t* pEntry)
 
 void gpHal_BleWlInit(void)
 {
+    UIntLoop i;
     UInt32 lAddr = GP_HAL_BLE_WHITELIST_START - GP_MM_RAM_LINEAR_START;
 #ifndef GP_COMP_CHIPEMU
     NOT_USED(gpHal_BleWl_WhitelistMemory);
@@ -224,11 +371,28 @@ void gpHal_BleWlInit(void)
 
     GP_WB_WRITE_BLEFILT_WHITELIST_BASE_ADDRESS((UInt16)lAddr);
     GP_WB_WRITE_BLEFILT_WHITELIST_LENGTH(0);
+    gpHal_BleWl_Length = 0;
+
+    //Build the index from the current whitelist content
+    MEMSET(gpHal_BleWl_HashHead, GP_HAL_BLE_WL_ID_INVALID, sizeof(gpHal_BleWl_HashHead));
+    MEMSET(gpHal_BleWl_Valid, 0, sizeof(gpHal_BleWl_Valid));
+    MEMSET(gpHal_BleWl_StateMask, 0, sizeof(gpHal_BleWl_StateMask));
+    gpHal_BleWl_RegularCount = 0;
+    gpHal_BleWl_SpecialCount = 0;
+    for(i = 0; i < GP_HAL_BLE_MAX_NR_OF_WHITELIST_ENTRIES; i++)
+    {
+        gpHal_Address_t offset = GPHAL_BLE_WHITELIST_ID_TO_OFFSET(i);
+
+        if(GPHAL_BLE_WHITELIST_ENTRY_VALID_OFFSET(offset))
+        {
+            gpHal_BleWlLinkEntry(i);
+        }
+        gpHal_BleWlSetStateMask(i, GP_WB_READ_BLE_WHITELIST_ENTRY_VALID_STATE_MASK_ADDRESS_TYPE(offset) & ~GP_WB_BLE_WHITELIST_ENTRY_ADDRESS_TYPE_MASK);
+    }
 }
 
 gpHal_Result_t gpHal_BleAddDeviceToWhiteList(gpHal_WhiteListEntry_t* pEntry, UInt8 rangeStart, UInt8 rangeStop)
 {
-    UIntLoop i;
     UInt8 currentEntryIndex;
 
     if(!gpHal_CheckWhitelistRange(rangeStart, rangeStop))
@@ -246,13 +410,11 @@ gpHal_Result_t gpHal_BleAddDeviceToWhiteList(gpHal_WhiteListEntry_t* pEntry, UIn
     }
 
     // Item not present yet, add on first available location
-    for(i = rangeStart; i <= rangeStop; i++)
+    currentEntryIndex = gpHal_BleWlFindFreeEntry(rangeStart, rangeStop);
+    if(currentEntryIndex != GP_HAL_BLE_WL_ID_INVALID)
     {
-        if(!GPHAL_BLE_WHITELIST_ENTRY_VALID(i))
-        {
-            gpHal_BleAddToWhiteList(i, pEntry);
-            return gpHal_ResultSuccess;
-        }
+        gpHal_BleAddToWhiteList(currentEntryIndex, pEntry);
+        return gpHal_ResultSuccess;
     }
 
     return gpHal_ResultBusy;
@@ -260,7 +422,6 @@ gpHal_Result_t gpHal_BleAddDeviceToWhiteList(gpHal_WhiteListEntry_t* pEntry, UIn
 void gpHal_BleClearWhiteList(UInt8 rangeStart, UInt8 rangeStop)
 {
     UIntLoop i;
-    UInt8 wlLength;
 
     // Consider return iso assert
     GP_ASSERT_DEV_EXT(gpHal_CheckWhitelistRange(rangeStart, rangeStop));
@@ -269,7 +430,7 @@ void gpHal_BleClearWhiteList(UInt8 rangeStart, UInt8 rangeStop)
 #ifdef GP_DIVERSITY_GPHAL_WHITELIST_UPDATE_CALLBACK
     for(i = rangeStart; i <= rangeStop; i++)
     {
-        if (GPHAL_BLE_WHITELIST_ENTRY_VALID(i))
+        if (GPHAL_BLE_WL_IS_VALID(i))
         {
             BtDeviceAddress_t address;
             UInt8 addressType;
@@ -295,6 +456,14 @@ void gpHal_BleClearWhiteList(UInt8 rangeStart, UInt8 rangeStop)
     }
 #endif
 
+    for(i = rangeStart; i <= rangeStop; i++)
+    {
+        if(GPHAL_BLE_WL_IS_VALID(i))
+        {
+            gpHal_BleWlUnlinkEntry(i);
+        }
+        gpHal_BleWlSetStateMask(i, 0x00);
+    }
 
 #ifdef GP_COMP_CHIPEMU
 {
@@ -309,29 +478,21 @@ void gpHal_BleClearWhiteList(UInt8 rangeStart, UInt8 rangeStop)
     MEMSET((void*)(GPHAL_BLE_WHITELIST_ID_TO_OFFSET(rangeStart)),0,(rangeStop-rangeStart+1)*GP_HAL_BLE_WHITELIST_ENTRY_SIZE);
 #endif
 
-    wlLength = GP_WB_READ_BLEFILT_WHITELIST_LENGTH();
     /* Only update the length if the tail of the list was removed */
-    if (wlLength <= (rangeStop+1))
+    if (gpHal_BleWl_Length <= (rangeStop+1))
     {
         // Calculate index of new last valid item of list
-        wlLength = 0;
-        for(i =  0; i < rangeStart; i++)
-        {
-            if(GPHAL_BLE_WHITELIST_ENTRY_VALID(i))
-            {
-                wlLength = i+1;
-            }
-        }
+        gpHal_BleWl_Length = gpHal_BleWlGetLengthBelow(rangeStart);
     }
 
-    GP_WB_WRITE_BLEFILT_WHITELIST_LENGTH(wlLength);
+    GP_WB_WRITE_BLEFILT_WHITELIST_LENGTH(gpHal_BleWl_Length);
 }
 
 Bool gpHal_BleIsWhiteListEntryValid(UInt8 id)
 {
     GP_ASSERT_DEV_EXT(id < GP_HAL_BLE_MAX_NR_OF_WHITELIST_ENTRIES);
 
-    return GPHAL_BLE_WHITELIST_ENTRY_VALID(id);
+    return GPHAL_BLE_WL_IS_VALID(id);
 }
 
 gpHal_Result_t gpHal_UpdateWhiteListEntryState(UInt8 id, UInt8 state, Bool set)
@@ -353,6 +514,7 @@ gpHal_Result_t gpHal_UpdateWhiteListEntryState(UInt8 id, UInt8 state, Bool set)
         }
 
         GP_WB_WRITE_BLE_WHITELIST_ENTRY_VALID_STATE_MASK_ADDRESS_TYPE(offset, applicableStates);
+        gpHal_BleWlSetStateMask(id, applicableStates & ~GP_WB_BLE_WHITELIST_ENTRY_ADDRESS_TYPE_MASK);
         return gpHal_ResultSuccess;
     }
 
@@ -362,7 +524,7 @@ gpHal_Result_t gpHal_UpdateWhiteListEntryState(UInt8 id, UInt8 state, Bool set)
 #ifdef GP_DIVERSITY_GPHAL_WHITELIST_UPDATE_CALLBACK
 UInt8 gpHal_BleWl_FindEntry(UInt8 addressType, BtDeviceAddress_t *pAddress)
 {
-    UInt8 wl_len = GP_WB_READ_BLEFILT_WHITELIST_LENGTH();
+    UInt8 wl_len = gpHal_BleWl_Length;
     if (0 == wl_len)
     {
         return GP_HAL_BLE_WL_ID_INVALID;
@@ -377,8 +539,8 @@ UInt8 gpHal_BleGetWhitelistEntryState(UInt8 id)
 
     if(id != GP_HAL_BLE_WL_ID_INVALID)
     {
-        gpHal_Address_t offset = GPHAL_BLE_WHITELIST_ID_TO_OFFSET(id);
-        state = GP_WB_READ_BLE_WHITELIST_ENTRY_VALID_STATE_MASK_ADDRESS_TYPE(offset) & ~GP_WB_BLE_WHITELIST_ENTRY_ADDRESS_TYPE_MASK;
+        GP_ASSERT_DEV_EXT(id < GP_HAL_BLE_MAX_NR_OF_WHITELIST_ENTRIES);
+        state = gpHal_BleWl_StateMask[id];
     }
 
     //GP_LOG_PRINTF("entry state: %d", 0, state);
@@ -416,16 +578,8 @@ gpHal_Result_t gpHal_BleUpdateWhiteListEntryState(UInt8 addressType, BtDeviceAdd
     wlEntry.stateMask   = stateMask_value;
     MEMCPY(&wlEntry.address, pAddress, sizeof(BtDeviceAddress_t));
 
-    UInt8 regular_cnt = 0;
-    UInt8 special_cnt = 0;
-    for(UInt8 i=0; i<GP_HAL_BLE_MAX_NR_OF_WHITELIST_ENTRIES; i++)
-    {
-        UInt8 entryStateMask = gpHal_BleGetWhitelistEntryState(i);
-        if(entryStateMask != 0x00)
-        {
-            GP_HAL_BLE_IS_REGULAR_ENTRY(entryStateMask) ? regular_cnt++ : special_cnt++;
-        }
-    }
+    UInt8 regular_cnt = gpHal_BleWl_RegularCount;
+    UInt8 special_cnt = gpHal_BleWl_SpecialCount;
 
     GP_LOG_PRINTF("regular entries cnt: %d", 0, regular_cnt);
     GP_LOG_PRINTF("special entries cnt: %d", 0, special_cnt);
@@ -451,9 +605,7 @@ gpHal_Result_t gpHal_BleUpdateWhiteListEntryState(UInt8 addressType, BtDeviceAdd
             {
                 GP_LOG_PRINTF("updating entry...", 0);
 
-                gpHal_Address_t offset = GPHAL_BLE_WHITELIST_ID_TO_OFFSET(idx);
-                UInt8 addrType = (GP_WB_READ_BLE_WHITELIST_ENTRY_VALID_STATE_MASK_ADDRESS_TYPE(offset) & GP_WB_BLE_WHITELIST_ENTRY_ADDRESS_TYPE_MASK);
-                GP_WB_WRITE_BLE_WHITELIST_ENTRY_VALID_STATE_MASK_ADDRESS_TYPE(offset, addrType | stateMask_new);
+                gpHal_BleWlWriteStateMask(idx, stateMask_new);
 
                 result = gpHal_ResultSuccess;
             }
@@ -468,9 +620,7 @@ gpHal_Result_t gpHal_BleUpdateWhiteListEntryState(UInt8 addressType, BtDeviceAdd
             {
                 GP_LOG_PRINTF("updating entry...", 0);
 
-                gpHal_Address_t offset = GPHAL_BLE_WHITELIST_ID_TO_OFFSET(idx);
-                UInt8 addrType = (GP_WB_READ_BLE_WHITELIST_ENTRY_VALID_STATE_MASK_ADDRESS_TYPE(offset) & GP_WB_BLE_WHITELIST_ENTRY_ADDRESS_TYPE_MASK);
-                GP_WB_WRITE_BLE_WHITELIST_ENTRY_VALID_STATE_MASK_ADDRESS_TYPE(offset, addrType | stateMask_new);
+                gpHal_BleWlWriteStateMask(idx, stateMask_new);
 
                 result = gpHal_ResultSuccess;
             }
@@ -483,9 +633,7 @@ gpHal_Result_t gpHal_BleUpdateWhiteListEntryState(UInt8 addressType, BtDeviceAdd
         {
             GP_LOG_PRINTF("updating entry...", 0);
 
-            gpHal_Address_t offset = GPHAL_BLE_WHITELIST_ID_TO_OFFSET(idx);
-            UInt8 addrType = (GP_WB_READ_BLE_WHITELIST_ENTRY_VALID_STATE_MASK_ADDRESS_TYPE(offset) & GP_WB_BLE_WHITELIST_ENTRY_ADDRESS_TYPE_MASK);
-            GP_WB_WRITE_BLE_WHITELIST_ENTRY_VALID_STATE_MASK_ADDRESS_TYPE(offset, addrType | stateMask_new);;
+            gpHal_BleWlWriteStateMask(idx, stateMask_new);
         }
     }
     else if(createIfNotExist) // create new entry
@@ -535,9 +683,10 @@ void gpHal_BleUpdateWhiteListEntryStateBulk(UInt8 matchMask, UInt8 stateMask_mas
     GP_LOG_PRINTF("--- WL bulk update ---", 0);
     GP_LOG_PRINTF("matchMask: 0x%02x stateMask_mask: 0x%02x stateMask_value: 0x%02x", 0, matchMask, stateMask_mask, stateMask_value);
 
+    //Only the RAM copy of the state masks is checked, the whitelist is only accessed for matching entries
     for(UInt8 i=0; i<GP_HAL_BLE_MAX_NR_OF_WHITELIST_ENTRIES; i++)
     {
-        UInt8 stateMask = gpHal_BleGetWhitelistEntryState(i);
+        UInt8 stateMask = gpHal_BleWl_StateMask[i];
         if((stateMask != 0x00) && (matchMask & stateMask))
         {
             UInt8 stateMask_new = (stateMask & ~stateMask_mask) | (stateMask_value & stateMask_mask);
@@ -548,9 +697,7 @@ void gpHal_BleUpdateWhiteListEntryStateBulk(UInt8 matchMask, UInt8 stateMask_mas
 
             if(stateMask_new)
             {
-                gpHal_Address_t offset = GPHAL_BLE_WHITELIST_ID_TO_OFFSET(i);
-                UInt8 addrType = (GP_WB_READ_BLE_WHITELIST_ENTRY_VALID_STATE_MASK_ADDRESS_TYPE(offset) & GP_WB_BLE_WHITELIST_ENTRY_ADDRESS_TYPE_MASK);
-                GP_WB_WRITE_BLE_WHITELIST_ENTRY_VALID_STATE_MASK_ADDRESS_TYPE(offset, addrType | stateMask_new);
+                gpHal_BleWlWriteStateMask(i, stateMask_new);
             }
             else
             {
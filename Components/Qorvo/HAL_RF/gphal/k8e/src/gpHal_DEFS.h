@@ -242,6 +242,7 @@ typedef struct __gpHalMac_CSMA_CA_state
     UInt8 backOffCount;
     UInt8 remainingFrameRetries;
     UInt8 initialMaxFrameRetries;
+    UInt8 ccaRetries;
 } gpHalMac_CSMA_CA_state_t;
 
 gpHalMac_CSMA_CA_state_t* gpHalMac_Get_CSMA_CA_State(UInt8 pbmHandle);
@@ -82,6 +82,19 @@
 #define GPHAL_DP_ENTRY_VALID    1
 #define GPHAL_DP_ENTRY_INVALID  0
 
+//RAM index on top of the address lists - hash on PAN + address to a chain of slots
+#ifndef GPHAL_DP_HASH_SIZE
+#define GPHAL_DP_HASH_SIZE          16
+#endif //GPHAL_DP_HASH_SIZE
+#define GPHAL_DP_HASH_MASK          (GPHAL_DP_HASH_SIZE - 1)
+#define GPHAL_DP_INVALID_SLOT       0xFF
+
+#define GPHAL_DP_BITMAP_WORDS(max)  (((max) + 31) / 32)
+
+#define GPHAL_DP_LIST_SHORT         0
+#define GPHAL_DP_LIST_LONG          1
+#define GPHAL_DP_NR_OF_LISTS        2
+
 /*****************************************************************************
  *                    Static Data Definitions
  *****************************************************************************/
@@ -99,6 +112,39 @@ GP_COMPILE_TIME_VERIFY(GPHAL_DP_SIZE_LONG_ENTRY >= GP_WB_LONG_SRC_ENTRY_SIZE);
 static UInt16 gpHalDP_ShortAddressList[GPHAL_DP_SIZE_SHORT_ENTRY*GPHAL_DP_SHORT_LIST_MAX/2] LINKER_SECTION(".lower_ram_retain_gpmicro_accessible");
 static UInt16 gpHalDP_LongAddressList[GPHAL_DP_SIZE_LONG_ENTRY*GPHAL_DP_LONG_LIST_MAX/2]    LINKER_SECTION(".lower_ram_retain_gpmicro_accessible");
 
+GP_COMPILE_TIME_VERIFY((GPHAL_DP_HASH_SIZE & GPHAL_DP_HASH_MASK) == 0);
+GP_COMPILE_TIME_VERIFY(GPHAL_DP_SHORT_LIST_MAX < GPHAL_DP_INVALID_SLOT);
+GP_COMPILE_TIME_VERIFY(GPHAL_DP_LONG_LIST_MAX < GPHAL_DP_INVALID_SLOT);
+
+//Index per list: chain heads per hash bucket, next slot in chain and bitmap of used slots
+//Entries themselves are only stored in the address lists, the index never needs to scan them
+static UInt8  gpHalDP_ShortHashHead[GPHAL_DP_HASH_SIZE];
+static UInt8  gpHalDP_ShortHashNext[GPHAL_DP_SHORT_LIST_MAX];
+static UInt32 gpHalDP_ShortUsed[GPHAL_DP_BITMAP_WORDS(GPHAL_DP_SHORT_LIST_MAX)];
+static UInt8  gpHalDP_LongHashHead[GPHAL_DP_HASH_SIZE];
+static UInt8  gpHalDP_LongHashNext[GPHAL_DP_LONG_LIST_MAX];
+static UInt32 gpHalDP_LongUsed[GPHAL_DP_BITMAP_WORDS(GPHAL_DP_LONG_LIST_MAX)];
+
+//Number of slots the radio needs to scan - kept in sync with MACFILT_*_SRC_ADDRESS_TABLE_SIZE
+static UInt8  gpHalDP_TableSize[GPHAL_DP_NR_OF_LISTS];
+
+typedef struct {
+    gpHal_Address_t listStart;
+    UInt8*  pHashHead;
+    UInt8*  pHashNext;
+    UInt32* pUsed;
+    UInt8   entrySize;
+    UInt8   addrSize;
+    UInt8   listMax;
+} gpHalDP_List_t;
+
+static const gpHalDP_List_t gpHalDP_Lists[GPHAL_DP_NR_OF_LISTS] = {
+    { GPHAL_DP_SHORT_LIST_START, gpHalDP_ShortHashHead, gpHalDP_ShortHashNext, gpHalDP_ShortUsed,
+      GPHAL_DP_SIZE_SHORT_ENTRY, sizeof(UInt16),       GPHAL_DP_SHORT_LIST_MAX },
+    { GPHAL_DP_LONG_LIST_START,  gpHalDP_LongHashHead,  gpHalDP_LongHashNext,  gpHalDP_LongUsed,
+      GPHAL_DP_SIZE_LONG_ENTRY,  sizeof(MACAddress_t), GPHAL_DP_LONG_LIST_MAX },
+};
+
 /*****************************************************************************
  *                    Static Function Prototypes
  *****************************************************************************/
@@ -161,209 +207,198 @@ void gpHalDP_DumpTable(Bool dumpShort)
 }
 #endif //GP_DIVERSITY_DEVELOPMENT
 
-static gpHal_Result_t gpHalDP_AddShortEntry(gpHal_AddressInfo_t* pAddressInfo, UInt8 id)
+static UInt8 gpHalDP_GetListIndex(gpHal_AddressInfo_t* pAddressInfo)
 {
-    UIntLoop i;
-    UInt8 tableSize;
-    gpHal_Address_t addr = GPHAL_DP_SHORT_LIST_START;
-
-    NOT_USED(id); //stack ID not used for now - PanID also gives distinction
+    return (gpHal_AddressModeShortAddress == pAddressInfo->addressMode) ? GPHAL_DP_LIST_SHORT : GPHAL_DP_LIST_LONG;
+}
 
-    tableSize = GP_WB_READ_MACFILT_SHORT_SRC_ADDRESS_TABLE_SIZE();
+static UInt8 gpHalDP_Hash(gpHal_AddressInfo_t* pAddressInfo)
+{
+    UInt16 hash = pAddressInfo->panId;
 
-    for(i = 0; i < GPHAL_DP_SHORT_LIST_MAX; i++)
+    if(gpHal_AddressModeShortAddress == pAddressInfo->addressMode)
     {
-        if(GP_HAL_READ_REG(addr+GPHAL_DP_OFFSET_VALID) == GPHAL_DP_ENTRY_INVALID)
-        {
-            // CHANNEL_INDEX = mask of channel slots to apply to this entry
-            // We use a fixed mapping stack 0 -> channel slot 0, stack 1 -> channel slot 1, etc.
-            UInt8 chmask = (1 << id);
-            GP_HAL_WRITE_REG(addr+GPHAL_DP_OFFSET_CHANNEL_INDEX, chmask);
-            GP_HAL_WRITE_REGS16(addr+GPHAL_DP_OFFSET_PANID, &pAddressInfo->panId);
-            GP_HAL_WRITE_REGS16(addr+GPHAL_DP_OFFSET_ADDR,  &pAddressInfo->address.Short);
-            GP_HAL_WRITE_REG(addr+GPHAL_DP_OFFSET_VALID, GPHAL_DP_ENTRY_VALID);
-            GP_LOG_PRINTF("A:%i %u %x %x",0, i, id, pAddressInfo->panId, pAddressInfo->address.Short);
-
-            // Update table size.
-            if (tableSize <= i)
-            {
-                tableSize = i + 1;
-            }
-
-            break;
-        }
-        addr += GPHAL_DP_SIZE_SHORT_ENTRY;
+        hash ^= pAddressInfo->address.Short;
     }
-
-    if (i == GPHAL_DP_SHORT_LIST_MAX)
+    else
     {
-        //Table completely full
-        GP_LOG_PRINTF("AS failed",0);
+        UInt32 fold = pAddressInfo->address.Extended.LSB ^ pAddressInfo->address.Extended.MSB;
+        hash ^= (UInt16)(fold ^ (fold >> 16));
     }
+    hash ^= (hash >> 8);
+    hash ^= (hash >> 4);
 
-    GP_WB_WRITE_MACFILT_SHORT_SRC_ADDRESS_TABLE_SIZE(tableSize);
-
-    return (i == GPHAL_DP_SHORT_LIST_MAX) ? gpHal_ResultBusy : gpHal_ResultSuccess;
+    return (UInt8)(hash & GPHAL_DP_HASH_MASK);
 }
 
-static gpHal_Result_t gpHalDP_AddLongEntry(gpHal_AddressInfo_t* pAddressInfo, UInt8 id)
+static Bool gpHalDP_EntryMatches(const gpHalDP_List_t* pList, UInt8 slot, gpHal_AddressInfo_t* pAddressInfo, UInt8 chmask)
 {
-    UIntLoop i;
-    UInt8 tableSize;
-    gpHal_Address_t addr = GPHAL_DP_LONG_LIST_START;
+    gpHal_Address_t addr = pList->listStart + slot*pList->entrySize;
+    gpHal_AddressInfo_t matchInfo;
 
-    tableSize = GP_WB_READ_MACFILT_LONG_SRC_ADDRESS_TABLE_SIZE();
+    if(GP_HAL_READ_REG(addr+GPHAL_DP_OFFSET_CHANNEL_INDEX) != chmask)
+    {
+        return false;
+    }
+    GP_HAL_READ_REGS16(addr+GPHAL_DP_OFFSET_PANID, &matchInfo.panId);
+    if(matchInfo.panId != pAddressInfo->panId)
+    {
+        return false;
+    }
+    if(gpHal_AddressModeShortAddress == pAddressInfo->addressMode)
+    {
+        GP_HAL_READ_REGS16(addr+GPHAL_DP_OFFSET_ADDR, &matchInfo.address.Short);
+        return (matchInfo.address.Short == pAddressInfo->address.Short);
+    }
+    GP_HAL_READ_REGS64(addr+GPHAL_DP_OFFSET_ADDR, &matchInfo.address.Extended);
+    return (matchInfo.address.Extended.MSB == pAddressInfo->address.Extended.MSB &&
+            matchInfo.address.Extended.LSB == pAddressInfo->address.Extended.LSB);
+}
+
+static UInt8 gpHalDP_FindEntry(gpHal_AddressInfo_t* pAddressInfo, UInt8 chmask)
+{
+    const gpHalDP_List_t* pList = &gpHalDP_Lists[gpHalDP_GetListIndex(pAddressInfo)];
+    UInt8 slot = pList->pHashHead[gpHalDP_Hash(pAddressInfo)];
 
-    for(i = 0; i < GPHAL_DP_LONG_LIST_MAX; i++)
+    while(slot != GPHAL_DP_INVALID_SLOT)
     {
-        if(GP_HAL_READ_REG(addr+GPHAL_DP_OFFSET_VALID) == GPHAL_DP_ENTRY_INVALID)
+        if(gpHalDP_EntryMatches(pList, slot, pAddressInfo, chmask))
         {
-            // CHANNEL_INDEX = mask of channel slots to apply to this entry
-            UInt8 chmask = (1 << id);
-            GP_HAL_WRITE_REG(addr+GPHAL_DP_OFFSET_CHANNEL_INDEX, chmask);
-            GP_HAL_WRITE_REGS16(addr+GPHAL_DP_OFFSET_PANID, &pAddressInfo->panId);
-            GP_HAL_WRITE_REGS64(addr+GPHAL_DP_OFFSET_ADDR,  &pAddressInfo->address.Extended);
-            GP_HAL_WRITE_REG(addr+GPHAL_DP_OFFSET_VALID, GPHAL_DP_ENTRY_VALID);
-            GP_LOG_PRINTF("A:st: %i %i %x %lx%lx",0,i, id,pAddressInfo->panId, pAddressInfo->address.Extended.MSB, pAddressInfo->address.Extended.LSB);
-
-            // Update table size.
-            if (tableSize <= i)
-            {
-                tableSize = i + 1;
-            }
-
             break;
         }
-        addr += GPHAL_DP_SIZE_LONG_ENTRY;
+        slot = pList->pHashNext[slot];
+    }
+    return slot;
+}
+
+static void gpHalDP_WriteTableSize(UInt8 list, UInt8 tableSize)
+{
+    gpHalDP_TableSize[list] = tableSize;
+    if(GPHAL_DP_LIST_SHORT == list)
+    {
+        GP_WB_WRITE_MACFILT_SHORT_SRC_ADDRESS_TABLE_SIZE(tableSize);
     }
-    if (i == GPHAL_DP_LONG_LIST_MAX)
+    else
     {
-        //Table completely full
-        GP_LOG_PRINTF("AL failed",0);
+        GP_WB_WRITE_MACFILT_LONG_SRC_ADDRESS_TABLE_SIZE(tableSize);
     }
-
-    GP_WB_WRITE_MACFILT_LONG_SRC_ADDRESS_TABLE_SIZE(tableSize);
-
-    return (i == GPHAL_DP_LONG_LIST_MAX) ? gpHal_ResultBusy : gpHal_ResultSuccess;
 }
 
-static gpHal_Result_t gpHalDP_RemoveShortEntry(gpHal_AddressInfo_t* pAddressInfo, UInt8 id)
+static gpHal_Result_t gpHalDP_AddIndexedEntry(gpHal_AddressInfo_t* pAddressInfo, UInt8 id, UInt8* pSlot)
 {
+    UInt8 list = gpHalDP_GetListIndex(pAddressInfo);
+    const gpHalDP_List_t* pList = &gpHalDP_Lists[list];
+    // CHANNEL_INDEX = mask of channel slots to apply to this entry
+    // We use a fixed mapping stack 0 -> channel slot 0, stack 1 -> channel slot 1, etc.
     UInt8 chmask = (1 << id);
-    UInt8 tableSize, newTableSize;
-    Bool foundEntry = false;
+    UInt8 hash;
+    UInt8 slot;
     UIntLoop i;
     gpHal_Address_t addr;
 
-    tableSize = GP_WB_READ_MACFILT_SHORT_SRC_ADDRESS_TABLE_SIZE();
-    newTableSize = 0;
+    *pSlot = gpHalDP_FindEntry(pAddressInfo, chmask);
+    if(*pSlot != GPHAL_DP_INVALID_SLOT)
+    {
+        //Already matching - nothing to write
+        return gpHal_ResultSuccess;
+    }
 
-    addr = GPHAL_DP_SHORT_LIST_START;
-    for(i = 0; i < tableSize; i++)
+    //Lowest free slot keeps the range the radio scans as small as possible
+    slot = GPHAL_DP_INVALID_SLOT;
+    for(i = 0; i < GPHAL_DP_BITMAP_WORDS(pList->listMax); i++)
     {
-        if(GP_HAL_READ_REG(addr+GPHAL_DP_OFFSET_VALID) == GPHAL_DP_ENTRY_VALID)
+        UInt32 freeBits = ~pList->pUsed[i];
+        if(freeBits != 0)
         {
-            Bool matchEntry = false;
-            gpHal_AddressInfo_t matchInfo;
-
-            if(GP_HAL_READ_REG(addr+GPHAL_DP_OFFSET_CHANNEL_INDEX) == chmask)
+            UInt8 bit = 0;
+            while(!BIT_TST(freeBits, bit))
             {
-                GP_HAL_READ_REGS16(addr+GPHAL_DP_OFFSET_PANID, &matchInfo.panId);
-                if(matchInfo.panId == pAddressInfo->panId)
-                {
-                    GP_HAL_READ_REGS16(addr+GPHAL_DP_OFFSET_ADDR, &matchInfo.address.Short);
-                    if(matchInfo.address.Short == pAddressInfo->address.Short)
-                    {
-                        matchEntry = true;
-                        foundEntry = true;
-                    }
-                }
-            }
-
-            if (matchEntry)
-            {
-                // Remove matching entry.
-                GP_LOG_PRINTF("R:%i %u %x",0, i, id, pAddressInfo->address.Short);
-                GP_HAL_WRITE_REG(addr + GPHAL_DP_OFFSET_VALID, GPHAL_DP_ENTRY_INVALID);
-            }
-            else
-            {
-                // Keep valid entry in table.
-                newTableSize = i + 1;
+                bit++;
             }
+            slot = i*32 + bit;
+            break;
         }
-
-        addr += GPHAL_DP_SIZE_SHORT_ENTRY;
+    }
+    if(slot >= pList->listMax)
+    {
+        //Table completely full
+        GP_LOG_PRINTF("A%c failed",0, (GPHAL_DP_LIST_SHORT == list) ? 'S' : 'L');
+        return gpHal_ResultBusy;
     }
 
-    if (!foundEntry)
+    addr = pList->listStart + slot*pList->entrySize;
+    GP_HAL_WRITE_REG(addr+GPHAL_DP_OFFSET_CHANNEL_INDEX, chmask);
+    GP_HAL_WRITE_REGS16(addr+GPHAL_DP_OFFSET_PANID, &pAddressInfo->panId);
+    if(GPHAL_DP_LIST_SHORT == list)
+    {
+        GP_HAL_WRITE_REGS16(addr+GPHAL_DP_OFFSET_ADDR, &pAddressInfo->address.Short);
+        GP_LOG_PRINTF("A:%i %u %x %x",0, slot, id, pAddressInfo->panId, pAddressInfo->address.Short);
+    }
+    else
     {
-        GP_LOG_PRINTF("S Not found",0);
+        GP_HAL_WRITE_REGS64(addr+GPHAL_DP_OFFSET_ADDR, &pAddressInfo->address.Extended);
+        GP_LOG_PRINTF("A:st: %i %i %x %lx%lx",0, slot, id, pAddressInfo->panId, pAddressInfo->address.Extended.MSB, pAddressInfo->address.Extended.LSB);
     }
+    GP_HAL_WRITE_REG(addr+GPHAL_DP_OFFSET_VALID, GPHAL_DP_ENTRY_VALID);
 
-    GP_WB_WRITE_MACFILT_SHORT_SRC_ADDRESS_TABLE_SIZE(newTableSize);
+    BIT_SET(pList->pUsed[slot/32], slot%32);
+    hash = gpHalDP_Hash(pAddressInfo);
+    pList->pHashNext[slot] = pList->pHashHead[hash];
+    pList->pHashHead[hash] = slot;
 
-    return (foundEntry) ? gpHal_ResultSuccess : gpHal_ResultInvalidHandle;
+    // Update table size.
+    if(gpHalDP_TableSize[list] <= slot)
+    {
+        gpHalDP_WriteTableSize(list, slot + 1);
+    }
+
+    *pSlot = slot;
+    return gpHal_ResultSuccess;
 }
 
-static gpHal_Result_t gpHalDP_RemoveLongEntry(gpHal_AddressInfo_t* pAddressInfo, UInt8 id)
+static void gpHalDP_RemoveSlot(UInt8 list, UInt8 slot, UInt8 hash)
 {
-    UInt8 chmask = (1 << id);
-    UInt8 tableSize, newTableSize;
-    Bool foundEntry = false;
-    UIntLoop i;
-    gpHal_Address_t addr;
-
-    tableSize = GP_WB_READ_MACFILT_LONG_SRC_ADDRESS_TABLE_SIZE();
-    newTableSize = 0;
+    const gpHalDP_List_t* pList = &gpHalDP_Lists[list];
+    UInt8* pLink = &pList->pHashHead[hash];
 
-    addr = GPHAL_DP_LONG_LIST_START;
-    for(i = 0; i < tableSize; i++)
+    //Unlink from the hash chain
+    while(*pLink != slot)
     {
-        if(GP_HAL_READ_REG(addr+GPHAL_DP_OFFSET_VALID) == GPHAL_DP_ENTRY_VALID)
-        {
-            Bool matchEntry = false;
-            gpHal_AddressInfo_t matchInfo;
+        GP_ASSERT_DEV_INT(*pLink != GPHAL_DP_INVALID_SLOT);
+        pLink = &pList->pHashNext[*pLink];
+    }
+    *pLink = pList->pHashNext[slot];
 
-            if(GP_HAL_READ_REG(addr+GPHAL_DP_OFFSET_CHANNEL_INDEX) == chmask)
-            {
-                GP_HAL_READ_REGS16(addr+GPHAL_DP_OFFSET_PANID, &matchInfo.panId);
-                if(matchInfo.panId == pAddressInfo->panId)
-                {
-                    GP_HAL_READ_REGS64(addr+GPHAL_DP_OFFSET_ADDR, &matchInfo.address.Extended);
-                    if(matchInfo.address.Extended.MSB == pAddressInfo->address.Extended.MSB &&
-                       matchInfo.address.Extended.LSB == pAddressInfo->address.Extended.LSB )
-                    {
-                        matchEntry = true;
-                        foundEntry = true;
-                    }
-                }
-            }
+    GP_HAL_WRITE_REG(pList->listStart + slot*pList->entrySize + GPHAL_DP_OFFSET_VALID, GPHAL_DP_ENTRY_INVALID);
+    BIT_CLR(pList->pUsed[slot/32], slot%32);
 
-            if (matchEntry)
-            {
-                // Remove matching entry.
-                GP_LOG_PRINTF("R:%i %u %lx%lx",0, i, id, pAddressInfo->address.Extended.MSB, pAddressInfo->address.Extended.LSB);
-                GP_HAL_WRITE_REG(addr + GPHAL_DP_OFFSET_VALID, GPHAL_DP_ENTRY_INVALID);
-            }
-            else
-            {
-                // Keep valid entry in table.
-                newTableSize = i + 1;
-            }
+    // Shrink table size up to the last entry still in use.
+    if(slot + 1 == gpHalDP_TableSize[list])
+    {
+        UInt8 tableSize = slot;
+        while(tableSize > 0 && !BIT_TST(pList->pUsed[(tableSize-1)/32], (tableSize-1)%32))
+        {
+            tableSize--;
         }
-
-        addr += GPHAL_DP_SIZE_LONG_ENTRY;
+        gpHalDP_WriteTableSize(list, tableSize);
     }
+}
+
+static gpHal_Result_t gpHalDP_RemoveIndexedEntry(gpHal_AddressInfo_t* pAddressInfo, UInt8 id)
+{
+    UInt8 list = gpHalDP_GetListIndex(pAddressInfo);
+    UInt8 slot = gpHalDP_FindEntry(pAddressInfo, (1 << id));
 
-    if (!foundEntry)
+    if(slot == GPHAL_DP_INVALID_SLOT)
     {
-        GP_LOG_PRINTF("L Not found",0);
+        GP_LOG_PRINTF("%c Not found",0, (GPHAL_DP_LIST_SHORT == list) ? 'S' : 'L');
+        return gpHal_ResultInvalidHandle;
     }
 
-    GP_WB_WRITE_MACFILT_LONG_SRC_ADDRESS_TABLE_SIZE(newTableSize);
+    GP_LOG_PRINTF("R:%i %u",0, slot, id);
+    gpHalDP_RemoveSlot(list, slot, gpHalDP_Hash(pAddressInfo));
 
-    return (foundEntry) ? gpHal_ResultSuccess : gpHal_ResultInvalidHandle;
+    return gpHal_ResultSuccess;
 }
 
 /*****************************************************************************
@@ -372,69 +407,53 @@ static gpHal_Result_t gpHalDP_RemoveLongEntry(gpHal_AddressInfo_t* pAddressInfo,
 
 static void gpHalDP_InvalidatePan(UInt16 panId)
 {
+    UIntLoop list;
     UIntLoop i;
-    gpHal_Address_t addr;
-    UInt8 newTableSize;
-
-    // Remove matching entries from short address table.
 
-    newTableSize = 0;
-    addr = GPHAL_DP_SHORT_LIST_START;
-
-    for (i = 0; i < GPHAL_DP_SHORT_LIST_MAX; i++)
+    if(panId == 0xFFFF)
     {
-        UInt16 matchPanId = 0xFFFF;
-        if (panId != 0xFFFF)
+        // clear all entries and the index
+        for(list = 0; list < GPHAL_DP_NR_OF_LISTS; list++)
         {
-            // clear specific pan ID (0xFFFF means clear all entries)
-            GP_HAL_READ_REGS16(addr+GPHAL_DP_OFFSET_PANID, &matchPanId);
-        }
+            const gpHalDP_List_t* pList = &gpHalDP_Lists[list];
+            gpHal_Address_t addr = pList->listStart;
 
-        if (panId == matchPanId)
-        {
-            // delete entry
-            GP_HAL_WRITE_REG(addr+GPHAL_DP_OFFSET_VALID, GPHAL_DP_ENTRY_INVALID);
-        }
-        else if (GPHAL_DP_ENTRY_VALID == GP_HAL_READ_REG(addr+GPHAL_DP_OFFSET_VALID))
-        {
-            // keep existing entry
-            newTableSize = i + 1;
+            for(i = 0; i < pList->listMax; i++)
+            {
+                GP_HAL_WRITE_REG(addr+GPHAL_DP_OFFSET_VALID, GPHAL_DP_ENTRY_INVALID);
+                pList->pHashNext[i] = GPHAL_DP_INVALID_SLOT;
+                addr += pList->entrySize;
+            }
+            MEMSET(pList->pHashHead, GPHAL_DP_INVALID_SLOT, GPHAL_DP_HASH_SIZE);
+            MEMSET(pList->pUsed, 0, GPHAL_DP_BITMAP_WORDS(pList->listMax)*sizeof(UInt32));
+            gpHalDP_WriteTableSize(list, 0);
         }
-
-        addr += GPHAL_DP_SIZE_SHORT_ENTRY;
+        return;
     }
 
-    GP_WB_WRITE_MACFILT_SHORT_SRC_ADDRESS_TABLE_SIZE(newTableSize);
-
-    // Remove matching entries from long address table.
-
-    newTableSize = 0;
-    addr = GPHAL_DP_LONG_LIST_START;
-
-    for (i = 0; i < GPHAL_DP_LONG_LIST_MAX; i++)
+    // Remove matching entries, walking the hash chains so the hash of each entry is known
+    for(list = 0; list < GPHAL_DP_NR_OF_LISTS; list++)
     {
-        UInt16 matchPanId = 0xFFFF;
-        if (panId != 0xFFFF)
-        {
-            // clear specific pan ID (0xFFFF means clear all entries)
-            GP_HAL_READ_REGS16(addr+GPHAL_DP_OFFSET_PANID, &matchPanId);
-        }
+        const gpHalDP_List_t* pList = &gpHalDP_Lists[list];
+        UInt8 hash;
 
-        if (panId == matchPanId)
+        for(hash = 0; hash < GPHAL_DP_HASH_SIZE; hash++)
         {
-            // delete entry
-            GP_HAL_WRITE_REG(addr+GPHAL_DP_OFFSET_VALID, GPHAL_DP_ENTRY_INVALID);
-        }
-        else if (GPHAL_DP_ENTRY_VALID == GP_HAL_READ_REG(addr+GPHAL_DP_OFFSET_VALID))
-        {
-            // keep existing entry
-            newTableSize = i + 1;
-        }
+            UInt8 slot = pList->pHashHead[hash];
+            while(slot != GPHAL_DP_INVALID_SLOT)
+            {
+                UInt8 nextSlot = pList->pHashNext[slot];
+                UInt16 matchPanId;
 
-        addr += GPHAL_DP_SIZE_LONG_ENTRY;
+                GP_HAL_READ_REGS16(pList->listStart + slot*pList->entrySize + GPHAL_DP_OFFSET_PANID, &matchPanId);
+                if(matchPanId == panId)
+                {
+                    gpHalDP_RemoveSlot(list, slot, hash);
+                }
+                slot = nextSlot;
+            }
+        }
     }
-
-    GP_WB_WRITE_MACFILT_LONG_SRC_ADDRESS_TABLE_SIZE(newTableSize);
 }
 
 void gpHal_InitDataPending(void)
@@ -446,8 +465,11 @@ void gpHal_InitDataPending(void)
     COMPILE_TIME_ASSERT((GPHAL_DP_LONG_LIST_START % 2) == 0);
 
     //Base address in byte resolution
+#if !defined(HAL_DIVERSITY_MM_SIM)
+    // Host builds keep the lists in host memory, outside the chip RAM the offset is relative to
     GP_ASSERT_DEV_EXT((GPHAL_DP_SHORT_LIST_START - GP_MM_RAM_LINEAR_START) <= 0xFFFF);
     GP_ASSERT_DEV_EXT((GPHAL_DP_LONG_LIST_START - GP_MM_RAM_LINEAR_START) <= 0xFFFF);
+#endif //HAL_DIVERSITY_MM_SIM
 
     GP_WB_WRITE_MACFILT_SHORT_SRC_ADDRESS_TABLE_BASE_ADDRESS((UInt16)((GPHAL_DP_SHORT_LIST_START - GP_MM_RAM_LINEAR_START) & 0xFFFF));
     GP_WB_WRITE_MACFILT_LONG_SRC_ADDRESS_TABLE_BASE_ADDRESS((UInt16)((GPHAL_DP_LONG_LIST_START - GP_MM_RAM_LINEAR_START) & 0xFFFF));
@@ -462,7 +484,7 @@ void gpHal_InitDataPending(void)
 
 gpHal_Result_t gpHal_DpAddEntry(gpHal_AddressInfo_t* pAddressInfo, UInt8 id)
 {
-    if(id > GP_DIVERSITY_NR_OF_STACKS)
+    if(id >= GP_DIVERSITY_NR_OF_STACKS)
     {
         return gpHal_ResultInvalidParameter;
     }
@@ -473,43 +495,115 @@ gpHal_Result_t gpHal_DpAddEntry(gpHal_AddressInfo_t* pAddressInfo, UInt8 id)
         gpHalDP_StackLookup[id] = pAddressInfo->panId;
     }
 
-    if(gpHal_AddressModeShortAddress == pAddressInfo->addressMode)
+    if((gpHal_AddressModeShortAddress == pAddressInfo->addressMode) ||
+       (gpHal_AddressModeExtendedAddress == pAddressInfo->addressMode))
+    {
+        UInt8 slot;
+        return gpHalDP_AddIndexedEntry(pAddressInfo, id, &slot);
+    }
+
+    return gpHal_ResultInvalidParameter;
+}
+
+gpHal_Result_t gpHal_DpRemoveEntry(gpHal_AddressInfo_t* pAddressInfo, UInt8 id)
+{
+    if(id >= GP_DIVERSITY_NR_OF_STACKS)
     {
-        //gpHalDP_DumpTable(true);
-        return gpHalDP_AddShortEntry(pAddressInfo, id);
+        return gpHal_ResultInvalidParameter;
     }
-    else if(gpHal_AddressModeExtendedAddress == pAddressInfo->addressMode)
+
+    if((gpHal_AddressModeShortAddress == pAddressInfo->addressMode) ||
+       (gpHal_AddressModeExtendedAddress == pAddressInfo->addressMode))
     {
-        //gpHalDP_DumpTable(false);
-        return gpHalDP_AddLongEntry(pAddressInfo, id);
+        return gpHalDP_RemoveIndexedEntry(pAddressInfo, id);
     }
 
     return gpHal_ResultInvalidParameter;
 }
 
-gpHal_Result_t gpHal_DpRemoveEntry(gpHal_AddressInfo_t* pAddressInfo, UInt8 id)
+gpHal_Result_t gpHal_DpSyncEntries(gpHal_AddressInfo_t* pAddressInfo, UInt8 nrOfEntries, UInt8 id)
 {
-    if(id > GP_DIVERSITY_NR_OF_STACKS)
+    UInt32 keep[GPHAL_DP_NR_OF_LISTS][GPHAL_DP_BITMAP_WORDS(max(GPHAL_DP_SHORT_LIST_MAX, GPHAL_DP_LONG_LIST_MAX))];
+    gpHal_Result_t result = gpHal_ResultSuccess;
+    UInt8 chmask;
+    UIntLoop list;
+    UIntLoop i;
+
+    if(id >= GP_DIVERSITY_NR_OF_STACKS)
     {
         return gpHal_ResultInvalidParameter;
     }
+    chmask = (1 << id);
+    if((nrOfEntries > 0) && (gpHalDP_StackLookup[id] != pAddressInfo[0].panId))
+    {
+        gpHal_DpClearEntries(id);
+        gpHalDP_StackLookup[id] = pAddressInfo[0].panId;
+    }
 
-    if(gpHal_AddressModeShortAddress == pAddressInfo->addressMode)
+    // Mark the entries that should stay - they are never rewritten
+    MEMSET(keep, 0, sizeof(keep));
+    for(i = 0; i < nrOfEntries; i++)
+    {
+        UInt8 slot;
+
+        if((gpHal_AddressModeShortAddress != pAddressInfo[i].addressMode) &&
+           (gpHal_AddressModeExtendedAddress != pAddressInfo[i].addressMode))
+        {
+            continue;
+        }
+        slot = gpHalDP_FindEntry(&pAddressInfo[i], chmask);
+        if(slot != GPHAL_DP_INVALID_SLOT)
+        {
+            BIT_SET(keep[gpHalDP_GetListIndex(&pAddressInfo[i])][slot/32], slot%32);
+        }
+    }
+
+    // Drop entries of this stack that are no longer in the set, freeing slots first
+    for(list = 0; list < GPHAL_DP_NR_OF_LISTS; list++)
     {
-        return gpHalDP_RemoveShortEntry(pAddressInfo, id);
+        const gpHalDP_List_t* pList = &gpHalDP_Lists[list];
+        UInt8 hash;
+
+        for(hash = 0; hash < GPHAL_DP_HASH_SIZE; hash++)
+        {
+            UInt8 slot = pList->pHashHead[hash];
+            while(slot != GPHAL_DP_INVALID_SLOT)
+            {
+                UInt8 nextSlot = pList->pHashNext[slot];
+
+                if(!BIT_TST(keep[list][slot/32], slot%32) &&
+                   (GP_HAL_READ_REG(pList->listStart + slot*pList->entrySize + GPHAL_DP_OFFSET_CHANNEL_INDEX) == chmask))
+                {
+                    gpHalDP_RemoveSlot(list, slot, hash);
+                }
+                slot = nextSlot;
+            }
+        }
     }
-    else if(gpHal_AddressModeExtendedAddress == pAddressInfo->addressMode)
+
+    // Add what is missing
+    for(i = 0; i < nrOfEntries; i++)
     {
-        return gpHalDP_RemoveLongEntry(pAddressInfo, id);
+        UInt8 slot;
+
+        if((gpHal_AddressModeShortAddress != pAddressInfo[i].addressMode) &&
+           (gpHal_AddressModeExtendedAddress != pAddressInfo[i].addressMode))
+        {
+            result = gpHal_ResultInvalidParameter;
+        }
+        else if(gpHalDP_AddIndexedEntry(&pAddressInfo[i], id, &slot) != gpHal_ResultSuccess)
+        {
+            result = gpHal_ResultBusy;
+        }
     }
 
-    return gpHal_ResultInvalidParameter;
+    return result;
 }
 
 gpHal_Result_t gpHal_DpClearEntries(UInt8 id)
 {
     UInt16 stackPanId;
-    if(id > GP_DIVERSITY_NR_OF_STACKS)
+    if(id >= GP_DIVERSITY_NR_OF_STACKS)
     {
         return gpHal_ResultInvalidParameter;
     }
@@ -545,8 +639,8 @@ gpHal_Result_t gpHal_DpClearEntries(UInt8 id)
 
 Bool gpHal_DPEntriesPending(void)
 {
-    if((GP_WB_READ_MACFILT_SHORT_SRC_ADDRESS_TABLE_SIZE() != 0) ||
-       (GP_WB_READ_MACFILT_LONG_SRC_ADDRESS_TABLE_SIZE()  != 0) )
+    if((gpHalDP_TableSize[GPHAL_DP_LIST_SHORT] != 0) ||
+       (gpHalDP_TableSize[GPHAL_DP_LIST_LONG]  != 0) )
     {
         return true;
     }
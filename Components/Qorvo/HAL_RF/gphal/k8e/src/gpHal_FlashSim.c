@@ -0,0 +1,442 @@
+/*
+ * Copyright (c) 2026, Qorvo Inc
+ *
+ *  RAM backed simulation of the Kx flash, to run flash users (gpNvm, qvCHIP KVS, gpUpgrade)
+ *  in host builds. Built instead of gpHal_Flash.c.
+ *
+ * This software is owned by Qorvo Inc
+ * and protected under applicable copyright laws.
+ * It is delivered under the terms of the license
+ * and is intended and supplied for use solely and
+ * exclusively with products manufactured by
+ * Qorvo Inc.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED IN AN "AS IS"
+ * CONDITION. NO WARRANTIES, WHETHER EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING, BUT NOT
+ * LIMITED TO, IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ * QORVO INC. SHALL NOT, IN ANY
+ * CIRCUMSTANCES, BE LIABLE FOR SPECIAL,
+ * INCIDENTAL OR CONSEQUENTIAL DAMAGES,
+ * FOR ANY REASON WHATSOEVER.
+ *
+ * $Header$
+ * $Change$
+ * $DateTime$
+ *
+ */
+
+/*****************************************************************************
+ *                    Includes Definitions
+ *****************************************************************************/
+
+// #define GP_LOCAL_LOG
+
+#include "global.h"
+#include "hal.h"
+
+#include "gpHal.h"
+#include "gpLog.h"
+
+#include "gpHal_kx_Flash.h"
+
+/*****************************************************************************
+ *                    Macro Definitions
+ *****************************************************************************/
+
+#define GP_COMPONENT_ID GP_COMPONENT_ID_GPHAL
+
+/* Size of the simulated flash, starting at GP_MM_FLASH_START (and GP_MM_FLASH_ALT_START for the alternate view) */
+#ifndef GP_HAL_FLASH_SIM_SIZE
+#define GP_HAL_FLASH_SIM_SIZE (GP_MM_FLASH_LINEAR_END - GP_MM_FLASH_LINEAR_START)
+#endif //GP_HAL_FLASH_SIM_SIZE
+
+/* Simulated time to erase one sector */
+#ifndef GP_HAL_FLASH_SIM_ERASE_TIME_US
+#define GP_HAL_FLASH_SIM_ERASE_TIME_US 4000
+#endif //GP_HAL_FLASH_SIM_ERASE_TIME_US
+
+/* Simulated time to program one FLASH_WRITE_UNIT */
+#ifndef GP_HAL_FLASH_SIM_WRITE_TIME_US
+#define GP_HAL_FLASH_SIM_WRITE_TIME_US 30
+#endif //GP_HAL_FLASH_SIM_WRITE_TIME_US
+
+/* Content of erased flash - see gpHal_FlashBlankCheck */
+#define FLASH_SIM_ERASED_BYTE 0x00
+
+#define FLASH_SIM_NR_OF_SECTORS (GP_HAL_FLASH_SIM_SIZE / FLASH_SECTOR_SIZE)
+
+/*****************************************************************************
+ *                    Functional Macro Definitions
+ *****************************************************************************/
+
+#define FLASH_CHECK_WORD_ALIGNED(address)               (((address) & 0x3) == 0)
+#define FLASH_RANGE_IN_SINGLE_SECTOR(address, length)   ((length) <= (FLASH_SECTOR_SIZE - ((address) % FLASH_SECTOR_SIZE)))
+
+GP_COMPILE_TIME_VERIFY((GP_HAL_FLASH_SIM_SIZE % FLASH_SECTOR_SIZE) == 0);
+
+/*****************************************************************************
+ *                    Static Data Definitions
+ *****************************************************************************/
+
+static UInt8 gpHal_FlashSim_Data[GP_HAL_FLASH_SIM_SIZE];
+static UInt32 gpHal_FlashSim_EraseCount[FLASH_SIM_NR_OF_SECTORS];
+static gpHal_FlashSimStats_t gpHal_FlashSim_Stats;
+static Bool gpHal_FlashSim_Swapped;
+static Bool gpHal_FlashSim_Initialized;
+
+/*****************************************************************************
+ *                    Static Function Definitions
+ *****************************************************************************/
+
+static void gpHal_FlashSimCheckInit(void)
+{
+    if(!gpHal_FlashSim_Initialized)
+    {
+        gpHal_FlashSimInit();
+    }
+}
+
+/* Map an absolute address on an offset in the simulated flash, false if the range is not simulated */
+static Bool gpHal_FlashSimGetOffset(FlashPtr address, UInt32 length, UInt32* pOffset)
+{
+    UInt32 offset;
+
+    if(FLASH_CHECK_ADDRESS_RANGE(address, length))
+    {
+        offset = address - GP_MM_FLASH_START;
+        if(gpHal_FlashSim_Swapped)
+        {
+            /* remap swaps the lower and upper half of the linear view */
+            offset = (offset + (GP_HAL_FLASH_SIM_SIZE / 2)) % GP_HAL_FLASH_SIM_SIZE;
+        }
+    }
+    else if(FLASH_CHECK_ALT_ADDRESS_RANGE(address, length))
+    {
+        offset = address - GP_MM_FLASH_ALT_START;
+    }
+    else
+    {
+        return false;
+    }
+
+    if((offset >= GP_HAL_FLASH_SIM_SIZE) || (length > (GP_HAL_FLASH_SIM_SIZE - offset)))
+    {
+        return false;
+    }
+
+    *pOffset = offset;
+    return true;
+}
+
+static void gpHal_FlashSimAddBusyTime(UInt32 timeUs)
+{
+    gpHal_FlashSim_Stats.busyTimeUs += timeUs;
+    if(timeUs > gpHal_FlashSim_Stats.maxBusyTimeUs)
+    {
+        gpHal_FlashSim_Stats.maxBusyTimeUs = timeUs;
+    }
+}
+
+static gpHal_FlashError_t gpHal_FlashVerify(FlashPtr address, UInt32* data, UInt16 length_32)
+{
+    UInt32 offset;
+
+    if(!gpHal_FlashSimGetOffset(address, ((UInt32)length_32) * 4, &offset))
+    {
+        return gpHal_FlashError_OutOfRange;
+    }
+    return MEMCMP(&gpHal_FlashSim_Data[offset], data, length_32 * 4) ? gpHal_FlashError_VerifyFailure : gpHal_FlashError_Success;
+}
+
+/*****************************************************************************
+ *                    Public Function Definitions
+ *****************************************************************************/
+
+void gpHal_FlashSimInit(void)
+{
+    MEMSET(gpHal_FlashSim_Data, FLASH_SIM_ERASED_BYTE, sizeof(gpHal_FlashSim_Data));
+    MEMSET(gpHal_FlashSim_EraseCount, 0, sizeof(gpHal_FlashSim_EraseCount));
+    MEMSET(&gpHal_FlashSim_Stats, 0, sizeof(gpHal_FlashSim_Stats));
+    gpHal_FlashSim_Swapped = false;
+    gpHal_FlashSim_Initialized = true;
+}
+
+void gpHal_FlashSimGetStats(gpHal_FlashSimStats_t* pStats)
+{
+    HAL_DISABLE_GLOBAL_INT();
+    MEMCPY(pStats, &gpHal_FlashSim_Stats, sizeof(gpHal_FlashSimStats_t));
+    HAL_ENABLE_GLOBAL_INT();
+}
+
+void gpHal_FlashSimResetStats(void)
+{
+    UInt32 maxEraseCount;
+
+    HAL_DISABLE_GLOBAL_INT();
+    maxEraseCount = gpHal_FlashSim_Stats.maxEraseCount;
+    MEMSET(&gpHal_FlashSim_Stats, 0, sizeof(gpHal_FlashSim_Stats));
+    /* derived from the erase counts, which are kept */
+    gpHal_FlashSim_Stats.maxEraseCount = maxEraseCount;
+    HAL_ENABLE_GLOBAL_INT();
+}
+
+UInt32 gpHal_FlashSimGetEraseCount(FlashPtr sectorAddress)
+{
+    UInt32 offset;
+
+    if(!gpHal_FlashSimGetOffset(sectorAddress, 1, &offset))
+    {
+        return 0;
+    }
+    return gpHal_FlashSim_EraseCount[offset / FLASH_SECTOR_SIZE];
+}
+
+gpHal_FlashError_t gpHal_FlashBlankCheck(FlashPtr address, UInt16 numUInt32)
+{
+    UInt32 offset;
+    UInt32 i;
+
+    gpHal_FlashSimCheckInit();
+
+    if (!FLASH_CHECK_WORD_ALIGNED(address))
+    {
+        GP_LOG_PRINTF("FlashBlankCheck unaligned address 0x%lx", 0, (unsigned long)address);
+        return gpHal_FlashError_UnalignedAddress;
+    }
+
+    if(!gpHal_FlashSimGetOffset(address, ((UInt32)numUInt32) * 4, &offset))
+    {
+        return gpHal_FlashError_OutOfRange;
+    }
+
+    for (i = 0; i < ((UInt32)numUInt32) * 4; ++i)
+    {
+        if (gpHal_FlashSim_Data[offset + i] != FLASH_SIM_ERASED_BYTE)
+        {
+            GP_LOG_PRINTF("Failing erasure address %lx",0,(unsigned long)(address + i));
+            return gpHal_FlashError_BlankFailure;
+        }
+    }
+
+    return gpHal_FlashError_Success;
+}
+
+gpHal_FlashError_t gpHal_FlashRead(FlashPtr address, UInt16 numBytes, UInt8* data)
+{
+    UInt32 offset;
+
+    gpHal_FlashSimCheckInit();
+
+    if(!gpHal_FlashSimGetOffset(address, numBytes, &offset))
+    {
+        GP_LOG_PRINTF("FlashRead address out of range 0x%lx", 0, (unsigned long)address);
+        return gpHal_FlashError_OutOfRange;
+    }
+
+    HAL_DISABLE_GLOBAL_INT();
+    MEMCPY(data, &gpHal_FlashSim_Data[offset], numBytes);
+    gpHal_FlashSim_Stats.reads++;
+    gpHal_FlashSim_Stats.bytesRead += numBytes;
+    HAL_ENABLE_GLOBAL_INT();
+
+    return gpHal_FlashError_Success;
+}
+
+gpHal_FlashError_t gpHal_FlashEraseSectorNoVerify(FlashPtr sectorAddress)
+{
+    UInt32 offset;
+    UInt32 sector;
+
+    gpHal_FlashSimCheckInit();
+
+#if defined(GP_DIVERSITY_GPHAL_FLASH_USE_APP_ADDRESS_CHECK)
+    if(gpHal_cbFlashAddressCheck(sectorAddress) != gpHal_FlashError_Success)
+    {
+        return gpHal_FlashError_Locked;
+    }
+#endif
+
+    if(!gpHal_FlashSimGetOffset(sectorAddress, FLASH_SECTOR_SIZE, &offset))
+    {
+        GP_LOG_PRINTF("FlashErase addres out of range 0x%lx", 0, (unsigned long)sectorAddress);
+        return gpHal_FlashError_OutOfRange;
+    }
+
+    if (sectorAddress % FLASH_SECTOR_SIZE != 0)
+    {
+        GP_LOG_PRINTF("FlashErase unaligned addres 0x%lx", 0, (unsigned long)sectorAddress);
+        return gpHal_FlashError_UnalignedAddress;
+    }
+
+    HAL_DISABLE_GLOBAL_INT();
+
+    MEMSET(&gpHal_FlashSim_Data[offset], FLASH_SIM_ERASED_BYTE, FLASH_SECTOR_SIZE);
+
+    sector = offset / FLASH_SECTOR_SIZE;
+    gpHal_FlashSim_EraseCount[sector]++;
+    if(gpHal_FlashSim_EraseCount[sector] > gpHal_FlashSim_Stats.maxEraseCount)
+    {
+        gpHal_FlashSim_Stats.maxEraseCount = gpHal_FlashSim_EraseCount[sector];
+    }
+    gpHal_FlashSim_Stats.erases++;
+    gpHal_FlashSimAddBusyTime(GP_HAL_FLASH_SIM_ERASE_TIME_US);
+
+    HAL_ENABLE_GLOBAL_INT();
+
+    return gpHal_FlashError_Success;
+}
+
+gpHal_FlashError_t gpHal_FlashEraseSector(FlashPtr sectorAddress)
+{
+    gpHal_FlashError_t ret = gpHal_FlashEraseSectorNoVerify(sectorAddress);
+    if (ret == gpHal_FlashError_Success)
+    {
+        ret = gpHal_FlashBlankCheck(sectorAddress, FLASH_SECTOR_SIZE / 4);
+    }
+    return ret;
+}
+
+gpHal_FlashError_t gpHal_FlashWriteNoVerify(FlashPtr address, UInt16 numWord, UInt32 *data)
+{
+    UInt32 offset;
+    UInt32 i;
+    UInt32 unit;
+    const UInt8* pData = (const UInt8*)data;
+
+    gpHal_FlashSimCheckInit();
+
+#if defined(GP_DIVERSITY_GPHAL_FLASH_USE_APP_ADDRESS_CHECK)
+    if(gpHal_cbFlashAddressCheck(address) != gpHal_FlashError_Success)
+    {
+        return gpHal_FlashError_Locked;
+    }
+#endif
+
+    if (!gpHal_FlashSimGetOffset(address, ((UInt32)numWord) * 4, &offset))
+    {
+        GP_LOG_PRINTF("FlashWrite addres out of range 0x%lx", 0, (unsigned long)address);
+        return gpHal_FlashError_OutOfRange;
+    }
+
+    if (address % FLASH_WRITE_UNIT != 0)
+    {
+        GP_LOG_PRINTF("FlashWrite unaligned address 0x%lx", 0, (unsigned long)address);
+        return gpHal_FlashError_UnalignedAddress;
+    }
+
+    if (numWord % (FLASH_WRITE_UNIT / 4) != 0)
+    {
+        GP_LOG_PRINTF("FlashWrite unaligned length 0x%x", 0, numWord);
+        return gpHal_FlashError_UnalignedAddress;
+    }
+
+    if (numWord > (FLASH_PAGE_SIZE - (address % FLASH_PAGE_SIZE)) / 4)
+    {
+        GP_LOG_PRINTF("FlashWrite crossing page boundary 0x%lx 0x%x", 0, (unsigned long)address, numWord);
+        return gpHal_FlashError_UnalignedAddress;
+    }
+
+    HAL_DISABLE_GLOBAL_INT();
+
+    for (unit = 0; unit < ((UInt32)numWord) * 4; unit += FLASH_WRITE_UNIT)
+    {
+        for (i = 0; i < FLASH_WRITE_UNIT; i++)
+        {
+            if (gpHal_FlashSim_Data[offset + unit + i] != FLASH_SIM_ERASED_BYTE)
+            {
+                /* programming only sets bits - the result no longer matches the data written */
+                gpHal_FlashSim_Stats.rewriteViolations++;
+                GP_LOG_PRINTF("FlashWrite unit not blank 0x%lx", 0, (unsigned long)(address + unit));
+                break;
+            }
+        }
+        for (i = 0; i < FLASH_WRITE_UNIT; i++)
+        {
+            gpHal_FlashSim_Data[offset + unit + i] |= pData[unit + i];
+        }
+    }
+
+    gpHal_FlashSim_Stats.writes++;
+    gpHal_FlashSim_Stats.bytesWritten += ((UInt32)numWord) * 4;
+    gpHal_FlashSimAddBusyTime((((UInt32)numWord) * 4 / FLASH_WRITE_UNIT) * GP_HAL_FLASH_SIM_WRITE_TIME_US);
+
+    HAL_ENABLE_GLOBAL_INT();
+
+    return gpHal_FlashError_Success;
+}
+
+gpHal_FlashError_t gpHal_FlashWrite(FlashPtr address, UInt16 numWord, UInt32* data)
+{
+    gpHal_FlashError_t ret = gpHal_FlashWriteNoVerify(address, numWord, data);
+    if (ret == gpHal_FlashError_Success)
+    {
+        ret = gpHal_FlashVerify(address, data, numWord);
+    }
+    return ret;
+}
+
+gpHal_FlashError_t gpHal_FlashProgramSector(FlashPtr address, UInt16 length, UInt8* data)
+{
+    gpHal_FlashError_t result;
+    FlashPtr           sectorAligned = FLASH_ALIGN_SECTOR(address);
+    UInt32             buffer[FLASH_SECTOR_SIZE / sizeof(UInt32)];
+    UIntLoop           page;
+
+    if(!FLASH_RANGE_IN_SINGLE_SECTOR(address, length))
+    {
+        return gpHal_FlashError_OutOfRange;
+    }
+
+    /* read complete sector*/
+    result = gpHal_FlashRead(sectorAligned, FLASH_SECTOR_SIZE, (UInt8*)buffer);
+
+    if(result != gpHal_FlashError_Success)
+    {
+        return result;
+    }
+
+    /* modify */
+    MEMCPY(((UInt8*)buffer) + (address - sectorAligned), data, length);
+    /* erase sector */
+    result = gpHal_FlashEraseSectorNoVerify(sectorAligned);
+
+    /* write back page by page */
+    for(page = 0; (page < FLASH_PAGES_PER_SECTOR) && (result == gpHal_FlashError_Success); page++)
+    {
+        result = gpHal_FlashWrite(sectorAligned + page * FLASH_PAGE_SIZE, FLASH_PAGE_SIZE/4,
+                                  &buffer[page * (FLASH_PAGE_SIZE/4)]);
+    }
+
+    return result;
+}
+
+#if defined(GP_DIVERSITY_GPHAL_INTERN)
+void gpHal_FlashWriteLockFineCoarse(UInt32 block256k_0, UInt32 block256k_1, UInt32 block256k_2, UInt32 block256k_3)
+{
+    /* lock bits are not simulated */
+    NOT_USED(block256k_0);
+    NOT_USED(block256k_1);
+    NOT_USED(block256k_2);
+    NOT_USED(block256k_3);
+}
+#endif
+
+UInt32 gpHal_FlashRemap_GetSwapLocationOffset(void)
+{
+    /* Flash is swapped at half of the Flash */
+    return GP_HAL_FLASH_SIM_SIZE / 2;
+}
+
+void gpHal_FlashRemap_SwapUpperAndLowerFlashAreas(void)
+{
+    gpHal_FlashSim_Swapped = true;
+}
+
+Bool gpHal_FlashRemap_IsFlashSwapped(void)
+{
+    return gpHal_FlashSim_Swapped;
+}
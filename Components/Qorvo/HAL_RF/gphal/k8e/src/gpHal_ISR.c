@@ -52,6 +52,7 @@
 #endif //GP_COMP_TXMONITOR
 
 #include "gpSched.h"
+#include "gpUtils.h"
 
 #if defined(GP_DIVERSITY_FREERTOS) && defined(GP_COMP_GPHAL_BLE)
 #include "hal_BleFreeRTOS.h"
@@ -316,6 +317,7 @@ void gpHal_RCIInterrupt(void)
 #endif //GP_COMP_GPHAL_MAC
 
     UInt16 rciPending;
+    GP_UTILS_PROF_SCOPE(gpUtils_ProfProbeRciInterrupt);
 
     GP_STAT_SAMPLE_TIME();
 
@@ -436,6 +438,8 @@ void gpHal_RCIInterrupt(void)
 
 void gpHal_PHYInterrupt(void)
 {
+    GP_UTILS_PROF_SCOPE(gpUtils_ProfProbePhyInterrupt);
+
     GP_LOG_PRINTF("PHY INT",0);
 
     gpHal_FllHandleInterrupts();
@@ -450,6 +454,8 @@ void gpHal_PHYInterrupt(void)
 
 void gpHal_ESInterrupt(void)
 {
+    GP_UTILS_PROF_SCOPE(gpUtils_ProfProbeEsInterrupt);
+
 #if defined(GP_COMP_GPHAL_ES_EXT_EVENT)
 
 #ifdef GP_COMP_GPHAL_ES_EXT_EVENT
@@ -122,7 +122,10 @@ static UInt8 gpHal_activeRawVsIeIndex;
 
 #if defined(GP_HAL_MAC_SW_CSMA_CA)
 // Check if current state is the first entry in the queue
-#define GP_HAL_MAC_CSMA_FIRST_ENTRY(pCsmaState) (&gpHalMac_CSMA_CA_state[0] == (pCsmaState))
+#define GP_HAL_MAC_CSMA_FIRST_ENTRY(pCsmaState) (&gpHalMac_CSMA_CA_state[gpHalMac_CSMA_CA_head] == (pCsmaState))
+// Next slot in the state ring
+#define GP_HAL_MAC_CSMA_NEXT_SLOT(slot)         (((slot) + 1 == GPHAL_QTA_MAX_SIZE) ? 0 : ((slot) + 1))
+#define GP_HAL_MAC_CSMA_INVALID_SLOT            0xFF
 #endif //GP_HAL_MAC_SW_CSMA_CA
 
 /*****************************************************************************
@@ -215,7 +218,12 @@ gpHal_TxPower_t gpHal_LastUsedTxPower;
 static UInt8 gpHalMac_PbmHandleCalibration = 0xFF;
 
 #if defined(GP_HAL_MAC_SW_CSMA_CA)
+// Ring of states in transmit order - the head holds the active entry, slots never move while queued
 static gpHalMac_CSMA_CA_state_t gpHalMac_CSMA_CA_state[GPHAL_QTA_MAX_SIZE];
+static UInt8 gpHalMac_CSMA_CA_head;
+static UInt8 gpHalMac_CSMA_CA_count;
+// Slot of the state per PBM entry, for lookups from the data confirm interrupt
+static UInt8 gpHalMac_CSMA_CA_slotLookup[GP_MM_RAM_PBM_OPTS_NR_OF];
 #endif // GP_HAL_MAC_SW_CSMA_CA
 
 gpHal_RxModeConfig_t    gpHal_ConfiguredReceiverMode;
@@ -235,6 +243,7 @@ static void gpHalMac_InitMacAddress(void);
 #if defined(GP_HAL_MAC_SW_CSMA_CA)
 static void gpHalMac_CCARetry(void *pData);
 static void gpHalMac_Trigger_CSMA_CA_State(void);
+static void gpHalMac_Queue_CSMA_CA_State(gpHalMac_CSMA_CA_state_t* pCsmaState);
 #endif // GP_HAL_MAC_SW_CSMA_CA
 
 /*****************************************************************************
@@ -732,6 +741,9 @@ void gpHal_InitMAC(void)
                 gpHalMac_CSMA_CA_state[idx].pbmHandle = GP_PBM_INVALID_HANDLE;
         }
     }
+    MEMSET(gpHalMac_CSMA_CA_slotLookup, GP_HAL_MAC_CSMA_INVALID_SLOT, sizeof(gpHalMac_CSMA_CA_slotLookup));
+    gpHalMac_CSMA_CA_head = 0;
+    gpHalMac_CSMA_CA_count = 0;
 #endif // GP_HAL_MAC_SW_CSMA_CA
 
 
@@ -1072,6 +1084,7 @@ gpHal_Result_t gpHal_DataRequest(gpHal_DataReqOptions_t *dataReqOptions, gpPad_H
         pCsmaState->maxBe = padAttributes.maxBE;
         pCsmaState->maxCsmaBackoffs = padAttributes.maxCsmaBackoffs;
         pCsmaState->backOffCount = 0;
+        pCsmaState->ccaRetries = 0;
 
         /* If !ackRequest already handled in SW in another way (see gpHal_DataConfirmInterrupt)*/
         if (ackRequest)
@@ -1088,6 +1101,8 @@ gpHal_Result_t gpHal_DataRequest(gpHal_DataReqOptions_t *dataReqOptions, gpPad_H
             pCsmaState->initialMaxFrameRetries = 0;
         }
 
+        gpHalMac_Queue_CSMA_CA_State(pCsmaState);
+
         /* Only trigger HW queueing on first CSMA CA state entry */
         if(GP_HAL_MAC_CSMA_FIRST_ENTRY(pCsmaState))
         {
@@ -1692,6 +1707,8 @@ void gpHalMac_Do_CCAFailRetry(gpHalMac_CSMA_CA_state_t *pCSMA_CA_State)
 {
     //From CSMA-CA algorithm, first increase backoff counter, then calculate the delay
     pCSMA_CA_State->backOffCount++;
+    pCSMA_CA_State->ccaRetries++;
+    gpHal_StatisticsMacCounters.swCcaRetries++;
 
     //calculate the backoff delay and trigger retry
     gpHalMac_DoBackoffScheduleCalculation(pCSMA_CA_State);
@@ -1721,45 +1738,42 @@ void gpHalMac_Do_NoAckRetry(gpHalMac_CSMA_CA_state_t *pCSMA_CA_State)
     }
 
     pCSMA_CA_State->remainingFrameRetries--;
+    gpHal_StatisticsMacCounters.swNoAckRetries++;
 }
 
 //-------------------------------------------------------------------------------------------------------
 /* State queue administration */
 //-------------------------------------------------------------------------------------------------------
 
-static void gpHalMac_ShiftQueue_CSMA_CA_State(void)
+static void gpHalMac_Queue_CSMA_CA_State(gpHalMac_CSMA_CA_state_t* pCsmaState)
 {
-    UIntLoop i;
-    //Shift to front and invalidate the end
-    for(i = 0; i < GPHAL_QTA_MAX_SIZE-1; i++)
-    {
-        if(gpHalMac_CSMA_CA_state[i+1].pbmHandle == GP_PBM_INVALID_HANDLE)
-        {
-            //No need to shift further
-            break;
-        }
-        MEMCPY(&gpHalMac_CSMA_CA_state[i], &gpHalMac_CSMA_CA_state[i+1], sizeof(gpHalMac_CSMA_CA_state_t));
-    }
-    //Invalidate last entry - if none were shifted first entry is invalidated
-    gpHalMac_CSMA_CA_state[i].pbmHandle = GP_PBM_INVALID_HANDLE;
+    //Entry handed out by gpHalMac_Get_CSMA_CA_State(GP_PBM_INVALID_HANDLE) is always the tail of the ring
+    UInt8 slot = (UInt8)(pCsmaState - gpHalMac_CSMA_CA_state);
+
+    GP_ASSERT_DEV_INT(gpHalMac_CSMA_CA_count < GPHAL_QTA_MAX_SIZE);
+    GP_ASSERT_DEV_INT(GP_HAL_CHECK_PBM_VALID(pCsmaState->pbmHandle));
+
+    gpHalMac_CSMA_CA_slotLookup[pCsmaState->pbmHandle] = slot;
+    gpHalMac_CSMA_CA_count++;
 }
 
 static void gpHalMac_Trigger_CSMA_CA_State(void)
 {
     //Head of queue alyways holds active entry
-    if (gpHalMac_CSMA_CA_state[0].pbmHandle != GP_PBM_INVALID_HANDLE)
+    if (gpHalMac_CSMA_CA_count != 0)
     {
+        gpHalMac_CSMA_CA_state_t* pHead = &gpHalMac_CSMA_CA_state[gpHalMac_CSMA_CA_head];
         gpHal_Address_t pbmOptAddress;
-        pbmOptAddress = GP_HAL_PBM_ENTRY2ADDR_OPT_BASE(gpHalMac_CSMA_CA_state[0].pbmHandle);
+        pbmOptAddress = GP_HAL_PBM_ENTRY2ADDR_OPT_BASE(pHead->pbmHandle);
 
         //if first backoff is zero or if csma is not enabled for this packet
         if(GP_WB_READ_PBM_FORMAT_T_GP_FIRST_BOFF_IS_0(pbmOptAddress) || (!GP_WB_READ_PBM_FORMAT_T_GP_CSMA_CA_ENABLE(pbmOptAddress)))
         {
-            gpHal_DataRequest_base(gpHalMac_CSMA_CA_state[0].pbmHandle);
+            gpHal_DataRequest_base(pHead->pbmHandle);
         }
         else
         {
-            gpHalMac_DoBackoffScheduleCalculation(&gpHalMac_CSMA_CA_state[0]);
+            gpHalMac_DoBackoffScheduleCalculation(pHead);
         }
     }
 }
@@ -1767,24 +1781,57 @@ static void gpHalMac_Trigger_CSMA_CA_State(void)
 /** Get new state entry - returns a pointer to a free space when called with GP_PBM_INVALID_HANDLE */
 gpHalMac_CSMA_CA_state_t* gpHalMac_Get_CSMA_CA_State(UInt8 pbmHandle)
 {
-    UIntLoop idx;
-    for (idx=0; idx<GPHAL_QTA_MAX_SIZE; ++idx)
+    UInt8 slot;
+
+    if (pbmHandle == GP_PBM_INVALID_HANDLE)
     {
-        if (gpHalMac_CSMA_CA_state[idx].pbmHandle == pbmHandle)
+        if (gpHalMac_CSMA_CA_count >= GPHAL_QTA_MAX_SIZE)
+        {
+            return NULL;
+        }
+        slot = gpHalMac_CSMA_CA_head + gpHalMac_CSMA_CA_count;
+        if (slot >= GPHAL_QTA_MAX_SIZE)
         {
-            return &gpHalMac_CSMA_CA_state[idx];
+            slot -= GPHAL_QTA_MAX_SIZE;
         }
+        return &gpHalMac_CSMA_CA_state[slot];
+    }
+
+    if (!GP_HAL_CHECK_PBM_VALID(pbmHandle))
+    {
+        return NULL;
     }
-    return NULL;
+    slot = gpHalMac_CSMA_CA_slotLookup[pbmHandle];
+    return (slot == GP_HAL_MAC_CSMA_INVALID_SLOT) ? NULL : &gpHalMac_CSMA_CA_state[slot];
 }
 
 void gpHalMac_Free_CSMA_CA_State(UInt8 pbmHandle)
 {
+    gpHalMac_CSMA_CA_state_t* pHead = &gpHalMac_CSMA_CA_state[gpHalMac_CSMA_CA_head];
+    UInt8 noAckRetries;
+
     //Only active entry should be freed
-    GP_ASSERT_DEV_EXT(pbmHandle == gpHalMac_CSMA_CA_state[0].pbmHandle);
+    GP_ASSERT_DEV_EXT(gpHalMac_CSMA_CA_count != 0);
+    GP_ASSERT_DEV_EXT(pbmHandle == pHead->pbmHandle);
+
+    //Per frame retry trace
+    noAckRetries = pHead->initialMaxFrameRetries - pHead->remainingFrameRetries;
+    GP_LOG_PRINTF("csma pbm:%u cca:%u noack:%u",0, pbmHandle, pHead->ccaRetries, noAckRetries);
+    if (pHead->ccaRetries > gpHal_StatisticsMacCounters.maxCcaRetriesPerFrame)
+    {
+        gpHal_StatisticsMacCounters.maxCcaRetriesPerFrame = pHead->ccaRetries;
+    }
+    if (noAckRetries > gpHal_StatisticsMacCounters.maxNoAckRetriesPerFrame)
+    {
+        gpHal_StatisticsMacCounters.maxNoAckRetriesPerFrame = noAckRetries;
+    }
+
+    //Pop out head entry
+    gpHalMac_CSMA_CA_slotLookup[pbmHandle] = GP_HAL_MAC_CSMA_INVALID_SLOT;
+    pHead->pbmHandle = GP_PBM_INVALID_HANDLE;
+    gpHalMac_CSMA_CA_head = GP_HAL_MAC_CSMA_NEXT_SLOT(gpHalMac_CSMA_CA_head);
+    gpHalMac_CSMA_CA_count--;
 
-    //Pop out entry 0 - shift up rest of queue
-    gpHalMac_ShiftQueue_CSMA_CA_State();
     //Re trigger queue if needed
     gpHalMac_Trigger_CSMA_CA_State();
 }
@@ -319,11 +319,13 @@ gpHal_PbmDescriptor_t* gpHal_PbmDescriptorAllocate(UInt8 pbmHandle, Bool txPbm,
     UIntLoop i;
     gpHal_PbmDescriptor_t* pDesc = NULL;
 
+    // Descriptors and memory are claimed with atomic operations, TX PBMs can be claimed from interrupt context
     for(i = 0; i < number_of_elements(gpHal_PbmDescriptors); i++)
     {
-        if(gpHal_PbmDescriptors[i].pbmHandle == GP_PBM_INVALID_HANDLE)
+        UInt8 freeHandle = GP_PBM_INVALID_HANDLE;
+
+        if(__atomic_compare_exchange_n(&gpHal_PbmDescriptors[i].pbmHandle, &freeHandle, pbmHandle, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
         {
-            gpHal_PbmDescriptors[i].pbmHandle = pbmHandle;
             gpHal_PbmDescriptors[i].pbmLength = pbmLength;
             gpHal_PbmDescriptors[i].txPbm = txPbm;
             pDesc = &gpHal_PbmDescriptors[i];
@@ -341,7 +343,7 @@ gpHal_PbmDescriptor_t* gpHal_PbmDescriptorAllocate(UInt8 pbmHandle, Bool txPbm,
         {
             GP_LOG_SYSTEM_PRINTF("Unable to claim pbm memory for handle: %i (len: %i)",0,pbmHandle,pbmLength);
             // Unable to configure the memory, free descriptor again
-            gpHal_PbmDescriptors[i].pbmHandle = GP_PBM_INVALID_HANDLE;
+            __atomic_store_n(&gpHal_PbmDescriptors[i].pbmHandle, GP_PBM_INVALID_HANDLE, __ATOMIC_RELEASE);
             return NULL;
         }
 
@@ -391,9 +393,10 @@ void gpHal_PbmDescriptorMallocMemory(gpHal_PbmDescriptor_t* pDesc)
 
     for(i = start; i <= end; i++)
     {
-        if(BIT_TST(gpHal_PbmAdmin.memoryAllocated, i) == 0)
+        UInt32 memoryBit = (UInt32)1 << i;
+
+        if((__atomic_fetch_or(&gpHal_PbmAdmin.memoryAllocated, memoryBit, __ATOMIC_ACQUIRE) & memoryBit) == 0)
         {
-            BIT_SET(gpHal_PbmAdmin.memoryAllocated, i);
             //GP_LOG_SYSTEM_PRINTF("accum = %x en tot = %x",0,accumulatedSize,(i-start)*(pDesc->pbmLength));
             pDesc->pData = &gpHal_PbmAdmin.memory[accumulatedSize + (i-start)*(pDesc->pbmLength)];
             //GP_LOG_SYSTEM_PRINTF("start mem = %lx, dataP = %lx",0,gpHal_PbmAdmin.memory, pDesc->pData);
@@ -417,8 +420,8 @@ void gpHal_PbmDescriptorFreeMemory(gpHal_PbmDescriptor_t* pDesc)
     {
         if(pDesc->pData == &gpHal_PbmAdmin.memory[accumulatedSize + (i-start)*pDesc->pbmLength])
         {
-            BIT_CLR(gpHal_PbmAdmin.memoryAllocated, i);
             pDesc->pData = NULL;
+            __atomic_fetch_and(&gpHal_PbmAdmin.memoryAllocated, ~((UInt32)1 << i), __ATOMIC_RELEASE);
             break;
         }
     }
@@ -438,7 +441,7 @@ void gpHal_PbmDescriptorFree(gpHal_PbmDescriptor_t* pDesc)
     // However, if you dump the pbm through the regmap interface, the result will also be different.
 
     GP_HAL_WRITE_PBM_START_TO_MM_ENTRY(pDesc->pbmHandle, 0);
-    pDesc->pbmHandle = GP_PBM_INVALID_HANDLE;
+    __atomic_store_n(&pDesc->pbmHandle, GP_PBM_INVALID_HANDLE, __ATOMIC_RELEASE);
 }
 
 void gpHal_PbmSetDefaultOptions(UInt8 pbmHandle)
@@ -48,6 +48,9 @@
  *                    Macro Definitions
  *****************************************************************************/
 
+/** @brief Stream handle returned when no value could be opened */
+#define QVCHIP_KVS_STREAM_HANDLE_INVALID 0xFF
+
 /*****************************************************************************
  *                    Functional Macro Definitions
  *****************************************************************************/
@@ -56,6 +59,19 @@
  *                    Type Definitions
  *****************************************************************************/
 
+/** @brief Handle of a value opened for streaming reads */
+typedef uint8_t qvCHIP_KvsStreamHandle_t;
+
+/** @brief Counters of the KVS key index (QVCHIP_DIVERSITY_KVS_INDEX_CACHE).
+ *  Hit ratio = hits / (hits + misses).
+*/
+typedef struct {
+    uint32_t hits;           // Key found in the index - no key hashing needed
+    uint32_t misses;         // Key not (or no longer) indexed
+    uint32_t evictions;      // Index entries reused for another key
+    uint32_t lookupsSkipped; // NVM lookup builds avoided by a known fragment count
+} qvCHIP_KvsIndexStats_t;
+
 /*****************************************************************************
  *                    Public Function Prototypes
  *****************************************************************************/
@@ -81,6 +97,7 @@ qvStatus_t qvCHIP_KvsInit(void);
  *  @return                 QV_STATUS_NO_ERROR - No error
  *                          QV_STATUS_INVALID_ARGUMENT - one of the arguments is not valid
  *                          QV_STATUS_INVALID_DATA - the data could not be stored
+ *                          QV_STATUS_WRONG_STATE - the key is part of a committed batch that still fails to apply
 */
 qvStatus_t qvCHIP_KvsPut(const char * key, const void * value, size_t valueSize);
 
@@ -107,6 +124,7 @@ qvStatus_t qvCHIP_KvsGet(const char * key, void * value, size_t valueSize, size_
  *  @return                 QV_STATUS_NO_ERROR - no error
  *                          QV_STATUS_INVALID_ARGUMENT - pointer to key is not valid
  *                          QV_STATUS_INVALID_DATA - the data could not be deleted
+ *                          QV_STATUS_WRONG_STATE - the key is part of a committed batch that still fails to apply
 */
 qvStatus_t qvCHIP_KvsDelete(const char * key);
 
@@ -117,6 +135,114 @@ qvStatus_t qvCHIP_KvsDelete(const char * key);
 */
 qvStatus_t qvCHIP_KvsErasePartition(void);
 
+/** @brief Retrieve the counters of the KVS key index.
+ *
+ *  @param pStats           Pointer to the structure to fill in.
+ *  @return                 QV_STATUS_NO_ERROR - no error
+ *                          QV_STATUS_INVALID_ARGUMENT - pointer to pStats is not valid
+ *                          QV_STATUS_NOT_IMPLEMENTED - the key index is not enabled in this build
+*/
+qvStatus_t qvCHIP_KvsGetIndexStats(qvCHIP_KvsIndexStats_t* pStats);
+
+/** @brief Open the value stored for a key for chunked reads.
+ *
+ *  Reads through the stream only access the NVM fragments holding the requested range.
+ *  The stream becomes invalid when the value is changed or deleted.
+ *
+ *  @param key              Identifier for NVM data to read.
+ *  @param pHandle          Returns the stream handle, QVCHIP_KVS_STREAM_HANDLE_INVALID on failure.
+ *  @param pValueSize       Returns the total size of the value. Can be NULL.
+ *  @return                 QV_STATUS_NO_ERROR - no error
+ *                          QV_STATUS_INVALID_ARGUMENT - one of the arguments is not valid
+ *                          QV_STATUS_INVALID_DATA - no valid data stored for the key
+ *                          QV_STATUS_WRONG_STATE - all streams are in use
+*/
+qvStatus_t qvCHIP_KvsStreamOpen(const char * key, qvCHIP_KvsStreamHandle_t * pHandle, size_t * pValueSize);
+
+/** @brief Read part of a value opened with qvCHIP_KvsStreamOpen.
+ *
+ *  @param streamHandle     Handle returned by qvCHIP_KvsStreamOpen.
+ *  @param offsetBytes      Offset in the value to start reading from.
+ *  @param buffer           Pointer to the RAM location to read data to.
+ *  @param bufferSize       Maximum number of bytes to read.
+ *  @param readBytesSize    Actual number of bytes read - less than bufferSize only at the end of the value.
+ *  @return                 QV_STATUS_NO_ERROR - no error
+ *                          QV_STATUS_INVALID_ARGUMENT - one of the arguments is not valid
+ *                          QV_STATUS_INVALID_DATA - the data retrieved is not valid
+ *                          QV_STATUS_WRONG_STATE - stream not open or value changed since opening
+*/
+qvStatus_t qvCHIP_KvsStreamRead(qvCHIP_KvsStreamHandle_t streamHandle, size_t offsetBytes, void * buffer, size_t bufferSize,
+                                size_t * readBytesSize);
+
+/** @brief Close a stream opened with qvCHIP_KvsStreamOpen.
+ *
+ *  @param streamHandle     Handle returned by qvCHIP_KvsStreamOpen.
+ *  @return                 QV_STATUS_NO_ERROR - no error
+ *                          QV_STATUS_INVALID_ARGUMENT - handle is not valid
+*/
+qvStatus_t qvCHIP_KvsStreamClose(qvCHIP_KvsStreamHandle_t streamHandle);
+
+/** @brief Start a batch of puts and deletes applied atomically by qvCHIP_KvsBatchCommit.
+ *
+ *  Only one batch can be open at a time. Values are staged in NVM when added to the batch,
+ *  the caller's buffers are not referenced afterwards.
+ *
+ *  @return                 QV_STATUS_NO_ERROR - no error
+ *                          QV_STATUS_WRONG_STATE - a batch is already open, or a committed batch still fails to apply
+ *                          QV_STATUS_NOT_IMPLEMENTED - batches are not enabled in this build
+*/
+qvStatus_t qvCHIP_KvsBatchBegin(void);
+
+/** @brief Add storing a value to the open batch.
+ *
+ *  A later put or delete of the same key in the batch replaces this one.
+ *  When staging the value fails, the key keeps the operation staged for it before. If that was a
+ *  put, its staged value is lost and qvCHIP_KvsBatchCommit fails without changing any key.
+ *
+ *  @param key              Identifier for NVM data to store.
+ *  @param value            Pointer to the RAM location of the data.
+ *  @param valueSize        Size of the data - must not be 0.
+ *  @return                 QV_STATUS_NO_ERROR - no error
+ *                          QV_STATUS_INVALID_ARGUMENT - one of the arguments is not valid
+ *                          QV_STATUS_WRONG_STATE - no batch is open
+ *                          QV_STATUS_BUFFER_TOO_SMALL - the batch holds QVCHIP_KVS_BATCH_MAX_OPS keys
+ *                          QV_STATUS_INVALID_DATA - staging the value in NVM failed
+*/
+qvStatus_t qvCHIP_KvsBatchPut(const char * key, const void * value, size_t valueSize);
+
+/** @brief Add deleting a key to the open batch.
+ *
+ *  @param key              Identifier for NVM data to delete.
+ *  @return                 QV_STATUS_NO_ERROR - no error
+ *                          QV_STATUS_INVALID_ARGUMENT - key is not valid
+ *                          QV_STATUS_WRONG_STATE - no batch is open
+ *                          QV_STATUS_BUFFER_TOO_SMALL - the batch holds QVCHIP_KVS_BATCH_MAX_OPS keys
+*/
+qvStatus_t qvCHIP_KvsBatchDelete(const char * key);
+
+/** @brief Apply all operations of the open batch and close it.
+ *
+ *  After a reset during the commit, qvCHIP_KvsInit either completes the batch or leaves
+ *  all keys at their previous values.
+ *  When a committed batch fails to apply, applying it is retried by the next qvCHIP_KvsPut,
+ *  qvCHIP_KvsDelete or qvCHIP_KvsBatchBegin. Until it is applied, these return
+ *  QV_STATUS_WRONG_STATE for the keys in the batch.
+ *
+ *  @return                 QV_STATUS_NO_ERROR - no error
+ *                          QV_STATUS_WRONG_STATE - no batch is open
+ *                          QV_STATUS_INVALID_DATA - NVM access failed, retried later as described above
+ *                                                   when the batch was already committed
+ *                                                   or a put lost a value staged earlier, no key is changed
+*/
+qvStatus_t qvCHIP_KvsBatchCommit(void);
+
+/** @brief Drop the open batch without changing any key.
+ *
+ *  @return                 QV_STATUS_NO_ERROR - no error
+ *                          QV_STATUS_WRONG_STATE - no batch is open
+*/
+qvStatus_t qvCHIP_KvsBatchAbort(void);
+
 #ifdef __cplusplus
 }
 #endif //__cplusplus
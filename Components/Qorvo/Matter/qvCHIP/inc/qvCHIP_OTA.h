@@ -167,6 +167,12 @@ void qvCHIP_OtaStartWrite(void);
 */
 qvCHIP_OtaStatus_t qvCHIP_OtaWriteChunk(uint32_t offset, uint16_t length, uint8_t* dataChunk);
 
+/** @brief Application API: program the written chunks still buffered in RAM, see gpUpgrade_FlushWrite.
+*
+*   @return result
+*/
+qvCHIP_OtaStatus_t qvCHIP_OtaFlushWrite(void);
+
 /** @brief Application API: read chunk of data from external or internal storage device.
 *
 *   @param offset                    Offset of the data to read.
@@ -57,6 +57,7 @@
 #include "hal.h"
 #include "gpLog.h"
 #include "gpNvm.h"
+#include "gpUtils.h"
 
 
 #ifdef QVCHIP_DIVERSITY_KVS_HASH_KEYS
@@ -71,6 +72,14 @@
 /* <CodeGenerator Placeholder> Macro */
 
 #define MIN(a, b) (((a) < (b)) ? (a) : (b))
+#define MAX(a, b) (((a) > (b)) ? (a) : (b))
+
+/* Let the NVM driver do its deferred work when the stack is idle instead of in a later write */
+#ifdef GP_NVM_DIVERSITY_IDLE_MAINTENANCE
+#define KVS_REQUEST_NVM_MAINTENANCE() gpNvm_RequestIdleMaintenance()
+#else
+#define KVS_REQUEST_NVM_MAINTENANCE()
+#endif //GP_NVM_DIVERSITY_IDLE_MAINTENANCE
 
 /* Pool ID for KVS is the same as pool id for NVN implementation - they share the same pool */
 #define KVS_POOL_ID (0)
@@ -103,6 +112,76 @@ typedef PACKED_PRE struct qvCHIP_KVS_Tag_ {
 #error CHIP glue layer only built for use with 1 pool currently.
 #endif //GP_NVM_NBR_OF_POOLS
 
+/* Number of keys remembered by the RAM index (QVCHIP_DIVERSITY_KVS_INDEX_CACHE) */
+#ifndef QVCHIP_KVS_INDEX_CACHE_SIZE
+#define QVCHIP_KVS_INDEX_CACHE_SIZE 8
+#endif //QVCHIP_KVS_INDEX_CACHE_SIZE
+/* Longest key string that can be indexed - longer keys always take the full lookup path */
+#ifndef QVCHIP_KVS_INDEX_CACHE_KEY_LEN
+#define QVCHIP_KVS_INDEX_CACHE_KEY_LEN 32
+#endif //QVCHIP_KVS_INDEX_CACHE_KEY_LEN
+
+/* Fragment count of an index entry of which the NVM state is not known (anymore) */
+#define KVS_INDEX_FRAGMENTS_UNKNOWN 0xFF
+
+typedef struct {
+    uint32_t keyHash;
+    uint32_t lastUse;
+    uint8_t keyLen;        // 0 when the entry is unused
+    uint8_t nrOfFragments; // 0 when the key is known to be absent
+    char key[QVCHIP_KVS_INDEX_CACHE_KEY_LEN];
+    uint8_t tagKey[MAX_KVS_KEY_LEN];
+} qvCHIP_KvsIndexEntry_t;
+
+/* Number of values that can be open for streaming reads at the same time */
+#ifndef QVCHIP_KVS_NR_OF_STREAMS
+#define QVCHIP_KVS_NR_OF_STREAMS 2
+#endif //QVCHIP_KVS_NR_OF_STREAMS
+
+typedef struct {
+    Bool inUse;
+    Bool stale;            // value was changed or removed after opening
+    uint8_t nrOfFragments;
+    size_t valueSize;
+    qvCHIP_KVS_Tag extTag;
+} qvCHIP_KvsStream_t;
+
+#ifdef QVCHIP_DIVERSITY_KVS_BATCH
+/* Maximum number of keys put or deleted by one batch - the commit record must fit one NVM record */
+#ifndef QVCHIP_KVS_BATCH_MAX_OPS
+#define QVCHIP_KVS_BATCH_MAX_OPS 16
+#endif //QVCHIP_KVS_BATCH_MAX_OPS
+/* Component id in the tags of staged values and of the commit record - not to be used by other NVM users */
+#ifndef QVCHIP_KVS_BATCH_COMPONENT_ID
+#define QVCHIP_KVS_BATCH_COMPONENT_ID (GP_COMPONENT_ID | 0x80)
+#endif //QVCHIP_KVS_BATCH_COMPONENT_ID
+
+#define KVS_BATCH_OP_PUT    1
+#define KVS_BATCH_OP_DELETE 2
+
+/* idExt of the commit record - never reached by fragments of a staged value */
+#define KVS_BATCH_COMMIT_IDEXT 0xFF
+
+typedef PACKED_PRE struct qvCHIP_KvsBatchOp_ {
+    uint8_t op;
+    uint8_t key[MAX_KVS_KEY_LEN];
+    uint8_t nrOfFragments;
+} PACKED_POST qvCHIP_KvsBatchOp_t;
+
+/* Commit record - written in a single NVM write, so it is either fully present or absent after a reset */
+typedef PACKED_PRE struct qvCHIP_KvsBatchRecord_ {
+    uint8_t nrOfOps;
+    qvCHIP_KvsBatchOp_t ops[QVCHIP_KVS_BATCH_MAX_OPS];
+} PACKED_POST qvCHIP_KvsBatchRecord_t;
+
+GP_COMPILE_TIME_VERIFY(sizeof(qvCHIP_KvsBatchRecord_t) <= MAX_KVS_VALUE_LEN);
+
+#define KVS_BATCH_RECORD_SIZE(nrOfOps) (1 + (nrOfOps) * sizeof(qvCHIP_KvsBatchOp_t))
+#endif //QVCHIP_DIVERSITY_KVS_BATCH
+
+/* Known fragment count of a key, KVS_INDEX_FRAGMENTS_UNKNOWN if the key is not indexed */
+#define KVS_INDEX_FRAGMENTS(pEntry) (((pEntry) == NULL) ? KVS_INDEX_FRAGMENTS_UNKNOWN : (pEntry)->nrOfFragments)
+
 /* </CodeGenerator Placeholder> Macro */
 
 /*****************************************************************************
@@ -114,6 +193,23 @@ HAL_CRITICAL_SECTION_DEF(qvCHIP_KvsMutex)
 // Start of NVM area - linkerscript defined
 extern const UIntPtr gpNvm_Start;
 
+static qvCHIP_KvsStream_t qvCHIP_KvsStreams[QVCHIP_KVS_NR_OF_STREAMS];
+
+#ifdef QVCHIP_DIVERSITY_KVS_BATCH
+static Bool qvCHIP_KvsBatchOpen;
+/* Set when a failed put overwrote a value staged earlier in the open batch - the batch can only be aborted */
+static Bool qvCHIP_KvsBatchFailed;
+/* Set while the commit record of qvCHIP_KvsBatch is in NVM but the batch could not be applied */
+static Bool qvCHIP_KvsBatchPending;
+static qvCHIP_KvsBatchRecord_t qvCHIP_KvsBatch;
+#endif //QVCHIP_DIVERSITY_KVS_BATCH
+
+#ifdef QVCHIP_DIVERSITY_KVS_INDEX_CACHE
+static qvCHIP_KvsIndexEntry_t qvCHIP_KvsIndex[QVCHIP_KVS_INDEX_CACHE_SIZE];
+static uint32_t qvCHIP_KvsIndexUseCounter;
+static qvCHIP_KvsIndexStats_t qvCHIP_KvsIndexStats;
+#endif //QVCHIP_DIVERSITY_KVS_INDEX_CACHE
+
 /*****************************************************************************
  *                    Static Component Function Definitions
  *****************************************************************************/
@@ -172,82 +268,110 @@ static qvStatus_t qvCHIP_KvsCreateExtTag(const char* key, qvCHIP_KVS_Tag* extTag
     return qv_status;
 }
 
-/*****************************************************************************
- *                    Public Component Function Definitions
- *****************************************************************************/
-
-qvStatus_t qvCHIP_KvsInit(void)
+#ifdef QVCHIP_DIVERSITY_KVS_INDEX_CACHE
+static uint32_t qvCHIP_KvsIndexHashKey(const char* key, size_t keyLen)
 {
-#ifdef GP_NVM_DIVERSITY_VARIABLE_SETTINGS
-    UInt8 availableMaxTokenLength;
-    UIntPtr currentNvmStart;
-    gpNvm_KeyIndex_t currentNumberOfUniqueTokens;
-
-    gpNvm_GetVariableSettings(&currentNvmStart, &currentNumberOfUniqueTokens, &availableMaxTokenLength);
-    GP_LOG_PRINTF("Settings old/new: Nvm Start:%lx/%lx #Uniq Token:%u/%u Token Length:%u/%u", 0,
-                  (unsigned long)currentNvmStart, (unsigned long)&gpNvm_Start,
-                  currentNumberOfUniqueTokens, GP_NVM_NBR_OF_UNIQUE_TOKENS,
-                  availableMaxTokenLength, GP_NVM_MAX_TOKENLENGTH);
+    /* FNV-1a - only used to skip string compares of non-matching entries */
+    uint32_t hash = 2166136261UL;
+    size_t i;
 
-    if(availableMaxTokenLength < GP_NVM_MAX_TOKENLENGTH)
+    for(i = 0; i < keyLen; i++)
     {
-        GP_LOG_SYSTEM_PRINTF("Max token length %u < %u", 0, availableMaxTokenLength, GP_NVM_MAX_TOKENLENGTH);
-        return QV_STATUS_BUFFER_TOO_SMALL;
+        hash ^= (uint8_t)key[i];
+        hash *= 16777619UL;
     }
+    return hash;
+}
+#endif //QVCHIP_DIVERSITY_KVS_INDEX_CACHE
 
-    gpNvm_SetVariableSettings((UIntPtr)&gpNvm_Start, GP_NVM_NBR_OF_UNIQUE_TOKENS);
-#endif //GP_NVM_DIVERSITY_VARIABLE_SETTINGS
-#ifdef GP_NVM_DIVERSITY_VARIABLE_SIZE
-    UInt16 currentNrOfSectors;
-    UInt8 currentNrOfPools;
-    UInt8 currentSectorsPerPool[4]; // Max from NVM implementation
+/* Create the ext tag of a key, taking it from the RAM index if the key was seen before.
+   Returns the index entry of the key in ppEntry, or NULL if the key is not indexed.
+   Must be called with qvCHIP_KvsMutex taken. */
+static qvStatus_t qvCHIP_KvsGetExtTag(const char* key, qvCHIP_KVS_Tag* extTag, qvCHIP_KvsIndexEntry_t** ppEntry)
+{
+#ifdef QVCHIP_DIVERSITY_KVS_INDEX_CACHE
+    qvStatus_t qv_status;
+    qvCHIP_KvsIndexEntry_t* pVictim = &qvCHIP_KvsIndex[0];
+    size_t keyLen = strlen(key);
+    uint32_t keyHash;
+    UIntLoop i;
 
-    UInt8 sectorsPerPool[] = {GP_NVM_POOL_1_NBR_OF_PHY_SECTORS};
+    *ppEntry = NULL;
+    if((keyLen == 0) || (keyLen > QVCHIP_KVS_INDEX_CACHE_KEY_LEN))
+    {
+        return qvCHIP_KvsCreateExtTag(key, extTag);
+    }
 
-    gpNvm_GetVariableSize(&currentNrOfSectors, &currentNrOfPools, currentSectorsPerPool);
-    GP_LOG_PRINTF("Sizes old/new: #sectors:%lx/%lx #pools:%u/%u", 0,
-                  currentNrOfSectors, sectorsPerPool[0],
-                  currentNrOfPools, GP_NVM_NBR_OF_POOLS);
+    keyHash = qvCHIP_KvsIndexHashKey(key, keyLen);
+    qvCHIP_KvsIndexUseCounter++;
+    for(i = 0; i < QVCHIP_KVS_INDEX_CACHE_SIZE; i++)
+    {
+        qvCHIP_KvsIndexEntry_t* pEntry = &qvCHIP_KvsIndex[i];
 
-    gpNvm_SetVariableSize(sectorsPerPool[0], GP_NVM_NBR_OF_POOLS, sectorsPerPool);
-#endif //GP_NVM_DIVERSITY_VARIABLE_SIZE
+        if((pEntry->keyLen == keyLen) && (pEntry->keyHash == keyHash) && (MEMCMP(pEntry->key, key, keyLen) == 0))
+        {
+            qvCHIP_KvsIndexStats.hits++;
+            pEntry->lastUse = qvCHIP_KvsIndexUseCounter;
+            extTag->componentId = GP_COMPONENT_ID;
+            MEMCPY(extTag->key, pEntry->tagKey, MAX_KVS_KEY_LEN);
+            *ppEntry = pEntry;
+            return QV_STATUS_NO_ERROR;
+        }
+        /* Unused entries first, then the least recently used one */
+        if((pVictim->keyLen != 0) &&
+           ((pEntry->keyLen == 0) || ((uint32_t)(qvCHIP_KvsIndexUseCounter - pEntry->lastUse) > (uint32_t)(qvCHIP_KvsIndexUseCounter - pVictim->lastUse))))
+        {
+            pVictim = pEntry;
+        }
+    }
+    qvCHIP_KvsIndexStats.misses++;
 
-    hal_MutexCreate(&qvCHIP_KvsMutex);
-    if(!hal_MutexIsValid(qvCHIP_KvsMutex))
+    qv_status = qvCHIP_KvsCreateExtTag(key, extTag);
+    if(QV_STATUS_NO_ERROR != qv_status)
     {
-        return QV_STATUS_NVM_ERROR;
+        return qv_status;
     }
 
+    if(pVictim->keyLen != 0)
+    {
+        qvCHIP_KvsIndexStats.evictions++;
+    }
+    pVictim->keyHash = keyHash;
+    pVictim->lastUse = qvCHIP_KvsIndexUseCounter;
+    pVictim->keyLen = (uint8_t)keyLen;
+    pVictim->nrOfFragments = KVS_INDEX_FRAGMENTS_UNKNOWN;
+    MEMCPY(pVictim->key, key, keyLen);
+    MEMCPY(pVictim->tagKey, extTag->key, MAX_KVS_KEY_LEN);
+    *ppEntry = pVictim;
     return QV_STATUS_NO_ERROR;
+#else
+    *ppEntry = NULL;
+    return qvCHIP_KvsCreateExtTag(key, extTag);
+#endif //QVCHIP_DIVERSITY_KVS_INDEX_CACHE
 }
 
-/*****************************************************************************
- *                    Public Function Definitions
- *****************************************************************************/
-qvStatus_t qvCHIP_KvsPut(const char* key, const void* value, size_t valueSize)
+/* Remember the number of NVM fragments stored for an indexed key */
+static void qvCHIP_KvsIndexSetFragments(qvCHIP_KvsIndexEntry_t* pEntry, uint8_t nrOfFragments)
 {
-    /* <CodeGenerator Placeholder> Implementation_qvCHIP_KvsPut */
-    qvStatus_t qv_status;
-    gpNvm_Result_t nvm_result;
-
-    qvCHIP_KVS_Tag extTag;
-    uint8_t idExt;
-
-    size_t totalBytesWritten;
-
-    if((key == NULL) || (value == NULL))
-    {
-        return QV_STATUS_INVALID_ARGUMENT;
-    }
-
-    qv_status = qvCHIP_KvsCreateExtTag(key, &extTag);
-    if(QV_STATUS_NO_ERROR != qv_status)
+    if(pEntry != NULL)
     {
-        return qv_status;
+        pEntry->nrOfFragments = nrOfFragments;
     }
+}
 
-    hal_MutexAcquire(qvCHIP_KvsMutex);
+static void qvCHIP_KvsIndexLookupSkipped(void)
+{
+#ifdef QVCHIP_DIVERSITY_KVS_INDEX_CACHE
+    qvCHIP_KvsIndexStats.lookupsSkipped++;
+#endif //QVCHIP_DIVERSITY_KVS_INDEX_CACHE
+}
 
+/* Write a value as consecutive fragments of MAX_KVS_VALUE_LEN bytes, the last one possibly shorter */
+static qvStatus_t qvCHIP_KvsWriteFragments(qvCHIP_KVS_Tag* extTag, const uint8_t* value, size_t valueSize, uint8_t* pNrOfFragments)
+{
+    gpNvm_Result_t nvm_result;
+    size_t totalBytesWritten;
+    uint8_t idExt;
 
     idExt = 0;
     totalBytesWritten = 0;
@@ -258,13 +382,15 @@ qvStatus_t qvCHIP_KvsPut(const char* key, const void* value, size_t valueSize)
         bytesToWrite = ((valueSize - totalBytesWritten) > MAX_KVS_VALUE_LEN) ? MAX_KVS_VALUE_LEN : (valueSize - totalBytesWritten);
         /* idExt is incrementing to create unique tags for value sizes more than
             the maximum size of one KVS entry */
-        extTag.idExt = idExt;
+        extTag->idExt = idExt;
 
-        nvm_result = gpNvm_Write(KVS_POOL_ID, gpNvm_UpdateFrequencyIgnore, GP_NVM_MAX_TOKENLENGTH, (uint8_t*)&extTag,
-                                 bytesToWrite, (unsigned char*)value + totalBytesWritten);
+        GP_UTILS_PROF_START(nvm);
+        nvm_result = gpNvm_Write(KVS_POOL_ID, gpNvm_UpdateFrequencyIgnore, GP_NVM_MAX_TOKENLENGTH, (uint8_t*)extTag,
+                                 bytesToWrite, (uint8_t*)value + totalBytesWritten);
+        GP_UTILS_PROF_STOP(nvm, gpUtils_ProfProbeNvmWrite);
         if((nvm_result != gpNvm_Result_DataAvailable) && (nvm_result != gpNvm_Result_NoDataAvailable))
         {
-            hal_MutexRelease(qvCHIP_KvsMutex);
+            *pNrOfFragments = idExt;
             return QV_STATUS_INVALID_DATA;
         }
 
@@ -272,193 +398,1083 @@ qvStatus_t qvCHIP_KvsPut(const char* key, const void* value, size_t valueSize)
         totalBytesWritten += bytesToWrite;
     }
 
-    hal_MutexRelease(qvCHIP_KvsMutex);
+    *pNrOfFragments = idExt;
     return QV_STATUS_NO_ERROR;
-    /* </CodeGenerator Placeholder> Implementation_qvCHIP_KvsPut */
 }
 
-qvStatus_t qvCHIP_KvsGet(const char* key, void* value, size_t valueSize, size_t* readBytesSize,
-                         size_t offsetBytes)
+/* Remove fragments fromIdExt up to toIdExt, KVS_INDEX_FRAGMENTS_UNKNOWN to remove up to the last one stored.
+   The highest fragment is removed first, so an interrupted removal does not leave a gap. */
+static void qvCHIP_KvsRemoveFragments(qvCHIP_KVS_Tag* extTag, uint8_t fromIdExt, uint8_t toIdExt)
 {
-    /* <CodeGenerator Placeholder> Implementation_qvCHIP_KvsGet */
-    gpNvm_LookupTable_Handle_t handle;
-    gpNvm_Result_t nvm_result;
-    uint8_t nrOfMatches;
-    qvCHIP_KVS_Tag extTag;
-
-    uint8_t tempTagData[MAX_KVS_VALUE_LEN];
     uint8_t idExt;
 
-    size_t totalBytesRead;
+    if(toIdExt == KVS_INDEX_FRAGMENTS_UNKNOWN)
+    {
+        gpNvm_LookupTable_Handle_t handle;
+        gpNvm_Result_t nvm_result;
 
-    qvStatus_t qv_status = QV_STATUS_NO_ERROR;
+        nvm_result = gpNvm_BuildLookup(&handle, KVS_POOL_ID, gpNvm_UpdateFrequencyIgnore,
+                                       MAX_KVS_TOKENMASK_LEN, (uint8_t*)extTag,
+                                       GP_NVM_NBR_OF_UNIQUE_TOKENS, &toIdExt);
+        gpNvm_FreeLookup(handle);
+        if(nvm_result != gpNvm_Result_DataAvailable)
+        {
+            return;
+        }
+    }
 
-    /* check parameters*/
-    if((key == NULL) || (value == NULL) || (readBytesSize == NULL))
+    for(idExt = toIdExt; idExt > fromIdExt; idExt--)
     {
-        return QV_STATUS_INVALID_ARGUMENT;
+        extTag->idExt = idExt - 1;
+        gpNvm_Remove(KVS_POOL_ID, gpNvm_UpdateFrequencyIgnore, GP_NVM_MAX_TOKENLENGTH, (uint8_t*)extTag);
     }
+}
 
-    /* initialize variables */
-    *readBytesSize = 0;
+/* Build the NVM lookup table holding all fragments of a key.
+   The lookup table must be freed when true is returned in pLookupBuilt. */
+static qvStatus_t qvCHIP_KvsBuildFragmentLookup(qvCHIP_KVS_Tag* extTag, qvCHIP_KvsIndexEntry_t* pIndex,
+                                                gpNvm_LookupTable_Handle_t* pHandle, uint8_t* pNrOfFragments, Bool* pLookupBuilt)
+{
+    gpNvm_Result_t nvm_result;
 
-    qv_status = qvCHIP_KvsCreateExtTag(key, &extTag);
-    if(QV_STATUS_NO_ERROR != qv_status)
+    /* key known to be absent - no need to scan the pool */
+    if(KVS_INDEX_FRAGMENTS(pIndex) == 0)
     {
-        return qv_status;
+        qvCHIP_KvsIndexLookupSkipped();
+        return QV_STATUS_INVALID_DATA;
     }
 
-    hal_MutexAcquire(qvCHIP_KvsMutex);
-
     /* build the lookup table based on the key - could return multiple results */
-    nvm_result = gpNvm_BuildLookup(&handle, KVS_POOL_ID, gpNvm_UpdateFrequencyIgnore,
-                                   MAX_KVS_TOKENMASK_LEN, (uint8_t*)&extTag,
-                                   GP_NVM_NBR_OF_UNIQUE_TOKENS, &nrOfMatches);
-    if((nvm_result != gpNvm_Result_DataAvailable) || (nrOfMatches == 0))
+    nvm_result = gpNvm_BuildLookup(pHandle, KVS_POOL_ID, gpNvm_UpdateFrequencyIgnore,
+                                   MAX_KVS_TOKENMASK_LEN, (uint8_t*)extTag,
+                                   GP_NVM_NBR_OF_UNIQUE_TOKENS, pNrOfFragments);
+    *pLookupBuilt = true;
+    if((nvm_result != gpNvm_Result_DataAvailable) || (*pNrOfFragments == 0))
     {
-        qv_status = QV_STATUS_INVALID_DATA;
-        goto _cleanup;
+        if(((nvm_result == gpNvm_Result_DataAvailable) || (nvm_result == gpNvm_Result_NoDataAvailable)) && (*pNrOfFragments == 0))
+        {
+            qvCHIP_KvsIndexSetFragments(pIndex, 0);
+        }
+        return QV_STATUS_INVALID_DATA;
     }
+    qvCHIP_KvsIndexSetFragments(pIndex, *pNrOfFragments);
 
-    /*
-        Note: due to offseting, we need to read the tag into a temporary buffer and rebuild the
-              data afterwards
-    */
-    idExt = 0;
-    totalBytesRead = 0;
-    while(nrOfMatches > 0)
+    return QV_STATUS_NO_ERROR;
+}
+
+/* Read value bytes starting at offsetBytes into pDst, using a lookup table built for the key.
+   All fragments except the last one hold MAX_KVS_VALUE_LEN bytes, so reading starts at the fragment
+   holding the offset. Fragments read from their start that fit the destination entirely are read
+   into it directly, others go through a temporary buffer.
+   Returns QV_STATUS_BUFFER_TOO_SMALL when more data follows than fits pDst. */
+static qvStatus_t qvCHIP_KvsReadRange(gpNvm_LookupTable_Handle_t handle, qvCHIP_KVS_Tag* extTag, uint8_t nrOfFragments,
+                                      size_t offsetBytes, uint8_t* pDst, size_t dstSize, size_t* readBytesSize)
+{
+    uint8_t tempTagData[MAX_KVS_VALUE_LEN];
+    size_t firstFragment = offsetBytes / MAX_KVS_VALUE_LEN;
+    size_t skip = offsetBytes % MAX_KVS_VALUE_LEN;
+    uint8_t idExt;
+
+    *readBytesSize = 0;
+    if(firstFragment >= nrOfFragments)
     {
-        uint8_t bytesRead;
+        /* offset past the end of the value */
+        return QV_STATUS_NO_ERROR;
+    }
 
-        /* idExt is incrementing to create unique tags for value sizes more than
-            the maximum size of one KVS entry */
-        extTag.idExt = idExt;
+    for(idExt = (uint8_t)firstFragment; idExt < nrOfFragments; idExt++)
+    {
+        gpNvm_Result_t nvm_result;
+        uint8_t bytesRead;
+        size_t bytesToCopy;
+        Bool direct = (skip == 0) && ((dstSize - *readBytesSize) >= MAX_KVS_VALUE_LEN);
 
+        extTag->idExt = idExt;
+        GP_UTILS_PROF_START(nvm);
         nvm_result = gpNvm_ReadUnique(handle, KVS_POOL_ID, gpNvm_UpdateFrequencyIgnore, NULL,
-                                      GP_NVM_MAX_TOKENLENGTH, (uint8_t*)&extTag, MAX_KVS_VALUE_LEN, &bytesRead,
-                                      tempTagData);
+                                      GP_NVM_MAX_TOKENLENGTH, (uint8_t*)extTag, MAX_KVS_VALUE_LEN, &bytesRead,
+                                      direct ? (pDst + *readBytesSize) : tempTagData);
+        GP_UTILS_PROF_STOP(nvm, gpUtils_ProfProbeNvmRead);
         if(nvm_result == gpNvm_Result_Truncated)
         {
             //Note: this error should not appear, as the maximum tag value size is MAX_KVS_VALUE_LEN
             //      and we provide a buffer this size for reading
-            qv_status = QV_STATUS_BUFFER_TOO_SMALL;
-            goto _cleanup;
+            return QV_STATUS_BUFFER_TOO_SMALL;
         }
         if(nvm_result != gpNvm_Result_DataAvailable)
         {
-            qv_status = QV_STATUS_INVALID_DATA;
-            goto _cleanup;
+            return QV_STATUS_INVALID_DATA;
+        }
+        if(bytesRead <= skip)
+        {
+            /* offset past the end of the value */
+            break;
         }
 
-        totalBytesRead += bytesRead;
+        bytesToCopy = MIN((size_t)bytesRead - skip, dstSize - *readBytesSize);
+        if(!direct)
+        {
+            MEMCPY(pDst + *readBytesSize, &tempTagData[skip], bytesToCopy);
+        }
+        *readBytesSize += bytesToCopy;
 
-        /* only copy data into the provided buffer if we are past the specified offset */
-        if(totalBytesRead > offsetBytes)
+        /* if we read more than fits the data buffer, trim length to fit and return BUFFER_TOO_SMALL */
+        if(bytesToCopy < ((size_t)bytesRead - skip))
         {
-            Bool bufferTooSmall = false;
+            return QV_STATUS_BUFFER_TOO_SMALL;
+        }
+        skip = 0;
+    }
 
-            /* if we read more than fits the data buffer, trim length to fit and return BUFFER_TOO_SMALL */
-            if(totalBytesRead - offsetBytes > valueSize)
-            {
-                totalBytesRead = offsetBytes + valueSize;
-                bufferTooSmall = true;
-            }
-            /* use old value of readBytesSize as index into the destination buffer */
-            MEMCPY((unsigned char*)value + *readBytesSize,
-                   ((totalBytesRead - offsetBytes) > MAX_KVS_VALUE_LEN) ? tempTagData : &tempTagData[offsetBytes % MAX_KVS_VALUE_LEN],
-                   totalBytesRead - offsetBytes - *readBytesSize);
-            *readBytesSize = totalBytesRead - offsetBytes;
+    return QV_STATUS_NO_ERROR;
+}
 
-            if(bufferTooSmall == true)
-            {
-                qv_status = QV_STATUS_BUFFER_TOO_SMALL;
-                goto _cleanup;
-            }
-        }
+/* Mark open streams on a key (all streams for NULL) as stale after the value changed */
+static void qvCHIP_KvsStreamsInvalidate(const qvCHIP_KVS_Tag* extTag)
+{
+    UIntLoop i;
 
-        idExt += 1;
-        nrOfMatches -= 1;
-    }
+    for(i = 0; i < QVCHIP_KVS_NR_OF_STREAMS; i++)
+    {
+        qvCHIP_KvsStream_t* pStream = &qvCHIP_KvsStreams[i];
 
+        if(pStream->inUse && ((extTag == NULL) || (MEMCMP(&pStream->extTag, extTag, MAX_KVS_TOKENMASK_LEN) == 0)))
+        {
+            pStream->stale = true;
+        }
+    }
+}
 
-_cleanup:
+#ifdef QVCHIP_DIVERSITY_KVS_BATCH
+static void qvCHIP_KvsBatchSetTag(qvCHIP_KVS_Tag* extTag, uint8_t componentId, const uint8_t* key)
+{
+    extTag->componentId = componentId;
+    MEMCPY(extTag->key, key, MAX_KVS_KEY_LEN);
+}
 
-    gpNvm_FreeLookup(handle);
-    hal_MutexRelease(qvCHIP_KvsMutex);
-    return qv_status;
-    /* </CodeGenerator Placeholder> Implementation_qvCHIP_KvsGet */
+static void qvCHIP_KvsBatchSetCommitTag(qvCHIP_KVS_Tag* extTag)
+{
+    extTag->componentId = QVCHIP_KVS_BATCH_COMPONENT_ID;
+    MEMSET(extTag->key, 0x00, MAX_KVS_KEY_LEN);
+    extTag->idExt = KVS_BATCH_COMMIT_IDEXT;
 }
 
-qvStatus_t qvCHIP_KvsDelete(const char* key)
+/* Read a single NVM record - the lookup table is not kept open while writing */
+static qvStatus_t qvCHIP_KvsReadRecord(qvCHIP_KVS_Tag* extTag, uint8_t* pData, uint8_t* pLength)
 {
-    /* <CodeGenerator Placeholder> Implementation_qvCHIP_KvsDelete */
     gpNvm_LookupTable_Handle_t handle;
     gpNvm_Result_t nvm_result;
-
     uint8_t nrOfMatches;
-    qvCHIP_KVS_Tag extTag;
-    uint8_t idExt;
-
-    qvStatus_t qv_status = QV_STATUS_NO_ERROR;
 
-    if(key == NULL)
+    nvm_result = gpNvm_BuildLookup(&handle, KVS_POOL_ID, gpNvm_UpdateFrequencyIgnore,
+                                   GP_NVM_MAX_TOKENLENGTH, (uint8_t*)extTag, 1, &nrOfMatches);
+    if((nvm_result == gpNvm_Result_DataAvailable) && (nrOfMatches == 1))
     {
-        return QV_STATUS_INVALID_ARGUMENT;
+        GP_UTILS_PROF_START(nvm);
+        nvm_result = gpNvm_ReadUnique(handle, KVS_POOL_ID, gpNvm_UpdateFrequencyIgnore, NULL,
+                                      GP_NVM_MAX_TOKENLENGTH, (uint8_t*)extTag, MAX_KVS_VALUE_LEN, pLength, pData);
+        GP_UTILS_PROF_STOP(nvm, gpUtils_ProfProbeNvmRead);
     }
-
-    qv_status = qvCHIP_KvsCreateExtTag(key, &extTag);
-    if(QV_STATUS_NO_ERROR != qv_status)
+    else
     {
-        return qv_status;
+        nvm_result = gpNvm_Result_NoDataAvailable;
     }
-    hal_MutexAcquire(qvCHIP_KvsMutex);
+    gpNvm_FreeLookup(handle);
 
-    nvm_result = gpNvm_BuildLookup(&handle, KVS_POOL_ID, gpNvm_UpdateFrequencyIgnore,
-                                   MAX_KVS_TOKENMASK_LEN, (uint8_t*)&extTag,
-                                   GP_NVM_NBR_OF_UNIQUE_TOKENS, &nrOfMatches);
-    if((nvm_result != gpNvm_Result_DataAvailable) || (nrOfMatches == 0))
+    return (nvm_result == gpNvm_Result_DataAvailable) ? QV_STATUS_NO_ERROR : QV_STATUS_INVALID_DATA;
+}
+
+static qvCHIP_KvsBatchOp_t* qvCHIP_KvsBatchFindOp(const uint8_t* key)
+{
+    UIntLoop i;
+
+    for(i = 0; i < qvCHIP_KvsBatch.nrOfOps; i++)
     {
-        qv_status = QV_STATUS_INVALID_DATA;
-        goto _cleanup;
+        if(MEMCMP(qvCHIP_KvsBatch.ops[i].key, key, MAX_KVS_KEY_LEN) == 0)
+        {
+            return &qvCHIP_KvsBatch.ops[i];
+        }
     }
+    return NULL;
+}
 
-    /* delete all extended tags matching the specified tag - the algorithm assumes the extended tag
-       ids are generated linearly starting from 0 */
-    idExt = 0;
-    while(nrOfMatches > 0)
-    {
-        extTag.idExt = idExt;
+static void qvCHIP_KvsBatchRemoveStaged(const qvCHIP_KvsBatchOp_t* pOp, uint8_t fromIdExt)
+{
+    qvCHIP_KVS_Tag stagedTag;
 
-        nvm_result = gpNvm_Remove(KVS_POOL_ID, gpNvm_UpdateFrequencyIgnore, GP_NVM_MAX_TOKENLENGTH, (uint8_t*)&extTag);
-        if(nvm_result != gpNvm_Result_DataAvailable)
+    qvCHIP_KvsBatchSetTag(&stagedTag, QVCHIP_KVS_BATCH_COMPONENT_ID, pOp->key);
+    qvCHIP_KvsRemoveFragments(&stagedTag, fromIdExt, (pOp->op == KVS_BATCH_OP_PUT) ? pOp->nrOfFragments : 0);
+}
+
+static void qvCHIP_KvsBatchDropOp(qvCHIP_KvsBatchOp_t* pOp)
+{
+    qvCHIP_KvsBatch.nrOfOps--;
+    MEMCPY(pOp, &qvCHIP_KvsBatch.ops[qvCHIP_KvsBatch.nrOfOps], sizeof(qvCHIP_KvsBatchOp_t));
+}
+
+/* Make one operation of a committed batch live. Safe to repeat after a reset: a put is only
+   applied while all its staged fragments are present, they are removed after all ops are applied. */
+static qvStatus_t qvCHIP_KvsBatchApplyOp(const qvCHIP_KvsBatchOp_t* pOp)
+{
+    qvCHIP_KVS_Tag liveTag;
+    uint8_t nrOfFragments = 0;
+
+    qvCHIP_KvsBatchSetTag(&liveTag, GP_COMPONENT_ID, pOp->key);
+    if(pOp->op == KVS_BATCH_OP_PUT)
+    {
+        qvCHIP_KVS_Tag stagedTag;
+        gpNvm_LookupTable_Handle_t handle;
+        gpNvm_Result_t nvm_result;
+        uint8_t nrOfMatches;
+        uint8_t data[MAX_KVS_VALUE_LEN];
+        uint8_t length;
+
+        qvCHIP_KvsBatchSetTag(&stagedTag, QVCHIP_KVS_BATCH_COMPONENT_ID, pOp->key);
+        nvm_result = gpNvm_BuildLookup(&handle, KVS_POOL_ID, gpNvm_UpdateFrequencyIgnore,
+                                       MAX_KVS_TOKENMASK_LEN, (uint8_t*)&stagedTag,
+                                       GP_NVM_NBR_OF_UNIQUE_TOKENS, &nrOfMatches);
+        gpNvm_FreeLookup(handle);
+        if((nvm_result != gpNvm_Result_DataAvailable) || (nrOfMatches != pOp->nrOfFragments))
         {
-            qv_status = QV_STATUS_INVALID_DATA;
-            goto _cleanup;
+            /* already applied before a reset */
+            return QV_STATUS_NO_ERROR;
         }
 
-        idExt += 1;
-        nrOfMatches -= 1;
+        for(nrOfFragments = 0; nrOfFragments < pOp->nrOfFragments; nrOfFragments++)
+        {
+            stagedTag.idExt = nrOfFragments;
+            if(QV_STATUS_NO_ERROR != qvCHIP_KvsReadRecord(&stagedTag, data, &length))
+            {
+                return QV_STATUS_INVALID_DATA;
+            }
+            liveTag.idExt = nrOfFragments;
+            GP_UTILS_PROF_START(nvm);
+            nvm_result = gpNvm_Write(KVS_POOL_ID, gpNvm_UpdateFrequencyIgnore, GP_NVM_MAX_TOKENLENGTH, (uint8_t*)&liveTag,
+                                     length, data);
+            GP_UTILS_PROF_STOP(nvm, gpUtils_ProfProbeNvmWrite);
+            if((nvm_result != gpNvm_Result_DataAvailable) && (nvm_result != gpNvm_Result_NoDataAvailable))
+            {
+                return QV_STATUS_INVALID_DATA;
+            }
+        }
     }
 
-_cleanup:
+    /* tail of a longer previous value, or the complete value for a delete */
+    qvCHIP_KvsRemoveFragments(&liveTag, nrOfFragments, KVS_INDEX_FRAGMENTS_UNKNOWN);
+    qvCHIP_KvsStreamsInvalidate(&liveTag);
+#ifdef QVCHIP_DIVERSITY_KVS_INDEX_CACHE
+    {
+        UIntLoop i;
 
-    gpNvm_FreeLookup(handle);
-    hal_MutexRelease(qvCHIP_KvsMutex);
-    return qv_status;
-    /* </CodeGenerator Placeholder> Implementation_qvCHIP_KvsDelete */
+        for(i = 0; i < QVCHIP_KVS_INDEX_CACHE_SIZE; i++)
+        {
+            if((qvCHIP_KvsIndex[i].keyLen != 0) && (MEMCMP(qvCHIP_KvsIndex[i].tagKey, pOp->key, MAX_KVS_KEY_LEN) == 0))
+            {
+                qvCHIP_KvsIndex[i].nrOfFragments = nrOfFragments;
+            }
+        }
+    }
+#endif //QVCHIP_DIVERSITY_KVS_INDEX_CACHE
+
+    return QV_STATUS_NO_ERROR;
 }
 
-qvStatus_t qvCHIP_KvsErasePartition(void)
+/* Apply all operations of a committed batch, then remove the staged values and the commit record */
+static qvStatus_t qvCHIP_KvsBatchFinish(const qvCHIP_KvsBatchRecord_t* pRecord)
 {
-    /* <CodeGenerator Placeholder> Implementation_qvCHIP_KvsErasePartition */
-    // When using this function, advise to trigger a reset in a higher lever afterwards to make sure everything
-    // is cleaned up. [qvCHIP_ResetSystem API can be used to trigger the reset].
-    // see <matter repo>/src/platform/qpg/ConfigurationManagerImpl.cpp - ConfigurationManagerImpl::DoFactoryReset
-
-    qvStatus_t res = QV_STATUS_NO_ERROR;
-
-    gpNvm_ErasePool(gpNvm_PoolId_AllPoolIds);
+    qvCHIP_KVS_Tag commitTag;
+    UIntLoop i;
 
-    return res;
+    for(i = 0; i < pRecord->nrOfOps; i++)
+    {
+        if(QV_STATUS_NO_ERROR != qvCHIP_KvsBatchApplyOp(&pRecord->ops[i]))
+        {
+            /* commit record stays - applying is retried at the next qvCHIP_KvsInit */
+            return QV_STATUS_INVALID_DATA;
+        }
+    }
+    for(i = 0; i < pRecord->nrOfOps; i++)
+    {
+        qvCHIP_KvsBatchRemoveStaged(&pRecord->ops[i], 0);
+    }
+
+    qvCHIP_KvsBatchSetCommitTag(&commitTag);
+    gpNvm_Remove(KVS_POOL_ID, gpNvm_UpdateFrequencyIgnore, GP_NVM_MAX_TOKENLENGTH, (uint8_t*)&commitTag);
+    KVS_REQUEST_NVM_MAINTENANCE();
+
+    return QV_STATUS_NO_ERROR;
+}
+
+/* Retry applying a committed batch that failed to apply. Until it is applied, its keys can not be
+   changed outside of a batch: rolling it forward at the next qvCHIP_KvsInit would undo that change. */
+static qvStatus_t qvCHIP_KvsBatchCheckPending(const qvCHIP_KVS_Tag* extTag)
+{
+    if(qvCHIP_KvsBatchPending)
+    {
+        if(QV_STATUS_NO_ERROR == qvCHIP_KvsBatchFinish(&qvCHIP_KvsBatch))
+        {
+            qvCHIP_KvsBatchPending = false;
+        }
+        else if((extTag == NULL) || (qvCHIP_KvsBatchFindOp(extTag->key) != NULL))
+        {
+            return QV_STATUS_WRONG_STATE;
+        }
+    }
+    return QV_STATUS_NO_ERROR;
+}
+
+/* Complete a batch interrupted by a reset: roll forward when its commit record was written,
+   otherwise drop whatever was staged */
+static void qvCHIP_KvsBatchRecover(void)
+{
+    qvCHIP_KVS_Tag commitTag;
+    qvCHIP_KvsBatchRecord_t record;
+    uint8_t data[MAX_KVS_VALUE_LEN];
+    uint8_t length;
+
+    qvCHIP_KvsBatchSetCommitTag(&commitTag);
+    if(QV_STATUS_NO_ERROR == qvCHIP_KvsReadRecord(&commitTag, data, &length))
+    {
+        MEMCPY(&record, data, MIN(length, sizeof(record)));
+        if((length >= 1) && (record.nrOfOps <= QVCHIP_KVS_BATCH_MAX_OPS) && (length == KVS_BATCH_RECORD_SIZE(record.nrOfOps)))
+        {
+            GP_LOG_SYSTEM_PRINTF("KVS batch: roll forward %u ops", 0, record.nrOfOps);
+            if(QV_STATUS_NO_ERROR != qvCHIP_KvsBatchFinish(&record))
+            {
+                /* staged values are still needed - keep retrying before its keys are written */
+                MEMCPY(&qvCHIP_KvsBatch, &record, sizeof(record));
+                qvCHIP_KvsBatchPending = true;
+                return;
+            }
+        }
+        else
+        {
+            gpNvm_Remove(KVS_POOL_ID, gpNvm_UpdateFrequencyIgnore, GP_NVM_MAX_TOKENLENGTH, (uint8_t*)&commitTag);
+        }
+    }
+
+    /* staged values without commit record */
+    while(true)
+    {
+        gpNvm_LookupTable_Handle_t handle;
+        gpNvm_Result_t nvm_result;
+        gpNvm_UpdateFrequency_t updateFrequency;
+        uint8_t nrOfMatches = 0;
+        uint8_t token[GP_NVM_MAX_TOKENLENGTH];
+        uint8_t tokenLength = 0;
+
+        token[0] = QVCHIP_KVS_BATCH_COMPONENT_ID;
+        nvm_result = gpNvm_BuildLookup(&handle, KVS_POOL_ID, gpNvm_UpdateFrequencyIgnore,
+                                       1, token, GP_NVM_NBR_OF_UNIQUE_TOKENS, &nrOfMatches);
+        if((nvm_result == gpNvm_Result_DataAvailable) && (nrOfMatches > 0))
+        {
+            GP_UTILS_PROF_START(nvm);
+            nvm_result = gpNvm_ReadNext(handle, KVS_POOL_ID, &updateFrequency, GP_NVM_MAX_TOKENLENGTH, &tokenLength, token,
+                                        MAX_KVS_VALUE_LEN, &length, data);
+            GP_UTILS_PROF_STOP(nvm, gpUtils_ProfProbeNvmRead);
+        }
+        else
+        {
+            nvm_result = gpNvm_Result_NoDataAvailable;
+        }
+        gpNvm_FreeLookup(handle);
+
+        if((nvm_result != gpNvm_Result_DataAvailable) ||
+           (gpNvm_Remove(KVS_POOL_ID, gpNvm_UpdateFrequencyIgnore, tokenLength, token) != gpNvm_Result_DataAvailable))
+        {
+            break;
+        }
+    }
+}
+#endif //QVCHIP_DIVERSITY_KVS_BATCH
+
+/*****************************************************************************
+ *                    Public Component Function Definitions
+ *****************************************************************************/
+
+qvStatus_t qvCHIP_KvsInit(void)
+{
+#ifdef GP_NVM_DIVERSITY_VARIABLE_SETTINGS
+    UInt8 availableMaxTokenLength;
+    UIntPtr currentNvmStart;
+    gpNvm_KeyIndex_t currentNumberOfUniqueTokens;
+
+    gpNvm_GetVariableSettings(&currentNvmStart, &currentNumberOfUniqueTokens, &availableMaxTokenLength);
+    GP_LOG_PRINTF("Settings old/new: Nvm Start:%lx/%lx #Uniq Token:%u/%u Token Length:%u/%u", 0,
+                  (unsigned long)currentNvmStart, (unsigned long)&gpNvm_Start,
+                  currentNumberOfUniqueTokens, GP_NVM_NBR_OF_UNIQUE_TOKENS,
+                  availableMaxTokenLength, GP_NVM_MAX_TOKENLENGTH);
+
+    if(availableMaxTokenLength < GP_NVM_MAX_TOKENLENGTH)
+    {
+        GP_LOG_SYSTEM_PRINTF("Max token length %u < %u", 0, availableMaxTokenLength, GP_NVM_MAX_TOKENLENGTH);
+        return QV_STATUS_BUFFER_TOO_SMALL;
+    }
+
+    gpNvm_SetVariableSettings((UIntPtr)&gpNvm_Start, GP_NVM_NBR_OF_UNIQUE_TOKENS);
+#endif //GP_NVM_DIVERSITY_VARIABLE_SETTINGS
+#ifdef GP_NVM_DIVERSITY_VARIABLE_SIZE
+    UInt16 currentNrOfSectors;
+    UInt8 currentNrOfPools;
+    UInt8 currentSectorsPerPool[4]; // Max from NVM implementation
+
+    UInt8 sectorsPerPool[] = {GP_NVM_POOL_1_NBR_OF_PHY_SECTORS};
+
+    gpNvm_GetVariableSize(&currentNrOfSectors, &currentNrOfPools, currentSectorsPerPool);
+    GP_LOG_PRINTF("Sizes old/new: #sectors:%lx/%lx #pools:%u/%u", 0,
+                  currentNrOfSectors, sectorsPerPool[0],
+                  currentNrOfPools, GP_NVM_NBR_OF_POOLS);
+
+    gpNvm_SetVariableSize(sectorsPerPool[0], GP_NVM_NBR_OF_POOLS, sectorsPerPool);
+#endif //GP_NVM_DIVERSITY_VARIABLE_SIZE
+
+    hal_MutexCreate(&qvCHIP_KvsMutex);
+    if(!hal_MutexIsValid(qvCHIP_KvsMutex))
+    {
+        return QV_STATUS_NVM_ERROR;
+    }
+
+#ifdef QVCHIP_DIVERSITY_KVS_BATCH
+    qvCHIP_KvsBatchRecover();
+#endif //QVCHIP_DIVERSITY_KVS_BATCH
+
+    return QV_STATUS_NO_ERROR;
+}
+
+/*****************************************************************************
+ *                    Public Function Definitions
+ *****************************************************************************/
+qvStatus_t qvCHIP_KvsPut(const char* key, const void* value, size_t valueSize)
+{
+    /* <CodeGenerator Placeholder> Implementation_qvCHIP_KvsPut */
+    qvStatus_t qv_status;
+
+    qvCHIP_KVS_Tag extTag;
+    qvCHIP_KvsIndexEntry_t* pIndex;
+    uint8_t idExt;
+    GP_UTILS_PROF_SCOPE(gpUtils_ProfProbeKvsPut);
+
+    if((key == NULL) || (value == NULL))
+    {
+        return QV_STATUS_INVALID_ARGUMENT;
+    }
+
+    hal_MutexAcquire(qvCHIP_KvsMutex);
+
+    qv_status = qvCHIP_KvsGetExtTag(key, &extTag, &pIndex);
+#ifdef QVCHIP_DIVERSITY_KVS_BATCH
+    if(QV_STATUS_NO_ERROR == qv_status)
+    {
+        qv_status = qvCHIP_KvsBatchCheckPending(&extTag);
+    }
+#endif //QVCHIP_DIVERSITY_KVS_BATCH
+    if(QV_STATUS_NO_ERROR != qv_status)
+    {
+        hal_MutexRelease(qvCHIP_KvsMutex);
+        return qv_status;
+    }
+
+    qv_status = qvCHIP_KvsWriteFragments(&extTag, (const uint8_t*)value, valueSize, &idExt);
+    if(QV_STATUS_NO_ERROR != qv_status)
+    {
+        qvCHIP_KvsIndexSetFragments(pIndex, KVS_INDEX_FRAGMENTS_UNKNOWN);
+        qvCHIP_KvsStreamsInvalidate(&extTag);
+        hal_MutexRelease(qvCHIP_KvsMutex);
+        return qv_status;
+    }
+
+    if(idExt > 0)
+    {
+        /* remove fragments left behind by a longer previous value, so only the last fragment of
+           a value can be shorter than MAX_KVS_VALUE_LEN */
+        qvCHIP_KvsRemoveFragments(&extTag, idExt, KVS_INDEX_FRAGMENTS(pIndex));
+        qvCHIP_KvsIndexSetFragments(pIndex, idExt);
+    }
+    qvCHIP_KvsStreamsInvalidate(&extTag);
+    KVS_REQUEST_NVM_MAINTENANCE();
+
+    hal_MutexRelease(qvCHIP_KvsMutex);
+    return QV_STATUS_NO_ERROR;
+    /* </CodeGenerator Placeholder> Implementation_qvCHIP_KvsPut */
+}
+
+qvStatus_t qvCHIP_KvsGet(const char* key, void* value, size_t valueSize, size_t* readBytesSize,
+                         size_t offsetBytes)
+{
+    /* <CodeGenerator Placeholder> Implementation_qvCHIP_KvsGet */
+    gpNvm_LookupTable_Handle_t handle = gpNvm_LookupTable_Handle_Invalid;
+    uint8_t nrOfMatches;
+    qvCHIP_KVS_Tag extTag;
+    qvCHIP_KvsIndexEntry_t* pIndex;
+    Bool lookupBuilt = false;
+
+    qvStatus_t qv_status = QV_STATUS_NO_ERROR;
+    GP_UTILS_PROF_SCOPE(gpUtils_ProfProbeKvsGet);
+
+    /* check parameters*/
+    if((key == NULL) || (value == NULL) || (readBytesSize == NULL))
+    {
+        return QV_STATUS_INVALID_ARGUMENT;
+    }
+
+    /* initialize variables */
+    *readBytesSize = 0;
+
+    hal_MutexAcquire(qvCHIP_KvsMutex);
+
+    qv_status = qvCHIP_KvsGetExtTag(key, &extTag, &pIndex);
+    if(QV_STATUS_NO_ERROR != qv_status)
+    {
+        goto _cleanup;
+    }
+
+    qv_status = qvCHIP_KvsBuildFragmentLookup(&extTag, pIndex, &handle, &nrOfMatches, &lookupBuilt);
+    if(QV_STATUS_NO_ERROR != qv_status)
+    {
+        goto _cleanup;
+    }
+
+    qv_status = qvCHIP_KvsReadRange(handle, &extTag, nrOfMatches, offsetBytes, (uint8_t*)value, valueSize, readBytesSize);
+
+_cleanup:
+
+    if(lookupBuilt)
+    {
+        gpNvm_FreeLookup(handle);
+    }
+    hal_MutexRelease(qvCHIP_KvsMutex);
+    return qv_status;
+    /* </CodeGenerator Placeholder> Implementation_qvCHIP_KvsGet */
+}
+
+qvStatus_t qvCHIP_KvsDelete(const char* key)
+{
+    /* <CodeGenerator Placeholder> Implementation_qvCHIP_KvsDelete */
+    gpNvm_LookupTable_Handle_t handle = gpNvm_LookupTable_Handle_Invalid;
+    gpNvm_Result_t nvm_result;
+
+    uint8_t nrOfMatches;
+    qvCHIP_KVS_Tag extTag;
+    qvCHIP_KvsIndexEntry_t* pIndex;
+    Bool lookupBuilt = false;
+    uint8_t idExt;
+
+    qvStatus_t qv_status = QV_STATUS_NO_ERROR;
+    GP_UTILS_PROF_SCOPE(gpUtils_ProfProbeKvsDelete);
+
+    if(key == NULL)
+    {
+        return QV_STATUS_INVALID_ARGUMENT;
+    }
+
+    hal_MutexAcquire(qvCHIP_KvsMutex);
+
+    qv_status = qvCHIP_KvsGetExtTag(key, &extTag, &pIndex);
+#ifdef QVCHIP_DIVERSITY_KVS_BATCH
+    if(QV_STATUS_NO_ERROR == qv_status)
+    {
+        qv_status = qvCHIP_KvsBatchCheckPending(&extTag);
+    }
+#endif //QVCHIP_DIVERSITY_KVS_BATCH
+    if(QV_STATUS_NO_ERROR != qv_status)
+    {
+        goto _cleanup;
+    }
+
+    nrOfMatches = KVS_INDEX_FRAGMENTS(pIndex);
+    if(nrOfMatches == KVS_INDEX_FRAGMENTS_UNKNOWN)
+    {
+        nvm_result = gpNvm_BuildLookup(&handle, KVS_POOL_ID, gpNvm_UpdateFrequencyIgnore,
+                                       MAX_KVS_TOKENMASK_LEN, (uint8_t*)&extTag,
+                                       GP_NVM_NBR_OF_UNIQUE_TOKENS, &nrOfMatches);
+        lookupBuilt = true;
+        if(nvm_result != gpNvm_Result_DataAvailable)
+        {
+            nrOfMatches = 0;
+        }
+    }
+    else
+    {
+        /* fragment count known from the index - no need to scan the pool */
+        qvCHIP_KvsIndexLookupSkipped();
+    }
+    if(nrOfMatches == 0)
+    {
+        qv_status = QV_STATUS_INVALID_DATA;
+        goto _cleanup;
+    }
+
+    /* state unknown until all fragments are removed */
+    qvCHIP_KvsIndexSetFragments(pIndex, KVS_INDEX_FRAGMENTS_UNKNOWN);
+    qvCHIP_KvsStreamsInvalidate(&extTag);
+
+    /* delete all extended tags matching the specified tag - the algorithm assumes the extended tag
+       ids are generated linearly starting from 0 */
+    idExt = 0;
+    while(nrOfMatches > 0)
+    {
+        extTag.idExt = idExt;
+
+        nvm_result = gpNvm_Remove(KVS_POOL_ID, gpNvm_UpdateFrequencyIgnore, GP_NVM_MAX_TOKENLENGTH, (uint8_t*)&extTag);
+        if(nvm_result != gpNvm_Result_DataAvailable)
+        {
+            qv_status = QV_STATUS_INVALID_DATA;
+            goto _cleanup;
+        }
+
+        idExt += 1;
+        nrOfMatches -= 1;
+    }
+    qvCHIP_KvsIndexSetFragments(pIndex, 0);
+    KVS_REQUEST_NVM_MAINTENANCE();
+
+_cleanup:
+
+    if(lookupBuilt)
+    {
+        gpNvm_FreeLookup(handle);
+    }
+    hal_MutexRelease(qvCHIP_KvsMutex);
+    return qv_status;
+    /* </CodeGenerator Placeholder> Implementation_qvCHIP_KvsDelete */
+}
+
+qvStatus_t qvCHIP_KvsErasePartition(void)
+{
+    /* <CodeGenerator Placeholder> Implementation_qvCHIP_KvsErasePartition */
+    // When using this function, advise to trigger a reset in a higher lever afterwards to make sure everything
+    // is cleaned up. [qvCHIP_ResetSystem API can be used to trigger the reset].
+    // see <matter repo>/src/platform/qpg/ConfigurationManagerImpl.cpp - ConfigurationManagerImpl::DoFactoryReset
+
+    qvStatus_t res = QV_STATUS_NO_ERROR;
+
+    gpNvm_ErasePool(gpNvm_PoolId_AllPoolIds);
+
+    hal_MutexAcquire(qvCHIP_KvsMutex);
+#ifdef QVCHIP_DIVERSITY_KVS_INDEX_CACHE
+    MEMSET(qvCHIP_KvsIndex, 0, sizeof(qvCHIP_KvsIndex));
+#endif //QVCHIP_DIVERSITY_KVS_INDEX_CACHE
+#ifdef QVCHIP_DIVERSITY_KVS_BATCH
+    qvCHIP_KvsBatchOpen = false;
+    qvCHIP_KvsBatchPending = false;
+#endif //QVCHIP_DIVERSITY_KVS_BATCH
+    qvCHIP_KvsStreamsInvalidate(NULL);
+    hal_MutexRelease(qvCHIP_KvsMutex);
+
+    return res;
     /* </CodeGenerator Placeholder> Implementation_qvCHIP_KvsErasePartition */
 }
+
+qvStatus_t qvCHIP_KvsGetIndexStats(qvCHIP_KvsIndexStats_t* pStats)
+{
+    if(pStats == NULL)
+    {
+        return QV_STATUS_INVALID_ARGUMENT;
+    }
+#ifdef QVCHIP_DIVERSITY_KVS_INDEX_CACHE
+    hal_MutexAcquire(qvCHIP_KvsMutex);
+    MEMCPY(pStats, &qvCHIP_KvsIndexStats, sizeof(qvCHIP_KvsIndexStats_t));
+    hal_MutexRelease(qvCHIP_KvsMutex);
+    return QV_STATUS_NO_ERROR;
+#else
+    MEMSET(pStats, 0, sizeof(qvCHIP_KvsIndexStats_t));
+    return QV_STATUS_NOT_IMPLEMENTED;
+#endif //QVCHIP_DIVERSITY_KVS_INDEX_CACHE
+}
+
+qvStatus_t qvCHIP_KvsStreamOpen(const char* key, qvCHIP_KvsStreamHandle_t* pHandle, size_t* pValueSize)
+{
+    gpNvm_LookupTable_Handle_t handle = gpNvm_LookupTable_Handle_Invalid;
+    qvCHIP_KvsIndexEntry_t* pIndex;
+    qvCHIP_KvsStream_t* pStream = NULL;
+    Bool lookupBuilt = false;
+    uint8_t lastFragment[MAX_KVS_VALUE_LEN];
+    size_t lastFragmentSize;
+    UIntLoop i;
+
+    qvStatus_t qv_status = QV_STATUS_NO_ERROR;
+
+    if((key == NULL) || (pHandle == NULL))
+    {
+        return QV_STATUS_INVALID_ARGUMENT;
+    }
+    *pHandle = QVCHIP_KVS_STREAM_HANDLE_INVALID;
+
+    hal_MutexAcquire(qvCHIP_KvsMutex);
+
+    for(i = 0; i < QVCHIP_KVS_NR_OF_STREAMS; i++)
+    {
+        if(!qvCHIP_KvsStreams[i].inUse)
+        {
+            pStream = &qvCHIP_KvsStreams[i];
+            break;
+        }
+    }
+    if(pStream == NULL)
+    {
+        qv_status = QV_STATUS_WRONG_STATE;
+        goto _cleanup;
+    }
+
+    qv_status = qvCHIP_KvsGetExtTag(key, &pStream->extTag, &pIndex);
+    if(QV_STATUS_NO_ERROR != qv_status)
+    {
+        goto _cleanup;
+    }
+    qv_status = qvCHIP_KvsBuildFragmentLookup(&pStream->extTag, pIndex, &handle, &pStream->nrOfFragments, &lookupBuilt);
+    if(QV_STATUS_NO_ERROR != qv_status)
+    {
+        goto _cleanup;
+    }
+
+    /* only the last fragment can be partially filled - its size completes the value size */
+    qv_status = qvCHIP_KvsReadRange(handle, &pStream->extTag, pStream->nrOfFragments,
+                                    (size_t)(pStream->nrOfFragments - 1) * MAX_KVS_VALUE_LEN,
+                                    lastFragment, sizeof(lastFragment), &lastFragmentSize);
+    if(QV_STATUS_NO_ERROR != qv_status)
+    {
+        goto _cleanup;
+    }
+
+    pStream->valueSize = (size_t)(pStream->nrOfFragments - 1) * MAX_KVS_VALUE_LEN + lastFragmentSize;
+    pStream->stale = false;
+    pStream->inUse = true;
+    *pHandle = (qvCHIP_KvsStreamHandle_t)(pStream - qvCHIP_KvsStreams);
+    if(pValueSize != NULL)
+    {
+        *pValueSize = pStream->valueSize;
+    }
+
+_cleanup:
+    if(lookupBuilt)
+    {
+        gpNvm_FreeLookup(handle);
+    }
+    hal_MutexRelease(qvCHIP_KvsMutex);
+    return qv_status;
+}
+
+qvStatus_t qvCHIP_KvsStreamRead(qvCHIP_KvsStreamHandle_t streamHandle, size_t offsetBytes, void* buffer, size_t bufferSize,
+                                size_t* readBytesSize)
+{
+    gpNvm_LookupTable_Handle_t handle = gpNvm_LookupTable_Handle_Invalid;
+    qvCHIP_KvsStream_t* pStream;
+    Bool lookupBuilt = false;
+    uint8_t nrOfFragments;
+
+    qvStatus_t qv_status = QV_STATUS_NO_ERROR;
+
+    if((streamHandle >= QVCHIP_KVS_NR_OF_STREAMS) || (buffer == NULL) || (readBytesSize == NULL))
+    {
+        return QV_STATUS_INVALID_ARGUMENT;
+    }
+    *readBytesSize = 0;
+
+    hal_MutexAcquire(qvCHIP_KvsMutex);
+
+    pStream = &qvCHIP_KvsStreams[streamHandle];
+    if(!pStream->inUse || pStream->stale)
+    {
+        qv_status = QV_STATUS_WRONG_STATE;
+        goto _cleanup;
+    }
+    if(offsetBytes >= pStream->valueSize)
+    {
+        goto _cleanup;
+    }
+
+    /* the lookup is not kept between reads: writes to other keys and compaction move the fragments,
+     * only the fragment count of the opened value is checked */
+    qv_status = qvCHIP_KvsBuildFragmentLookup(&pStream->extTag, NULL, &handle, &nrOfFragments, &lookupBuilt);
+    if((QV_STATUS_NO_ERROR != qv_status) || (nrOfFragments != pStream->nrOfFragments))
+    {
+        pStream->stale = true;
+        qv_status = QV_STATUS_WRONG_STATE;
+        goto _cleanup;
+    }
+
+    qv_status = qvCHIP_KvsReadRange(handle, &pStream->extTag, nrOfFragments, offsetBytes, (uint8_t*)buffer,
+                                    MIN(bufferSize, pStream->valueSize - offsetBytes), readBytesSize);
+    if(QV_STATUS_BUFFER_TOO_SMALL == qv_status)
+    {
+        /* partial reads are the purpose of a stream */
+        qv_status = QV_STATUS_NO_ERROR;
+    }
+
+_cleanup:
+    if(lookupBuilt)
+    {
+        gpNvm_FreeLookup(handle);
+    }
+    hal_MutexRelease(qvCHIP_KvsMutex);
+    return qv_status;
+}
+
+qvStatus_t qvCHIP_KvsStreamClose(qvCHIP_KvsStreamHandle_t streamHandle)
+{
+    if(streamHandle >= QVCHIP_KVS_NR_OF_STREAMS)
+    {
+        return QV_STATUS_INVALID_ARGUMENT;
+    }
+
+    hal_MutexAcquire(qvCHIP_KvsMutex);
+    qvCHIP_KvsStreams[streamHandle].inUse = false;
+    hal_MutexRelease(qvCHIP_KvsMutex);
+
+    return QV_STATUS_NO_ERROR;
+}
+
+#ifdef QVCHIP_DIVERSITY_KVS_BATCH
+qvStatus_t qvCHIP_KvsBatchBegin(void)
+{
+    qvStatus_t qv_status = QV_STATUS_NO_ERROR;
+
+    hal_MutexAcquire(qvCHIP_KvsMutex);
+    if(qvCHIP_KvsBatchOpen || (QV_STATUS_NO_ERROR != qvCHIP_KvsBatchCheckPending(NULL)))
+    {
+        qv_status = QV_STATUS_WRONG_STATE;
+    }
+    else
+    {
+        qvCHIP_KvsBatchOpen = true;
+        qvCHIP_KvsBatchFailed = false;
+        qvCHIP_KvsBatch.nrOfOps = 0;
+    }
+    hal_MutexRelease(qvCHIP_KvsMutex);
+
+    return qv_status;
+}
+
+qvStatus_t qvCHIP_KvsBatchPut(const char* key, const void* value, size_t valueSize)
+{
+    qvStatus_t qv_status;
+    qvCHIP_KVS_Tag stagedTag;
+    qvCHIP_KvsIndexEntry_t* pIndex;
+    qvCHIP_KvsBatchOp_t* pOp;
+    qvCHIP_KvsBatchOp_t prevOp;
+    Bool newOp = false;
+    uint8_t nrOfFragments;
+
+    if((key == NULL) || (value == NULL) || (valueSize == 0))
+    {
+        return QV_STATUS_INVALID_ARGUMENT;
+    }
+
+    hal_MutexAcquire(qvCHIP_KvsMutex);
+
+    if(!qvCHIP_KvsBatchOpen)
+    {
+        qv_status = QV_STATUS_WRONG_STATE;
+        goto _cleanup;
+    }
+    qv_status = qvCHIP_KvsGetExtTag(key, &stagedTag, &pIndex);
+    if(QV_STATUS_NO_ERROR != qv_status)
+    {
+        goto _cleanup;
+    }
+
+    pOp = qvCHIP_KvsBatchFindOp(stagedTag.key);
+    if(pOp == NULL)
+    {
+        if(qvCHIP_KvsBatch.nrOfOps >= QVCHIP_KVS_BATCH_MAX_OPS)
+        {
+            qv_status = QV_STATUS_BUFFER_TOO_SMALL;
+            goto _cleanup;
+        }
+        pOp = &qvCHIP_KvsBatch.ops[qvCHIP_KvsBatch.nrOfOps++];
+        pOp->op = KVS_BATCH_OP_DELETE;
+        pOp->nrOfFragments = 0;
+        MEMCPY(pOp->key, stagedTag.key, MAX_KVS_KEY_LEN);
+        newOp = true;
+    }
+    MEMCPY(&prevOp, pOp, sizeof(qvCHIP_KvsBatchOp_t));
+
+    /* stage the value next to the live one */
+    stagedTag.componentId = QVCHIP_KVS_BATCH_COMPONENT_ID;
+    qv_status = qvCHIP_KvsWriteFragments(&stagedTag, (const uint8_t*)value, valueSize, &nrOfFragments);
+    if(QV_STATUS_NO_ERROR != qv_status)
+    {
+        pOp->nrOfFragments = MAX(pOp->nrOfFragments, nrOfFragments);
+        pOp->op = KVS_BATCH_OP_PUT;
+        qvCHIP_KvsBatchRemoveStaged(pOp, 0);
+        if(newOp)
+        {
+            qvCHIP_KvsBatchDropOp(pOp);
+        }
+        else
+        {
+            /* a staged delete is restored, a staged put was (partly) overwritten and is lost */
+            MEMCPY(pOp, &prevOp, sizeof(qvCHIP_KvsBatchOp_t));
+            if(prevOp.op == KVS_BATCH_OP_PUT)
+            {
+                pOp->nrOfFragments = 0;
+                qvCHIP_KvsBatchFailed = true;
+            }
+        }
+        goto _cleanup;
+    }
+    if(pOp->op == KVS_BATCH_OP_PUT)
+    {
+        /* previously staged value was longer */
+        qvCHIP_KvsBatchRemoveStaged(pOp, nrOfFragments);
+    }
+    pOp->op = KVS_BATCH_OP_PUT;
+    pOp->nrOfFragments = nrOfFragments;
+
+_cleanup:
+    hal_MutexRelease(qvCHIP_KvsMutex);
+    return qv_status;
+}
+
+qvStatus_t qvCHIP_KvsBatchDelete(const char* key)
+{
+    qvStatus_t qv_status;
+    qvCHIP_KVS_Tag extTag;
+    qvCHIP_KvsIndexEntry_t* pIndex;
+    qvCHIP_KvsBatchOp_t* pOp;
+
+    if(key == NULL)
+    {
+        return QV_STATUS_INVALID_ARGUMENT;
+    }
+
+    hal_MutexAcquire(qvCHIP_KvsMutex);
+
+    if(!qvCHIP_KvsBatchOpen)
+    {
+        qv_status = QV_STATUS_WRONG_STATE;
+        goto _cleanup;
+    }
+    qv_status = qvCHIP_KvsGetExtTag(key, &extTag, &pIndex);
+    if(QV_STATUS_NO_ERROR != qv_status)
+    {
+        goto _cleanup;
+    }
+
+    pOp = qvCHIP_KvsBatchFindOp(extTag.key);
+    if(pOp == NULL)
+    {
+        if(qvCHIP_KvsBatch.nrOfOps >= QVCHIP_KVS_BATCH_MAX_OPS)
+        {
+            qv_status = QV_STATUS_BUFFER_TOO_SMALL;
+            goto _cleanup;
+        }
+        pOp = &qvCHIP_KvsBatch.ops[qvCHIP_KvsBatch.nrOfOps++];
+        MEMCPY(pOp->key, extTag.key, MAX_KVS_KEY_LEN);
+    }
+    else
+    {
+        qvCHIP_KvsBatchRemoveStaged(pOp, 0);
+    }
+    pOp->op = KVS_BATCH_OP_DELETE;
+    pOp->nrOfFragments = 0;
+
+_cleanup:
+    hal_MutexRelease(qvCHIP_KvsMutex);
+    return qv_status;
+}
+
+qvStatus_t qvCHIP_KvsBatchCommit(void)
+{
+    qvStatus_t qv_status = QV_STATUS_NO_ERROR;
+    gpNvm_Result_t nvm_result;
+    qvCHIP_KVS_Tag commitTag;
+    UIntLoop i;
+
+    hal_MutexAcquire(qvCHIP_KvsMutex);
+
+    if(!qvCHIP_KvsBatchOpen)
+    {
+        qv_status = QV_STATUS_WRONG_STATE;
+        goto _cleanup;
+    }
+    if(qvCHIP_KvsBatchFailed)
+    {
+        for(i = 0; i < qvCHIP_KvsBatch.nrOfOps; i++)
+        {
+            qvCHIP_KvsBatchRemoveStaged(&qvCHIP_KvsBatch.ops[i], 0);
+        }
+        qv_status = QV_STATUS_INVALID_DATA;
+    }
+    else if(qvCHIP_KvsBatch.nrOfOps > 0)
+    {
+        /* from here on the batch survives a reset */
+        qvCHIP_KvsBatchSetCommitTag(&commitTag);
+        GP_UTILS_PROF_START(nvm);
+        nvm_result = gpNvm_Write(KVS_POOL_ID, gpNvm_UpdateFrequencyIgnore, GP_NVM_MAX_TOKENLENGTH, (uint8_t*)&commitTag,
+                                 KVS_BATCH_RECORD_SIZE(qvCHIP_KvsBatch.nrOfOps), (uint8_t*)&qvCHIP_KvsBatch);
+        GP_UTILS_PROF_STOP(nvm, gpUtils_ProfProbeNvmWrite);
+        if((nvm_result != gpNvm_Result_DataAvailable) && (nvm_result != gpNvm_Result_NoDataAvailable))
+        {
+            for(i = 0; i < qvCHIP_KvsBatch.nrOfOps; i++)
+            {
+                qvCHIP_KvsBatchRemoveStaged(&qvCHIP_KvsBatch.ops[i], 0);
+            }
+            qv_status = QV_STATUS_INVALID_DATA;
+        }
+        else
+        {
+            qv_status = qvCHIP_KvsBatchFinish(&qvCHIP_KvsBatch);
+            qvCHIP_KvsBatchPending = (QV_STATUS_NO_ERROR != qv_status);
+        }
+    }
+    qvCHIP_KvsBatchOpen = false;
+
+_cleanup:
+    hal_MutexRelease(qvCHIP_KvsMutex);
+    return qv_status;
+}
+
+qvStatus_t qvCHIP_KvsBatchAbort(void)
+{
+    qvStatus_t qv_status = QV_STATUS_NO_ERROR;
+    UIntLoop i;
+
+    hal_MutexAcquire(qvCHIP_KvsMutex);
+
+    if(!qvCHIP_KvsBatchOpen)
+    {
+        qv_status = QV_STATUS_WRONG_STATE;
+    }
+    else
+    {
+        for(i = 0; i < qvCHIP_KvsBatch.nrOfOps; i++)
+        {
+            qvCHIP_KvsBatchRemoveStaged(&qvCHIP_KvsBatch.ops[i], 0);
+        }
+        qvCHIP_KvsBatchOpen = false;
+    }
+
+    hal_MutexRelease(qvCHIP_KvsMutex);
+    return qv_status;
+}
+#else
+qvStatus_t qvCHIP_KvsBatchBegin(void)
+{
+    return QV_STATUS_NOT_IMPLEMENTED;
+}
+
+qvStatus_t qvCHIP_KvsBatchPut(const char* key, const void* value, size_t valueSize)
+{
+    NOT_USED(key);
+    NOT_USED(value);
+    NOT_USED(valueSize);
+    return QV_STATUS_NOT_IMPLEMENTED;
+}
+
+qvStatus_t qvCHIP_KvsBatchDelete(const char* key)
+{
+    NOT_USED(key);
+    return QV_STATUS_NOT_IMPLEMENTED;
+}
+
+qvStatus_t qvCHIP_KvsBatchCommit(void)
+{
+    return QV_STATUS_NOT_IMPLEMENTED;
+}
+
+qvStatus_t qvCHIP_KvsBatchAbort(void)
+{
+    return QV_STATUS_NOT_IMPLEMENTED;
+}
+#endif //QVCHIP_DIVERSITY_KVS_BATCH
@@ -175,6 +175,11 @@ qvCHIP_OtaStatus_t qvCHIP_OtaWriteChunk(uint32_t offset, uint16_t length, uint8_
     return (qvCHIP_OtaStatus_t)gpUpgrade_WriteChunk(memorymap_offset, length, dataChunk);
 }
 
+qvCHIP_OtaStatus_t qvCHIP_OtaFlushWrite(void)
+{
+    return (qvCHIP_OtaStatus_t)gpUpgrade_FlushWrite();
+}
+
 qvCHIP_OtaStatus_t qvCHIP_OtaReadChunk(uint32_t offset, uint16_t length, uint8_t* dataChunk)
 {
     qvCHIP_OtaStatus_t result;
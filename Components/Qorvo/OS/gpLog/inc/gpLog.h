@@ -97,6 +97,56 @@
 #define gpLog_Flush()
 #endif //GP_DIVERSITY_LOG
 
+#if defined(GP_DIVERSITY_LOG) && defined(GP_LOG_DIVERSITY_DEFERRED) && !defined(GP_DIVERSITY_ROM_CODE) && !defined(__cplusplus)
+/* Deferred logging: the call only records the format string address and the arguments, converted to
+   UInt32 - the first variadic argument is the deprecated length parameter of gpLog_Printf.
+   Format strings are resolved from the ELF file by jadelogger.py.
+   Only integer arguments of at most 32 bits are accepted: pointers, strings, floating point and 64-bit
+   values have no matching _Generic association and are rejected at compile time. */
+#define GP_LOG_DEFERRED_ARG(x) _Generic((x),  \
+    _Bool: (UInt32)(x),                       \
+    char: (UInt32)(x),                        \
+    signed char: (UInt32)(x),                 \
+    unsigned char: (UInt32)(x),               \
+    short: (UInt32)(x),                       \
+    unsigned short: (UInt32)(x),              \
+    int: (UInt32)(x),                         \
+    unsigned int: (UInt32)(x),                \
+    long: (UInt32)(x),                        \
+    unsigned long: (UInt32)(x))
+
+/* Apply GP_LOG_DEFERRED_ARG to each of up to 12 arguments (length parameter included) */
+#define GP_LOG_DEFERRED_CAT_(a, b) a##b
+#define GP_LOG_DEFERRED_CAT(a, b)  GP_LOG_DEFERRED_CAT_(a, b)
+#define GP_LOG_DEFERRED_NARG_(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, N, ...) N
+#define GP_LOG_DEFERRED_NARG(...)  GP_LOG_DEFERRED_NARG_(__VA_ARGS__, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1)
+#define GP_LOG_DEFERRED_MAP_1(x)       GP_LOG_DEFERRED_ARG(x)
+#define GP_LOG_DEFERRED_MAP_2(x, ...)  GP_LOG_DEFERRED_ARG(x), GP_LOG_DEFERRED_MAP_1(__VA_ARGS__)
+#define GP_LOG_DEFERRED_MAP_3(x, ...)  GP_LOG_DEFERRED_ARG(x), GP_LOG_DEFERRED_MAP_2(__VA_ARGS__)
+#define GP_LOG_DEFERRED_MAP_4(x, ...)  GP_LOG_DEFERRED_ARG(x), GP_LOG_DEFERRED_MAP_3(__VA_ARGS__)
+#define GP_LOG_DEFERRED_MAP_5(x, ...)  GP_LOG_DEFERRED_ARG(x), GP_LOG_DEFERRED_MAP_4(__VA_ARGS__)
+#define GP_LOG_DEFERRED_MAP_6(x, ...)  GP_LOG_DEFERRED_ARG(x), GP_LOG_DEFERRED_MAP_5(__VA_ARGS__)
+#define GP_LOG_DEFERRED_MAP_7(x, ...)  GP_LOG_DEFERRED_ARG(x), GP_LOG_DEFERRED_MAP_6(__VA_ARGS__)
+#define GP_LOG_DEFERRED_MAP_8(x, ...)  GP_LOG_DEFERRED_ARG(x), GP_LOG_DEFERRED_MAP_7(__VA_ARGS__)
+#define GP_LOG_DEFERRED_MAP_9(x, ...)  GP_LOG_DEFERRED_ARG(x), GP_LOG_DEFERRED_MAP_8(__VA_ARGS__)
+#define GP_LOG_DEFERRED_MAP_10(x, ...) GP_LOG_DEFERRED_ARG(x), GP_LOG_DEFERRED_MAP_9(__VA_ARGS__)
+#define GP_LOG_DEFERRED_MAP_11(x, ...) GP_LOG_DEFERRED_ARG(x), GP_LOG_DEFERRED_MAP_10(__VA_ARGS__)
+#define GP_LOG_DEFERRED_MAP_12(x, ...) GP_LOG_DEFERRED_ARG(x), GP_LOG_DEFERRED_MAP_11(__VA_ARGS__)
+#define GP_LOG_DEFERRED_ARGS(...) \
+    ((const UInt32[]){GP_LOG_DEFERRED_CAT(GP_LOG_DEFERRED_MAP_, GP_LOG_DEFERRED_NARG(__VA_ARGS__))(__VA_ARGS__)})
+#define GP_LOG_DEFERRED_PRINTF(s, ...)                                                                     \
+    gpLog_PrintfDeferred(GP_COMPONENT_ID, GP_LOG_PSTR(s),                                                 \
+                         (UInt8)(sizeof(GP_LOG_DEFERRED_ARGS(__VA_ARGS__)) / sizeof(UInt32) - 1),         \
+                         &GP_LOG_DEFERRED_ARGS(__VA_ARGS__)[1])
+
+#undef GP_LOG_SYSTEM_PRINTF
+#define GP_LOG_SYSTEM_PRINTF(s, ...) GP_LOG_DEFERRED_PRINTF(s, __VA_ARGS__)
+#if defined(GP_LOCAL_LOG)
+#undef GP_LOG_PRINTF
+#define GP_LOG_PRINTF(s, ...) GP_LOG_DEFERRED_PRINTF(s, __VA_ARGS__)
+#endif //GP_LOCAL_LOG
+#endif //GP_LOG_DIVERSITY_DEFERRED
+
 #define gpLog_PrintfEnable(enable)
 
 /* Print bits easily */
@@ -163,6 +213,18 @@ GP_API void gpLog_Printf(UInt8 componentID, Bool progmem, FLASH_STRING format_st
 
 
 #ifdef GP_DIVERSITY_LOG
+#ifdef GP_LOG_DIVERSITY_DEFERRED
+/**
+*   @brief Records a log call to be sent later from the scheduler. Used through GP_LOG_SYSTEM_PRINTF.
+*
+*   @param    componentID Component ID of component calling the print function.
+*   @param    format_str  Format string in flash - only its address is stored, so it must stay valid.
+*   @param    nrOfArgs    Number of arguments in pArgs.
+*   @param    pArgs       Arguments of the format string.
+*/
+GP_API void gpLog_PrintfDeferred(UInt8 componentID, FLASH_STRING format_str, UInt8 nrOfArgs, const UInt32* pArgs);
+#endif //GP_LOG_DIVERSITY_DEFERRED
+
 /**
 *   @brief Prints a data buffer in hex format.
 *
@@ -49,6 +49,9 @@
 #include "gpCom.h"
 
 #include "gpAssert.h"
+#ifdef GP_LOG_DIVERSITY_DEFERRED
+#include "gpSched.h"
+#endif //GP_LOG_DIVERSITY_DEFERRED
 
 #include <stdarg.h>             // va_arg()
 #include <string.h>             // memmove()
@@ -82,6 +85,29 @@
 #define GP_LOG_COMMUNICATION_ID                  GP_COM_DEFAULT_COMMUNICATION_ID
 #endif
 
+#ifdef GP_LOG_DIVERSITY_DEFERRED
+/* Number of log calls buffered until the drain runs - power of 2 */
+#ifndef GP_LOG_DEFERRED_RING_SIZE
+#define GP_LOG_DEFERRED_RING_SIZE               16
+#endif //GP_LOG_DEFERRED_RING_SIZE
+/* Arguments recorded per call, further arguments are dropped */
+#ifndef GP_LOG_DEFERRED_MAX_ARGS
+#define GP_LOG_DEFERRED_MAX_ARGS                6
+#endif //GP_LOG_DEFERRED_MAX_ARGS
+
+GP_COMPILE_TIME_VERIFY((GP_LOG_DEFERRED_RING_SIZE & (GP_LOG_DEFERRED_RING_SIZE - 1)) == 0);
+GP_COMPILE_TIME_VERIFY(GP_LOG_DEFERRED_RING_SIZE <= 128);
+/* GP_LOG_DEFERRED_ARG narrows long arguments to UInt32 */
+GP_COMPILE_TIME_VERIFY(sizeof(long) == sizeof(UInt32));
+
+/* Delay before the drain looks again at a record still being filled */
+#define GP_LOG_DEFERRED_RETRY_US                1000
+
+#define LOG_DEFERRED_RING_INDEX(i)              ((i) & (GP_LOG_DEFERRED_RING_SIZE - 1))
+/* format string address in front of the arguments */
+#define GP_LOG_POINTER_LENGTH                   4
+#endif //GP_LOG_DIVERSITY_DEFERRED
+
 /*****************************************************************************
  *                    Type Definitions
  *****************************************************************************/
@@ -97,18 +123,163 @@ typedef UInt8 gpLog_ParameterEndianess_t;
 #define gpLog_CommandIDPrintfIndication         0x02
 typedef UInt8 gpLog_CommandID_t;
 
+#ifdef GP_LOG_DIVERSITY_DEFERRED
+typedef struct {
+    FLASH_STRING format_str;
+    UInt32 time;
+    UInt32 args[GP_LOG_DEFERRED_MAX_ARGS];
+    UInt8 componentID;
+    UInt8 nrOfArgs;
+    volatile Bool ready;    // set once the producer filled the record
+} Log_DeferredRecord_t;
+#endif //GP_LOG_DIVERSITY_DEFERRED
+
 /*****************************************************************************
  *                    Static Data Definitions
  *****************************************************************************/
 
 static UInt8 gpLog_PrintfTotalCnt = 0;
 
+#ifdef GP_LOG_DIVERSITY_DEFERRED
+static Log_DeferredRecord_t Log_DeferredRing[GP_LOG_DEFERRED_RING_SIZE];
+/* free running indexes - reserved by producers, consumed by the drain */
+static UInt8 Log_DeferredWriteIndex;
+static UInt8 Log_DeferredReadIndex;
+static UInt8 Log_DeferredDropped;
+static Bool Log_DeferredDrainScheduled;
+#endif //GP_LOG_DIVERSITY_DEFERRED
+
 /*****************************************************************************
  *                    Static Function Prototypes
  *****************************************************************************/
 /*****************************************************************************
  *                    Static Function Definitions
  *****************************************************************************/
+
+#ifdef GP_LOG_DIVERSITY_DEFERRED
+/* Encode one record the way gpLog_Printf encodes its arguments, with the format string
+   address instead of the format string itself */
+static UInt8 Log_DeferredEncode(const Log_DeferredRecord_t* pRecord, UInt8* pBuf, UInt8 maxLength)
+{
+    Char   fmt[GP_LOG_MAX_LEN];
+    UInt8  nbr_chars = 0;
+    UInt8  argIndex = 0;
+    UInt32 address = (UInt32)(UIntPtr)pRecord->format_str;
+    UInt32 time = pRecord->time;
+    UIntLoop formatLoopCnt;
+
+    STRNCPY_P(fmt, pRecord->format_str, sizeof(fmt) - 1);
+    fmt[sizeof(fmt) - 1] = '\0';
+
+    pBuf[nbr_chars++] = gpLog_CommandIDPrintfIndication;
+    pBuf[nbr_chars++] = pRecord->componentID;
+    pBuf[nbr_chars++] = gpLog_FormatStringModePointer | (LOG_ENDIANESS << 1);
+    pBuf[nbr_chars++] = 0; //Former interval counter
+    HAL_DISABLE_GLOBAL_INT();
+    gpLog_PrintfTotalCnt++;
+    pBuf[nbr_chars++] = gpLog_PrintfTotalCnt;
+    HAL_ENABLE_GLOBAL_INT();
+    HOST_TO_LITTLE_UINT32(&time);
+    MEMCPY(&pBuf[nbr_chars], &time, 4);
+    nbr_chars += 4;
+    HOST_TO_LITTLE_UINT32(&address);
+    MEMCPY(&pBuf[nbr_chars], &address, GP_LOG_POINTER_LENGTH);
+    nbr_chars += GP_LOG_POINTER_LENGTH;
+
+    for (formatLoopCnt = 0; fmt[formatLoopCnt]; formatLoopCnt++)
+    {
+        UInt32 arg;
+
+        if (fmt[formatLoopCnt] != '%')
+        {
+            continue;
+        }
+        while (fmt[formatLoopCnt+1] >= '0' && fmt[formatLoopCnt+1] <= '9')
+        {
+            /* ignore length indicator */
+            formatLoopCnt++;
+        }
+        /* arguments missing in the record are sent as 0 */
+        arg = (argIndex < pRecord->nrOfArgs) ? pRecord->args[argIndex] : 0;
+        if (fmt[formatLoopCnt+1] == 'l')
+        {
+            if ((nbr_chars + sizeof(UInt32)) > maxLength)
+            {
+                break;
+            }
+            MEMCPY(&pBuf[nbr_chars], &arg, sizeof(UInt32));
+            nbr_chars += sizeof(UInt32);
+            argIndex++;
+        }
+        else if ((fmt[formatLoopCnt+1] == 'x') ||
+                 (fmt[formatLoopCnt+1] == 'X') ||
+                 (fmt[formatLoopCnt+1] == 'u') ||
+                 (fmt[formatLoopCnt+1] == 'i') ||
+                 (fmt[formatLoopCnt+1] == 'd') ||
+                 (fmt[formatLoopCnt+1] == 'c'))
+        {
+            UInt16 arg16 = (UInt16)(arg & 0xFFFF);
+
+            if ((nbr_chars + sizeof(UInt16)) > maxLength)
+            {
+                break;
+            }
+            MEMCPY(&pBuf[nbr_chars], &arg16, sizeof(UInt16));
+            nbr_chars += sizeof(UInt16);
+            argIndex++;
+        }
+    }
+
+    return nbr_chars;
+}
+
+/* Send all complete records, in order of reservation */
+static void Log_DeferredDrain(void)
+{
+    UInt8 log_strng[GP_LOG_HEADER_LENGTH + GP_LOG_POINTER_LENGTH + GP_LOG_DEFERRED_MAX_ARGS * sizeof(UInt32)];
+    UInt8 dropped;
+    Bool scheduleRetry;
+
+    HAL_DISABLE_GLOBAL_INT();
+    Log_DeferredDrainScheduled = false;
+    HAL_ENABLE_GLOBAL_INT();
+
+    while (Log_DeferredReadIndex != Log_DeferredWriteIndex)
+    {
+        Log_DeferredRecord_t* pRecord = &Log_DeferredRing[LOG_DEFERRED_RING_INDEX(Log_DeferredReadIndex)];
+        UInt8 length;
+
+        if (!pRecord->ready)
+        {
+            /* producer preempted while filling its record - retry later, it may have a lower priority */
+            HAL_DISABLE_GLOBAL_INT();
+            scheduleRetry = !Log_DeferredDrainScheduled;
+            Log_DeferredDrainScheduled = true;
+            HAL_ENABLE_GLOBAL_INT();
+            if (scheduleRetry)
+            {
+                gpSched_ScheduleEvent(GP_LOG_DEFERRED_RETRY_US, Log_DeferredDrain);
+            }
+            break;
+        }
+        length = Log_DeferredEncode(pRecord, log_strng, sizeof(log_strng));
+        pRecord->ready = false;
+        Log_DeferredReadIndex++;
+
+        gpCom_DataRequest(GP_COMPONENT_ID_LOG, length, log_strng, GP_LOG_COMMUNICATION_ID);
+    }
+
+    HAL_DISABLE_GLOBAL_INT();
+    dropped = Log_DeferredDropped;
+    Log_DeferredDropped = 0;
+    HAL_ENABLE_GLOBAL_INT();
+    if (dropped)
+    {
+        gpLog_Printf(GP_COMPONENT_ID, true, GP_LOG_PSTR("Log ring overflow: %u dropped"), 0, dropped);
+    }
+}
+#endif //GP_LOG_DIVERSITY_DEFERRED
+
 /*****************************************************************************
  *                    Public Function Definitions
  *****************************************************************************/
@@ -116,9 +287,68 @@ void gpLog_Init(void)
 {
     HAL_DISABLE_GLOBAL_INT();
     gpLog_PrintfTotalCnt = 0;
+#ifdef GP_LOG_DIVERSITY_DEFERRED
+    MEMSET(Log_DeferredRing, 0, sizeof(Log_DeferredRing));
+    Log_DeferredWriteIndex = 0;
+    Log_DeferredReadIndex = 0;
+    Log_DeferredDropped = 0;
+    Log_DeferredDrainScheduled = false;
+#endif //GP_LOG_DIVERSITY_DEFERRED
     HAL_ENABLE_GLOBAL_INT();
 }
 
+#ifdef GP_LOG_DIVERSITY_DEFERRED
+void gpLog_PrintfDeferred(UInt8 componentID, FLASH_STRING format_str, UInt8 nrOfArgs, const UInt32* pArgs)
+{
+    Log_DeferredRecord_t* pRecord;
+    Bool scheduleDrain;
+    UIntLoop i;
+
+    if (!gpCom_GetTXEnable())
+    {
+        return;
+    }
+
+    /* only the slot reservation is atomic, the record is filled with interrupts enabled */
+    HAL_DISABLE_GLOBAL_INT();
+    if ((UInt8)(Log_DeferredWriteIndex - Log_DeferredReadIndex) >= GP_LOG_DEFERRED_RING_SIZE)
+    {
+        if (Log_DeferredDropped < 0xFF)
+        {
+            Log_DeferredDropped++;
+        }
+        HAL_ENABLE_GLOBAL_INT();
+        return;
+    }
+    pRecord = &Log_DeferredRing[LOG_DEFERRED_RING_INDEX(Log_DeferredWriteIndex)];
+    Log_DeferredWriteIndex++;
+    scheduleDrain = !Log_DeferredDrainScheduled;
+    Log_DeferredDrainScheduled = true;
+    HAL_ENABLE_GLOBAL_INT();
+
+    HAL_TIMER_GET_CURRENT_TIME(pRecord->time);
+    pRecord->format_str = format_str;
+    pRecord->componentID = componentID;
+    if (nrOfArgs > GP_LOG_DEFERRED_MAX_ARGS)
+    {
+        nrOfArgs = GP_LOG_DEFERRED_MAX_ARGS;
+    }
+    for (i = 0; i < nrOfArgs; i++)
+    {
+        pRecord->args[i] = pArgs[i];
+    }
+    pRecord->nrOfArgs = nrOfArgs;
+    // Record must be written before it is published to the drain
+    __DMB();
+    pRecord->ready = true;
+
+    if (scheduleDrain)
+    {
+        gpSched_ScheduleEvent(0, Log_DeferredDrain);
+    }
+}
+#endif //GP_LOG_DIVERSITY_DEFERRED
+
 
 static void Log_SizeErr(UInt8 componentID, FLASH_STRING format_str,Bool progmem)
 {
@@ -267,6 +497,9 @@ overflow:
 
 void gpLog_Flush(void)
 {
+#ifdef GP_LOG_DIVERSITY_DEFERRED
+    Log_DeferredDrain();
+#endif //GP_LOG_DIVERSITY_DEFERRED
     gpCom_Flush();
 }
 
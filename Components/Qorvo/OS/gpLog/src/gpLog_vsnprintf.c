@@ -45,6 +45,10 @@
 #include <string.h>             // memmove()
 #include <stdio.h>              // memmove()
 
+#ifdef GP_LOG_DIVERSITY_DEFERRED
+#error GP_LOG_DIVERSITY_DEFERRED is only implemented by gpLog.c, build gpLog.c instead of gpLog_vsnprintf.c
+#endif //GP_LOG_DIVERSITY_DEFERRED
+
 /*****************************************************************************
  *                    Macro Definitions
  *****************************************************************************/
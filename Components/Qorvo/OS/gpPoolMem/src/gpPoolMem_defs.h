@@ -104,6 +104,45 @@
 #define GP_POOLMEM_MAX_ENTRIES (GP_POOLMEM_CHUNK_AMOUNT1 + GP_POOLMEM_CHUNK_AMOUNT2 + GP_POOLMEM_CHUNK_AMOUNT3)
 #endif // GP_POOLMEM_PD_AMOUNT
 
+/* Size classes used by the slab backend (gpPoolMem_impl_slab.c), max 4 classes in ascending size */
+
+/** @ingroup DEF_POOLMEM
+ *  @brief Data size of slab class 1..4
+*/
+#ifndef GP_POOLMEM_SLAB_SIZE1
+#define GP_POOLMEM_SLAB_SIZE1 32
+#endif //GP_POOLMEM_SLAB_SIZE1
+#ifndef GP_POOLMEM_SLAB_SIZE2
+#define GP_POOLMEM_SLAB_SIZE2 64
+#endif //GP_POOLMEM_SLAB_SIZE2
+#ifndef GP_POOLMEM_SLAB_SIZE3
+#define GP_POOLMEM_SLAB_SIZE3 128
+#endif //GP_POOLMEM_SLAB_SIZE3
+#ifndef GP_POOLMEM_SLAB_SIZE4
+#define GP_POOLMEM_SLAB_SIZE4 256
+#endif //GP_POOLMEM_SLAB_SIZE4
+/** @ingroup DEF_POOLMEM
+ *  @brief Amount of slots in slab class 1..4 - a class with amount 0 is left out
+*/
+#ifndef GP_POOLMEM_SLAB_AMOUNT1
+#define GP_POOLMEM_SLAB_AMOUNT1 8
+#endif //GP_POOLMEM_SLAB_AMOUNT1
+#ifndef GP_POOLMEM_SLAB_AMOUNT2
+#define GP_POOLMEM_SLAB_AMOUNT2 8
+#endif //GP_POOLMEM_SLAB_AMOUNT2
+#ifndef GP_POOLMEM_SLAB_AMOUNT3
+#define GP_POOLMEM_SLAB_AMOUNT3 4
+#endif //GP_POOLMEM_SLAB_AMOUNT3
+#ifndef GP_POOLMEM_SLAB_AMOUNT4
+#define GP_POOLMEM_SLAB_AMOUNT4 2
+#endif //GP_POOLMEM_SLAB_AMOUNT4
+/** @ingroup DEF_POOLMEM
+ *  @brief Number of components tracked individually by the slab backend, others are accounted together
+*/
+#ifndef GP_POOLMEM_SLAB_NR_OF_COMP_STATS
+#define GP_POOLMEM_SLAB_NR_OF_COMP_STATS 8
+#endif //GP_POOLMEM_SLAB_NR_OF_COMP_STATS
+
 #ifdef ALIGNMENT_NEEDED
 typedef UInt32 GUARD;
 #else
@@ -0,0 +1,514 @@
+/*
+ * Copyright (c) 2026, Qorvo Inc
+ *
+ * This file implements a pool memory allocator using segregated size-class slabs
+ *
+ * This software is owned by Qorvo Inc
+ * and protected under applicable copyright law
+ * It is delivered under the terms of the license
+ * and is intended and supplied for use solely and
+ * exclusively with products manufactured by
+ * Qorvo Inc
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED IN AN "AS IS"
+ * CONDITION. NO WARRANTIES, WHETHER EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING, BUT NOT
+ * LIMITED TO, IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ * QORVO INC. SHALL NOT, IN ANY
+ * CIRCUMSTANCES, BE LIABLE FOR SPECIAL,
+ * INCIDENTAL OR CONSEQUENTIAL DAMAGES,
+ * FOR ANY REASON WHATSOEVER.
+ *
+ * Alternatively, this software may be distributed under the terms of the
+ * modified BSD License or the 3-clause BSD License as published by the Free
+ * Software Foundation @ https://directory.fsf.org/wiki/License:BSD-3-Clause
+ *
+ * $Header$
+ * $Change$
+ * $DateTime$
+ *
+ */
+
+/*
+ * Alternative for gpPoolMem_impl.c / gpPoolMem_impl_malloc.c (select one of the three in the build).
+ *
+ * Every size class owns a static array of equally sized slots. Free slots of a class are
+ * chained through their header, so malloc pops and free pushes in constant time. The owning
+ * slot of a pointer is derived from the header in front of the data and verified against the
+ * class storage range, no list walk is needed.
+ *
+ * Slot layout: | header (GuardStart, compId, class, link, nbytes) | data[nbytes] | GUARD | pad |
+ * The end guard is placed right after the requested size, so small overruns are caught too.
+ */
+
+#define GP_COMPONENT_ID GP_COMPONENT_ID_POOLMEM
+#define GP_MODULE_ID GP_MODULE_ID_POOLMEM
+
+//#define GP_LOCAL_LOG
+
+/*****************************************************************************
+ *                    Include Definitions
+ *****************************************************************************/
+
+#include "hal.h"
+#include "gpLog.h"
+#include "gpAssert.h"
+#include "gpPoolMem.h"
+#include "gpPoolMem_defs.h"
+
+/*****************************************************************************
+ *                    Type Definitions
+ *****************************************************************************/
+
+typedef struct {
+    GUARD  guardStart;
+    UInt8  compId;      // GP_POOLMEM_NOTUSED when free
+    UInt8  classId;
+    UInt16 link;        // Next free slot of the class while free
+    UInt16 nbytes;      // Requested size while in use
+} PoolMem_SlabHdr_t;
+
+typedef struct {
+    UInt8* pStorage;
+    UInt16 dataSize;
+    UInt16 slotSize;
+    UInt16 amount;
+} PoolMem_SlabClass_t;
+
+typedef struct {
+    UInt16 freeHead;
+    UInt16 inUse;
+    UInt16 peak;
+    UInt16 failed;      // Requests that had to move to a bigger class or failed entirely
+    UInt32 requested;   // Sum of requested bytes of slots in use
+} PoolMem_SlabClassState_t;
+
+typedef struct {
+    UInt8  compId;
+    UInt16 chunks;
+    UInt32 liveBytes;
+    UInt32 peakBytes;
+} PoolMem_SlabCompStats_t;
+
+/*****************************************************************************
+ *                    Macro Definitions
+ *****************************************************************************/
+
+#define POOLMEM_SLAB_NR_OF_CLASSES  4
+#define POOLMEM_SLAB_NONE           0xFFFF
+
+#define POOLMEM_SLAB_ALIGN(n)       (((n) + 3UL) & ~3UL)
+#define POOLMEM_SLAB_SLOT_SIZE(size) (sizeof(PoolMem_SlabHdr_t) + POOLMEM_SLAB_ALIGN((size) + sizeof(GUARD)))
+#define POOLMEM_SLAB_STORAGE_WORDS(size, amount) ((POOLMEM_SLAB_SLOT_SIZE(size) / sizeof(UInt32)) * (amount))
+
+#define POOLMEM_SLAB_HDR(pClass, idx) ((PoolMem_SlabHdr_t*)((pClass)->pStorage + (UInt32)(idx) * (pClass)->slotSize))
+#define POOLMEM_SLAB_DATA(pHdr)       ((UInt8*)(pHdr) + sizeof(PoolMem_SlabHdr_t))
+
+// Last entry collects all components not fitting the table
+#define POOLMEM_SLAB_COMP_OTHER     GP_POOLMEM_SLAB_NR_OF_COMP_STATS
+
+#if GP_POOLMEM_SLAB_AMOUNT1 == 0
+#error Minimum need 1 buffer to play with
+#endif
+#if (GP_POOLMEM_SLAB_SIZE1 > GP_POOLMEM_SLAB_SIZE2) || (GP_POOLMEM_SLAB_SIZE2 > GP_POOLMEM_SLAB_SIZE3) || (GP_POOLMEM_SLAB_SIZE3 > GP_POOLMEM_SLAB_SIZE4)
+#error Slab classes need ascending sizes
+#endif
+#if GP_POOLMEM_SLAB_SIZE4 > 0xFFFF
+#error Slab size does not fit the slot header
+#endif
+#if (GP_POOLMEM_SLAB_AMOUNT1 >= POOLMEM_SLAB_NONE) || (GP_POOLMEM_SLAB_AMOUNT2 >= POOLMEM_SLAB_NONE) || \
+    (GP_POOLMEM_SLAB_AMOUNT3 >= POOLMEM_SLAB_NONE) || (GP_POOLMEM_SLAB_AMOUNT4 >= POOLMEM_SLAB_NONE)
+#error Slab amount does not fit the slot header
+#endif
+
+GP_COMPILE_TIME_VERIFY((sizeof(PoolMem_SlabHdr_t) % sizeof(UInt32)) == 0);
+
+/*****************************************************************************
+ *                    Static Data Definitions
+ *****************************************************************************/
+
+static UInt32 PoolMem_SlabStorage1[POOLMEM_SLAB_STORAGE_WORDS(GP_POOLMEM_SLAB_SIZE1, GP_POOLMEM_SLAB_AMOUNT1)] GP_EXTRAM_SECTION_ATTR;
+#if GP_POOLMEM_SLAB_AMOUNT2 > 0
+static UInt32 PoolMem_SlabStorage2[POOLMEM_SLAB_STORAGE_WORDS(GP_POOLMEM_SLAB_SIZE2, GP_POOLMEM_SLAB_AMOUNT2)] GP_EXTRAM_SECTION_ATTR;
+#define POOLMEM_SLAB_STORAGE2 ((UInt8*)PoolMem_SlabStorage2)
+#else
+#define POOLMEM_SLAB_STORAGE2 NULL
+#endif
+#if GP_POOLMEM_SLAB_AMOUNT3 > 0
+static UInt32 PoolMem_SlabStorage3[POOLMEM_SLAB_STORAGE_WORDS(GP_POOLMEM_SLAB_SIZE3, GP_POOLMEM_SLAB_AMOUNT3)] GP_EXTRAM_SECTION_ATTR;
+#define POOLMEM_SLAB_STORAGE3 ((UInt8*)PoolMem_SlabStorage3)
+#else
+#define POOLMEM_SLAB_STORAGE3 NULL
+#endif
+#if GP_POOLMEM_SLAB_AMOUNT4 > 0
+static UInt32 PoolMem_SlabStorage4[POOLMEM_SLAB_STORAGE_WORDS(GP_POOLMEM_SLAB_SIZE4, GP_POOLMEM_SLAB_AMOUNT4)] GP_EXTRAM_SECTION_ATTR;
+#define POOLMEM_SLAB_STORAGE4 ((UInt8*)PoolMem_SlabStorage4)
+#else
+#define POOLMEM_SLAB_STORAGE4 NULL
+#endif
+
+static const PoolMem_SlabClass_t PoolMem_SlabClasses[POOLMEM_SLAB_NR_OF_CLASSES] = {
+    { (UInt8*)PoolMem_SlabStorage1, GP_POOLMEM_SLAB_SIZE1, POOLMEM_SLAB_SLOT_SIZE(GP_POOLMEM_SLAB_SIZE1), GP_POOLMEM_SLAB_AMOUNT1 },
+    { POOLMEM_SLAB_STORAGE2,        GP_POOLMEM_SLAB_SIZE2, POOLMEM_SLAB_SLOT_SIZE(GP_POOLMEM_SLAB_SIZE2), GP_POOLMEM_SLAB_AMOUNT2 },
+    { POOLMEM_SLAB_STORAGE3,        GP_POOLMEM_SLAB_SIZE3, POOLMEM_SLAB_SLOT_SIZE(GP_POOLMEM_SLAB_SIZE3), GP_POOLMEM_SLAB_AMOUNT3 },
+    { POOLMEM_SLAB_STORAGE4,        GP_POOLMEM_SLAB_SIZE4, POOLMEM_SLAB_SLOT_SIZE(GP_POOLMEM_SLAB_SIZE4), GP_POOLMEM_SLAB_AMOUNT4 },
+};
+
+static PoolMem_SlabClassState_t PoolMem_SlabState[POOLMEM_SLAB_NR_OF_CLASSES];
+static PoolMem_SlabCompStats_t PoolMem_SlabCompStats[GP_POOLMEM_SLAB_NR_OF_COMP_STATS + 1];
+
+// Worst case internal fragmentation (slot bytes handed out but not requested)
+static UInt32 PoolMem_SlabWastePeak;
+
+/*****************************************************************************
+ *                    Static Function Definitions
+ *****************************************************************************/
+
+static PoolMem_SlabCompStats_t* PoolMem_SlabGetCompStats(UInt8 comp_id, Bool create)
+{
+    UIntLoop i;
+
+    for(i = 0; i < GP_POOLMEM_SLAB_NR_OF_COMP_STATS; i++)
+    {
+        if(PoolMem_SlabCompStats[i].compId == comp_id)
+        {
+            return &PoolMem_SlabCompStats[i];
+        }
+    }
+    if(create)
+    {
+        for(i = 0; i < GP_POOLMEM_SLAB_NR_OF_COMP_STATS; i++)
+        {
+            if(PoolMem_SlabCompStats[i].compId == GP_POOLMEM_NOTUSED)
+            {
+                PoolMem_SlabCompStats[i].compId = comp_id;
+                return &PoolMem_SlabCompStats[i];
+            }
+        }
+    }
+    return &PoolMem_SlabCompStats[POOLMEM_SLAB_COMP_OTHER];
+}
+
+static UInt32 PoolMem_SlabGetWaste(void)
+{
+    UIntLoop c;
+    UInt32 waste = 0;
+
+    for(c = 0; c < POOLMEM_SLAB_NR_OF_CLASSES; c++)
+    {
+        waste += (UInt32)PoolMem_SlabState[c].inUse * PoolMem_SlabClasses[c].dataSize - PoolMem_SlabState[c].requested;
+    }
+    return waste;
+}
+
+static Bool PoolMem_SlabCheckGuards(PoolMem_SlabHdr_t* pHdr)
+{
+    GUARD val = GP_POOLMEM_GUARD;
+
+    if(pHdr->guardStart != GP_POOLMEM_GUARD)
+    {
+        return false;
+    }
+    if(pHdr->compId == GP_POOLMEM_NOTUSED)
+    {
+        return true;
+    }
+    return (0 == MEMCMP(POOLMEM_SLAB_DATA(pHdr) + pHdr->nbytes, &val, sizeof(GUARD)));
+}
+
+/* Map a data pointer back on its slot header, NULL if it is not the start of a slot */
+static PoolMem_SlabHdr_t* PoolMem_SlabFromData(void* pData)
+{
+    PoolMem_SlabHdr_t* pHdr = (PoolMem_SlabHdr_t*)((UInt8*)pData - sizeof(PoolMem_SlabHdr_t));
+    const PoolMem_SlabClass_t* pClass;
+    UIntPtr offset;
+
+    if((NULL == pData) || (pHdr->classId >= POOLMEM_SLAB_NR_OF_CLASSES))
+    {
+        return NULL;
+    }
+    pClass = &PoolMem_SlabClasses[pHdr->classId];
+    if((UInt8*)pHdr < pClass->pStorage)
+    {
+        return NULL;
+    }
+    offset = (UIntPtr)((UInt8*)pHdr - pClass->pStorage);
+    if((offset >= (UIntPtr)pClass->slotSize * pClass->amount) || (0 != (offset % pClass->slotSize)))
+    {
+        return NULL;
+    }
+    return pHdr;
+}
+
+static void PoolMem_SlabRelease(PoolMem_SlabHdr_t* pHdr)
+{
+    PoolMem_SlabClassState_t* pState = &PoolMem_SlabState[pHdr->classId];
+    PoolMem_SlabCompStats_t* pComp = PoolMem_SlabGetCompStats(pHdr->compId, false);
+    UInt16 idx;
+
+    idx = (UInt16)(((UInt8*)pHdr - PoolMem_SlabClasses[pHdr->classId].pStorage) / PoolMem_SlabClasses[pHdr->classId].slotSize);
+
+    pComp->chunks--;
+    pComp->liveBytes -= pHdr->nbytes;
+    pState->inUse--;
+    pState->requested -= pHdr->nbytes;
+
+    pHdr->compId = GP_POOLMEM_NOTUSED;
+    pHdr->nbytes = 0;
+    pHdr->link = pState->freeHead;
+    pState->freeHead = idx;
+}
+
+/*****************************************************************************
+ *                    Public Function Definitions
+ *****************************************************************************/
+
+/* Init of slabs, chain all slots of a class in its free list */
+void PoolMem_Init(void)
+{
+    UIntLoop c;
+    UIntLoop i;
+
+    GP_LOG_PRINTF("Init PoolMem slab",0);
+    for(c = 0; c < POOLMEM_SLAB_NR_OF_CLASSES; c++)
+    {
+        const PoolMem_SlabClass_t* pClass = &PoolMem_SlabClasses[c];
+
+        for(i = 0; i < pClass->amount; i++)
+        {
+            PoolMem_SlabHdr_t* pHdr = POOLMEM_SLAB_HDR(pClass, i);
+
+            pHdr->guardStart = GP_POOLMEM_GUARD;
+            pHdr->compId = GP_POOLMEM_NOTUSED;
+            pHdr->classId = (UInt8)c;
+            pHdr->nbytes = 0;
+            pHdr->link = (i + 1 < pClass->amount) ? (UInt16)(i + 1) : POOLMEM_SLAB_NONE;
+        }
+        MEMSET(&PoolMem_SlabState[c], 0, sizeof(PoolMem_SlabClassState_t));
+        PoolMem_SlabState[c].freeHead = (pClass->amount > 0) ? 0 : POOLMEM_SLAB_NONE;
+    }
+    MEMSET(PoolMem_SlabCompStats, 0, sizeof(PoolMem_SlabCompStats));
+    for(i = 0; i < GP_POOLMEM_SLAB_NR_OF_COMP_STATS + 1; i++)
+    {
+        PoolMem_SlabCompStats[i].compId = GP_POOLMEM_NOTUSED;
+    }
+    PoolMem_SlabWastePeak = 0;
+}
+
+void gpPoolMem_Reset(void)
+{
+    GP_LOG_PRINTF("Reset PoolMem slab",0);
+    PoolMem_Init();
+}
+
+/* Implementation Malloc function - smallest fitting class first, spill to bigger classes when exhausted */
+void *PoolMem_Malloc ( UInt8 comp_id, UInt32 nbytes, Bool try_)
+{
+    UIntLoop c;
+
+    HAL_DISABLE_GLOBAL_INT();
+    for(c = 0; c < POOLMEM_SLAB_NR_OF_CLASSES; c++)
+    {
+        const PoolMem_SlabClass_t* pClass = &PoolMem_SlabClasses[c];
+        PoolMem_SlabClassState_t* pState = &PoolMem_SlabState[c];
+
+        if(nbytes > pClass->dataSize)
+        {
+            continue;
+        }
+        if(pState->freeHead == POOLMEM_SLAB_NONE)
+        {
+            pState->failed++;
+            continue;
+        }
+        {
+            PoolMem_SlabHdr_t* pHdr = POOLMEM_SLAB_HDR(pClass, pState->freeHead);
+            PoolMem_SlabCompStats_t* pComp;
+            GUARD val = GP_POOLMEM_GUARD;
+            UInt32 waste;
+
+            GP_ASSERT_SYSTEM(pHdr->guardStart == GP_POOLMEM_GUARD && pHdr->compId == GP_POOLMEM_NOTUSED);
+            pState->freeHead = pHdr->link;
+            pHdr->link = POOLMEM_SLAB_NONE;
+            pHdr->compId = comp_id;
+            pHdr->nbytes = (UInt16)nbytes;
+            MEMCPY(POOLMEM_SLAB_DATA(pHdr) + nbytes, &val, sizeof(GUARD));
+
+            pState->inUse++;
+            pState->peak = max(pState->peak, pState->inUse);
+            pState->requested += nbytes;
+
+            pComp = PoolMem_SlabGetCompStats(comp_id, true);
+            pComp->chunks++;
+            pComp->liveBytes += nbytes;
+            pComp->peakBytes = max(pComp->peakBytes, pComp->liveBytes);
+
+            waste = PoolMem_SlabGetWaste();
+            PoolMem_SlabWastePeak = max(PoolMem_SlabWastePeak, waste);
+            HAL_ENABLE_GLOBAL_INT();
+
+            GP_LOG_PRINTF("BA-%u-CId:%u-S:%lu",6,(UInt16)pClass->dataSize,(UInt16)comp_id,(UInt32)nbytes);
+            return POOLMEM_SLAB_DATA(pHdr);
+        }
+    }
+    HAL_ENABLE_GLOBAL_INT();
+
+    GP_LOG_PRINTF("Chunk size too small: CId:%u - size:%lu",4,(UInt16)comp_id,(UInt32)nbytes);
+    if(!try_)
+    {
+        GP_LOG_SYSTEM_PRINTF("malloc failed comp:%x %lu",0, comp_id, (unsigned long)nbytes);
+        gpPoolMem_Dump(false);
+        GP_ASSERT_DEV_EXT(false);
+    }
+    return NULL;
+}
+
+/* Implementation Free function */
+void PoolMem_Free (void* pData)
+{
+    PoolMem_SlabHdr_t* pHdr = PoolMem_SlabFromData(pData);
+
+    GP_LOG_PRINTF("free address 0x%p",2, pData);
+    if(NULL == pHdr)
+    {
+        // Wrong pointer is given
+        GP_ASSERT_DEV_EXT(false);
+        return;
+    }
+    GP_ASSERT_SYSTEM(pHdr->compId != GP_POOLMEM_NOTUSED && PoolMem_SlabCheckGuards(pHdr));
+
+    HAL_DISABLE_GLOBAL_INT();
+    PoolMem_SlabRelease(pHdr);
+    HAL_ENABLE_GLOBAL_INT();
+}
+
+void gpPoolMem_Dump(Bool checkConsistency)
+{
+    UIntLoop c;
+    UIntLoop i;
+    Bool failure = false;
+    UInt32 largestFree = 0;
+
+    for(c = 0; c < POOLMEM_SLAB_NR_OF_CLASSES; c++)
+    {
+        const PoolMem_SlabClass_t* pClass = &PoolMem_SlabClasses[c];
+        PoolMem_SlabClassState_t* pState = &PoolMem_SlabState[c];
+
+        if(pClass->amount == 0)
+        {
+            continue;
+        }
+        if(pState->inUse < pClass->amount)
+        {
+            largestFree = pClass->dataSize;
+        }
+        GP_LOG_SYSTEM_PRINTF("Slab %u: used %u/%u peak %u miss %u req %lu waste %lu", 0,
+                             (UInt16)pClass->dataSize, pState->inUse, pClass->amount, pState->peak, pState->failed,
+                             (unsigned long)pState->requested,
+                             (unsigned long)((UInt32)pState->inUse * pClass->dataSize - pState->requested));
+
+        if(checkConsistency)
+        {
+            UInt16 nrFree = 0;
+            UInt16 idx;
+
+            for(i = 0; i < pClass->amount; i++)
+            {
+                if(!PoolMem_SlabCheckGuards(POOLMEM_SLAB_HDR(pClass, i)))
+                {
+                    GP_LOG_SYSTEM_PRINTF("BA-%u[%u]-grd fail",4,(UInt16)pClass->dataSize,(UInt16)i);
+                    failure = true;
+                }
+            }
+            for(idx = pState->freeHead; (idx != POOLMEM_SLAB_NONE) && (nrFree <= pClass->amount); idx = POOLMEM_SLAB_HDR(pClass, idx)->link)
+            {
+                nrFree++;
+            }
+            if(nrFree != pClass->amount - pState->inUse)
+            {
+                GP_LOG_SYSTEM_PRINTF("Slab %u free list %u/%u",0,(UInt16)pClass->dataSize, nrFree, pClass->amount - pState->inUse);
+                failure = true;
+            }
+        }
+    }
+    GP_LOG_SYSTEM_PRINTF("Slab waste %lu peak %lu - largest free %lu", 0,
+                         (unsigned long)PoolMem_SlabGetWaste(), (unsigned long)PoolMem_SlabWastePeak, (unsigned long)largestFree);
+
+    for(i = 0; i < GP_POOLMEM_SLAB_NR_OF_COMP_STATS + 1; i++)
+    {
+        PoolMem_SlabCompStats_t* pComp = &PoolMem_SlabCompStats[i];
+
+        if((pComp->peakBytes != 0) || (pComp->chunks != 0))
+        {
+            GP_LOG_SYSTEM_PRINTF("compId:%x - n:%u - live:%lu - peak:%lu", 0,
+                                 (i == POOLMEM_SLAB_COMP_OTHER) ? GP_POOLMEM_NOTUSED : pComp->compId,
+                                 pComp->chunks, (unsigned long)pComp->liveBytes, (unsigned long)pComp->peakBytes);
+        }
+    }
+    gpLog_Flush();
+
+    GP_ASSERT_SYSTEM(!failure);
+}
+
+#ifdef GP_COMP_UNIT_TEST
+
+void PoolMem_Free_ByCompId (UInt8 comp_id)
+{
+    PoolMem_SlabCompStats_t* pComp = PoolMem_SlabGetCompStats(comp_id, false);
+    UIntLoop c;
+    UIntLoop i;
+
+    // Tracked components stop the walk as soon as all their chunks are released
+    for(c = 0; c < POOLMEM_SLAB_NR_OF_CLASSES; c++)
+    {
+        const PoolMem_SlabClass_t* pClass = &PoolMem_SlabClasses[c];
+
+        for(i = 0; i < pClass->amount; i++)
+        {
+            PoolMem_SlabHdr_t* pHdr = POOLMEM_SLAB_HDR(pClass, i);
+
+            if((pComp->compId == comp_id) && (pComp->chunks == 0))
+            {
+                return;
+            }
+            if(pHdr->compId == comp_id)
+            {
+                GP_ASSERT_SYSTEM(PoolMem_SlabCheckGuards(pHdr));
+                PoolMem_SlabRelease(pHdr);
+            }
+        }
+    }
+}
+
+/*
+    returns the number of allocations done by the system
+*/
+UInt8 PoolMem_InUse (void)
+{
+    UIntLoop c;
+    UInt16 amountInUse = 0;
+
+    for(c = 0; c < POOLMEM_SLAB_NR_OF_CLASSES; c++)
+    {
+        amountInUse += PoolMem_SlabState[c].inUse;
+    }
+    return (UInt8)amountInUse;
+}
+#endif //GP_COMP_UNIT_TEST
+
+UInt32 gpPoolMem_GetMaxAvailableChunkSize(void)
+{
+    UIntLoop c;
+
+    for(c = POOLMEM_SLAB_NR_OF_CLASSES; c > 0; c--)
+    {
+        if(PoolMem_SlabState[c-1].freeHead != POOLMEM_SLAB_NONE)
+        {
+            return PoolMem_SlabClasses[c-1].dataSize;
+        }
+    }
+    return 0;
+}
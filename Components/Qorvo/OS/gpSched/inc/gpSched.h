@@ -348,6 +348,24 @@ GP_API void gpSched_Main_Init(void);
  */
 Bool gpSched_InitTask(void);
 
+#ifdef GP_DIVERSITY_FREERTOS
+/** @brief Counters of the deferred event ring and timer coalescing (FreeRTOS integration) */
+typedef struct {
+    UInt32 deferredEvents;          // Events scheduled from interrupt context
+    UInt32 deferredOverflow;        // Events passed through the overflow queue because the ring was full
+    UInt32 deferredDropped;         // Events dropped because the ring and the overflow queue were full
+    UInt32 deferredHighWaterMark;   // Maximum number of events waiting in the ring
+    UInt32 coalescedEvents;         // Events handled on the timer wakeup of an earlier event
+} gpSched_DeferredStats_t;
+
+/**
+ * @brief Returns a snapshot of the deferred event and timer coalescing counters.
+ *
+ * @param pStats   Pointer to the structure to be filled in.
+ */
+void gpSched_GetDeferredStats(gpSched_DeferredStats_t* pStats);
+#endif //GP_DIVERSITY_FREERTOS
+
 /**
  * @brief A function that checks if an schedule event should be deferred to the context of the task
  *
@@ -129,8 +129,7 @@ void Sched_RescheduleEvent (UInt32 rel_time, gpSched_Event_t * pevt)
 {
 #if (GPJUMPTABLES_MIN_ROMVERSION < ROMVERSION_FIXFORPATCH_SCHED_INTEGRATION_CALLS)
     gpSched_globals_t* sched_globals = GP_SCHED_GET_GLOBALS();
-    gpUtils_LinkList_t* pList = sched_globals->gpSched_EventList_p;
-    gpSched_Event_t* pevt_nxt = NULL;
+    gpSched_Event_t* pevt_first = SCHED_EVENT_QUEUE_FIRST(sched_globals->gpSched_EventList_p);
     UInt32 now;
 
     GP_ASSERT_DEV_INT(pevt); //pevt pointer should be != NULL
@@ -140,10 +139,9 @@ void Sched_RescheduleEvent (UInt32 rel_time, gpSched_Event_t * pevt)
     {
         UInt32 first_time;
 
-        if (pList->plnk_first)
+        if (pevt_first)
         {
-            pevt_nxt = (gpSched_Event_t*)GP_UTILS_LL_GET_ELEM(pList->plnk_first);
-            first_time = pevt_nxt->time;
+            first_time = pevt_first->time;
         }
         else
         {
@@ -164,10 +162,9 @@ void Sched_RescheduleEvent (UInt32 rel_time, gpSched_Event_t * pevt)
     // But you also can't schedule further then GP_SCHED_EVENT_TIME_MAX from the first event in the list (else the order in the list will be wrong)
     // This is especially true if the first event in the list is in the past (before 'now').
 
-    if(pList->plnk_first)
+    if(pevt_first)
     {
-        pevt_nxt = (gpSched_Event_t*)GP_UTILS_LL_GET_ELEM(pList->plnk_first);
-        GP_ASSERT_SYSTEM(rel_time < (pevt_nxt->time - now + GP_SCHED_EVENT_TIME_MAX));
+        GP_ASSERT_SYSTEM(rel_time < (pevt_first->time - now + GP_SCHED_EVENT_TIME_MAX));
     }
 
     Sched_RescheduleEventAbs (pevt->time, pevt);
@@ -177,13 +174,16 @@ void Sched_RescheduleEvent (UInt32 rel_time, gpSched_Event_t * pevt)
 STATIC_FUNC void Sched_RescheduleEventAbs (UInt32 time, gpSched_Event_t * pevt)
 {
 #if (GPJUMPTABLES_MIN_ROMVERSION < ROMVERSION_FIXFORPATCH_SCHED_INTEGRATION_CALLS)
+    pevt->time  = time;
+
+#ifdef GP_SCHED_DIVERSITY_EVENT_HEAP
+    Sched_EventQueueInsert(pevt);
+#else
     gpSched_globals_t* sched_globals = GP_SCHED_GET_GLOBALS();
     gpUtils_LinkList_t* pList = sched_globals->gpSched_EventList_p;
     gpSched_Event_t* pevt_nxt = NULL;
     gpUtils_Link_t* plnk = NULL;
 
-    pevt->time  = time;
-
     // Scroll pointer
     // Insert event
     // Duration : 8us per loop
@@ -210,6 +210,7 @@ STATIC_FUNC void Sched_RescheduleEventAbs (UInt32 time, gpSched_Event_t * pevt)
     {
         gpUtils_LLAdd( pevt, pList );
     }
+#endif //GP_SCHED_DIVERSITY_EVENT_HEAP
     gpSched_Trigger();
 #endif // (GPJUMPTABLES_MIN_ROMVERSION < ROMVERSION_FIXFORPATCH_SCHED_INTEGRATION_CALLS)
 }
@@ -278,7 +279,7 @@ STATIC_FUNC gpSched_Event_t* Sched_GetEvent(void)
     gpSched_globals_t* sched_globals = GP_SCHED_GET_GLOBALS();
 
     gpUtils_LLLockAcquire((gpUtils_Links_t *)sched_globals->gpSched_EventList_p);
-    pevt = (gpSched_Event_t*)gpUtils_LLGetFirstElem(sched_globals->gpSched_EventList_p);
+    pevt = SCHED_EVENT_QUEUE_FIRST(sched_globals->gpSched_EventList_p);
     if(pevt)
     {
         UInt32 time_now;
@@ -287,7 +288,7 @@ STATIC_FUNC gpSched_Event_t* Sched_GetEvent(void)
 
         if (GP_SCHED_TIME_COMPARE_BIGGER_EQUAL (time_now, pevt->time))
         {
-            gpUtils_LLUnlink(pevt, sched_globals->gpSched_EventList_p);
+            SCHED_EVENT_QUEUE_UNLINK(pevt, sched_globals->gpSched_EventList_p);
         }
         else
         {
@@ -336,13 +337,17 @@ void gpSched_Clear( void )
     gpSched_globals_t* sched_globals = GP_SCHED_GET_GLOBALS();
 
     gpUtils_LLLockAcquire((gpUtils_Links_t *)sched_globals->gpSched_EventList_p);
-    while(sched_globals->gpSched_EventList_p->plnk_last)
+    while(!SCHED_EVENT_QUEUE_IS_EMPTY(sched_globals->gpSched_EventList_p))
     {
         gpSched_Event_t* pevt;
 
+#ifdef GP_SCHED_DIVERSITY_EVENT_HEAP
+        pevt = Sched_EventQueueFirst();
+#else
         pevt = (gpSched_Event_t*)GP_UTILS_LL_GET_ELEM(sched_globals->gpSched_EventList_p->plnk_last);
+#endif //GP_SCHED_DIVERSITY_EVENT_HEAP
         //GP_LOG_SYSTEM_PRINTF("event %x",2,(UInt16)pevt->func.callback);
-        gpUtils_LLUnlink(pevt, sched_globals->gpSched_EventList_p);
+        SCHED_EVENT_QUEUE_UNLINK(pevt, sched_globals->gpSched_EventList_p);
         Sched_ReleaseEventBody(pevt);
     }
 
@@ -358,7 +363,7 @@ Bool gpSched_EventQueueEmpty( void )
     Bool Empty;
 
     gpUtils_LLLockAcquire((gpUtils_Links_t *)sched_globals->gpSched_EventList_p);
-    Empty = (!sched_globals->gpSched_EventList_p->plnk_first);
+    Empty = SCHED_EVENT_QUEUE_IS_EMPTY(sched_globals->gpSched_EventList_p);
     gpUtils_LLLockRelease((gpUtils_Links_t *)sched_globals->gpSched_EventList_p);
     return Empty;
 #else
@@ -440,6 +445,17 @@ UInt32 gpSched_GetRemainingTimeArgInSecAndUs(gpSched_EventCallback_t callback, v
 gpSched_Event_t* Sched_FindEventArg(gpUtils_LinkList_t* plst , gpSched_EventCallback_t callback, void* arg, Bool unscheduleWhenFound)
 {
 #if (GPJUMPTABLES_MIN_ROMVERSION < ROMVERSION_FIXFORPATCH_SCHED_INTEGRATION_CALLS)
+#ifdef GP_SCHED_DIVERSITY_EVENT_HEAP
+    gpSched_Event_t* pevt = Sched_EventQueueFind(callback, arg);
+
+    if (pevt && unscheduleWhenFound)
+    {
+        Sched_EventQueueRemove(pevt);
+        Sched_ReleaseEventBody(pevt);
+    }
+    NOT_USED(plst);
+    return pevt;
+#else
     gpUtils_Link_t* plnk;
     for (plnk = plst->plnk_first;plnk;plnk = plnk->plnk_nxt)
     {
@@ -461,6 +477,7 @@ gpSched_Event_t* Sched_FindEventArg(gpUtils_LinkList_t* plst , gpSched_EventCall
             return pevt;
         }
     }
+#endif //GP_SCHED_DIVERSITY_EVENT_HEAP
 
 #endif // (GPJUMPTABLES_MIN_ROMVERSION < ROMVERSION_FIXFORPATCH_SCHED_INTEGRATION_CALLS)
     return NULL;
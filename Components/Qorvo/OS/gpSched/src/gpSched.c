@@ -54,7 +54,7 @@ UInt32 gpSched_GetTimeToNextEvent (void)
     gpSched_Event_t* pevt;
 
     gpUtils_LLLockAcquire((gpUtils_Links_t *)sched_globals->gpSched_EventList_p);
-    pevt = (gpSched_Event_t*)gpUtils_LLGetFirstElem(sched_globals->gpSched_EventList_p);
+    pevt = SCHED_EVENT_QUEUE_FIRST(sched_globals->gpSched_EventList_p);
     if(pevt)
     {
         UInt32 time_now;
@@ -74,6 +74,58 @@ UInt32 gpSched_GetTimeToNextEvent (void)
     return timeToNextEvent;
 }
 
+UInt32 Sched_GetTimeToNextEventCoalesced(UInt32 slack, UInt8* pNrOfEvents)
+{
+    gpSched_globals_t* sched_globals = GP_SCHED_GET_GLOBALS();
+    UInt32 timeToNextEvent = 0;
+    gpSched_Event_t* pevt;
+
+    *pNrOfEvents = 0;
+    gpUtils_LLLockAcquire((gpUtils_Links_t *)sched_globals->gpSched_EventList_p);
+    pevt = SCHED_EVENT_QUEUE_FIRST(sched_globals->gpSched_EventList_p);
+    if(pevt)
+    {
+        UInt32 time_now;
+        UInt32 target = pevt->time;
+
+        HAL_TIMER_GET_CURRENT_TIME_1US(time_now);
+
+        *pNrOfEvents = 1;
+        // Only postpone events that are not due yet
+        if(GP_SCHED_TIME_COMPARE_BIGGER(pevt->time, time_now) && slack)
+        {
+#ifdef GP_SCHED_DIVERSITY_EVENT_HEAP
+            target = Sched_EventQueueLatestWithin(pevt->time + slack, pNrOfEvents);
+#else
+            UInt32 limit = pevt->time + slack;
+            gpUtils_Link_t* plnk;
+
+            for(plnk = (GP_UTILS_LL_GET_LINK(pevt))->plnk_nxt; plnk; plnk = plnk->plnk_nxt)
+            {
+                gpSched_Event_t* pevt_nxt = (gpSched_Event_t*)GP_UTILS_LL_GET_ELEM(plnk);
+                if(GP_SCHED_TIME_COMPARE_BIGGER(pevt_nxt->time, limit))
+                {
+                    break;
+                }
+                target = pevt_nxt->time;
+                if(*pNrOfEvents < 0xFF)
+                {
+                    (*pNrOfEvents)++;
+                }
+            }
+#endif //GP_SCHED_DIVERSITY_EVENT_HEAP
+        }
+
+        if(GP_SCHED_TIME_COMPARE_BIGGER_EQUAL(target, time_now))
+        {
+            timeToNextEvent = GP_SCHED_GET_TIME_DIFF(time_now, target);
+        }
+    }
+    gpUtils_LLLockRelease((gpUtils_Links_t *)sched_globals->gpSched_EventList_p);
+
+    return timeToNextEvent;
+}
+
 UInt32 gpSched_GetGoToSleepThreshold (void)
 {
     UInt32 threshold;
@@ -0,0 +1,352 @@
+/*
+ * Copyright (c) 2026, Qorvo Inc
+ *
+ * gpSched_EventHeap.c
+ *   This file contains the indexed binary heap backend for the pending event queue
+ *   of the scheduler (GP_SCHED_DIVERSITY_EVENT_HEAP).
+ *
+ *   Events are still allocated from the gpSched_EventArray free list. Only the
+ *   ordering of pending events moves from the sorted linked list to a min-heap of
+ *   event indexes, combined with a callback hash index for unschedule/exists lookups:
+ *   - insert / cancel : O(log n)
+ *   - peek first      : O(1)
+ *   - find (cb,arg)   : O(events with the same callback hash)
+ *
+ *
+ * This software is owned by Qorvo Inc
+ * and protected under applicable copyright laws.
+ * It is delivered under the terms of the license
+ * and is intended and supplied for use solely and
+ * exclusively with products manufactured by
+ * Qorvo Inc.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED IN AN "AS IS"
+ * CONDITION. NO WARRANTIES, WHETHER EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING, BUT NOT
+ * LIMITED TO, IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ * QORVO INC. SHALL NOT, IN ANY
+ * CIRCUMSTANCES, BE LIABLE FOR SPECIAL,
+ * INCIDENTAL OR CONSEQUENTIAL DAMAGES,
+ * FOR ANY REASON WHATSOEVER.
+ *
+ * Alternatively, this software may be distributed under the terms of the
+ * modified BSD License or the 3-clause BSD License as published by the Free
+ * Software Foundation @ https://directory.fsf.org/wiki/License:BSD-3-Clause
+ *
+ * $Header$
+ * $Change$
+ * $DateTime$
+ *
+ */
+
+/*****************************************************************************
+ *                    Includes Definitions
+ *****************************************************************************/
+
+#define GP_COMPONENT_ID GP_COMPONENT_ID_SCHED
+
+#include "gpUtils.h"
+#include "gpSched.h"
+#include "gpSched_defs.h"
+
+#include "gpLog.h"
+#include "gpAssert.h"
+
+#ifdef GP_SCHED_DIVERSITY_EVENT_HEAP
+
+/*****************************************************************************
+ *                    Macro Definitions
+ *****************************************************************************/
+
+#if (GP_SCHED_EVENT_HASH_SIZE & (GP_SCHED_EVENT_HASH_SIZE - 1)) != 0
+#error GP_SCHED_EVENT_HASH_SIZE must be a power of 2
+#endif
+
+#if GP_SCHED_EVENT_LIST_SIZE >= 0xFFFF
+#error GP_SCHED_EVENT_LIST_SIZE too big for the event heap index
+#endif
+
+#define SCHED_HEAP_INDEX_INVALID    0xFFFF
+
+#define SCHED_HEAP_PARENT(pos)      (((pos) - 1) >> 1)
+#define SCHED_HEAP_LEFT(pos)        (((pos) << 1) + 1)
+
+#define SCHED_HASH_CALLBACK(cb)     ((UInt16)((((UIntPtr)(cb)) >> 2) ^ (((UIntPtr)(cb)) >> 9)) & (GP_SCHED_EVENT_HASH_SIZE - 1))
+
+#ifdef GP_SCHED_DIVERSITY_USE_ARGS
+//using (arg == NULL) as wildcard
+#define SCHED_EVENT_MATCHES(pevt, cb, a)    (((pevt)->func.callbackarg == (cb)) && (((pevt)->arg == (a)) || ((a) == NULL)))
+#else
+#define SCHED_EVENT_MATCHES(pevt, cb, a)    ((pevt)->func.callbackarg == (cb))
+#endif
+
+/*****************************************************************************
+ *                    Type Definitions
+ *****************************************************************************/
+
+typedef struct {
+    UIntPtr base;                                           // Address of the first link in the event buffer
+    UInt32  elemSize;                                       // Size of one link + event in the event buffer
+    UInt32  seqCounter;                                     // Insertion counter, keeps FIFO order for equal times
+    UInt16  count;                                          // Number of pending events
+    UInt16  heap[GP_SCHED_EVENT_LIST_SIZE];                 // Event indexes, ordered as min-heap on time
+    UInt16  heapPos[GP_SCHED_EVENT_LIST_SIZE];              // Position of each event in heap[]
+    UInt32  seq[GP_SCHED_EVENT_LIST_SIZE];                  // Insertion sequence number of each event
+    UInt16  hashNext[GP_SCHED_EVENT_LIST_SIZE];             // Next event index in the same hash bucket
+    UInt16  hashHead[GP_SCHED_EVENT_HASH_SIZE];             // First event index per callback hash bucket
+} Sched_EventHeap_t;
+
+/*****************************************************************************
+ *                    Static Data Definitions
+ *****************************************************************************/
+
+static Sched_EventHeap_t Sched_EventHeap;
+
+/*****************************************************************************
+ *                    Static Function Definitions
+ *****************************************************************************/
+
+static INLINE gpSched_Event_t* Sched_HeapGetEvent(UInt16 index)
+{
+    return (gpSched_Event_t*)GP_UTILS_LL_GET_ELEM(Sched_EventHeap.base + (UIntPtr)index * Sched_EventHeap.elemSize);
+}
+
+static INLINE UInt16 Sched_HeapGetIndex(gpSched_Event_t* pevt)
+{
+    UIntPtr offset = (UIntPtr)GP_UTILS_LL_GET_LINK(pevt) - Sched_EventHeap.base;
+
+    GP_ASSERT_DEV_INT((offset % Sched_EventHeap.elemSize) == 0);
+    return (UInt16)(offset / Sched_EventHeap.elemSize);
+}
+
+/* Returns true if event a has to be executed before event b */
+static Bool Sched_HeapBefore(UInt16 a, UInt16 b)
+{
+    UInt32 timeA = Sched_HeapGetEvent(a)->time;
+    UInt32 timeB = Sched_HeapGetEvent(b)->time;
+
+    if (timeA != timeB)
+    {
+        return GP_SCHED_TIME_COMPARE_LOWER(timeA, timeB);
+    }
+    return ((Int32)(Sched_EventHeap.seq[a] - Sched_EventHeap.seq[b]) < 0);
+}
+
+static INLINE void Sched_HeapPlace(UInt16 pos, UInt16 index)
+{
+    Sched_EventHeap.heap[pos] = index;
+    Sched_EventHeap.heapPos[index] = pos;
+}
+
+static void Sched_HeapSiftUp(UInt16 pos)
+{
+    UInt16 index = Sched_EventHeap.heap[pos];
+
+    while (pos > 0)
+    {
+        UInt16 parent = SCHED_HEAP_PARENT(pos);
+        if (!Sched_HeapBefore(index, Sched_EventHeap.heap[parent]))
+        {
+            break;
+        }
+        Sched_HeapPlace(pos, Sched_EventHeap.heap[parent]);
+        pos = parent;
+    }
+    Sched_HeapPlace(pos, index);
+}
+
+static void Sched_HeapSiftDown(UInt16 pos)
+{
+    UInt16 index = Sched_EventHeap.heap[pos];
+
+    for (;;)
+    {
+        UInt16 child = SCHED_HEAP_LEFT(pos);
+        if (child >= Sched_EventHeap.count)
+        {
+            break;
+        }
+        if ((child + 1 < Sched_EventHeap.count) &&
+            Sched_HeapBefore(Sched_EventHeap.heap[child + 1], Sched_EventHeap.heap[child]))
+        {
+            child++;
+        }
+        if (!Sched_HeapBefore(Sched_EventHeap.heap[child], index))
+        {
+            break;
+        }
+        Sched_HeapPlace(pos, Sched_EventHeap.heap[child]);
+        pos = child;
+    }
+    Sched_HeapPlace(pos, index);
+}
+
+static void Sched_HashUnlink(UInt16 index)
+{
+    UInt16* pLink = &Sched_EventHeap.hashHead[SCHED_HASH_CALLBACK(Sched_HeapGetEvent(index)->func.callbackarg)];
+
+    while (*pLink != SCHED_HEAP_INDEX_INVALID)
+    {
+        if (*pLink == index)
+        {
+            *pLink = Sched_EventHeap.hashNext[index];
+            return;
+        }
+        pLink = &Sched_EventHeap.hashNext[*pLink];
+    }
+    GP_ASSERT_DEV_INT(false);
+}
+
+/* Visits only the heap nodes due at or before limit: every child is due after its parent.
+ * Pre-order walk over the implicit tree, without recursion: left children have odd positions. */
+static void Sched_HeapLatestWithin(UInt32 limit, UInt32* pLatest, UInt8* pCount)
+{
+    UInt32 pos = 0;
+
+    for (;;)
+    {
+        if (pos < Sched_EventHeap.count)
+        {
+            UInt32 time = Sched_HeapGetEvent(Sched_EventHeap.heap[pos])->time;
+
+            if (!GP_SCHED_TIME_COMPARE_BIGGER(time, limit))
+            {
+                if (GP_SCHED_TIME_COMPARE_BIGGER(time, *pLatest))
+                {
+                    *pLatest = time;
+                }
+                if (*pCount < 0xFF)
+                {
+                    (*pCount)++;
+                }
+                pos = SCHED_HEAP_LEFT(pos);
+                continue;
+            }
+        }
+        // Subtree done: climb while coming from a right child, then continue with the right sibling
+        while ((pos > 0) && ((pos & 1) == 0))
+        {
+            pos = SCHED_HEAP_PARENT(pos);
+        }
+        if (pos == 0)
+        {
+            break;
+        }
+        pos++;
+    }
+}
+
+/*****************************************************************************
+ *                    Public Function Definitions
+ *****************************************************************************/
+
+void Sched_EventQueueInit(void* pEventBuffer, UInt32 elemSize)
+{
+    UIntLoop i;
+
+    Sched_EventHeap.base = (UIntPtr)pEventBuffer;
+    Sched_EventHeap.elemSize = elemSize;
+    Sched_EventHeap.seqCounter = 0;
+    Sched_EventHeap.count = 0;
+    for (i = 0; i < GP_SCHED_EVENT_HASH_SIZE; i++)
+    {
+        Sched_EventHeap.hashHead[i] = SCHED_HEAP_INDEX_INVALID;
+    }
+}
+
+Bool Sched_EventQueueEmpty(void)
+{
+    return (Sched_EventHeap.count == 0);
+}
+
+gpSched_Event_t* Sched_EventQueueFirst(void)
+{
+    if (Sched_EventHeap.count == 0)
+    {
+        return NULL;
+    }
+    return Sched_HeapGetEvent(Sched_EventHeap.heap[0]);
+}
+
+void Sched_EventQueueInsert(gpSched_Event_t* pevt)
+{
+    UInt16 index = Sched_HeapGetIndex(pevt);
+    UInt16 bucket = SCHED_HASH_CALLBACK(pevt->func.callbackarg);
+
+    GP_ASSERT_SYSTEM(Sched_EventHeap.count < GP_SCHED_EVENT_LIST_SIZE);
+
+    Sched_EventHeap.seq[index] = Sched_EventHeap.seqCounter++;
+    Sched_EventHeap.hashNext[index] = Sched_EventHeap.hashHead[bucket];
+    Sched_EventHeap.hashHead[bucket] = index;
+
+    Sched_EventHeap.heap[Sched_EventHeap.count] = index;
+    Sched_EventHeap.count++;
+    Sched_HeapSiftUp(Sched_EventHeap.count - 1);
+}
+
+void Sched_EventQueueRemove(gpSched_Event_t* pevt)
+{
+    UInt16 index = Sched_HeapGetIndex(pevt);
+    UInt16 pos = Sched_EventHeap.heapPos[index];
+
+    GP_ASSERT_DEV_INT((pos < Sched_EventHeap.count) && (Sched_EventHeap.heap[pos] == index));
+
+    Sched_HashUnlink(index);
+
+    Sched_EventHeap.count--;
+    if (pos != Sched_EventHeap.count)
+    {
+        // Move the last element into the hole and restore the heap property
+        Sched_HeapPlace(pos, Sched_EventHeap.heap[Sched_EventHeap.count]);
+        if ((pos > 0) && Sched_HeapBefore(Sched_EventHeap.heap[pos], Sched_EventHeap.heap[SCHED_HEAP_PARENT(pos)]))
+        {
+            Sched_HeapSiftUp(pos);
+        }
+        else
+        {
+            Sched_HeapSiftDown(pos);
+        }
+    }
+}
+
+gpSched_Event_t* Sched_EventQueueFind(gpSched_EventCallback_t callback, void* arg)
+{
+    UInt16 index = Sched_EventHeap.hashHead[SCHED_HASH_CALLBACK(callback)];
+    UInt16 found = SCHED_HEAP_INDEX_INVALID;
+
+    NOT_USED(arg);
+
+    // Return the first matching event in execution order, as the sorted list did
+    for (; index != SCHED_HEAP_INDEX_INVALID; index = Sched_EventHeap.hashNext[index])
+    {
+        gpSched_Event_t* pevt = Sched_HeapGetEvent(index);
+        if (SCHED_EVENT_MATCHES(pevt, callback, arg))
+        {
+            if ((found == SCHED_HEAP_INDEX_INVALID) || Sched_HeapBefore(index, found))
+            {
+                found = index;
+            }
+        }
+    }
+
+    return (found == SCHED_HEAP_INDEX_INVALID) ? NULL : Sched_HeapGetEvent(found);
+}
+
+UInt32 Sched_EventQueueLatestWithin(UInt32 limit, UInt8* pNrOfEvents)
+{
+    UInt32 latest;
+
+    *pNrOfEvents = 0;
+    if (Sched_EventHeap.count == 0)
+    {
+        return limit;
+    }
+    latest = Sched_HeapGetEvent(Sched_EventHeap.heap[0])->time;
+    Sched_HeapLatestWithin(limit, &latest, pNrOfEvents);
+    return latest;
+}
+
+#endif //GP_SCHED_DIVERSITY_EVENT_HEAP
@@ -57,11 +57,6 @@
  *                    Macro Definitions
  *****************************************************************************/
 
-//Size definitions
-#ifndef GP_SCHED_EVENT_LIST_SIZE
-#define GP_SCHED_EVENT_LIST_SIZE            10
-#endif
-
 /*****************************************************************************
  *                    Type Definitions
  *****************************************************************************/
@@ -104,6 +99,8 @@ void gpSched_RegisterOnIdleCallback(gpSched_OnIdleCallback_t callback)
             break;
         }
     }
+    // A callback that does not get a slot would never run
+    GP_ASSERT_SYSTEM(i < GP_SCHED_NR_OF_IDLE_CALLBACKS);
 }
 
 void gpSched_PostProcessIdle(void)
@@ -133,6 +130,9 @@ void gpSched_InitExtramData(void)
     gpSched_globals.gpSched_EventList_p = &gpSched_eventLinkList;
 #endif
     gpUtils_LLInit(gpSched_EventArray, GP_UTILS_LL_SIZE_OF (gpSched_Event_t) , GP_SCHED_EVENT_LIST_SIZE, gpSched_globals.gpSched_EventFree_p);
+#ifdef GP_SCHED_DIVERSITY_EVENT_HEAP
+    Sched_EventQueueInit(gpSched_EventArray, GP_UTILS_LL_SIZE_OF (gpSched_Event_t));
+#endif //GP_SCHED_DIVERSITY_EVENT_HEAP
 
 #if defined(GP_DIVERSITY_JUMPTABLES)
     gpSched_globals.AppDiversitySleep = SCHED_APP_DIVERSITY_SLEEP();
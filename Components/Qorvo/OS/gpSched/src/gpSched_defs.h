@@ -58,6 +58,27 @@
 #define GP_SCHED_TIME_COMPARE_LOWER_EQUAL(t1,t2)    ( ((UInt32)(((t2)  - (t1))) <= 0x80000000LU))
 #define GP_SCHED_TIME_COMPARE_LOWER(t1,t2)          (!((UInt32)(((t1)  - (t2))) <  0x80000000LU))
 
+//Size definitions
+#ifndef GP_SCHED_EVENT_LIST_SIZE
+#define GP_SCHED_EVENT_LIST_SIZE            10
+#endif
+
+#ifdef GP_SCHED_DIVERSITY_EVENT_HEAP
+//Number of callback hash buckets of the event heap, power of 2
+#ifndef GP_SCHED_EVENT_HASH_SIZE
+#define GP_SCHED_EVENT_HASH_SIZE            16
+#endif
+
+//The event list is only used for its lock when the event heap is active
+#define SCHED_EVENT_QUEUE_FIRST(plst)           ((void)(plst), Sched_EventQueueFirst())
+#define SCHED_EVENT_QUEUE_UNLINK(pevt, plst)    ((void)(plst), Sched_EventQueueRemove(pevt))
+#define SCHED_EVENT_QUEUE_IS_EMPTY(plst)        ((void)(plst), Sched_EventQueueEmpty())
+#else
+#define SCHED_EVENT_QUEUE_FIRST(plst)           ((gpSched_Event_t*)gpUtils_LLGetFirstElem(plst))
+#define SCHED_EVENT_QUEUE_UNLINK(pevt, plst)    gpUtils_LLUnlink(pevt, plst)
+#define SCHED_EVENT_QUEUE_IS_EMPTY(plst)        (!(plst)->plnk_first)
+#endif //GP_SCHED_DIVERSITY_EVENT_HEAP
+
 /*****************************************************************************
  *                    Type Definitions
  *****************************************************************************/
@@ -128,6 +149,21 @@ void Sched_Integration_DeInit(void);
 /* JUMPTABLE_FLASH_FUNCTION_DEFINITIONS_END */
 /* JUMPTABLE_ROM_FUNCTION_DEFINITIONS_END */
 
+#ifdef GP_SCHED_DIVERSITY_EVENT_HEAP
+// Pending event queue backend - see gpSched_EventHeap.c
+void Sched_EventQueueInit(void* pEventBuffer, UInt32 elemSize);
+Bool Sched_EventQueueEmpty(void);
+gpSched_Event_t* Sched_EventQueueFirst(void);
+void Sched_EventQueueInsert(gpSched_Event_t* pevt);
+void Sched_EventQueueRemove(gpSched_Event_t* pevt);
+gpSched_Event_t* Sched_EventQueueFind(gpSched_EventCallback_t callback, void* arg);
+UInt32 Sched_EventQueueLatestWithin(UInt32 limit, UInt8* pNrOfEvents);
+#endif //GP_SCHED_DIVERSITY_EVENT_HEAP
+
+/** @brief Time to the next event, extended to the last event due within slack us of it.
+ *  @param pNrOfEvents Returns the number of events that will be handled on this single timeout. */
+UInt32 Sched_GetTimeToNextEventCoalesced(UInt32 slack, UInt8* pNrOfEvents);
+
 #if defined(GP_DIVERSITY_JUMPTABLES) && defined(GP_DIVERSITY_ROM_CODE)
     // in case we are in ROM, we need to retrieve the pointer via a shim table entry
 #define GP_SCHED_GET_GLOBALS()    ((gpSched_globals_t*) JumpTables_DataTable.gpSched_globals_ptr)
@@ -42,7 +42,7 @@
 #include "hal.h"
 #include "FreeRTOS.h"
 #include "task.h"
-#include "timers.h"
+#include "queue.h"
 
 #include "gpUtils.h"
 #include "gpSched.h"
@@ -63,17 +63,46 @@
 #define GP_SCHED_TASK_NOTIFY_TERMINATE_MASK (0x2UL)
 #define GP_SCHED_TASK_NOTIFY_ALL_MASK       (GP_SCHED_TASK_NOTIFY_EVENTQ_MASK | GP_SCHED_TASK_NOTIFY_TERMINATE_MASK)
 
-#define SCHED_EVENT_QUEUE_LENGTH 5
+/** @brief Number of events that can be deferred from interrupt context before the task drains them, power of 2 */
+#ifndef GP_SCHED_DEFERRED_RING_SIZE
+#define GP_SCHED_DEFERRED_RING_SIZE 16
+#endif
+
+#if (GP_SCHED_DEFERRED_RING_SIZE & (GP_SCHED_DEFERRED_RING_SIZE - 1)) != 0
+#error GP_SCHED_DEFERRED_RING_SIZE must be a power of 2
+#endif
+
+#define SCHED_DEFERRED_RING_MASK (GP_SCHED_DEFERRED_RING_SIZE - 1)
+
+/** @brief Number of events the locked overflow queue takes when the deferred ring is full */
+#ifndef GP_SCHED_DEFERRED_OVERFLOW_SIZE
+#define GP_SCHED_DEFERRED_OVERFLOW_SIZE 5
+#endif
+
+/** @brief Events due within this window (us) after the next event are handled on the same timer wakeup.
+ *         0 disables coalescing: the timer is always programmed for the next event. */
+#ifndef GP_SCHED_TIMER_SLACK_US
+#define GP_SCHED_TIMER_SLACK_US 0
+#endif
+
 /*****************************************************************************
  *                    Type Definitions
  *****************************************************************************/
 
+/* Slot of the deferred event ring. The sequence number tells producers and
+ * the consumer whether the slot is free or filled for a given ring position. */
+typedef struct {
+    UInt32 sequence;
+    UInt32 rel_time;
+    gpSched_EventCallback_t callback;
+    void* arg;
+} schedDeferredSlot_t;
 
 typedef struct {
     UInt32 rel_time;
     gpSched_EventCallback_t callback;
     void* arg;
-} schedEventQueueElement_t;
+} schedDeferredOverflowElement_t;
 
 /*****************************************************************************
  *                    Static Data Definitions
@@ -86,12 +115,6 @@ static TaskHandle_t gpSched_TaskHandle;
 static StaticTask_t gpSched_TaskInfo;
 /** @brief gpSched FreeRTOS Stack allocation */
 static StackType_t gpSched_TaskStack[GP_SCHED_TASK_STACK_SIZE];
-
-/* The variable used to hold the scheduler event queue's data structure. */
-static StaticQueue_t xSchedEventStaticQueue;
-/* The array to use as the scheduler event queue's storage area.  This must be at least
-uxQueueLength * uxItemSize bytes. */
-uint8_t ucSchedEventQueueStorageArea[SCHED_EVENT_QUEUE_LENGTH * sizeof(schedEventQueueElement_t)];
 #endif // GP_FREERTOS_DIVERSITY_HEAP
 
 /** @brief Bool to signal initialisation done before the main loop has passed. */
@@ -99,8 +122,24 @@ static Bool gpSched_AppInitDone;
 /** @brief ID of claimed HW Absolute Event for kick of gpSched task */
 static gpHal_AbsoluteEventId_t gpSched_ESTimerId;
 
-
-QueueHandle_t xSchedEventQueue;
+/** @brief Multi-producer (interrupts), single consumer (gpSched task) ring of deferred events */
+static schedDeferredSlot_t gpSched_DeferredRing[GP_SCHED_DEFERRED_RING_SIZE];
+/** @brief Next ring position to be claimed by a producer */
+static UInt32 gpSched_DeferredHead;
+/** @brief Next ring position to be drained by the gpSched task */
+static UInt32 gpSched_DeferredTail;
+
+/** @brief Locked queue taking deferred events while the ring is full */
+static QueueHandle_t gpSched_DeferredOverflowQueue;
+static StaticQueue_t gpSched_DeferredOverflowQueueInfo;
+static UInt8 gpSched_DeferredOverflowQueueStorage[GP_SCHED_DEFERRED_OVERFLOW_SIZE * sizeof(schedDeferredOverflowElement_t)];
+
+/** @brief Deferred event and timer coalescing counters */
+static gpSched_DeferredStats_t gpSched_DeferredStats;
+/** @brief Absolute time the ES timer was last programmed for */
+static UInt32 gpSched_CoalescedTarget;
+/** @brief Events coalesced on the programmed ES timer, counted once the timer has expired */
+static UInt8 gpSched_CoalescedPending;
 
 /*****************************************************************************
  *                    External Function Prototypes
@@ -114,10 +153,109 @@ extern void Application_Init(void);
 
 #define Sched_WriteDbgInfo(line, arg1, arg2, arg3)
 
-static void Sched_ScheduleESTimer(UInt32 nextEventTime)
+/* Lock-free claim of a ring slot, callable from any interrupt priority */
+static Bool Sched_DeferredPush(UInt32 rel_time, gpSched_EventCallback_t callback, void* arg)
+{
+    schedDeferredSlot_t* pSlot;
+    UInt32 pos = __atomic_load_n(&gpSched_DeferredHead, __ATOMIC_RELAXED);
+    UInt32 depth;
+    UInt32 highWaterMark;
+
+    for(;;)
+    {
+        Int32 diff;
+
+        pSlot = &gpSched_DeferredRing[pos & SCHED_DEFERRED_RING_MASK];
+        diff = (Int32)(__atomic_load_n(&pSlot->sequence, __ATOMIC_ACQUIRE) - pos);
+        if(diff == 0)
+        {
+            if(__atomic_compare_exchange_n(&gpSched_DeferredHead, &pos, pos + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            {
+                break;
+            }
+        }
+        else if(diff < 0)
+        {
+            // Ring full
+            return false;
+        }
+        else
+        {
+            pos = __atomic_load_n(&gpSched_DeferredHead, __ATOMIC_RELAXED);
+        }
+    }
+
+    pSlot->rel_time = rel_time;
+    pSlot->callback = callback;
+    pSlot->arg = arg;
+    __atomic_store_n(&pSlot->sequence, pos + 1, __ATOMIC_RELEASE);
+
+    // Counters are updated lock-free as well, producers may preempt each other
+    depth = pos + 1 - __atomic_load_n(&gpSched_DeferredTail, __ATOMIC_RELAXED);
+    highWaterMark = __atomic_load_n(&gpSched_DeferredStats.deferredHighWaterMark, __ATOMIC_RELAXED);
+    while((depth > highWaterMark) &&
+          !__atomic_compare_exchange_n(&gpSched_DeferredStats.deferredHighWaterMark, &highWaterMark, depth, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    {
+    }
+    __atomic_fetch_add(&gpSched_DeferredStats.deferredEvents, 1, __ATOMIC_RELAXED);
+    return true;
+}
+
+/* Schedule all events deferred from interrupt context in one pass */
+static void Sched_DeferredDrain(void)
+{
+    schedDeferredOverflowElement_t element;
+
+    for(;;)
+    {
+        schedDeferredSlot_t* pSlot = &gpSched_DeferredRing[gpSched_DeferredTail & SCHED_DEFERRED_RING_MASK];
+        UInt32 rel_time;
+        gpSched_EventCallback_t callback;
+        void* arg;
+
+        if(__atomic_load_n(&pSlot->sequence, __ATOMIC_ACQUIRE) != (gpSched_DeferredTail + 1))
+        {
+            // Empty
+            break;
+        }
+        rel_time = pSlot->rel_time;
+        callback = pSlot->callback;
+        arg = pSlot->arg;
+        // Hand the slot back to the producers
+        __atomic_store_n(&pSlot->sequence, gpSched_DeferredTail + GP_SCHED_DEFERRED_RING_SIZE, __ATOMIC_RELEASE);
+        __atomic_store_n(&gpSched_DeferredTail, gpSched_DeferredTail + 1, __ATOMIC_RELAXED);
+
+        gpSched_ScheduleEventArg(rel_time, callback, arg);
+    }
+
+    // Events that did not fit in the ring
+    while(xQueueReceive(gpSched_DeferredOverflowQueue, &element, (TickType_t)0) == pdPASS)
+    {
+        gpSched_ScheduleEventArg(element.rel_time, element.callback, element.arg);
+    }
+}
+
+/* Count the events coalesced on the programmed ES timer once it has expired.
+ * A timer reprogrammed before expiry replaces its pending count, so no event is counted twice. */
+static void Sched_CoalescedSettle(void)
+{
+    UInt32 currTime;
+
+    if(gpSched_CoalescedPending != 0)
+    {
+        HAL_TIMER_GET_CURRENT_TIME_1US(currTime);
+        if(GP_SCHED_TIME_COMPARE_BIGGER_EQUAL(currTime, gpSched_CoalescedTarget))
+        {
+            gpSched_DeferredStats.coalescedEvents += gpSched_CoalescedPending;
+            gpSched_CoalescedPending = 0;
+        }
+    }
+}
+
+static UInt32 Sched_ScheduleESTimer(UInt32 nextEventTime)
 {
     UInt32 currTime = 0;
-    UInt32 absTime;
+    UInt32 absTime = 0;
     UInt8 control = 0;
 
     if(nextEventTime)
@@ -133,6 +271,7 @@ static void Sched_ScheduleESTimer(UInt32 nextEventTime)
         ENABLE_GP_GLOBAL_INT();
         Sched_WriteDbgInfo(__LINE__, currTime, nextEventTime, absTime);
     }
+    return absTime;
 }
 
 static void Sched_SetupESTimer(void)
@@ -173,17 +312,24 @@ static void Sched_Main(void* params)
         if((notificationVal & GP_SCHED_TASK_NOTIFY_EVENTQ_MASK) != 0UL)
         {
             GP_UTILS_CPUMON_NEW_SCHEDULER_LOOP();
+            GP_UTILS_PROF_SCOPE(gpUtils_ProfProbeSchedLoop);
+            Sched_DeferredDrain();
+            Sched_CoalescedSettle();
             gpSched_Main_Body();
             while((!gpSched_EventQueueEmpty() && (timerScheduled == false)) || (HAL_RADIO_INT_CHECK_IF_OCCURED()))
             {
                 gpSched_Main_Body();
                 if(!gpSched_EventQueueEmpty())
                 {
-                    nextEventTime = gpSched_GetTimeToNextEvent();
+                    UInt8 nrOfEvents;
+
+                    nextEventTime = Sched_GetTimeToNextEventCoalesced(GP_SCHED_TIMER_SLACK_US, &nrOfEvents);
                     if((nextEventTime > 0) && (timerScheduled == false))
                     {
                         Sched_WriteDbgInfo(__LINE__, 0, nextEventTime, 0);
-                        Sched_ScheduleESTimer(nextEventTime);
+                        Sched_CoalescedSettle();
+                        gpSched_CoalescedTarget = Sched_ScheduleESTimer(nextEventTime);
+                        gpSched_CoalescedPending = nrOfEvents - 1;
                         timerScheduled = true;
                     }
                 }
@@ -194,6 +340,7 @@ static void Sched_Main(void* params)
             }
 #if GP_SCHED_NR_OF_IDLE_CALLBACKS > 0
             gpSched_PostProcessIdle();
+            GP_UTILS_CPUMON_PROCDONE(POSTPROCESSING);
 #endif
         }
         /* terminate signal received */
@@ -206,19 +353,6 @@ static void Sched_Main(void* params)
     vTaskDelete(NULL);
 }
 
-static void gpSched_DeferredEvent(void* pvParameter1, uint32_t ulParameter2)
-{
-    (void)pvParameter1;
-    (void)ulParameter2;
-
-    schedEventQueueElement_t queueElement = {0};
-
-    if(xQueueReceive(xSchedEventQueue, &(queueElement), (TickType_t)0) == pdPASS)
-    {
-        gpSched_ScheduleEventArg(queueElement.rel_time, queueElement.callback, queueElement.arg);
-    }
-}
-
 /*****************************************************************************
  *                    FreeRTOS weak overrides
  *****************************************************************************/
@@ -265,14 +399,28 @@ Bool gpSched_ScheduleEventDeferred(UInt32 rel_time, gpSched_EventCallback_t call
 
     if(psr.b.ISR != 0)
     {
-        schedEventQueueElement_t queueElement = {
-            .rel_time = rel_time,
-            .callback = callback,
-            .arg = arg,
-        };
         BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-        xQueueSendFromISR(xSchedEventQueue, &queueElement, &xHigherPriorityTaskWoken);
-        xTimerPendFunctionCallFromISR(gpSched_DeferredEvent, NULL, 0, &xHigherPriorityTaskWoken);
+
+        if(!Sched_DeferredPush(rel_time, callback, arg))
+        {
+            // Ring full, fall back to the locked queue
+            schedDeferredOverflowElement_t element = {
+                .rel_time = rel_time,
+                .callback = callback,
+                .arg = arg
+            };
+
+            if(xQueueSendFromISR(gpSched_DeferredOverflowQueue, &element, &xHigherPriorityTaskWoken) != pdPASS)
+            {
+                __atomic_fetch_add(&gpSched_DeferredStats.deferredDropped, 1, __ATOMIC_RELAXED);
+                GP_ASSERT_DEV_EXT(false);
+                return true;
+            }
+            __atomic_fetch_add(&gpSched_DeferredStats.deferredOverflow, 1, __ATOMIC_RELAXED);
+            __atomic_fetch_add(&gpSched_DeferredStats.deferredEvents, 1, __ATOMIC_RELAXED);
+        }
+        // Wake the task directly; everything queued until it runs is drained in one batch
+        xTaskNotifyFromISR(gpSched_TaskHandle, GP_SCHED_TASK_NOTIFY_EVENTQ_MASK, eSetBits, &xHigherPriorityTaskWoken);
         portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
         return true;
     }
@@ -321,10 +469,29 @@ MAIN_FUNCTION_RETURN_TYPE MAIN_FUNCTION_NAME(void)
 }
 #endif // GP_SCHED_EXTERNAL_MAIN
 
+void gpSched_GetDeferredStats(gpSched_DeferredStats_t* pStats)
+{
+    GP_ASSERT_DEV_EXT(pStats != NULL);
+    HAL_DISABLE_GLOBAL_INT();
+    MEMCPY(pStats, &gpSched_DeferredStats, sizeof(gpSched_DeferredStats_t));
+    HAL_ENABLE_GLOBAL_INT();
+}
+
 void Sched_Integration_Init(void)
 {
-    xSchedEventQueue = xQueueCreateStatic(SCHED_EVENT_QUEUE_LENGTH, sizeof(schedEventQueueElement_t),
-                                          ucSchedEventQueueStorageArea, &xSchedEventStaticQueue);
+    UIntLoop i;
+
+    gpSched_DeferredHead = 0;
+    gpSched_DeferredTail = 0;
+    for(i = 0; i < GP_SCHED_DEFERRED_RING_SIZE; i++)
+    {
+        gpSched_DeferredRing[i].sequence = i;
+    }
+    MEMSET(&gpSched_DeferredStats, 0, sizeof(gpSched_DeferredStats));
+    gpSched_CoalescedPending = 0;
+    gpSched_DeferredOverflowQueue = xQueueCreateStatic(GP_SCHED_DEFERRED_OVERFLOW_SIZE, sizeof(schedDeferredOverflowElement_t),
+                                                       gpSched_DeferredOverflowQueueStorage, &gpSched_DeferredOverflowQueueInfo);
+    GP_ASSERT_SYSTEM(gpSched_DeferredOverflowQueue != NULL);
 
     return;
 }
@@ -86,16 +86,19 @@ MAIN_FUNCTION_RETURN_TYPE MAIN_FUNCTION_NAME(void)
     for (;;)
     {
         GP_UTILS_CPUMON_NEW_SCHEDULER_LOOP();
-        gpSched_Main_Body();
+        {
+            GP_UTILS_PROF_SCOPE(gpUtils_ProfProbeSchedLoop);
+            gpSched_Main_Body();
 
 #if GP_SCHED_NR_OF_IDLE_CALLBACKS > 0
-        /* When new work can be indicated to an external stack/scheduler at many locations in our stack it is
-         * easier and less error-prone to service that stack here than at all these different code locations.
-         * Continuously rescheduling a handler event is not a good alternative because this prohibits sleeping. */
-        /* Call all registered post processing callbacks*/
-        gpSched_PostProcessIdle();
-        GP_UTILS_CPUMON_PROCDONE(POSTPROCESSING);
+            /* When new work can be indicated to an external stack/scheduler at many locations in our stack it is
+             * easier and less error-prone to service that stack here than at all these different code locations.
+             * Continuously rescheduling a handler event is not a good alternative because this prohibits sleeping. */
+            /* Call all registered post processing callbacks*/
+            gpSched_PostProcessIdle();
+            GP_UTILS_CPUMON_PROCDONE(POSTPROCESSING);
 #endif /* GP_SCHED_NR_OF_IDLE_CALLBACKS > 0*/
+        }
     }
 
     return MAIN_FUNCTION_RETURN_VALUE;
@@ -59,6 +59,24 @@ void qorvoRadioReset(void);
  */
 void qorvoRadioProcess(void);
 
+/**
+ * Receive path statistics, counted since qorvoRadioInit().
+ *
+ */
+typedef struct {
+    uint32_t rxFrames;      ///< Frames queued towards OpenThread
+    uint32_t rxDropped;     ///< Frames dropped because all receive slots were still in use
+    uint32_t rxCopiedBytes; ///< PSDU bytes copied out of the packet buffer memory
+} qorvoRadioRxCounters_t;
+
+/**
+ * This function returns the receive path statistics.
+ *
+ * @param[out] pCounters  Location to store the counters.
+ *
+ */
+void qorvoRadioGetRxCounters(qorvoRadioRxCounters_t* pCounters);
+
 /**
  * This function starts an ED scan.
  *
@@ -59,6 +59,14 @@
 GP_COMPILE_TIME_VERIFY(GP_SCHED_DEFAULT_GOTOSLEEP_THRES>0);
 #endif //GP_SCHED_FREE_CPU_TIME
 
+/** @brief Number of received frames that can be queued towards OpenThread - must be a power of 2 */
+#ifndef QVOT_RADIO_RX_QUEUE_SIZE
+#define QVOT_RADIO_RX_QUEUE_SIZE    4
+#endif //QVOT_RADIO_RX_QUEUE_SIZE
+
+GP_COMPILE_TIME_VERIFY((QVOT_RADIO_RX_QUEUE_SIZE & (QVOT_RADIO_RX_QUEUE_SIZE - 1)) == 0);
+GP_COMPILE_TIME_VERIFY(QVOT_RADIO_RX_QUEUE_SIZE <= 128);
+
 /*****************************************************************************
  *                    Static Function Prototypes
  *****************************************************************************/
@@ -100,6 +108,7 @@ static gpMacCore_StackId_t qorvoGetStackId(void);
 static void qorvoSetStackId(gpMacCore_StackId_t stackId);
 static bool qorvoValidStackId(gpMacCore_StackId_t stackId);
 static otError qorvoToThreadError(gpMacCore_Result_t res);
+static void qorvoRadioDeliverReceivedFrames(void);
 
 /*****************************************************************************
  *                    Type Definitions
@@ -109,10 +118,19 @@ static otError qorvoToThreadError(gpMacCore_Result_t res);
  *                    Static Data Definitions
  *****************************************************************************/
 
-static otRadioFrame sReceiveFrame;
+#define QVOT_RADIO_RX_QUEUE_ENTRY(index)    ((index) & (QVOT_RADIO_RX_QUEUE_SIZE - 1))
+
+/* Received frames waiting for OpenThread. Slots are filled by the data indication (tail) and
+ * released after cbQorvoRadioReceiveDone() returned (head), so a frame that OpenThread is still
+ * parsing is never overwritten. Both run from the scheduler. */
+static otRadioFrame sReceiveFrame[QVOT_RADIO_RX_QUEUE_SIZE];
+static uint8_t sReceivePsdu[QVOT_RADIO_RX_QUEUE_SIZE][OT_RADIO_FRAME_MAX_SIZE];
+static uint8_t sReceiveQueueHead;
+static uint8_t sReceiveQueueTail;
+static bool sReceiveDelivering;
+static qorvoRadioRxCounters_t sReceiveCounters;
 
 static uint8_t sTransmitPsdu[OT_RADIO_FRAME_MAX_SIZE];
-static uint8_t sReceivePsdu[OT_RADIO_FRAME_MAX_SIZE];
 static otError sTransmitStatus;
 
 #define QVOT_THREAD_1_2_ENABLED 0
@@ -204,6 +222,22 @@ otError qorvoToThreadError(gpMacCore_Result_t res)
     }
 }
 
+void qorvoRadioDeliverReceivedFrames(void)
+{
+    sReceiveDelivering = true;
+    while(sReceiveQueueHead != sReceiveQueueTail)
+    {
+        otRadioFrame* pFrame = &sReceiveFrame[QVOT_RADIO_RX_QUEUE_ENTRY(sReceiveQueueHead)];
+
+        GP_LOG_PRINTF("rx seq = %d", 0, pFrame->mPsdu[2]);
+        cbQorvoRadioReceiveDone(pFrame, OT_ERROR_NONE);
+
+        // Slot is only reused once OpenThread is done with the frame
+        sReceiveQueueHead++;
+    }
+    sReceiveDelivering = false;
+}
+
 /*****************************************************************************
  *                    gpMacDispatcher callbacks
  *****************************************************************************/
@@ -221,27 +255,42 @@ void gpMacDispatcher_cbDataIndication(const gpMacCore_AddressInfo_t* pSrcAddrInf
         return;
     }
 
-    // Copy packet into OT structure
-    gpPd_ReadByteStream(pdLoh.handle, pdLoh.offset, pdLoh.length, &sReceiveFrame.mPsdu[0]);
+    // Frames only queue up while cbQorvoRadioReceiveDone() runs, otherwise the ring is empty here
+    if((uint8_t)(sReceiveQueueTail - sReceiveQueueHead) >= QVOT_RADIO_RX_QUEUE_SIZE)
+    {
+        // Indication from within cbQorvoRadioReceiveDone() - drop, the sender will retry
+        sReceiveCounters.rxDropped++;
+        gpPd_FreePd(pdLoh.handle);
+        return;
+    }
+
+    otRadioFrame* pFrame = &sReceiveFrame[QVOT_RADIO_RX_QUEUE_ENTRY(sReceiveQueueTail)];
+
+    // Copy packet into OT structure - single copy out of the PBM, which is returned to the radio right away
+    gpPd_ReadByteStream(pdLoh.handle, pdLoh.offset, pdLoh.length, &pFrame->mPsdu[0]);
 
-    sReceiveFrame.mPsdu[pdLoh.length] = 0x00;     // dummy crc byte
-    sReceiveFrame.mPsdu[pdLoh.length + 1] = 0x00; // dummy crc byte
-    sReceiveFrame.mLength = pdLoh.length + 2;
-    sReceiveFrame.mChannel = gpMacDispatcher_GetCurrentChannel(qorvoGetStackId());
-    sReceiveFrame.mInfo.mRxInfo.mRssi = gpPd_GetRssi(pdLoh.handle);
-    sReceiveFrame.mInfo.mRxInfo.mLqi = gpPd_GetLqi(pdLoh.handle);
-    sReceiveFrame.mInfo.mRxInfo.mAckedWithFramePending = true;
-    sReceiveFrame.mInfo.mRxInfo.mAckedWithSecEnhAck = false;
+    pFrame->mPsdu[pdLoh.length] = 0x00;     // dummy crc byte
+    pFrame->mPsdu[pdLoh.length + 1] = 0x00; // dummy crc byte
+    pFrame->mLength = pdLoh.length + 2;
+    pFrame->mChannel = gpMacDispatcher_GetCurrentChannel(qorvoGetStackId());
+    pFrame->mInfo.mRxInfo.mRssi = gpPd_GetRssi(pdLoh.handle);
+    pFrame->mInfo.mRxInfo.mLqi = gpPd_GetLqi(pdLoh.handle);
+    pFrame->mInfo.mRxInfo.mAckedWithFramePending = true;
+    pFrame->mInfo.mRxInfo.mAckedWithSecEnhAck = false;
 
     gpPd_FreePd(pdLoh.handle);
 
-    GP_LOG_PRINTF("rx seq = %d", 0, sReceiveFrame.mPsdu[2]);
+    sReceiveCounters.rxFrames++;
+    sReceiveCounters.rxCopiedBytes += pdLoh.length;
 
+    sReceiveQueueTail++;
+
+    // Deliver synchronously, keeping the order with transmit done and other MAC callbacks.
+    // An indication from within cbQorvoRadioReceiveDone() is picked up by the running delivery loop.
+    if(!sReceiveDelivering)
     {
-        cbQorvoRadioReceiveDone(&sReceiveFrame, OT_ERROR_NONE);
+        qorvoRadioDeliverReceivedFrames();
     }
-
-
 }
 
 void gpMacDispatcher_cbDataConfirm(gpMacCore_Result_t status, UInt8 msduHandle, gpMacCore_StackId_t stackId)
@@ -335,8 +384,14 @@ void qorvoRadioInit(void)
 
     sTransmitFrame.mLength = 0;
     sTransmitFrame.mPsdu = sTransmitPsdu;
-    sReceiveFrame.mLength = 0;
-    sReceiveFrame.mPsdu = sReceivePsdu;
+    for(UIntLoop i = 0; i < QVOT_RADIO_RX_QUEUE_SIZE; i++)
+    {
+        sReceiveFrame[i].mLength = 0;
+        sReceiveFrame[i].mPsdu = sReceivePsdu[i];
+    }
+    sReceiveQueueHead = 0;
+    sReceiveQueueTail = 0;
+    MEMSET(&sReceiveCounters, 0, sizeof(sReceiveCounters));
 
     //register NWK layer to MAC layer
     qorvoSetStackId(gpMacDispatcher_RegisterNetworkStack(&openThreadStringId));
@@ -416,6 +471,11 @@ void qorvoRadioProcess(void)
 {
 }
 
+void qorvoRadioGetRxCounters(qorvoRadioRxCounters_t* pCounters)
+{
+    MEMCPY(pCounters, &sReceiveCounters, sizeof(qorvoRadioRxCounters_t));
+}
+
 void qorvoRadioGetIeeeEui64(uint8_t* aIeeeEui64)
 {
     for(UInt8 i = 0; i < OT_EXT_ADDRESS_SIZE; i++)
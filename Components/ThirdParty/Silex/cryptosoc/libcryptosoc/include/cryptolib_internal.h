@@ -26,6 +26,20 @@
 #include "gpAssert.h"
 #include "gpLog.h"
 
+#if defined(GP_SILEXCRYPTOSOC_DIVERSITY_HOST_SIM)
+#include "sx_hostsim.h"
+
+// addresses of the host model of the engines
+#define ADDR_CRYPTOMASTER_REGS      ((uintptr_t)sx_hostsim_cryptomaster_regs)
+#define ADDR_BA431_REGS             ((uintptr_t)sx_hostsim_ba431_regs)
+#define ADDR_BA414E_REGS            ((uintptr_t)sx_hostsim_ba414e_regs)
+#define ADDR_BA431_FIFO             ((uintptr_t)sx_hostsim_ba431_fifo)
+#define ADDR_BA414E_CRYPTORAM       ((uintptr_t)sx_hostsim_ba414e_cryptoram)
+#define ADDR_BA414E_UCODE           ((uintptr_t)sx_hostsim_ba414e_ucode)
+
+// the model runs the engines synchronously from the register writes
+#define CRYPTOLIB_DMA_BARRIER()     __sync_synchronize()
+#else //defined(GP_SILEXCRYPTOSOC_DIVERSITY_HOST_SIM)
 // addresses
 #define ADDR_CRYPTOMASTER_REGS      GP_MM_AHB_CRYPTOMASTER_DMA_START
 #define ADDR_BA431_REGS             GP_MM_AHB_RNG_CONTROL_REG_START
@@ -36,6 +50,7 @@
 
 // memory barrier before and after DMA
 #define CRYPTOLIB_DMA_BARRIER()     __DMB()
+#endif //defined(GP_SILEXCRYPTOSOC_DIVERSITY_HOST_SIM)
 
 // Wait type
 // 0: use irq hook macro bellow
@@ -43,6 +43,11 @@
 
 #include "hal.h"
 #include "gpHal.h"
+#include "gpUtils.h"
+#ifdef GP_DIVERSITY_FREERTOS
+#include "FreeRTOS.h"
+#include "task.h"
+#endif //GP_DIVERSITY_FREERTOS
 
 const block_t NULL_blk = {NULL, 0, BLOCK_S_INCR_ADDR | DMA_AXI_DESCR_DISCARD};
 
@@ -50,6 +55,40 @@ static bool rng_startup_failed = false;
 
 HAL_CRITICAL_SECTION_DEF(sx_usage_lock);
 
+/* Owner and nesting depth of the running crypto session, protected by sx_usage_lock */
+static void* sx_clock_owner;
+static UInt8 sx_clock_depth;
+static sx_clock_stats_t sx_clock_stats;
+
+#ifdef GP_UTILS_DIVERSITY_PROFILER
+/* Start of the running crypto session, protected by sx_usage_lock */
+static UInt32 sx_prof_session_start;
+#endif //GP_UTILS_DIVERSITY_PROFILER
+
+/* Markers for sessions not owned by a task */
+#define SX_CLOCK_OWNER_NO_TASK  ((void*)&sx_clock_owner)
+#define SX_CLOCK_OWNER_ISR      ((void*)&sx_clock_depth)
+
+static void* sx_clock_self(void)
+{
+    // The host model has neither interrupts nor a scheduler: all callers share one context
+#if defined(GP_DIVERSITY_FREERTOS) && !defined(GP_SILEXCRYPTOSOC_DIVERSITY_HOST_SIM)
+    xPSR_Type psr;
+    psr.w = __get_xPSR();
+
+    // An interrupt never joins the session of the task it preempted
+    if(psr.b.ISR != 0)
+    {
+        return SX_CLOCK_OWNER_ISR;
+    }
+    if(xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED)
+    {
+        return (void*)xTaskGetCurrentTaskHandle();
+    }
+#endif //GP_DIVERSITY_FREERTOS && !GP_SILEXCRYPTOSOC_DIVERSITY_HOST_SIM
+    return SX_CLOCK_OWNER_NO_TASK;
+}
+
 void sx_math_u64_to_u8array(uint64_t in, uint8_t *out, uint32_t little_endian)
 {
    UInt32 i = 0;
@@ -82,6 +121,19 @@ void sx_rng_set_startup_failed(bool fail)
 
 void sx_enable_clock(void)
 {
+    void* self = sx_clock_self();
+
+    // Nested call from the owner of the running session: keep the engine clocked
+    // The owner and depth only change under sx_usage_lock, the owner can't match for another context.
+    // All interrupts share one marker, so an interrupt never nests: it could be preempting another one
+    if((self != SX_CLOCK_OWNER_ISR) && (sx_clock_depth != 0) && (sx_clock_owner == self))
+    {
+        GP_ASSERT_SYSTEM(sx_clock_depth < 0xFF);
+        sx_clock_depth++;
+        sx_clock_stats.nested++;
+        return;
+    }
+
 #ifdef HAL_MUTEX_SUPPORTED
     // Create mutex first time enable was called
     if(!HAL_VALID_MUTEX(sx_usage_lock))
@@ -94,12 +146,29 @@ void sx_enable_clock(void)
     GP_ASSERT_SYSTEM(GP_WB_READ_SEC_PROC_CTRL_SEC_PROC_ENABLE() == 0);
 
     GP_WB_WRITE_SEC_PROC_CTRL_SEC_PROC_ENABLE(1);
+    sx_clock_owner = self;
+    sx_clock_depth = 1;
+    sx_clock_stats.sessions++;
+#ifdef GP_UTILS_DIVERSITY_PROFILER
+    sx_prof_session_start = gpUtils_ProfGetTime();
+#endif //GP_UTILS_DIVERSITY_PROFILER
 }
 
 void sx_disable_clock(void)
 {
+    GP_ASSERT_SYSTEM(sx_clock_depth != 0);
+    sx_clock_depth--;
+    if(sx_clock_depth != 0)
+    {
+        return;
+    }
+    sx_clock_owner = NULL;
+
     // Make sure clock was enabled before disabling
     GP_ASSERT_SYSTEM(GP_WB_READ_SEC_PROC_CTRL_SEC_PROC_ENABLE() == 1);
+#ifdef GP_UTILS_DIVERSITY_PROFILER
+    gpUtils_ProfRecord(gpUtils_ProfProbeCrypto, gpUtils_ProfGetTime() - sx_prof_session_start);
+#endif //GP_UTILS_DIVERSITY_PROFILER
 
     GP_WB_WRITE_SEC_PROC_CTRL_SEC_PROC_ENABLE(0);
 
@@ -109,3 +178,9 @@ void sx_disable_clock(void)
 #endif //HAL_MUTEX_SUPPORTED
 }
 
+void sx_clock_get_stats(sx_clock_stats_t *stats)
+{
+    HAL_DISABLE_GLOBAL_INT();
+    *stats = sx_clock_stats;
+    HAL_ENABLE_GLOBAL_INT();
+}
@@ -0,0 +1,781 @@
+/*
+ * Copyright (c) 2026, Qorvo Inc
+ *
+ * This software is owned by Qorvo Inc
+ * and protected under applicable copyright laws.
+ * It is delivered under the terms of the license
+ * and is intended and supplied for use solely and
+ * exclusively with products manufactured by
+ * Qorvo Inc.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED IN AN "AS IS"
+ * CONDITION. NO WARRANTIES, WHETHER EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING, BUT NOT
+ * LIMITED TO, IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ * QORVO INC. SHALL NOT, IN ANY
+ * CIRCUMSTANCES, BE LIABLE FOR SPECIAL,
+ * INCIDENTAL OR CONSEQUENTIAL DAMAGES,
+ * FOR ANY REASON WHATSOEVER.
+ *
+ * $Header$
+ * $Change$
+ * $DateTime$
+ *
+ */
+/**
+ * @file
+ * @brief Asynchronous crypto job queue, see sx_async.h
+ *
+ * The ROM functions (sx_hash_blk(), sx_aes_blk(), ...) build their descriptors and poll the cryptomaster DMA until
+ * it is done. For the DMA jobs, the descriptors are built here the same way, but the DMA is started with the
+ * pusher-stopped interrupt enabled and the worker task blocks until the SECPROC interrupt.
+ */
+
+/*****************************************************************************
+ *                    Includes Definitions
+ *****************************************************************************/
+
+#include "cryptolib_internal.h"
+#include "cryptolib_def.h"
+#include <stddef.h>
+#include <stdbool.h>
+#include "cryptodma.h"
+#include "sxregs.h"
+#include "ba411e_config.h"
+#include "ba413_config.h"
+#include "memcmp.h"
+#include "sx_generic.h"
+#include "sx_async.h"
+#include "silexCryptoSoc_Defs.h"
+
+#include "hal.h"
+#include "gpHal.h"
+
+#if defined(GP_SILEXCRYPTOSOC_DIVERSITY_ASYNC)
+
+#if !defined(GP_DIVERSITY_FREERTOS)
+#error "GP_SILEXCRYPTOSOC_DIVERSITY_ASYNC needs a worker task (GP_DIVERSITY_FREERTOS)"
+#endif //GP_DIVERSITY_FREERTOS
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*****************************************************************************
+ *                    Macro Definitions
+ *****************************************************************************/
+
+#define SX_ASYNC_TASK_NAME              "crypto"
+
+/* Notification bits of the worker task */
+#define SX_ASYNC_NOTIFY_JOB             0x1
+#define SX_ASYNC_NOTIFY_DMA_DONE        0x2
+
+/* Descriptors of one DMA job: sized for AES (ECB/CCM), a single block hash needs 4 in and 2 out */
+#define SX_ASYNC_MAX_FETCH_DESCRIPTORS  9
+#define SX_ASYNC_MAX_PUSH_DESCRIPTORS   5
+
+/* Maximum CCM header size, excluding the aad that is transferred directly */
+#define SX_ASYNC_CCM_HEADER_SIZE        22
+
+#define SX_ASYNC_AES_BLOCK_SIZE         16
+
+/* DMA interrupts: completion, and fetcher/pusher bus errors so a failing job is completed without waiting for the timeout */
+#define SX_ASYNC_DMA_INT_ERROR          (DMA_AXI_INTENSETREG_FETCHER_ERROR_EN | DMA_AXI_INTENSETREG_PUSHER_ERROR_EN)
+#define SX_ASYNC_DMA_INT_EN             (DMA_AXI_INTENSETREG_PUSHER_STOPPED_EN | SX_ASYNC_DMA_INT_ERROR)
+
+#if defined(GP_SILEXCRYPTOSOC_DIVERSITY_ASYNC_BENCHMARK)
+#define SX_ASYNC_BENCH_ITERATIONS       16
+#define SX_ASYNC_BENCH_HASH_SIZE        1024
+#define SX_ASYNC_BENCH_AES_SIZE         256
+/* Bit used to signal the benchmark task, not used by the worker task */
+#define SX_ASYNC_NOTIFY_BENCH_DONE      0x80000000UL
+
+/* Operation ids logged by the benchmark */
+#define SX_ASYNC_BENCH_SHA256_1K        0
+#define SX_ASYNC_BENCH_AES_ECB_256      1
+#define SX_ASYNC_BENCH_AES_CCM_256      2
+#endif //GP_SILEXCRYPTOSOC_DIVERSITY_ASYNC_BENCHMARK
+
+/*****************************************************************************
+ *                    Static Data Definitions
+ *****************************************************************************/
+
+static dma_sg_regs32_t * const sx_async_regs = (dma_sg_regs32_t *) ADDR_CRYPTOMASTER_REGS;
+
+/* Job queue, protected by disabling interrupts */
+static sx_async_job_t *sx_async_head;
+static sx_async_job_t *sx_async_tail;
+
+static TaskHandle_t sx_async_task;
+#if configSUPPORT_STATIC_ALLOCATION
+static StaticTask_t sx_async_TaskInfo;
+static StackType_t sx_async_TaskStack[SX_ASYNC_TASK_STACK_SIZE];
+#endif //configSUPPORT_STATIC_ALLOCATION
+
+/* Set when the DMA is started, cleared by the SECPROC interrupt */
+static volatile bool sx_async_dma_busy;
+static volatile uint32_t sx_async_dma_end;
+/* DMA interrupt status latched by the SECPROC interrupt */
+static volatile uint32_t sx_async_dma_int_stat;
+
+/* Descriptors and engine inputs of the running job, only used by the worker task */
+static struct dma_sg_descr_s sx_async_desc_in[SX_ASYNC_MAX_FETCH_DESCRIPTORS];
+static struct dma_sg_descr_s sx_async_desc_out[SX_ASYNC_MAX_PUSH_DESCRIPTORS];
+static uint32_t sx_async_config ALIGNED;
+static uint8_t sx_async_ccm_header[SX_ASYNC_CCM_HEADER_SIZE] ALIGNED;
+static uint8_t sx_async_tag_generated[SX_ASYNC_AES_BLOCK_SIZE] ALIGNED;
+
+/*****************************************************************************
+ *                    Static Function Definitions
+ *****************************************************************************/
+
+static uint32_t sx_async_get_time(void)
+{
+    return GET_CYCLE_COUNT();
+}
+
+/* BA413 mode of the hash functions sx_hash_internal() supports, 0 for the others */
+static uint32_t sx_async_hash_mode(sx_hash_fct_t hash_fct)
+{
+    switch(hash_fct)
+    {
+#if SHA1_ENABLED
+        case e_SHA1:   return BA413_CONF_MODE_SHA1;
+#endif //SHA1_ENABLED
+#if SHA224_ENABLED
+        case e_SHA224: return BA413_CONF_MODE_SHA224;
+#endif //SHA224_ENABLED
+        case e_SHA256: return BA413_CONF_MODE_SHA256;
+        case e_SHA384: return BA413_CONF_MODE_SHA384;
+        case e_SHA512: return BA413_CONF_MODE_SHA512;
+        default:       return 0;
+    }
+}
+
+static uint32_t sx_async_validate(sx_async_job_t *job)
+{
+    switch(job->op)
+    {
+        case SX_ASYNC_OP_HASH:
+        {
+            if(sx_async_hash_mode(job->params.hash.fct) == 0)
+            {
+                return CRYPTOLIB_INVALID_PARAM;
+            }
+            return CRYPTOLIB_SUCCESS;
+        }
+        case SX_ASYNC_OP_HASH_UPDATE:
+        {
+            uint32_t blocksize = sx_hash_get_block_size(job->params.hash.fct);
+
+            if((sx_async_hash_mode(job->params.hash.fct) == 0) ||
+               (job->params.hash.out.len != sx_hash_get_state_size(job->params.hash.fct)) ||
+               (job->params.hash.data.len % blocksize))
+            {
+                return CRYPTOLIB_INVALID_PARAM;
+            }
+            return CRYPTOLIB_SUCCESS;
+        }
+        case SX_ASYNC_OP_AES:
+        {
+            if((job->params.aes.fct != ECB) && (job->params.aes.fct != CCM))
+            {
+                return CRYPTOLIB_UNSUPPORTED_ERR;
+            }
+            if(job->params.aes.data_out.len < job->params.aes.data_in.len)
+            {
+                return CRYPTOLIB_INVALID_PARAM;
+            }
+            return sx_aes_validate_input(job->params.aes.dir, job->params.aes.fct, CTX_WHOLE, job->params.aes.key,
+                                         sx_getNULL_blk(), sx_getNULL_blk(), job->params.aes.data_in,
+                                         job->params.aes.aad, job->params.aes.tag, sx_getNULL_blk(),
+                                         job->params.aes.nonce);
+        }
+        case SX_ASYNC_OP_PK:
+        {
+            return (job->params.pk.fct != NULL) ? CRYPTOLIB_SUCCESS : CRYPTOLIB_INVALID_PARAM;
+        }
+        default:
+        {
+            return CRYPTOLIB_INVALID_PARAM;
+        }
+    }
+}
+
+/* Same descriptors as sx_hash_internal() for OP_FULL_HASH and OP_PART_HASH with a single data block */
+static void sx_async_build_hash(sx_async_job_t *job, struct ba413_regs_s *info)
+{
+    block_t extra_in = job->params.hash.out;
+    block_t data_in = job->params.hash.data;
+    block_t data_out = job->params.hash.out;
+    struct dma_sg_descr_s *current_desc;
+    uint32_t extra_in_tag;
+    uint32_t ign_bytes;
+    uint32_t genlen, outlen;
+
+    info->config = sx_async_hash_mode(job->params.hash.fct);
+    if(job->op == SX_ASYNC_OP_HASH)
+    {
+        info->config |= BA413_CONF_HWPAD | BA413_CONF_FINAL;
+        extra_in = block_t_convert(NULL, 0);
+        extra_in_tag = DMA_SG_ENGINESELECT_BA413;
+        genlen = sx_hash_get_digest_size(job->params.hash.fct);
+    }
+    else
+    {
+        extra_in_tag = DMA_SG_TAG_DATATYPE_HASHINIT | DMA_SG_ENGINESELECT_BA413 |
+                       DMA_SG_TAG_ISDATA | DMA_SG_TAG_ISLAST;
+        genlen = sx_hash_get_state_size(job->params.hash.fct);
+    }
+
+    // configuration (to register)
+    sx_async_desc_in[0].addr = info;
+    sx_async_desc_in[0].next_descr = &sx_async_desc_in[1];
+    sx_async_desc_in[0].length_irq = 4 | DMA_AXI_DESCR_REALIGN;
+    sx_async_desc_in[0].tag = DMA_SG_ENGINESELECT_BA413 | DMA_SG_TAG_ISCONFIG;
+
+    // init value
+    sx_async_desc_in[1].addr = extra_in.addr;
+    sx_async_desc_in[1].next_descr = &sx_async_desc_in[2];
+    sx_async_desc_in[1].length_irq = extra_in.len | (extra_in.flags & BLOCK_S_FLAG_MASK_DMA_PROPS) | DMA_AXI_DESCR_REALIGN;
+    sx_async_desc_in[1].tag = extra_in_tag;
+
+    // data
+    current_desc = &sx_async_desc_in[1];
+    if(data_in.len)
+    {
+        current_desc++;
+        current_desc->addr = data_in.addr;
+        current_desc->length_irq = data_in.len | (data_in.flags & BLOCK_S_FLAG_MASK_DMA_PROPS);
+        current_desc->tag = DMA_SG_ENGINESELECT_BA413 | DMA_SG_TAG_ISDATA | DMA_SG_TAG_DATATYPE_HASHMSG;
+    }
+
+    if(data_in.len == 0)
+    {
+        ign_bytes = 4;
+    }
+    else if(data_in.len & 0x3)
+    {
+        ign_bytes = 4 - (data_in.len & 0x3);
+    }
+    else
+    {
+        ign_bytes = 0;
+    }
+
+    // last descriptor
+    current_desc->next_descr = DMA_AXI_DESCR_NEXT_STOP;
+    current_desc->length_irq += ign_bytes;
+    current_desc->length_irq |= DMA_AXI_DESCR_REALIGN;
+    current_desc->tag |= DMA_SG_TAG_ISLAST | (ign_bytes << 8);
+
+    // output digest or state
+    outlen = SX_MIN(genlen, data_out.len);
+    sx_async_desc_out[0].addr = data_out.addr;
+    sx_async_desc_out[0].next_descr = &sx_async_desc_out[1];
+    sx_async_desc_out[0].length_irq = outlen | (data_out.flags & BLOCK_S_FLAG_MASK_DMA_PROPS);
+
+    // discard unused
+    sx_async_desc_out[1].addr = NULL;
+    sx_async_desc_out[1].next_descr = DMA_AXI_DESCR_NEXT_STOP;
+    sx_async_desc_out[1].length_irq = (genlen - outlen) | BLOCK_S_INCR_ADDR | DMA_AXI_DESCR_DISCARD | DMA_AXI_DESCR_REALIGN;
+}
+
+/* Same descriptors as sx_aes_build_descr() for ECB and CCM on a whole message */
+static void sx_async_build_aes(block_t *config, block_t *key, block_t *datain, block_t *dataout, block_t *aad1,
+                               block_t *aad2, block_t *tag_in, block_t *tag_out)
+{
+    struct dma_sg_descr_s *d;
+    // input padding
+    block_t aad_zeropad    = block_t_convert(SILEX_CRYPTOSOC_GET_GLOBALS()->zeroes, get_aes_pad_len(aad1->len + aad2->len));
+    block_t datain_zeropad = block_t_convert(SILEX_CRYPTOSOC_GET_GLOBALS()->zeroes, get_aes_pad_len(datain->len));
+    block_t tagin_zeropad  = block_t_convert(SILEX_CRYPTOSOC_GET_GLOBALS()->zeroes, get_aes_pad_len(tag_in->len));
+    // output discards
+    block_t aads_discard    = block_t_convert(NULL, aad1->len + aad2->len + aad_zeropad.len);
+    block_t dataout_discard = block_t_convert(NULL, get_aes_pad_len(dataout->len));
+    block_t tagout_discard  = block_t_convert(NULL, get_aes_pad_len(tag_out->len));
+
+    // no input provided, -> empty input = 1 block of zero padding
+    if(!datain->len && !tag_in->len && !aad1->len && !aad2->len)
+    {
+        datain_zeropad.len = SX_ASYNC_AES_BLOCK_SIZE;
+    }
+
+    // fetcher descriptors
+    d = sx_async_desc_in;
+    d = write_desc_blk(d,  config,          DMA_SG_ENGINESELECT_BA411E | DMA_SG_TAG_ISCONFIG | DMA_SG_TAG_SETCFGOFFSET(AES_OFFSET_CFG));
+    realign_desc(d-1);
+    d = write_desc_blk(d,  key,             DMA_SG_ENGINESELECT_BA411E | DMA_SG_TAG_ISCONFIG | DMA_SG_TAG_SETCFGOFFSET(AES_OFFSET_KEY));
+    realign_desc(d-1);
+    d = write_desc_blk(d,  aad1,            DMA_SG_ENGINESELECT_BA411E | DMA_SG_TAG_ISDATA   | DMA_SG_TAG_DATATYPE_AESHEADER);
+    d = write_desc_blk(d,  aad2,            DMA_SG_ENGINESELECT_BA411E | DMA_SG_TAG_ISDATA   | DMA_SG_TAG_DATATYPE_AESHEADER);
+    d = write_desc_blk(d, &aad_zeropad,     DMA_SG_ENGINESELECT_BA411E | DMA_SG_TAG_ISDATA   | DMA_SG_TAG_DATATYPE_AESHEADER | DMA_SG_TAG_SETINVALIDBYTES(aad_zeropad.len));
+    realign_desc(d-1);
+    d = write_desc_blk(d,  datain,          DMA_SG_ENGINESELECT_BA411E | DMA_SG_TAG_ISDATA   | DMA_SG_TAG_DATATYPE_AESPAYLOAD);
+    d = write_desc_blk(d, &datain_zeropad,  DMA_SG_ENGINESELECT_BA411E | DMA_SG_TAG_ISDATA   | DMA_SG_TAG_DATATYPE_AESPAYLOAD | DMA_SG_TAG_SETINVALIDBYTES(datain_zeropad.len));
+    d = write_desc_blk(d,  tag_in,          DMA_SG_ENGINESELECT_BA411E | DMA_SG_TAG_ISDATA   | DMA_SG_TAG_DATATYPE_AESPAYLOAD);
+    d = write_desc_blk(d, &tagin_zeropad,   DMA_SG_ENGINESELECT_BA411E | DMA_SG_TAG_ISDATA   | DMA_SG_TAG_DATATYPE_AESPAYLOAD | DMA_SG_TAG_SETINVALIDBYTES(tagin_zeropad.len));
+    set_last_desc(d-1);
+
+    // pusher descriptors
+    d = sx_async_desc_out;
+    d = write_desc_blk(d, &aads_discard, 0);
+    d = write_desc_blk(d,  dataout, 0);
+    d = write_desc_blk(d, &dataout_discard, 0);
+    d = write_desc_blk(d,  tag_out, 0);
+    d = write_desc_blk(d, &tagout_discard, 0);
+    set_last_desc(d-1);
+}
+
+/* cryptodma_config_sg() and cryptodma_start(), with the SECPROC interrupt unmasked */
+static void sx_async_dma_start(void)
+{
+    WR_REG32(sx_async_regs->fetch_addr, (uint32_t)(uintptr_t)sx_async_desc_in);
+    WR_REG32(sx_async_regs->push_addr,  (uint32_t)(uintptr_t)sx_async_desc_out);
+    WR_REG32(sx_async_regs->config,     DMA_AXI_CONFIGREG_FETCHER_INDIRECT | DMA_AXI_CONFIGREG_PUSHER_INDIRECT);
+
+    CRYPTOLIB_DMA_BARRIER();
+    WR_REG32(sx_async_regs->int_stat_clr, DMA_AXI_INTENSETREG_ALL_EN);
+    WR_REG32(sx_async_regs->int_en,       SX_ASYNC_DMA_INT_EN);
+    sx_async_dma_int_stat = 0;
+    sx_async_dma_busy = true;
+    GP_WB_WRITE_INT_CTRL_MASK_INT_SECPROC_INTERRUPT(1);
+    WR_REG32(sx_async_regs->start,        DMA_AXI_STARTREG_FETCH | DMA_AXI_STARTREG_PUSH);
+}
+
+/* Block the worker task until the DMA is done. Returns the cycles spent blocked. */
+static uint32_t sx_async_dma_wait(sx_async_job_t *job, uint32_t dmaStart, uint32_t *status)
+{
+    TickType_t startTick = xTaskGetTickCount();
+    TickType_t timeout = pdMS_TO_TICKS(SX_ASYNC_DMA_TIMEOUT_MS);
+    TickType_t elapsed;
+    uint32_t waitStart = sx_async_get_time();
+
+    while(sx_async_dma_busy)
+    {
+        elapsed = xTaskGetTickCount() - startTick;
+        if(elapsed >= timeout)
+        {
+            break;
+        }
+        // Stale bits of an earlier timed out job only cause an extra loop
+        (void)xTaskNotifyWait(0, SX_ASYNC_NOTIFY_DMA_DONE, NULL, timeout - elapsed);
+    }
+
+    if(sx_async_dma_busy)
+    {
+        GP_WB_WRITE_INT_CTRL_MASK_INT_SECPROC_INTERRUPT(0);
+        sx_async_dma_busy = false;
+        GP_LOG_SYSTEM_PRINTF("sx_async: DMA timeout", 0);
+        cryptodma_reset();
+        *status = CRYPTOLIB_DMA_ERR;
+        job->engine_cycles = sx_async_get_time() - dmaStart;
+        return sx_async_get_time() - waitStart;
+    }
+
+    job->engine_cycles = sx_async_dma_end - dmaStart;
+
+    // cryptodma_check_status(), but reported to the job instead of a hardfault
+    CRYPTOLIB_DMA_BARRIER();
+    if((sx_async_dma_int_stat & SX_ASYNC_DMA_INT_ERROR) ||
+       (RD_REG32(sx_async_regs->int_stat_raw) & (DMA_AXI_RAWSTATREG_MASK_FETCHER_ERROR | DMA_AXI_RAWSTATREG_MASK_PUSHER_ERROR)) ||
+       (RD_REG32(sx_async_regs->status) & (DMA_AXI_STATUSREG_MASK_FIFOIN_NOT_EMPTY | DMA_AXI_STATUSREG_MASK_FIFOOUT_NDATA)))
+    {
+        cryptodma_reset();
+        *status = CRYPTOLIB_DMA_ERR;
+    }
+    return sx_async_get_time() - waitStart;
+}
+
+/* Returns the cycles the worker task was blocked */
+static uint32_t sx_async_run_dma(sx_async_job_t *job)
+{
+    struct ba413_regs_s info ALIGNED;
+    block_t tag_ref = sx_getNULL_blk();
+    uint32_t status = CRYPTOLIB_SUCCESS;
+    uint32_t blocked;
+    uint32_t dmaStart;
+
+    if(job->op == SX_ASYNC_OP_AES)
+    {
+        block_t header = sx_getNULL_blk();
+        block_t tag_in = sx_getNULL_blk();
+        block_t tag_out = sx_getNULL_blk();
+        block_t config_blk = block_t_convert(&sx_async_config, sizeof(sx_async_config));
+
+        status = sw_aes_setmode(job->params.aes.fct, job->params.aes.dir, CTX_WHOLE, job->params.aes.key, &sx_async_config);
+        if((status == CRYPTOLIB_SUCCESS) && (job->params.aes.fct == CCM))
+        {
+            header = block_t_convert(sx_async_ccm_header, sizeof(sx_async_ccm_header));
+            status = generate_ccm_header(job->params.aes.nonce, job->params.aes.aad.len, job->params.aes.data_in.len,
+                                         job->params.aes.tag.len, &header);
+            if(job->params.aes.tag.len)
+            {
+                if(job->params.aes.dir == ENC)
+                {
+                    tag_out = job->params.aes.tag;
+                }
+                else
+                {
+                    // the engine returns zeroes for a valid tag
+                    tag_in = job->params.aes.tag;
+                    tag_out = block_t_convert(sx_async_tag_generated, job->params.aes.tag.len);
+                    tag_ref = block_t_convert(SILEX_CRYPTOSOC_GET_GLOBALS()->zeroes, job->params.aes.tag.len);
+                }
+            }
+        }
+        if(status != CRYPTOLIB_SUCCESS)
+        {
+            job->status = status;
+            return 0;
+        }
+        if(job->params.aes.data_out.flags & DMA_AXI_DESCR_CONST_ADDR)
+        {
+            job->params.aes.data_out.len = roundup_32(job->params.aes.data_out.len);
+        }
+        if(tag_out.flags & DMA_AXI_DESCR_CONST_ADDR)
+        {
+            tag_out.len = roundup_32(tag_out.len);
+        }
+        sx_async_build_aes(&config_blk, &job->params.aes.key, &job->params.aes.data_in, &job->params.aes.data_out,
+                           &header, &job->params.aes.aad, &tag_in, &tag_out);
+    }
+    else
+    {
+        sx_async_build_hash(job, &info);
+    }
+
+    sx_enable_clock();
+    dmaStart = sx_async_get_time();
+    sx_async_dma_start();
+    blocked = sx_async_dma_wait(job, dmaStart, &status);
+    sx_disable_clock();
+
+    if((status == CRYPTOLIB_SUCCESS) && tag_ref.len)
+    {
+        if(memcmp_time_cst(sx_async_tag_generated, tag_ref.addr, tag_ref.len))
+        {
+            status = CRYPTOLIB_INVALID_SIGN_ERR;
+        }
+    }
+    job->status = status;
+    return blocked;
+}
+
+static sx_async_job_t *sx_async_pop(void)
+{
+    sx_async_job_t *job;
+
+    HAL_DISABLE_GLOBAL_INT();
+    job = sx_async_head;
+    if(job != NULL)
+    {
+        sx_async_head = job->next;
+        if(sx_async_head == NULL)
+        {
+            sx_async_tail = NULL;
+        }
+    }
+    HAL_ENABLE_GLOBAL_INT();
+    return job;
+}
+
+static void sx_async_main(void *pvParameters)
+{
+    sx_async_job_t *job;
+    uint32_t start;
+    uint32_t blocked;
+
+    NOT_USED(pvParameters);
+
+    for(;;)
+    {
+        job = sx_async_pop();
+        if(job == NULL)
+        {
+            // A job queued after the pop leaves the bit set, so the wait returns immediately
+            (void)xTaskNotifyWait(0, SX_ASYNC_NOTIFY_JOB, NULL, portMAX_DELAY);
+            continue;
+        }
+
+        start = sx_async_get_time();
+        job->engine_cycles = 0;
+        if(job->op == SX_ASYNC_OP_PK)
+        {
+            job->status = job->params.pk.fct(job->params.pk.arg);
+            blocked = 0;
+        }
+        else
+        {
+            blocked = sx_async_run_dma(job);
+        }
+        job->cpu_cycles = (sx_async_get_time() - start) - blocked;
+
+        if(job->done != NULL)
+        {
+            job->done(job, job->status);
+        }
+    }
+}
+
+/*****************************************************************************
+ *                    Interrupt Handler
+ *****************************************************************************/
+
+void secproc_handler_impl(void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    uint32_t intStat;
+
+    GP_WB_WRITE_INT_CTRL_MASK_INT_SECPROC_INTERRUPT(0);
+    intStat = RD_REG32(sx_async_regs->int_stat);
+    WR_REG32(sx_async_regs->int_stat_clr, DMA_AXI_INTENSETREG_ALL_EN);
+    if(sx_async_dma_busy)
+    {
+        // A bus error stops the DMA as well: the worker completes the job with CRYPTOLIB_DMA_ERR
+        sx_async_dma_int_stat = intStat;
+        sx_async_dma_end = sx_async_get_time();
+        sx_async_dma_busy = false;
+        xTaskNotifyFromISR(sx_async_task, SX_ASYNC_NOTIFY_DMA_DONE, eSetBits, &xHigherPriorityTaskWoken);
+    }
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/*****************************************************************************
+ *                    Public Function Definitions
+ *****************************************************************************/
+
+void sx_async_init(void)
+{
+    INIT_CYCLE_COUNT();
+    RESUME_CYCLE_COUNT();
+
+    sx_async_head = NULL;
+    sx_async_tail = NULL;
+    sx_async_dma_busy = false;
+
+#if configSUPPORT_STATIC_ALLOCATION
+    sx_async_task = xTaskCreateStatic(sx_async_main, SX_ASYNC_TASK_NAME, SX_ASYNC_TASK_STACK_SIZE, NULL,
+                                      SX_ASYNC_TASK_PRIORITY, sx_async_TaskStack, &sx_async_TaskInfo);
+#else
+    (void)xTaskCreate(sx_async_main, SX_ASYNC_TASK_NAME, SX_ASYNC_TASK_STACK_SIZE, NULL, SX_ASYNC_TASK_PRIORITY,
+                      &sx_async_task);
+#endif //configSUPPORT_STATIC_ALLOCATION
+    GP_ASSERT_SYSTEM(sx_async_task != NULL);
+
+    // The DMA interrupt is routed to SECPROC, which stays masked while no job runs
+    GP_WB_WRITE_INT_CTRL_MASK_SECPROC_CRYPTO_MASTER_INTERRUPT(1);
+    GP_WB_WRITE_INT_CTRL_MASK_INT_SECPROC_INTERRUPT(0);
+    NVIC_EnableIRQ(SECPROC_IRQn);
+}
+
+uint32_t sx_async_submit(sx_async_job_t *job)
+{
+    uint32_t status;
+
+    GP_ASSERT_DEV_EXT(job != NULL);
+    GP_ASSERT_DEV_EXT(sx_async_task != NULL);
+
+    status = sx_async_validate(job);
+    if(status != CRYPTOLIB_SUCCESS)
+    {
+        return status;
+    }
+
+    job->status = CRYPTOLIB_SUCCESS;
+    job->cpu_cycles = 0;
+    job->engine_cycles = 0;
+    job->next = NULL;
+
+    HAL_DISABLE_GLOBAL_INT();
+    if(sx_async_tail != NULL)
+    {
+        sx_async_tail->next = job;
+    }
+    else
+    {
+        sx_async_head = job;
+    }
+    sx_async_tail = job;
+    HAL_ENABLE_GLOBAL_INT();
+
+    (void)xTaskNotify(sx_async_task, SX_ASYNC_NOTIFY_JOB, eSetBits);
+    return CRYPTOLIB_SUCCESS;
+}
+
+void sx_async_job_hash(sx_async_job_t *job, sx_hash_fct_t fct, block_t data, block_t digest,
+                       sx_async_done_t done, void *user)
+{
+    MEMSET(job, 0, sizeof(sx_async_job_t));
+    job->op = SX_ASYNC_OP_HASH;
+    job->params.hash.fct = fct;
+    job->params.hash.data = data;
+    job->params.hash.out = digest;
+    job->done = done;
+    job->user = user;
+}
+
+void sx_async_job_hash_update(sx_async_job_t *job, sx_hash_fct_t fct, block_t state, block_t data,
+                              sx_async_done_t done, void *user)
+{
+    MEMSET(job, 0, sizeof(sx_async_job_t));
+    job->op = SX_ASYNC_OP_HASH_UPDATE;
+    job->params.hash.fct = fct;
+    job->params.hash.data = data;
+    job->params.hash.out = state;
+    job->done = done;
+    job->user = user;
+}
+
+void sx_async_job_aes_ecb(sx_async_job_t *job, sx_aes_mode_t dir, block_t key, block_t data_in, block_t data_out,
+                          sx_async_done_t done, void *user)
+{
+    MEMSET(job, 0, sizeof(sx_async_job_t));
+    job->op = SX_ASYNC_OP_AES;
+    job->params.aes.fct = ECB;
+    job->params.aes.dir = dir;
+    job->params.aes.key = key;
+    job->params.aes.data_in = data_in;
+    job->params.aes.data_out = data_out;
+    job->params.aes.aad = sx_getNULL_blk();
+    job->params.aes.tag = sx_getNULL_blk();
+    job->params.aes.nonce = sx_getNULL_blk();
+    job->done = done;
+    job->user = user;
+}
+
+void sx_async_job_aes_ccm(sx_async_job_t *job, sx_aes_mode_t dir, block_t key, block_t nonce, block_t aad,
+                          block_t data_in, block_t data_out, block_t tag, sx_async_done_t done, void *user)
+{
+    MEMSET(job, 0, sizeof(sx_async_job_t));
+    job->op = SX_ASYNC_OP_AES;
+    job->params.aes.fct = CCM;
+    job->params.aes.dir = dir;
+    job->params.aes.key = key;
+    job->params.aes.data_in = data_in;
+    job->params.aes.data_out = data_out;
+    job->params.aes.aad = aad;
+    job->params.aes.tag = tag;
+    job->params.aes.nonce = nonce;
+    job->done = done;
+    job->user = user;
+}
+
+void sx_async_job_pk(sx_async_job_t *job, sx_async_pk_fct_t fct, void *arg, sx_async_done_t done, void *user)
+{
+    MEMSET(job, 0, sizeof(sx_async_job_t));
+    job->op = SX_ASYNC_OP_PK;
+    job->params.pk.fct = fct;
+    job->params.pk.arg = arg;
+    job->done = done;
+    job->user = user;
+}
+
+#if defined(GP_SILEXCRYPTOSOC_DIVERSITY_ASYNC_BENCHMARK)
+/*****************************************************************************
+ *                    Benchmark
+ *****************************************************************************/
+
+static uint8_t sx_async_bench_in[SX_ASYNC_BENCH_HASH_SIZE] ALIGNED;
+static uint8_t sx_async_bench_out[SX_ASYNC_BENCH_HASH_SIZE] ALIGNED;
+static uint8_t sx_async_bench_tag[16] ALIGNED;
+static const uint8_t sx_async_bench_key[16] ALIGNED = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+};
+static const uint8_t sx_async_bench_nonce[13] = {
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c
+};
+
+static void sx_async_bench_done(sx_async_job_t *job, uint32_t status)
+{
+    NOT_USED(status);
+    (void)xTaskNotify((TaskHandle_t)job->user, SX_ASYNC_NOTIFY_BENCH_DONE, eSetBits);
+}
+
+/* Synchronous run of the operation a job describes, through the ROM API */
+static uint32_t sx_async_bench_sync(sx_async_job_t *job)
+{
+    uint32_t status;
+
+    sx_enable_clock();
+    if(job->op == SX_ASYNC_OP_HASH)
+    {
+        status = sx_hash_blk(job->params.hash.fct, job->params.hash.data, job->params.hash.out);
+    }
+    else
+    {
+        status = sx_aes_blk(job->params.aes.fct, job->params.aes.dir, CTX_WHOLE, job->params.aes.key, sx_getNULL_blk(),
+                            sx_getNULL_blk(), job->params.aes.data_in, job->params.aes.data_out, job->params.aes.aad,
+                            job->params.aes.tag, sx_getNULL_blk(), job->params.aes.nonce);
+    }
+    sx_disable_clock();
+    return status;
+}
+
+static void sx_async_bench_run(uint8_t id, sx_async_job_t *job)
+{
+    uint32_t syncCycles = 0;
+    uint32_t asyncCycles = 0;
+    uint32_t engineCycles = 0;
+    uint32_t start;
+    uint32_t status = CRYPTOLIB_SUCCESS;
+    UIntLoop i;
+
+    for(i = 0; i < SX_ASYNC_BENCH_ITERATIONS; i++)
+    {
+        start = sx_async_get_time();
+        status |= sx_async_bench_sync(job);
+        syncCycles += sx_async_get_time() - start;
+    }
+
+    for(i = 0; i < SX_ASYNC_BENCH_ITERATIONS; i++)
+    {
+        start = sx_async_get_time();
+        status |= sx_async_submit(job);
+        asyncCycles += sx_async_get_time() - start;
+        (void)xTaskNotifyWait(0, SX_ASYNC_NOTIFY_BENCH_DONE, NULL, portMAX_DELAY);
+        status |= job->status;
+        asyncCycles += job->cpu_cycles;
+        engineCycles += job->engine_cycles;
+    }
+
+    GP_LOG_SYSTEM_PRINTF("bench %u: cpu sync %lu async %lu engine %lu cycles/op st:%lx", 0, (uint16_t)id,
+                         (unsigned long)(syncCycles / SX_ASYNC_BENCH_ITERATIONS),
+                         (unsigned long)(asyncCycles / SX_ASYNC_BENCH_ITERATIONS),
+                         (unsigned long)(engineCycles / SX_ASYNC_BENCH_ITERATIONS), (unsigned long)status);
+}
+
+void sx_async_benchmark(void)
+{
+    sx_async_job_t job;
+    void *self = xTaskGetCurrentTaskHandle();
+    block_t key = block_t_convert(sx_async_bench_key, sizeof(sx_async_bench_key));
+    block_t aesIn = block_t_convert(sx_async_bench_in, SX_ASYNC_BENCH_AES_SIZE);
+    block_t aesOut = block_t_convert(sx_async_bench_out, SX_ASYNC_BENCH_AES_SIZE);
+    UIntLoop i;
+
+    GP_ASSERT_DEV_EXT(self != sx_async_task);
+
+    for(i = 0; i < sizeof(sx_async_bench_in); i++)
+    {
+        sx_async_bench_in[i] = (uint8_t)i;
+    }
+
+    sx_async_job_hash(&job, e_SHA256, block_t_convert(sx_async_bench_in, SX_ASYNC_BENCH_HASH_SIZE),
+                      block_t_convert(sx_async_bench_out, 32), sx_async_bench_done, self);
+    sx_async_bench_run(SX_ASYNC_BENCH_SHA256_1K, &job);
+
+    sx_async_job_aes_ecb(&job, ENC, key, aesIn, aesOut, sx_async_bench_done, self);
+    sx_async_bench_run(SX_ASYNC_BENCH_AES_ECB_256, &job);
+
+    sx_async_job_aes_ccm(&job, ENC, key, block_t_convert(sx_async_bench_nonce, sizeof(sx_async_bench_nonce)),
+                         block_t_convert(sx_async_bench_in, 16), aesIn, aesOut,
+                         block_t_convert(sx_async_bench_tag, sizeof(sx_async_bench_tag)), sx_async_bench_done, self);
+    sx_async_bench_run(SX_ASYNC_BENCH_AES_CCM_256, &job);
+}
+#endif //GP_SILEXCRYPTOSOC_DIVERSITY_ASYNC_BENCHMARK
+
+#endif //GP_SILEXCRYPTOSOC_DIVERSITY_ASYNC
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2026, Qorvo Inc
+ *
+ * This software is owned by Qorvo Inc
+ * and protected under applicable copyright laws.
+ * It is delivered under the terms of the license
+ * and is intended and supplied for use solely and
+ * exclusively with products manufactured by
+ * Qorvo Inc.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED IN AN "AS IS"
+ * CONDITION. NO WARRANTIES, WHETHER EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING, BUT NOT
+ * LIMITED TO, IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ * QORVO INC. SHALL NOT, IN ANY
+ * CIRCUMSTANCES, BE LIABLE FOR SPECIAL,
+ * INCIDENTAL OR CONSEQUENTIAL DAMAGES,
+ * FOR ANY REASON WHATSOEVER.
+ *
+ * $Header$
+ * $Change$
+ * $DateTime$
+ *
+ */
+/**
+ * @file
+ * @brief Asynchronous crypto job queue (GP_SILEXCRYPTOSOC_DIVERSITY_ASYNC)
+ *
+ * Jobs are queued to a crypto worker task and completed through a callback.
+ * - Hash and AES (ECB, CCM) jobs are started on the cryptomaster DMA and completed from the SECPROC interrupt.
+ *   The worker task is blocked while the engine runs.
+ * - Public key jobs run a caller supplied function (e.g. sx_ecdsa_generate_signature()) in the worker task. The ROM
+ *   polls the PK engine, so these keep the CPU busy, but only at the priority of the worker task.
+ *
+ * Jobs are owned by the caller and must stay valid, together with all buffers they refer to, until the callback.
+ * Callbacks run in the worker task and should only hand over the result (e.g. notify a task or schedule an event).
+ */
+
+#ifndef SX_ASYNC_H
+#define SX_ASYNC_H
+
+#include <stdint.h>
+#include "cryptolib_types.h"
+#include "sx_hash.h"
+#include "sx_aes.h"
+
+/** @brief Priority of the crypto worker task. Below the stack tasks, so radio and scheduler work preempt PK jobs. */
+#ifndef SX_ASYNC_TASK_PRIORITY
+#define SX_ASYNC_TASK_PRIORITY      (1)
+#endif //SX_ASYNC_TASK_PRIORITY
+
+/** @brief Stack size of the crypto worker task, in words. PK functions of the ROM need about 1kB. */
+#ifndef SX_ASYNC_TASK_STACK_SIZE
+#define SX_ASYNC_TASK_STACK_SIZE    ((2 * 1024) / 4)
+#endif //SX_ASYNC_TASK_STACK_SIZE
+
+/** @brief Maximum time a DMA job may take before the engine is reset */
+#ifndef SX_ASYNC_DMA_TIMEOUT_MS
+#define SX_ASYNC_DMA_TIMEOUT_MS     (100)
+#endif //SX_ASYNC_DMA_TIMEOUT_MS
+
+/** @brief Type of a job */
+typedef enum sx_async_op_e
+{
+   SX_ASYNC_OP_HASH        = 1,  /**< Full hash of a message */
+   SX_ASYNC_OP_HASH_UPDATE = 2,  /**< Hash of complete blocks, starting from and updating a state */
+   SX_ASYNC_OP_AES         = 3,  /**< AES ECB or CCM on a whole message */
+   SX_ASYNC_OP_PK          = 4   /**< Public key operation, run by the worker task */
+} sx_async_op_t;
+
+typedef struct sx_async_job_s sx_async_job_t;
+
+/** @brief Completion callback, called from the worker task. @p status is a CRYPTOLIB_* code. */
+typedef void (*sx_async_done_t)(sx_async_job_t *job, uint32_t status);
+
+/** @brief Public key job function. Brackets its engine accesses with sx_enable_clock()/sx_disable_clock(). */
+typedef uint32_t (*sx_async_pk_fct_t)(void *arg);
+
+/** @brief A crypto job. Fill it with one of the sx_async_job_* functions. */
+struct sx_async_job_s
+{
+   sx_async_op_t op;
+   union {
+      struct {
+         sx_hash_fct_t fct;
+         block_t data;
+         block_t out;            /**< digest, or the state for ::SX_ASYNC_OP_HASH_UPDATE */
+      } hash;
+      struct {
+         sx_aes_fct_t fct;
+         sx_aes_mode_t dir;
+         block_t key;
+         block_t data_in;
+         block_t data_out;
+         block_t aad;
+         block_t tag;
+         block_t nonce;
+      } aes;
+      struct {
+         sx_async_pk_fct_t fct;
+         void *arg;
+      } pk;
+   } params;
+   sx_async_done_t done;
+   void *user;                   /**< free for the caller */
+   uint32_t status;
+   uint32_t cpu_cycles;          /**< CPU cycles the worker task spent on the job (0 without the DWT cycle counter) */
+   uint32_t engine_cycles;       /**< cycles from engine start to completion */
+   struct sx_async_job_s *next;  /**< private */
+};
+
+/**
+ * @brief Create the worker task and enable the SECPROC interrupt.
+ * Called once, after silexCryptoSoc_Init().
+ */
+void sx_async_init(void);
+
+/**
+ * @brief Queue a job. Must be called from a task.
+ * @param job filled job
+ * @return ::CRYPTOLIB_SUCCESS, or ::CRYPTOLIB_INVALID_PARAM if the job parameters are not valid (the callback is not called)
+ */
+uint32_t sx_async_submit(sx_async_job_t *job);
+
+/** @brief Fill a ::SX_ASYNC_OP_HASH job */
+void sx_async_job_hash(sx_async_job_t *job, sx_hash_fct_t fct, block_t data, block_t digest,
+                       sx_async_done_t done, void *user);
+
+/** @brief Fill a ::SX_ASYNC_OP_HASH_UPDATE job. @p data is a multiple of the block size. */
+void sx_async_job_hash_update(sx_async_job_t *job, sx_hash_fct_t fct, block_t state, block_t data,
+                              sx_async_done_t done, void *user);
+
+/** @brief Fill an AES ECB job. @p data_in is a non-zero multiple of 16 bytes. */
+void sx_async_job_aes_ecb(sx_async_job_t *job, sx_aes_mode_t dir, block_t key, block_t data_in, block_t data_out,
+                          sx_async_done_t done, void *user);
+
+/**
+ * @brief Fill an AES CCM job
+ * @param tag written for ::ENC, verified for ::DEC (status ::CRYPTOLIB_INVALID_SIGN_ERR on mismatch)
+ */
+void sx_async_job_aes_ccm(sx_async_job_t *job, sx_aes_mode_t dir, block_t key, block_t nonce, block_t aad,
+                          block_t data_in, block_t data_out, block_t tag, sx_async_done_t done, void *user);
+
+/** @brief Fill a ::SX_ASYNC_OP_PK job */
+void sx_async_job_pk(sx_async_job_t *job, sx_async_pk_fct_t fct, void *arg, sx_async_done_t done, void *user);
+
+#if defined(GP_SILEXCRYPTOSOC_DIVERSITY_ASYNC_BENCHMARK)
+/**
+ * @brief Log the CPU cycles per operation of the synchronous API and of the job queue.
+ * Runs SHA-256 1k (bench 0), AES-ECB 256 (bench 1) and AES-CCM 256 (bench 2);
+ * must be called from a task other than the worker task.
+ */
+void sx_async_benchmark(void);
+#endif //GP_SILEXCRYPTOSOC_DIVERSITY_ASYNC_BENCHMARK
+
+#endif //SX_ASYNC_H
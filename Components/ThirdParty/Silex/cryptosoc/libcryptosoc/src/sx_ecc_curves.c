@@ -364,7 +364,7 @@ static const sx_ecc_curve_t sx_ecc_curve_curve448 = {
 
 
 /* These symbols should not be compiled when this file in compiled in flash AGAINST a ROM lib */
-#if defined(GP_DIVERSITY_ROM_CODE) || defined(GP_DIVERSITY_KEEP_NRT_IN_FLASH)
+#if defined(GP_DIVERSITY_ROM_CODE) || defined(GP_DIVERSITY_KEEP_NRT_IN_FLASH) || defined(GP_SILEXCRYPTOSOC_DIVERSITY_HOST_SIM)
 
 uint32_t sx_ecc_curve_bitsize(const sx_ecc_curve_t *curve)
 {
@@ -1,7 +1,25 @@
 #ifndef SX_GENERIC_H
 #define SX_GENERIC_H
 
+#include <stdint.h>
+
+/** @brief Counters of crypto accelerator sessions, see sx_clock_get_stats() */
+typedef struct sx_clock_stats_s {
+   uint32_t sessions;   /**< outermost sx_enable_clock() calls, each one clocks the engine and takes the usage lock */
+   uint32_t nested;     /**< sx_enable_clock() calls that joined the running session of the same task */
+} sx_clock_stats_t;
+
+/**
+ * @brief Clock the crypto accelerator and take it for the calling task.
+ * Calls nest: a task that already runs a session only increments its depth, so a burst of operations
+ * can be bracketed once and keeps the engine clocked between them. Interrupts never join a task session.
+ */
 void sx_enable_clock(void);
+
+/** @brief End a sx_enable_clock() call. The engine is released when the outermost call ends. */
 void sx_disable_clock(void);
 
+/** @brief Get a copy of the session counters. */
+void sx_clock_get_stats(sx_clock_stats_t *stats);
+
 #endif // SX_GENERIC_H
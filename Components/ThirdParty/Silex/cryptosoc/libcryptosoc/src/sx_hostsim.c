@@ -0,0 +1,1719 @@
+/*
+ * Copyright (c) 2026, Qorvo Inc
+ *
+ * This software is owned by Qorvo Inc
+ * and protected under applicable copyright laws.
+ * It is delivered under the terms of the license
+ * and is intended and supplied for use solely and
+ * exclusively with products manufactured by
+ * Qorvo Inc.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED IN AN "AS IS"
+ * CONDITION. NO WARRANTIES, WHETHER EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING, BUT NOT
+ * LIMITED TO, IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ * QORVO INC. SHALL NOT, IN ANY
+ * CIRCUMSTANCES, BE LIABLE FOR SPECIAL,
+ * INCIDENTAL OR CONSEQUENTIAL DAMAGES,
+ * FOR ANY REASON WHATSOEVER.
+ *
+ * $Header$
+ * $Change$
+ * $DateTime$
+ *
+ */
+/**
+ * @file
+ * @brief Host model of the cryptosoc engines, see sx_hostsim.h
+ *
+ * The engines run synchronously from the register write that starts them. A scatter-gather run gathers the fetch
+ * descriptors per data type (the valid bytes only), runs the engine on the complete input and scatters the output
+ * over the push descriptors. This is not cycle accurate: the counters give the descriptor and transfer overhead of
+ * the driver, the host time of the driver is the total time minus sx_hostsim_stats_t::engine_ns.
+ */
+
+/*****************************************************************************
+ *                    Includes Definitions
+ *****************************************************************************/
+
+#include "cryptolib_internal.h"
+#include "cryptolib_def.h"
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+#include "cryptodma.h"
+#include "sxregs.h"
+#include "ba411e_config.h"
+#include "ba413_config.h"
+#include "ba414e_config.h"
+
+#include "hal.h"
+#include "gpHal.h"
+
+#if defined(GP_SILEXCRYPTOSOC_DIVERSITY_HOST_SIM)
+
+#if !defined(HAL_DIVERSITY_MM_SIM)
+#error "GP_SILEXCRYPTOSOC_DIVERSITY_HOST_SIM needs the simulated register space (HAL_DIVERSITY_MM_SIM)"
+#endif //HAL_DIVERSITY_MM_SIM
+
+#include "sx_hostsim.h"
+#include <stdlib.h>
+#include <time.h>
+
+/*****************************************************************************
+ *                    Macro Definitions
+ *****************************************************************************/
+
+/* Descriptors walked per run before the chain is considered broken */
+#define SX_HOSTSIM_MAX_DESCRIPTORS      64
+
+/* Length field of a descriptor: DMA_AXI_DESCR_MASK_LENGTH also covers the CONST_ADDR and REALIGN flags */
+#define SX_HOSTSIM_DESCR_LENGTH(l)      ((l) & 0x0FFFFFFF)
+
+/* Size of the configuration space of the BA411 and BA413 */
+#define SX_HOSTSIM_CFG_SIZE             128
+
+/* Data types of a data descriptor: DMA_SG_TAG_DATATYPE_* */
+#define SX_HOSTSIM_DATATYPES            4
+#define SX_HOSTSIM_TAG_ENGINE(tag)      ((tag) & 0xF)
+#define SX_HOSTSIM_TAG_DATATYPE(tag)    (((tag) >> 6) & 0x3)
+#define SX_HOSTSIM_TAG_CFGOFFSET(tag)   (((tag) >> 8) & 0xFF)
+#define SX_HOSTSIM_TAG_INVALID(tag)     (((tag) >> 8) & 0x1F)
+
+#define SX_HOSTSIM_AES_BLOCK_SIZE       16
+#define SX_HOSTSIM_AES_MAX_ROUNDKEYS    (16 * 15)
+
+#define SX_HOSTSIM_SHA_BLOCK_SIZE       64
+#define SX_HOSTSIM_SHA_STATE_SIZE       32
+#define SX_HOSTSIM_SHA224_DIGEST_SIZE   28
+
+/* BA414 operand size up to P-521, in words */
+#define SX_HOSTSIM_PK_MAX_WORDS         17
+#define SX_HOSTSIM_PK_SLOT_SIZE         512
+
+/*****************************************************************************
+ *                    Type Definitions
+ *****************************************************************************/
+
+/* Growable byte buffer for the engine input and output */
+typedef struct {
+    uint8_t *data;
+    uint32_t len;
+    uint32_t size;
+} sx_hostsim_buf_t;
+
+/* Prime field for Montgomery arithmetic */
+typedef struct {
+    uint32_t m[SX_HOSTSIM_PK_MAX_WORDS];
+    uint32_t rr[SX_HOSTSIM_PK_MAX_WORDS];     /* R^2 mod m */
+    uint32_t one[SX_HOSTSIM_PK_MAX_WORDS];    /* R mod m, 1 in the Montgomery domain */
+    uint32_t minv;                            /* -m^-1 mod 2^32 */
+    uint32_t n;                               /* words */
+} sx_hostsim_field_t;
+
+/* Curve point in Jacobian coordinates, Montgomery domain. Z = 0 is the point at infinity. */
+typedef struct {
+    uint32_t x[SX_HOSTSIM_PK_MAX_WORDS];
+    uint32_t y[SX_HOSTSIM_PK_MAX_WORDS];
+    uint32_t z[SX_HOSTSIM_PK_MAX_WORDS];
+} sx_hostsim_point_t;
+
+/* Prime field curve y^2 = x^3 + ax + b */
+typedef struct {
+    sx_hostsim_field_t p;
+    sx_hostsim_field_t order;
+    uint32_t a[SX_HOSTSIM_PK_MAX_WORDS];      /* Montgomery domain */
+    uint32_t b[SX_HOSTSIM_PK_MAX_WORDS];      /* Montgomery domain */
+} sx_hostsim_curve_t;
+
+/* Operand layout of the running BA414 operation */
+typedef struct {
+    uint32_t size;                            /* bytes */
+    uint32_t n;                               /* words */
+    bool swap;
+} sx_hostsim_pk_op_t;
+
+/*****************************************************************************
+ *                    Static Data Definitions
+ *****************************************************************************/
+
+volatile uint32_t sx_hostsim_cryptomaster_regs[SX_HOSTSIM_CRYPTOMASTER_REGS_WORDS];
+volatile uint32_t sx_hostsim_ba414e_regs[SX_HOSTSIM_BA414E_REGS_WORDS];
+volatile uint32_t sx_hostsim_ba431_regs[SX_HOSTSIM_BA431_REGS_WORDS];
+volatile uint32_t sx_hostsim_ba431_fifo[1];
+uint8_t sx_hostsim_ba414e_cryptoram[SX_HOSTSIM_BA414E_CRYPTORAM_SIZE] ALIGNED;
+uint32_t sx_hostsim_ba414e_ucode[SX_HOSTSIM_BA414E_UCODE_WORDS];
+
+static dma_sg_regs32_t * const sx_hostsim_dma = (dma_sg_regs32_t *) ADDR_CRYPTOMASTER_REGS;
+static BA414ERegs_t * const sx_hostsim_pk = (BA414ERegs_t *) ADDR_BA414E_REGS;
+
+static sx_hostsim_stats_t sx_hostsim_stats;
+
+/* Engine input per data type and engine output of the running DMA run */
+static uint8_t sx_hostsim_cfg[SX_HOSTSIM_CFG_SIZE];
+static sx_hostsim_buf_t sx_hostsim_in[SX_HOSTSIM_DATATYPES];
+static sx_hostsim_buf_t sx_hostsim_out;
+
+static uint8_t sx_hostsim_sbox[256];
+static uint8_t sx_hostsim_inv_sbox[256];
+
+static const uint32_t sx_hostsim_sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+static const uint32_t sx_hostsim_sha224_iv[8] = {
+    0xc1059ed8, 0x367cd507, 0x3070dd17, 0xf70e5939, 0xffc00b31, 0x68581511, 0x64f98fa7, 0xbefa4fa4,
+};
+
+static const uint32_t sx_hostsim_sha256_iv[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+};
+
+/*****************************************************************************
+ *                    Static Function Definitions
+ *****************************************************************************/
+
+static uint64_t sx_hostsim_get_time_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+static bool sx_hostsim_clocked(void)
+{
+    return GP_WB_READ_SEC_PROC_CTRL_SEC_PROC_ENABLE() != 0;
+}
+
+static bool sx_hostsim_buf_append(sx_hostsim_buf_t *buf, uint32_t len)
+{
+    if(buf->len + len > buf->size)
+    {
+        uint32_t size = (buf->len + len + 255) & ~255UL;
+        uint8_t *data = realloc(buf->data, size);
+        if(data == NULL)
+        {
+            return false;
+        }
+        buf->data = data;
+        buf->size = size;
+    }
+    buf->len += len;
+    return true;
+}
+
+/* Copy @p len bytes, a constant address is a 32-bit FIFO */
+static void sx_hostsim_copy(uint8_t *dst, bool dst_const, const uint8_t *src, bool src_const, uint32_t len)
+{
+    uint32_t i;
+
+    if(!dst_const && !src_const)
+    {
+        memcpy(dst, src, len);
+        return;
+    }
+    for(i = 0; i < len; i++)
+    {
+        dst[dst_const ? (i & 3) : i] = src[src_const ? (i & 3) : i];
+    }
+}
+
+/* The cryptomaster is a 32-bit master, see sx_hostsim.h */
+static bool sx_hostsim_addr_valid(const volatile void *addr)
+{
+    return (uintptr_t)addr <= UINT32_MAX;
+}
+
+/*****************************************************************************
+ *                    BA411 - AES
+ *****************************************************************************/
+
+static uint8_t sx_hostsim_xtime(uint8_t x)
+{
+    return (uint8_t)((x << 1) ^ ((x & 0x80) ? 0x1B : 0x00));
+}
+
+static uint8_t sx_hostsim_gmul(uint8_t a, uint8_t b)
+{
+    uint8_t r = 0;
+    while(b)
+    {
+        if(b & 1)
+        {
+            r ^= a;
+        }
+        a = sx_hostsim_xtime(a);
+        b >>= 1;
+    }
+    return r;
+}
+
+static uint8_t sx_hostsim_rotl8(uint8_t x, uint8_t shift)
+{
+    return (uint8_t)((x << shift) | (x >> (8 - shift)));
+}
+
+static void sx_hostsim_aes_init_tables(void)
+{
+    uint8_t p = 1;
+    uint8_t q = 1;
+
+    // p runs over the multiplicative group with generator 3, q over the inverses
+    do
+    {
+        p = p ^ sx_hostsim_xtime(p);
+        q ^= q << 1;
+        q ^= q << 2;
+        q ^= q << 4;
+        if(q & 0x80)
+        {
+            q ^= 0x09;
+        }
+        sx_hostsim_sbox[p] = q ^ sx_hostsim_rotl8(q, 1) ^ sx_hostsim_rotl8(q, 2) ^ sx_hostsim_rotl8(q, 3) ^
+                             sx_hostsim_rotl8(q, 4) ^ 0x63;
+    } while(p != 1);
+    sx_hostsim_sbox[0] = 0x63;
+
+    for(p = 0; ; p++)
+    {
+        sx_hostsim_inv_sbox[sx_hostsim_sbox[p]] = p;
+        if(p == 0xFF)
+        {
+            break;
+        }
+    }
+}
+
+/* Key expansion, returns the number of rounds */
+static uint32_t sx_hostsim_aes_expand_key(uint8_t *rk, const uint8_t *key, uint32_t key_len)
+{
+    uint32_t nk = key_len / 4;
+    uint32_t nr = nk + 6;
+    uint8_t rcon = 1;
+    uint32_t i, j;
+
+    memcpy(rk, key, key_len);
+    for(i = nk; i < 4 * (nr + 1); i++)
+    {
+        uint8_t t[4];
+        memcpy(t, &rk[4 * (i - 1)], 4);
+        if((i % nk) == 0)
+        {
+            uint8_t t0 = t[0];
+            t[0] = sx_hostsim_sbox[t[1]] ^ rcon;
+            t[1] = sx_hostsim_sbox[t[2]];
+            t[2] = sx_hostsim_sbox[t[3]];
+            t[3] = sx_hostsim_sbox[t0];
+            rcon = sx_hostsim_xtime(rcon);
+        }
+        else if((nk > 6) && ((i % nk) == 4))
+        {
+            for(j = 0; j < 4; j++)
+            {
+                t[j] = sx_hostsim_sbox[t[j]];
+            }
+        }
+        for(j = 0; j < 4; j++)
+        {
+            rk[4 * i + j] = rk[4 * (i - nk) + j] ^ t[j];
+        }
+    }
+    return nr;
+}
+
+static void sx_hostsim_aes_add_round_key(uint8_t *s, const uint8_t *rk)
+{
+    uint32_t i;
+    for(i = 0; i < SX_HOSTSIM_AES_BLOCK_SIZE; i++)
+    {
+        s[i] ^= rk[i];
+    }
+}
+
+static void sx_hostsim_aes_encrypt(const uint8_t *rk, uint32_t nr, uint8_t *block)
+{
+    uint8_t t[SX_HOSTSIM_AES_BLOCK_SIZE];
+    uint32_t round, c, r;
+
+    sx_hostsim_aes_add_round_key(block, rk);
+    for(round = 1; round <= nr; round++)
+    {
+        // SubBytes and ShiftRows, the state is column major
+        for(c = 0; c < 4; c++)
+        {
+            for(r = 0; r < 4; r++)
+            {
+                t[4 * c + r] = sx_hostsim_sbox[block[4 * ((c + r) & 3) + r]];
+            }
+        }
+        if(round != nr)
+        {
+            for(c = 0; c < 4; c++)
+            {
+                uint8_t *a = &t[4 * c];
+                uint8_t a0 = a[0], a1 = a[1], a2 = a[2], a3 = a[3];
+                block[4 * c + 0] = sx_hostsim_xtime(a0 ^ a1) ^ a1 ^ a2 ^ a3;
+                block[4 * c + 1] = sx_hostsim_xtime(a1 ^ a2) ^ a2 ^ a3 ^ a0;
+                block[4 * c + 2] = sx_hostsim_xtime(a2 ^ a3) ^ a3 ^ a0 ^ a1;
+                block[4 * c + 3] = sx_hostsim_xtime(a3 ^ a0) ^ a0 ^ a1 ^ a2;
+            }
+        }
+        else
+        {
+            memcpy(block, t, sizeof(t));
+        }
+        sx_hostsim_aes_add_round_key(block, &rk[SX_HOSTSIM_AES_BLOCK_SIZE * round]);
+    }
+    sx_hostsim_stats.aes_blocks++;
+}
+
+static void sx_hostsim_aes_decrypt(const uint8_t *rk, uint32_t nr, uint8_t *block)
+{
+    uint8_t t[SX_HOSTSIM_AES_BLOCK_SIZE];
+    uint32_t round, c, r;
+
+    sx_hostsim_aes_add_round_key(block, &rk[SX_HOSTSIM_AES_BLOCK_SIZE * nr]);
+    for(round = nr; round-- > 0; )
+    {
+        // InvShiftRows and InvSubBytes
+        for(c = 0; c < 4; c++)
+        {
+            for(r = 0; r < 4; r++)
+            {
+                t[4 * ((c + r) & 3) + r] = sx_hostsim_inv_sbox[block[4 * c + r]];
+            }
+        }
+        sx_hostsim_aes_add_round_key(t, &rk[SX_HOSTSIM_AES_BLOCK_SIZE * round]);
+        if(round != 0)
+        {
+            for(c = 0; c < 4; c++)
+            {
+                uint8_t *a = &t[4 * c];
+                block[4 * c + 0] = sx_hostsim_gmul(a[0], 14) ^ sx_hostsim_gmul(a[1], 11) ^
+                                   sx_hostsim_gmul(a[2], 13) ^ sx_hostsim_gmul(a[3], 9);
+                block[4 * c + 1] = sx_hostsim_gmul(a[0], 9) ^ sx_hostsim_gmul(a[1], 14) ^
+                                   sx_hostsim_gmul(a[2], 11) ^ sx_hostsim_gmul(a[3], 13);
+                block[4 * c + 2] = sx_hostsim_gmul(a[0], 13) ^ sx_hostsim_gmul(a[1], 9) ^
+                                   sx_hostsim_gmul(a[2], 14) ^ sx_hostsim_gmul(a[3], 11);
+                block[4 * c + 3] = sx_hostsim_gmul(a[0], 11) ^ sx_hostsim_gmul(a[1], 13) ^
+                                   sx_hostsim_gmul(a[2], 9) ^ sx_hostsim_gmul(a[3], 14);
+            }
+        }
+        else
+        {
+            memcpy(block, t, sizeof(t));
+        }
+    }
+    sx_hostsim_stats.aes_blocks++;
+}
+
+/* CBC-MAC over @p len bytes, zero padded to a block */
+static void sx_hostsim_ccm_mac(const uint8_t *rk, uint32_t nr, uint8_t *mac, const uint8_t *data, uint32_t len)
+{
+    uint32_t i;
+
+    for(i = 0; i < len; i++)
+    {
+        mac[i % SX_HOSTSIM_AES_BLOCK_SIZE] ^= data[i];
+        if(((i % SX_HOSTSIM_AES_BLOCK_SIZE) == (SX_HOSTSIM_AES_BLOCK_SIZE - 1)) || (i == len - 1))
+        {
+            sx_hostsim_aes_encrypt(rk, nr, mac);
+        }
+    }
+}
+
+static void sx_hostsim_ccm_counter(uint8_t *ctr, const uint8_t *b0, uint32_t l, uint32_t i)
+{
+    uint32_t j;
+
+    memcpy(ctr, b0, SX_HOSTSIM_AES_BLOCK_SIZE);
+    ctr[0] = (uint8_t)(l - 1);
+    for(j = 0; j < l; j++)
+    {
+        ctr[SX_HOSTSIM_AES_BLOCK_SIZE - 1 - j] = (j < 4) ? (uint8_t)(i >> (8 * j)) : 0;
+    }
+}
+
+/*
+ * CCM as the BA411 runs it for sx_aes_blk(): the header is B0 followed by the encoded aad, the payload section holds
+ * the message followed by the tag to check when decrypting. The output mirrors the padded input sections; the tag
+ * block is T xor S0, xor the input tag when decrypting so a valid tag gives zeroes.
+ */
+static bool sx_hostsim_aes_ccm(const uint8_t *rk, uint32_t nr, bool decrypt)
+{
+    const sx_hostsim_buf_t *header = &sx_hostsim_in[SX_HOSTSIM_TAG_DATATYPE(DMA_SG_TAG_DATATYPE_AESHEADER)];
+    const sx_hostsim_buf_t *payload = &sx_hostsim_in[SX_HOSTSIM_TAG_DATATYPE(DMA_SG_TAG_DATATYPE_AESPAYLOAD)];
+    uint8_t mac[SX_HOSTSIM_AES_BLOCK_SIZE] = {0};
+    uint8_t s[SX_HOSTSIM_AES_BLOCK_SIZE];
+    uint32_t header_len, msg_len, tag_len, l, m, i, j;
+    uint8_t *out;
+
+    if(header->len < SX_HOSTSIM_AES_BLOCK_SIZE)
+    {
+        return false;
+    }
+    l = (header->data[0] & 0x7) + 1;
+    m = (header->data[0] >> 3) & 0x7;
+    tag_len = (m != 0) ? (2 * m + 2) : 0;
+    msg_len = 0;
+    for(j = 0; j < l; j++)
+    {
+        if(j >= 4 && header->data[SX_HOSTSIM_AES_BLOCK_SIZE - 1 - j] != 0)
+        {
+            return false;
+        }
+        msg_len |= (j < 4) ? ((uint32_t)header->data[SX_HOSTSIM_AES_BLOCK_SIZE - 1 - j] << (8 * j)) : 0;
+    }
+    if((msg_len > payload->len) || (payload->len - msg_len > (decrypt ? tag_len : 0)))
+    {
+        return false;
+    }
+
+    header_len = (header->len + SX_HOSTSIM_AES_BLOCK_SIZE - 1) & ~(SX_HOSTSIM_AES_BLOCK_SIZE - 1);
+    if(!sx_hostsim_buf_append(&sx_hostsim_out, header_len + ((msg_len + 15) & ~15UL) + ((tag_len != 0) ? 16 : 0)))
+    {
+        return false;
+    }
+    out = sx_hostsim_out.data;
+    memset(out, 0, sx_hostsim_out.len);
+    memcpy(out, header->data, header->len);
+    out += header_len;
+
+    sx_hostsim_ccm_mac(rk, nr, mac, header->data, header->len);
+    for(i = 0; i * SX_HOSTSIM_AES_BLOCK_SIZE < msg_len; i++)
+    {
+        uint32_t len = msg_len - i * SX_HOSTSIM_AES_BLOCK_SIZE;
+        len = (len > SX_HOSTSIM_AES_BLOCK_SIZE) ? SX_HOSTSIM_AES_BLOCK_SIZE : len;
+        sx_hostsim_ccm_counter(s, header->data, l, i + 1);
+        sx_hostsim_aes_encrypt(rk, nr, s);
+        for(j = 0; j < len; j++)
+        {
+            out[i * SX_HOSTSIM_AES_BLOCK_SIZE + j] = payload->data[i * SX_HOSTSIM_AES_BLOCK_SIZE + j] ^ s[j];
+        }
+    }
+    sx_hostsim_ccm_mac(rk, nr, mac, decrypt ? out : payload->data, msg_len);
+    out += (msg_len + 15) & ~15UL;
+
+    if(tag_len != 0)
+    {
+        sx_hostsim_ccm_counter(s, header->data, l, 0);
+        sx_hostsim_aes_encrypt(rk, nr, s);
+        for(j = 0; j < SX_HOSTSIM_AES_BLOCK_SIZE; j++)
+        {
+            out[j] = mac[j] ^ s[j];
+            if(msg_len + j < payload->len)
+            {
+                out[j] ^= payload->data[msg_len + j];
+            }
+        }
+    }
+    return true;
+}
+
+static bool sx_hostsim_aes_run(void)
+{
+    const sx_hostsim_buf_t *header = &sx_hostsim_in[SX_HOSTSIM_TAG_DATATYPE(DMA_SG_TAG_DATATYPE_AESHEADER)];
+    const sx_hostsim_buf_t *payload = &sx_hostsim_in[SX_HOSTSIM_TAG_DATATYPE(DMA_SG_TAG_DATATYPE_AESPAYLOAD)];
+    uint8_t rk[SX_HOSTSIM_AES_MAX_ROUNDKEYS];
+    uint32_t mode, key_len, nr, i;
+    bool decrypt;
+
+    memcpy(&mode, &sx_hostsim_cfg[AES_OFFSET_CFG], sizeof(mode));
+    decrypt = (mode & AES_MODEID_DECRYPT) != 0;
+
+    // Hardware keys, masking and context switching are not modelled
+    if(mode & (AES_MODEID_KEYX_MASK | AES_MODEID_CX_SAVE | AES_MODEID_CX_LOAD))
+    {
+        return false;
+    }
+    key_len = (mode & AES_MODEID_AES256) ? 32 : ((mode & AES_MODEID_AES192) ? 24 : 16);
+    nr = sx_hostsim_aes_expand_key(rk, &sx_hostsim_cfg[AES_OFFSET_KEY], key_len);
+
+    switch(mode & (AES_MODEID_ECB | AES_MODEID_CBC | AES_MODEID_CTR | AES_MODEID_CFB | AES_MODEID_OFB |
+                   AES_MODEID_CCM | AES_MODEID_GCM | AES_MODEID_XTS | AES_MODEID_CMA))
+    {
+        case AES_MODEID_ECB:
+        {
+            if(header->len != 0)
+            {
+                return false;
+            }
+            if(!sx_hostsim_buf_append(&sx_hostsim_out, (payload->len + 15) & ~15UL))
+            {
+                return false;
+            }
+            memset(sx_hostsim_out.data, 0, sx_hostsim_out.len);
+            memcpy(sx_hostsim_out.data, payload->data, payload->len);
+            for(i = 0; i < sx_hostsim_out.len; i += SX_HOSTSIM_AES_BLOCK_SIZE)
+            {
+                if(decrypt)
+                {
+                    sx_hostsim_aes_decrypt(rk, nr, &sx_hostsim_out.data[i]);
+                }
+                else
+                {
+                    sx_hostsim_aes_encrypt(rk, nr, &sx_hostsim_out.data[i]);
+                }
+            }
+            return true;
+        }
+        case AES_MODEID_CCM:
+        {
+            return sx_hostsim_aes_ccm(rk, nr, decrypt);
+        }
+        default:
+        {
+            return false;
+        }
+    }
+}
+
+/*****************************************************************************
+ *                    BA413 - Hash
+ *****************************************************************************/
+
+static uint32_t sx_hostsim_ror32(uint32_t x, uint32_t n)
+{
+    return (x >> n) | (x << (32 - n));
+}
+
+static uint32_t sx_hostsim_get_be32(const uint8_t *p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+static void sx_hostsim_put_be32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+static void sx_hostsim_sha256_compress(uint32_t *state, const uint8_t *block)
+{
+    uint32_t w[64];
+    uint32_t a, b, c, d, e, f, g, h;
+    uint32_t i;
+
+    for(i = 0; i < 16; i++)
+    {
+        w[i] = sx_hostsim_get_be32(&block[4 * i]);
+    }
+    for(i = 16; i < 64; i++)
+    {
+        uint32_t s0 = sx_hostsim_ror32(w[i - 15], 7) ^ sx_hostsim_ror32(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = sx_hostsim_ror32(w[i - 2], 17) ^ sx_hostsim_ror32(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    a = state[0]; b = state[1]; c = state[2]; d = state[3];
+    e = state[4]; f = state[5]; g = state[6]; h = state[7];
+    for(i = 0; i < 64; i++)
+    {
+        uint32_t s1 = sx_hostsim_ror32(e, 6) ^ sx_hostsim_ror32(e, 11) ^ sx_hostsim_ror32(e, 25);
+        uint32_t t1 = h + s1 + ((e & f) ^ (~e & g)) + sx_hostsim_sha256_k[i] + w[i];
+        uint32_t s0 = sx_hostsim_ror32(a, 2) ^ sx_hostsim_ror32(a, 13) ^ sx_hostsim_ror32(a, 22);
+        uint32_t t2 = s0 + ((a & b) ^ (a & c) ^ (b & c));
+        h = g; g = f; f = e; e = d + t1;
+        d = c; c = b; b = a; a = t1 + t2;
+    }
+    state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+    state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+
+    sx_hostsim_stats.hash_blocks++;
+}
+
+/* Hash @p len bytes of a message of which @p prefix_len bytes were already compressed, with the final padding */
+static void sx_hostsim_sha256_final(uint32_t *state, const uint8_t *data, uint32_t len, uint32_t prefix_len)
+{
+    uint8_t block[SX_HOSTSIM_SHA_BLOCK_SIZE];
+    uint64_t bits = ((uint64_t)prefix_len + len) * 8;
+    uint32_t i;
+
+    while(len >= SX_HOSTSIM_SHA_BLOCK_SIZE)
+    {
+        sx_hostsim_sha256_compress(state, data);
+        data += SX_HOSTSIM_SHA_BLOCK_SIZE;
+        len -= SX_HOSTSIM_SHA_BLOCK_SIZE;
+    }
+    memset(block, 0, sizeof(block));
+    memcpy(block, data, len);
+    block[len] = 0x80;
+    if(len >= SX_HOSTSIM_SHA_BLOCK_SIZE - 8)
+    {
+        sx_hostsim_sha256_compress(state, block);
+        memset(block, 0, sizeof(block));
+    }
+    for(i = 0; i < 8; i++)
+    {
+        block[SX_HOSTSIM_SHA_BLOCK_SIZE - 1 - i] = (uint8_t)(bits >> (8 * i));
+    }
+    sx_hostsim_sha256_compress(state, block);
+}
+
+static bool sx_hostsim_hash_run(void)
+{
+    const sx_hostsim_buf_t *msg = &sx_hostsim_in[SX_HOSTSIM_TAG_DATATYPE(DMA_SG_TAG_DATATYPE_HASHMSG)];
+    const sx_hostsim_buf_t *init = &sx_hostsim_in[SX_HOSTSIM_TAG_DATATYPE(DMA_SG_TAG_DATATYPE_HASHINIT)];
+    const sx_hostsim_buf_t *k0 = &sx_hostsim_in[SX_HOSTSIM_TAG_DATATYPE(DMA_SG_TAG_DATATYPE_HASHK0)];
+    uint32_t config, state[8], i, out_len;
+    const uint32_t *iv;
+
+    memcpy(&config, sx_hostsim_cfg, sizeof(config));
+    switch(config & (BA413_CONF_MODE_MD5 | BA413_CONF_MODE_SHA1 | BA413_CONF_MODE_SHA224 | BA413_CONF_MODE_SHA256 |
+                     BA413_CONF_MODE_SHA384 | BA413_CONF_MODE_SHA512))
+    {
+        case BA413_CONF_MODE_SHA224:
+        {
+            iv = sx_hostsim_sha224_iv;
+            out_len = SX_HOSTSIM_SHA224_DIGEST_SIZE;
+            break;
+        }
+        case BA413_CONF_MODE_SHA256:
+        {
+            iv = sx_hostsim_sha256_iv;
+            out_len = SX_HOSTSIM_SHA_STATE_SIZE;
+            break;
+        }
+        default:
+        {
+            return false;
+        }
+    }
+
+    if(!(config & BA413_CONF_HWPAD))
+    {
+        // Partial hash: state in and out, whole blocks only
+        if((init->len != SX_HOSTSIM_SHA_STATE_SIZE) || (k0->len != 0) || (msg->len % SX_HOSTSIM_SHA_BLOCK_SIZE))
+        {
+            return false;
+        }
+        for(i = 0; i < 8; i++)
+        {
+            state[i] = sx_hostsim_get_be32(&init->data[4 * i]);
+        }
+        for(i = 0; i < msg->len; i += SX_HOSTSIM_SHA_BLOCK_SIZE)
+        {
+            sx_hostsim_sha256_compress(state, &msg->data[i]);
+        }
+        out_len = SX_HOSTSIM_SHA_STATE_SIZE;
+    }
+    else if(config & BA413_CONF_HMAC)
+    {
+        uint8_t pad[SX_HOSTSIM_SHA_BLOCK_SIZE];
+        uint8_t digest[SX_HOSTSIM_SHA_STATE_SIZE];
+
+        if((k0->len != SX_HOSTSIM_SHA_BLOCK_SIZE) || (init->len != 0))
+        {
+            return false;
+        }
+        memcpy(state, iv, sizeof(state));
+        for(i = 0; i < SX_HOSTSIM_SHA_BLOCK_SIZE; i++)
+        {
+            pad[i] = k0->data[i] ^ 0x36;
+        }
+        sx_hostsim_sha256_compress(state, pad);
+        sx_hostsim_sha256_final(state, msg->data, msg->len, SX_HOSTSIM_SHA_BLOCK_SIZE);
+        for(i = 0; i < 8; i++)
+        {
+            sx_hostsim_put_be32(&digest[4 * i], state[i]);
+        }
+
+        memcpy(state, iv, sizeof(state));
+        for(i = 0; i < SX_HOSTSIM_SHA_BLOCK_SIZE; i++)
+        {
+            pad[i] = k0->data[i] ^ 0x5C;
+        }
+        sx_hostsim_sha256_compress(state, pad);
+        sx_hostsim_sha256_final(state, digest, out_len, SX_HOSTSIM_SHA_BLOCK_SIZE);
+    }
+    else
+    {
+        if((init->len != 0) || (k0->len != 0))
+        {
+            return false;
+        }
+        memcpy(state, iv, sizeof(state));
+        sx_hostsim_sha256_final(state, msg->data, msg->len, 0);
+    }
+
+    if(!sx_hostsim_buf_append(&sx_hostsim_out, SX_HOSTSIM_SHA_STATE_SIZE))
+    {
+        return false;
+    }
+    for(i = 0; i < 8; i++)
+    {
+        sx_hostsim_put_be32(&sx_hostsim_out.data[4 * i], state[i]);
+    }
+    sx_hostsim_out.len = out_len;
+    return true;
+}
+
+/*****************************************************************************
+ *                    Cryptomaster DMA
+ *****************************************************************************/
+
+/* Gather the fetch descriptors into the configuration space and the input buffers, returns the engine or -1 */
+static int32_t sx_hostsim_dma_fetch(const volatile struct dma_sg_descr_s *d)
+{
+    int32_t engine = -1;
+    uint32_t count = 0;
+
+    while(d != DMA_AXI_DESCR_NEXT_STOP)
+    {
+        uint32_t len = SX_HOSTSIM_DESCR_LENGTH(d->length_irq);
+        uint32_t tag = d->tag;
+        bool src_const = (d->length_irq & DMA_AXI_DESCR_CONST_ADDR) != 0;
+
+        if((count++ >= SX_HOSTSIM_MAX_DESCRIPTORS) || !sx_hostsim_addr_valid(d) || !sx_hostsim_addr_valid(d->addr))
+        {
+            return -1;
+        }
+        if(engine < 0)
+        {
+            engine = (int32_t)SX_HOSTSIM_TAG_ENGINE(tag);
+        }
+        else if(engine != (int32_t)SX_HOSTSIM_TAG_ENGINE(tag))
+        {
+            return -1;
+        }
+        sx_hostsim_stats.fetch_descr++;
+        sx_hostsim_stats.fetch_bytes += len;
+
+        if(tag & DMA_SG_TAG_ISCONFIG)
+        {
+            uint32_t offset = SX_HOSTSIM_TAG_CFGOFFSET(tag);
+            if((offset + len > SX_HOSTSIM_CFG_SIZE) || ((len != 0) && (d->addr == NULL)))
+            {
+                return -1;
+            }
+            sx_hostsim_copy(&sx_hostsim_cfg[offset], false, (const uint8_t *)d->addr, src_const, len);
+            sx_hostsim_stats.config_bytes += len;
+        }
+        else
+        {
+            sx_hostsim_buf_t *buf = &sx_hostsim_in[SX_HOSTSIM_TAG_DATATYPE(tag)];
+            // Bypass tags carry no invalid bytes
+            uint32_t invalid = (engine != DMA_SG_ENGINESELECT_BYPASS) ? SX_HOSTSIM_TAG_INVALID(tag) : 0;
+            uint32_t valid;
+
+            if(invalid > len)
+            {
+                return -1;
+            }
+            valid = len - invalid;
+            if((valid != 0) && (d->addr == NULL))
+            {
+                return -1;
+            }
+            if(!sx_hostsim_buf_append(buf, valid))
+            {
+                return -1;
+            }
+            sx_hostsim_copy(&buf->data[buf->len - valid], false, (const uint8_t *)d->addr, src_const, valid);
+            sx_hostsim_stats.invalid_bytes += invalid;
+        }
+        d = d->next_descr;
+    }
+    return engine;
+}
+
+/* Scatter the engine output over the push descriptors */
+static bool sx_hostsim_dma_push(const volatile struct dma_sg_descr_s *d)
+{
+    uint32_t offset = 0;
+    uint32_t count = 0;
+
+    while(d != DMA_AXI_DESCR_NEXT_STOP)
+    {
+        uint32_t len = SX_HOSTSIM_DESCR_LENGTH(d->length_irq);
+
+        if((count++ >= SX_HOSTSIM_MAX_DESCRIPTORS) || !sx_hostsim_addr_valid(d) || !sx_hostsim_addr_valid(d->addr))
+        {
+            return false;
+        }
+        sx_hostsim_stats.push_descr++;
+        sx_hostsim_stats.push_bytes += len;
+
+        // The pusher would wait for data that never comes
+        if(offset + len > sx_hostsim_out.len)
+        {
+            return false;
+        }
+        if((d->length_irq & DMA_AXI_DESCR_DISCARD) || (d->addr == NULL))
+        {
+            sx_hostsim_stats.discard_bytes += len;
+        }
+        else
+        {
+            sx_hostsim_copy((uint8_t *)d->addr, (d->length_irq & DMA_AXI_DESCR_CONST_ADDR) != 0,
+                            &sx_hostsim_out.data[offset], false, len);
+        }
+        offset += len;
+        d = d->next_descr;
+    }
+
+    // Output left in the FIFO
+    sx_hostsim_dma->status |= ((sx_hostsim_out.len - offset) << DMA_AXI_STATUSREG_LSB_FIFOOUT_NDATA) &
+                              DMA_AXI_STATUSREG_MASK_FIFOOUT_NDATA;
+    return true;
+}
+
+static uint32_t sx_hostsim_dma_run_sg(void)
+{
+    const struct dma_sg_descr_s *fetch = (const struct dma_sg_descr_s *)(uintptr_t)sx_hostsim_dma->fetch_addr;
+    const struct dma_sg_descr_s *push = (const struct dma_sg_descr_s *)(uintptr_t)sx_hostsim_dma->push_addr;
+    int32_t engine;
+    bool done;
+    uint32_t i;
+
+    sx_hostsim_stats.dma_runs++;
+
+    memset(sx_hostsim_cfg, 0, sizeof(sx_hostsim_cfg));
+    for(i = 0; i < SX_HOSTSIM_DATATYPES; i++)
+    {
+        sx_hostsim_in[i].len = 0;
+    }
+    sx_hostsim_out.len = 0;
+
+    engine = sx_hostsim_dma_fetch(fetch);
+    switch(engine)
+    {
+        case DMA_SG_ENGINESELECT_BYPASS:
+        {
+            done = sx_hostsim_buf_append(&sx_hostsim_out, sx_hostsim_in[0].len);
+            if(done)
+            {
+                memcpy(sx_hostsim_out.data, sx_hostsim_in[0].data, sx_hostsim_in[0].len);
+            }
+            break;
+        }
+        case DMA_SG_ENGINESELECT_BA411E:
+        {
+            done = sx_hostsim_aes_run();
+            break;
+        }
+        case DMA_SG_ENGINESELECT_BA413:
+        {
+            done = sx_hostsim_hash_run();
+            break;
+        }
+        default:
+        {
+            // BA412, BA417 or a broken fetch chain
+            done = false;
+            break;
+        }
+    }
+    if(!done)
+    {
+        return DMA_AXI_RAWSTATREG_MASK_FETCHER_ERROR;
+    }
+    if(!sx_hostsim_dma_push(push))
+    {
+        return DMA_AXI_RAWSTATREG_MASK_PUSHER_ERROR;
+    }
+    return 0;
+}
+
+/* Direct mode, as memcpy_blk() uses it: bypass from the fetch to the push registers */
+static uint32_t sx_hostsim_dma_run_direct(void)
+{
+    uint32_t fetch_len = sx_hostsim_dma->fetch_len;
+    uint32_t push_len = sx_hostsim_dma->push_len;
+    uint32_t len = SX_HOSTSIM_DESCR_LENGTH(fetch_len);
+
+    sx_hostsim_stats.dma_direct++;
+
+    if((SX_HOSTSIM_DESCR_LENGTH(push_len)) < len)
+    {
+        len = SX_HOSTSIM_DESCR_LENGTH(push_len);
+    }
+    sx_hostsim_stats.fetch_bytes += len;
+    sx_hostsim_stats.push_bytes += len;
+    if(!(push_len & DMA_AXI_DESCR_DISCARD))
+    {
+        sx_hostsim_copy((uint8_t *)(uintptr_t)sx_hostsim_dma->push_addr, (push_len & DMA_AXI_DESCR_CONST_ADDR) != 0,
+                        (const uint8_t *)(uintptr_t)sx_hostsim_dma->fetch_addr,
+                        (fetch_len & DMA_AXI_DESCR_CONST_ADDR) != 0, len);
+    }
+    return 0;
+}
+
+static void sx_hostsim_dma_start(void)
+{
+    uint64_t start = sx_hostsim_get_time_ns();
+    uint32_t config = sx_hostsim_dma->config;
+    uint32_t error;
+
+    sx_hostsim_dma->status = 0;
+    if(!sx_hostsim_clocked())
+    {
+        error = DMA_AXI_RAWSTATREG_MASK_FETCHER_ERROR;
+    }
+    else if((config & (DMA_AXI_CONFIGREG_FETCHER_INDIRECT | DMA_AXI_CONFIGREG_PUSHER_INDIRECT)) ==
+            (DMA_AXI_CONFIGREG_FETCHER_INDIRECT | DMA_AXI_CONFIGREG_PUSHER_INDIRECT))
+    {
+        error = sx_hostsim_dma_run_sg();
+    }
+    else if((config & (DMA_AXI_CONFIGREG_FETCHER_INDIRECT | DMA_AXI_CONFIGREG_PUSHER_INDIRECT)) == 0)
+    {
+        error = sx_hostsim_dma_run_direct();
+    }
+    else
+    {
+        error = DMA_AXI_RAWSTATREG_MASK_FETCHER_ERROR;
+    }
+
+    if(error)
+    {
+        sx_hostsim_stats.errors++;
+    }
+    sx_hostsim_dma->int_stat_raw |= error | DMA_AXI_INTENSETREG_FETCHER_STOPPED_EN | DMA_AXI_INTENSETREG_PUSHER_STOPPED_EN;
+    sx_hostsim_dma->int_stat = sx_hostsim_dma->int_stat_raw & sx_hostsim_dma->int_en;
+    sx_hostsim_stats.engine_ns += sx_hostsim_get_time_ns() - start;
+}
+
+/*****************************************************************************
+ *                    BA414 - Big numbers
+ *****************************************************************************/
+
+static int sx_hostsim_bn_cmp(const uint32_t *a, const uint32_t *b, uint32_t n)
+{
+    while(n-- > 0)
+    {
+        if(a[n] != b[n])
+        {
+            return (a[n] > b[n]) ? 1 : -1;
+        }
+    }
+    return 0;
+}
+
+static bool sx_hostsim_bn_is_zero(const uint32_t *a, uint32_t n)
+{
+    uint32_t i;
+    for(i = 0; i < n; i++)
+    {
+        if(a[i] != 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static uint32_t sx_hostsim_bn_add(uint32_t *r, const uint32_t *a, const uint32_t *b, uint32_t n)
+{
+    uint64_t c = 0;
+    uint32_t i;
+    for(i = 0; i < n; i++)
+    {
+        c += (uint64_t)a[i] + b[i];
+        r[i] = (uint32_t)c;
+        c >>= 32;
+    }
+    return (uint32_t)c;
+}
+
+static uint32_t sx_hostsim_bn_sub(uint32_t *r, const uint32_t *a, const uint32_t *b, uint32_t n)
+{
+    uint64_t borrow = 0;
+    uint32_t i;
+    for(i = 0; i < n; i++)
+    {
+        uint64_t d = (uint64_t)a[i] - b[i] - borrow;
+        r[i] = (uint32_t)d;
+        borrow = (d >> 32) & 1;
+    }
+    return (uint32_t)borrow;
+}
+
+static void sx_hostsim_mod_add(uint32_t *r, const uint32_t *a, const uint32_t *b, const sx_hostsim_field_t *f)
+{
+    uint32_t carry = sx_hostsim_bn_add(r, a, b, f->n);
+    if(carry || (sx_hostsim_bn_cmp(r, f->m, f->n) >= 0))
+    {
+        sx_hostsim_bn_sub(r, r, f->m, f->n);
+    }
+}
+
+static void sx_hostsim_mod_sub(uint32_t *r, const uint32_t *a, const uint32_t *b, const sx_hostsim_field_t *f)
+{
+    if(sx_hostsim_bn_sub(r, a, b, f->n))
+    {
+        sx_hostsim_bn_add(r, r, f->m, f->n);
+    }
+}
+
+/* Montgomery multiplication (CIOS): r = a * b / R mod m, for a * b < m * R */
+static void sx_hostsim_mont_mul(uint32_t *r, const uint32_t *a, const uint32_t *b, const sx_hostsim_field_t *f)
+{
+    uint32_t t[SX_HOSTSIM_PK_MAX_WORDS + 2];
+    uint32_t n = f->n;
+    uint32_t i, j;
+
+    memset(t, 0, sizeof(t));
+    for(i = 0; i < n; i++)
+    {
+        uint64_t c = 0;
+        uint32_t q;
+
+        for(j = 0; j < n; j++)
+        {
+            c = (uint64_t)t[j] + (uint64_t)a[j] * b[i] + (c >> 32);
+            t[j] = (uint32_t)c;
+        }
+        c = (uint64_t)t[n] + (c >> 32);
+        t[n] = (uint32_t)c;
+        t[n + 1] = (uint32_t)(c >> 32);
+
+        q = t[0] * f->minv;
+        c = (uint64_t)t[0] + (uint64_t)q * f->m[0];
+        for(j = 1; j < n; j++)
+        {
+            c = (uint64_t)t[j] + (uint64_t)q * f->m[j] + (c >> 32);
+            t[j - 1] = (uint32_t)c;
+        }
+        c = (uint64_t)t[n] + (c >> 32);
+        t[n - 1] = (uint32_t)c;
+        t[n] = t[n + 1] + (uint32_t)(c >> 32);
+    }
+    if(t[n] || (sx_hostsim_bn_cmp(t, f->m, n) >= 0))
+    {
+        sx_hostsim_bn_sub(t, t, f->m, n);
+    }
+    memcpy(r, t, n * sizeof(uint32_t));
+}
+
+/* Returns false for an even or zero modulus */
+static bool sx_hostsim_field_init(sx_hostsim_field_t *f, const uint32_t *m, uint32_t n)
+{
+    uint32_t inv = 1;
+    uint32_t i;
+
+    if(((m[0] & 1) == 0) || ((n == 1) && (m[0] == 1)))
+    {
+        return false;
+    }
+    memset(f, 0, sizeof(*f));
+    memcpy(f->m, m, n * sizeof(uint32_t));
+    f->n = n;
+
+    // Newton iteration doubles the correct bits: 1, 2, 4, ..., 32
+    for(i = 0; i < 5; i++)
+    {
+        inv *= 2 - m[0] * inv;
+    }
+    f->minv = (uint32_t)0 - inv;
+
+    // R mod m and R^2 mod m by doubling 1
+    f->one[0] = 1;
+    for(i = 0; i < 32 * n; i++)
+    {
+        sx_hostsim_mod_add(f->one, f->one, f->one, f);
+    }
+    memcpy(f->rr, f->one, n * sizeof(uint32_t));
+    for(i = 0; i < 32 * n; i++)
+    {
+        sx_hostsim_mod_add(f->rr, f->rr, f->rr, f);
+    }
+    return true;
+}
+
+/* Into the Montgomery domain, reduces any a < R */
+static void sx_hostsim_to_mont(uint32_t *r, const uint32_t *a, const sx_hostsim_field_t *f)
+{
+    sx_hostsim_mont_mul(r, a, f->rr, f);
+}
+
+static void sx_hostsim_from_mont(uint32_t *r, const uint32_t *a, const sx_hostsim_field_t *f)
+{
+    uint32_t one[SX_HOSTSIM_PK_MAX_WORDS] = {1};
+    sx_hostsim_mont_mul(r, a, one, f);
+}
+
+/* Inverse in the Montgomery domain, a^(m-2) for a prime m */
+static void sx_hostsim_mont_inv(uint32_t *r, const uint32_t *a, const sx_hostsim_field_t *f)
+{
+    uint32_t e[SX_HOSTSIM_PK_MAX_WORDS] = {2};
+    uint32_t x[SX_HOSTSIM_PK_MAX_WORDS];
+    int32_t bit;
+
+    sx_hostsim_bn_sub(e, f->m, e, f->n);
+    memcpy(x, f->one, sizeof(x));
+    for(bit = (int32_t)(32 * f->n) - 1; bit >= 0; bit--)
+    {
+        sx_hostsim_mont_mul(x, x, x, f);
+        if((e[bit / 32] >> (bit % 32)) & 1)
+        {
+            sx_hostsim_mont_mul(x, x, a, f);
+        }
+    }
+    memcpy(r, x, f->n * sizeof(uint32_t));
+}
+
+/*****************************************************************************
+ *                    BA414 - Prime field curves
+ *****************************************************************************/
+
+static void sx_hostsim_point_double(sx_hostsim_point_t *r, const sx_hostsim_point_t *p, const sx_hostsim_curve_t *c)
+{
+    const sx_hostsim_field_t *f = &c->p;
+    uint32_t xx[SX_HOSTSIM_PK_MAX_WORDS], yy[SX_HOSTSIM_PK_MAX_WORDS], zz[SX_HOSTSIM_PK_MAX_WORDS];
+    uint32_t s[SX_HOSTSIM_PK_MAX_WORDS], m[SX_HOSTSIM_PK_MAX_WORDS], t[SX_HOSTSIM_PK_MAX_WORDS];
+
+    if(sx_hostsim_bn_is_zero(p->z, f->n) || sx_hostsim_bn_is_zero(p->y, f->n))
+    {
+        memset(r, 0, sizeof(*r));
+        return;
+    }
+    sx_hostsim_mont_mul(xx, p->x, p->x, f);
+    sx_hostsim_mont_mul(yy, p->y, p->y, f);
+    sx_hostsim_mont_mul(zz, p->z, p->z, f);
+
+    // S = 4 X Y^2
+    sx_hostsim_mont_mul(s, p->x, yy, f);
+    sx_hostsim_mod_add(s, s, s, f);
+    sx_hostsim_mod_add(s, s, s, f);
+    // M = 3 X^2 + a Z^4
+    sx_hostsim_mont_mul(t, zz, zz, f);
+    sx_hostsim_mont_mul(t, t, c->a, f);
+    sx_hostsim_mod_add(m, xx, xx, f);
+    sx_hostsim_mod_add(m, m, xx, f);
+    sx_hostsim_mod_add(m, m, t, f);
+    // Z3 = 2 Y Z
+    sx_hostsim_mont_mul(r->z, p->y, p->z, f);
+    sx_hostsim_mod_add(r->z, r->z, r->z, f);
+    // X3 = M^2 - 2 S
+    sx_hostsim_mont_mul(t, m, m, f);
+    sx_hostsim_mod_sub(t, t, s, f);
+    sx_hostsim_mod_sub(r->x, t, s, f);
+    // Y3 = M (S - X3) - 8 Y^4
+    sx_hostsim_mod_sub(s, s, r->x, f);
+    sx_hostsim_mont_mul(s, m, s, f);
+    sx_hostsim_mont_mul(t, yy, yy, f);
+    sx_hostsim_mod_add(t, t, t, f);
+    sx_hostsim_mod_add(t, t, t, f);
+    sx_hostsim_mod_add(t, t, t, f);
+    sx_hostsim_mod_sub(r->y, s, t, f);
+}
+
+static void sx_hostsim_point_add(sx_hostsim_point_t *r, const sx_hostsim_point_t *p, const sx_hostsim_point_t *q,
+                                 const sx_hostsim_curve_t *c)
+{
+    const sx_hostsim_field_t *f = &c->p;
+    uint32_t z1z1[SX_HOSTSIM_PK_MAX_WORDS], z2z2[SX_HOSTSIM_PK_MAX_WORDS];
+    uint32_t u1[SX_HOSTSIM_PK_MAX_WORDS], u2[SX_HOSTSIM_PK_MAX_WORDS];
+    uint32_t s1[SX_HOSTSIM_PK_MAX_WORDS], s2[SX_HOSTSIM_PK_MAX_WORDS];
+    uint32_t h[SX_HOSTSIM_PK_MAX_WORDS], hh[SX_HOSTSIM_PK_MAX_WORDS], hhh[SX_HOSTSIM_PK_MAX_WORDS];
+    uint32_t v[SX_HOSTSIM_PK_MAX_WORDS], t[SX_HOSTSIM_PK_MAX_WORDS];
+    sx_hostsim_point_t res;
+
+    if(sx_hostsim_bn_is_zero(p->z, f->n))
+    {
+        *r = *q;
+        return;
+    }
+    if(sx_hostsim_bn_is_zero(q->z, f->n))
+    {
+        *r = *p;
+        return;
+    }
+    sx_hostsim_mont_mul(z1z1, p->z, p->z, f);
+    sx_hostsim_mont_mul(z2z2, q->z, q->z, f);
+    sx_hostsim_mont_mul(u1, p->x, z2z2, f);
+    sx_hostsim_mont_mul(u2, q->x, z1z1, f);
+    sx_hostsim_mont_mul(s1, p->y, q->z, f);
+    sx_hostsim_mont_mul(s1, s1, z2z2, f);
+    sx_hostsim_mont_mul(s2, q->y, p->z, f);
+    sx_hostsim_mont_mul(s2, s2, z1z1, f);
+
+    if(sx_hostsim_bn_cmp(u1, u2, f->n) == 0)
+    {
+        if(sx_hostsim_bn_cmp(s1, s2, f->n) == 0)
+        {
+            sx_hostsim_point_double(r, p, c);
+        }
+        else
+        {
+            memset(r, 0, sizeof(*r));
+        }
+        return;
+    }
+
+    sx_hostsim_mod_sub(h, u2, u1, f);
+    sx_hostsim_mod_sub(s2, s2, s1, f);      // R
+    sx_hostsim_mont_mul(hh, h, h, f);
+    sx_hostsim_mont_mul(hhh, h, hh, f);
+    sx_hostsim_mont_mul(v, u1, hh, f);
+    // X3 = R^2 - H^3 - 2 V
+    sx_hostsim_mont_mul(t, s2, s2, f);
+    sx_hostsim_mod_sub(t, t, hhh, f);
+    sx_hostsim_mod_sub(t, t, v, f);
+    sx_hostsim_mod_sub(res.x, t, v, f);
+    // Y3 = R (V - X3) - S1 H^3
+    sx_hostsim_mod_sub(v, v, res.x, f);
+    sx_hostsim_mont_mul(v, s2, v, f);
+    sx_hostsim_mont_mul(t, s1, hhh, f);
+    sx_hostsim_mod_sub(res.y, v, t, f);
+    // Z3 = Z1 Z2 H
+    sx_hostsim_mont_mul(t, p->z, q->z, f);
+    sx_hostsim_mont_mul(res.z, t, h, f);
+    *r = res;
+}
+
+static void sx_hostsim_point_mult(sx_hostsim_point_t *r, const uint32_t *k, const sx_hostsim_point_t *p,
+                                  const sx_hostsim_curve_t *c)
+{
+    sx_hostsim_point_t acc;
+    int32_t bit;
+
+    memset(&acc, 0, sizeof(acc));
+    for(bit = (int32_t)(32 * c->p.n) - 1; bit >= 0; bit--)
+    {
+        sx_hostsim_point_double(&acc, &acc, c);
+        if((k[bit / 32] >> (bit % 32)) & 1)
+        {
+            sx_hostsim_point_add(&acc, &acc, p, c);
+        }
+    }
+    *r = acc;
+}
+
+/* Affine point (plain domain) into Jacobian coordinates, false if not on the curve */
+static bool sx_hostsim_point_from_affine(sx_hostsim_point_t *r, const uint32_t *x, const uint32_t *y,
+                                         const sx_hostsim_curve_t *c)
+{
+    const sx_hostsim_field_t *f = &c->p;
+    uint32_t lhs[SX_HOSTSIM_PK_MAX_WORDS], rhs[SX_HOSTSIM_PK_MAX_WORDS], t[SX_HOSTSIM_PK_MAX_WORDS];
+
+    if((sx_hostsim_bn_cmp(x, f->m, f->n) >= 0) || (sx_hostsim_bn_cmp(y, f->m, f->n) >= 0))
+    {
+        return false;
+    }
+    memset(r, 0, sizeof(*r));
+    sx_hostsim_to_mont(r->x, x, f);
+    sx_hostsim_to_mont(r->y, y, f);
+    memcpy(r->z, f->one, sizeof(r->z));
+
+    // y^2 = x^3 + a x + b
+    sx_hostsim_mont_mul(lhs, r->y, r->y, f);
+    sx_hostsim_mont_mul(t, r->x, r->x, f);
+    sx_hostsim_mod_add(t, t, c->a, f);
+    sx_hostsim_mont_mul(rhs, t, r->x, f);
+    sx_hostsim_mod_add(rhs, rhs, c->b, f);
+    return sx_hostsim_bn_cmp(lhs, rhs, f->n) == 0;
+}
+
+/* Jacobian point into affine coordinates (plain domain), false for the point at infinity */
+static bool sx_hostsim_point_to_affine(uint32_t *x, uint32_t *y, const sx_hostsim_point_t *p,
+                                       const sx_hostsim_curve_t *c)
+{
+    const sx_hostsim_field_t *f = &c->p;
+    uint32_t zinv[SX_HOSTSIM_PK_MAX_WORDS], t[SX_HOSTSIM_PK_MAX_WORDS];
+
+    if(sx_hostsim_bn_is_zero(p->z, f->n))
+    {
+        memset(x, 0, f->n * sizeof(uint32_t));
+        memset(y, 0, f->n * sizeof(uint32_t));
+        return false;
+    }
+    sx_hostsim_mont_inv(zinv, p->z, f);
+    sx_hostsim_mont_mul(t, zinv, zinv, f);
+    sx_hostsim_mont_mul(x, p->x, t, f);
+    sx_hostsim_from_mont(x, x, f);
+    sx_hostsim_mont_mul(t, t, zinv, f);
+    sx_hostsim_mont_mul(y, p->y, t, f);
+    sx_hostsim_from_mont(y, y, f);
+    return true;
+}
+
+/*****************************************************************************
+ *                    BA414 - Operations
+ *****************************************************************************/
+
+/* Operand of a CryptoRAM location: big endian at the end of the location when swapped, little endian at its start */
+static void sx_hostsim_pk_read(uint32_t *r, uint32_t loc, const sx_hostsim_pk_op_t *op)
+{
+    const uint8_t *slot = &sx_hostsim_ba414e_cryptoram[(loc & 0xF) * SX_HOSTSIM_PK_SLOT_SIZE];
+    uint32_t i;
+
+    memset(r, 0, SX_HOSTSIM_PK_MAX_WORDS * sizeof(uint32_t));
+    for(i = 0; i < op->size; i++)
+    {
+        uint8_t b = op->swap ? slot[SX_HOSTSIM_PK_SLOT_SIZE - 1 - i] : slot[i];
+        r[i / 4] |= (uint32_t)b << (8 * (i % 4));
+    }
+}
+
+static void sx_hostsim_pk_write(uint32_t loc, const uint32_t *a, const sx_hostsim_pk_op_t *op)
+{
+    uint8_t *slot = &sx_hostsim_ba414e_cryptoram[(loc & 0xF) * SX_HOSTSIM_PK_SLOT_SIZE];
+    uint32_t i;
+
+    for(i = 0; i < op->size; i++)
+    {
+        uint8_t b = (uint8_t)(a[i / 4] >> (8 * (i % 4)));
+        if(op->swap)
+        {
+            slot[SX_HOSTSIM_PK_SLOT_SIZE - 1 - i] = b;
+        }
+        else
+        {
+            slot[i] = b;
+        }
+    }
+}
+
+/* Curve parameters p, n, Gx, Gy, a, b in locations 0 to 5, see ba414e_load_curve() */
+static bool sx_hostsim_pk_load_curve(sx_hostsim_curve_t *c, const sx_hostsim_pk_op_t *op)
+{
+    uint32_t t[SX_HOSTSIM_PK_MAX_WORDS];
+
+    sx_hostsim_pk_read(t, BA414E_MEMLOC_0, op);
+    if(!sx_hostsim_field_init(&c->p, t, op->n))
+    {
+        return false;
+    }
+    sx_hostsim_pk_read(t, BA414E_MEMLOC_1, op);
+    if(!sx_hostsim_field_init(&c->order, t, op->n))
+    {
+        return false;
+    }
+    sx_hostsim_pk_read(t, BA414E_MEMLOC_4, op);
+    sx_hostsim_to_mont(c->a, t, &c->p);
+    sx_hostsim_pk_read(t, BA414E_MEMLOC_5, op);
+    sx_hostsim_to_mont(c->b, t, &c->p);
+    return true;
+}
+
+static bool sx_hostsim_pk_read_point(sx_hostsim_point_t *r, uint32_t loc, const sx_hostsim_curve_t *c,
+                                     const sx_hostsim_pk_op_t *op)
+{
+    uint32_t x[SX_HOSTSIM_PK_MAX_WORDS], y[SX_HOSTSIM_PK_MAX_WORDS];
+
+    sx_hostsim_pk_read(x, loc, op);
+    sx_hostsim_pk_read(y, loc + 1, op);
+    return sx_hostsim_point_from_affine(r, x, y, c);
+}
+
+static uint32_t sx_hostsim_pk_write_point(uint32_t loc, const sx_hostsim_point_t *p, const sx_hostsim_curve_t *c,
+                                          const sx_hostsim_pk_op_t *op)
+{
+    uint32_t x[SX_HOSTSIM_PK_MAX_WORDS], y[SX_HOSTSIM_PK_MAX_WORDS];
+    bool finite = sx_hostsim_point_to_affine(x, y, p, c);
+
+    sx_hostsim_pk_write(loc, x, op);
+    sx_hostsim_pk_write(loc + 1, y, op);
+    return finite ? 0 : BA414E_STS_PINF_MASK;
+}
+
+/* Plain value modulo the order */
+static void sx_hostsim_pk_mod_order(uint32_t *r, const uint32_t *a, const sx_hostsim_curve_t *c)
+{
+    sx_hostsim_to_mont(r, a, &c->order);
+    sx_hostsim_from_mont(r, r, &c->order);
+}
+
+static uint32_t sx_hostsim_pk_ecdsa_sign(const sx_hostsim_curve_t *c, const sx_hostsim_pk_op_t *op)
+{
+    const sx_hostsim_field_t *n = &c->order;
+    uint32_t d[SX_HOSTSIM_PK_MAX_WORDS], k[SX_HOSTSIM_PK_MAX_WORDS], h[SX_HOSTSIM_PK_MAX_WORDS];
+    uint32_t r[SX_HOSTSIM_PK_MAX_WORDS], s[SX_HOSTSIM_PK_MAX_WORDS], y[SX_HOSTSIM_PK_MAX_WORDS];
+    sx_hostsim_point_t g, kg;
+
+    if(!sx_hostsim_pk_read_point(&g, BA414E_MEMLOC_2, c, op))
+    {
+        return BA414E_STS_PNCU_MASK;
+    }
+    sx_hostsim_pk_read(d, BA414E_MEMLOC_6, op);
+    sx_hostsim_pk_read(k, BA414E_MEMLOC_7, op);
+    sx_hostsim_pk_read(h, BA414E_MEMLOC_12, op);
+
+    // r = (k G).x mod n
+    sx_hostsim_point_mult(&kg, k, &g, c);
+    if(!sx_hostsim_point_to_affine(r, y, &kg, c))
+    {
+        return BA414E_STS_SINV_MASK;
+    }
+    sx_hostsim_pk_mod_order(r, r, c);
+    if(sx_hostsim_bn_is_zero(r, n->n))
+    {
+        return BA414E_STS_SINV_MASK;
+    }
+
+    // s = k^-1 (h + r d) mod n
+    sx_hostsim_to_mont(d, d, n);
+    sx_hostsim_to_mont(h, h, n);
+    sx_hostsim_to_mont(k, k, n);
+    sx_hostsim_to_mont(s, r, n);
+    sx_hostsim_mont_mul(s, s, d, n);
+    sx_hostsim_mod_add(s, s, h, n);
+    if(sx_hostsim_bn_is_zero(k, n->n))
+    {
+        return BA414E_STS_SINV_MASK;
+    }
+    sx_hostsim_mont_inv(k, k, n);
+    sx_hostsim_mont_mul(s, s, k, n);
+    sx_hostsim_from_mont(s, s, n);
+    if(sx_hostsim_bn_is_zero(s, n->n))
+    {
+        return BA414E_STS_SINV_MASK;
+    }
+
+    sx_hostsim_pk_write(BA414E_MEMLOC_10, r, op);
+    sx_hostsim_pk_write(BA414E_MEMLOC_11, s, op);
+    return 0;
+}
+
+static uint32_t sx_hostsim_pk_ecdsa_verify(const sx_hostsim_curve_t *c, const sx_hostsim_pk_op_t *op)
+{
+    const sx_hostsim_field_t *n = &c->order;
+    uint32_t r[SX_HOSTSIM_PK_MAX_WORDS], s[SX_HOSTSIM_PK_MAX_WORDS], h[SX_HOSTSIM_PK_MAX_WORDS];
+    uint32_t u1[SX_HOSTSIM_PK_MAX_WORDS], u2[SX_HOSTSIM_PK_MAX_WORDS];
+    uint32_t x[SX_HOSTSIM_PK_MAX_WORDS], y[SX_HOSTSIM_PK_MAX_WORDS];
+    sx_hostsim_point_t g, q, p1, p2;
+
+    if(!sx_hostsim_pk_read_point(&g, BA414E_MEMLOC_2, c, op) || !sx_hostsim_pk_read_point(&q, BA414E_MEMLOC_8, c, op))
+    {
+        return BA414E_STS_PNCU_MASK;
+    }
+    sx_hostsim_pk_read(r, BA414E_MEMLOC_10, op);
+    sx_hostsim_pk_read(s, BA414E_MEMLOC_11, op);
+    sx_hostsim_pk_read(h, BA414E_MEMLOC_12, op);
+    if(sx_hostsim_bn_is_zero(r, n->n) || (sx_hostsim_bn_cmp(r, n->m, n->n) >= 0) ||
+       sx_hostsim_bn_is_zero(s, n->n) || (sx_hostsim_bn_cmp(s, n->m, n->n) >= 0))
+    {
+        return BA414E_STS_SINV_MASK;
+    }
+
+    // u1 = h s^-1, u2 = r s^-1, X = u1 G + u2 Q
+    sx_hostsim_to_mont(s, s, n);
+    sx_hostsim_mont_inv(s, s, n);
+    sx_hostsim_to_mont(h, h, n);
+    sx_hostsim_mont_mul(u1, h, s, n);
+    sx_hostsim_from_mont(u1, u1, n);
+    sx_hostsim_to_mont(u2, r, n);
+    sx_hostsim_mont_mul(u2, u2, s, n);
+    sx_hostsim_from_mont(u2, u2, n);
+
+    sx_hostsim_point_mult(&p1, u1, &g, c);
+    sx_hostsim_point_mult(&p2, u2, &q, c);
+    sx_hostsim_point_add(&p1, &p1, &p2, c);
+    if(!sx_hostsim_point_to_affine(x, y, &p1, c))
+    {
+        return BA414E_STS_SINV_MASK;
+    }
+    sx_hostsim_pk_mod_order(x, x, c);
+    return (sx_hostsim_bn_cmp(x, r, n->n) == 0) ? 0 : BA414E_STS_SINV_MASK;
+}
+
+static uint32_t sx_hostsim_pk_run(void)
+{
+    uint32_t command = sx_hostsim_pk->CommandReg;
+    uint32_t pointers = sx_hostsim_pk->PointerReg;
+    uint32_t ptr_a = (pointers & BA414E_PTR_OPPTRA_MASK) >> BA414E_PTR_OPPTRA_LSB;
+    uint32_t ptr_b = (pointers & BA414E_PTR_OPPTRB_MASK) >> BA414E_PTR_OPPTRB_LSB;
+    uint32_t ptr_c = (pointers & BA414E_PTR_OPPTRC_MASK) >> BA414E_PTR_OPPTRC_LSB;
+    uint32_t optype = (command & BA414E_CMD_OPTYPE_MASK) >> BA414E_CMD_OPTYPE_LSB;
+    uint32_t k[SX_HOSTSIM_PK_MAX_WORDS];
+    sx_hostsim_pk_op_t op;
+    sx_hostsim_curve_t curve;
+    sx_hostsim_point_t p, q;
+
+    op.size = ((command & BA414E_CMD_OPSIZE_MASK) >> BA414E_CMD_OPSIZE_LSB) + 1;
+    op.n = (op.size + 3) / 4;
+    op.swap = (command & BA414E_CMD_SWAP_MASK) != 0;
+
+    // Only the prime field curve operations of the ECC and ECDSA paths are modelled
+    if((command & BA414E_CMD_OPFLD_MASK) || (op.n > SX_HOSTSIM_PK_MAX_WORDS))
+    {
+        return BA414E_STS_NOTIMPL_MASK;
+    }
+    switch(optype)
+    {
+        case BA414E_OPTYPE_ECC_POINT_DOUBLE:
+        case BA414E_OPTYPE_ECC_POINT_ADD:
+        case BA414E_OPTYPE_ECC_POINT_MULT:
+        case BA414E_OPTYPE_ECC_CHECK_POINTONCURVE:
+        case BA414E_OPTYPE_ECDSA_SIGN_GEN:
+        case BA414E_OPTYPE_ECDSA_SIGN_VERIF:
+        {
+            break;
+        }
+        default:
+        {
+            return BA414E_STS_NOTIMPL_MASK;
+        }
+    }
+    if(!sx_hostsim_pk_load_curve(&curve, &op))
+    {
+        return BA414E_STS_NNV_MASK;
+    }
+
+    switch(optype)
+    {
+        case BA414E_OPTYPE_ECC_POINT_DOUBLE:
+        {
+            if(!sx_hostsim_pk_read_point(&p, ptr_a, &curve, &op))
+            {
+                return BA414E_STS_PNCU_MASK;
+            }
+            sx_hostsim_point_double(&p, &p, &curve);
+            return sx_hostsim_pk_write_point(ptr_c, &p, &curve, &op);
+        }
+        case BA414E_OPTYPE_ECC_POINT_ADD:
+        {
+            if(!sx_hostsim_pk_read_point(&p, ptr_a, &curve, &op) || !sx_hostsim_pk_read_point(&q, ptr_b, &curve, &op))
+            {
+                return BA414E_STS_PNCU_MASK;
+            }
+            sx_hostsim_point_add(&p, &p, &q, &curve);
+            return sx_hostsim_pk_write_point(ptr_c, &p, &curve, &op);
+        }
+        case BA414E_OPTYPE_ECC_POINT_MULT:
+        {
+            if(!sx_hostsim_pk_read_point(&p, ptr_a, &curve, &op))
+            {
+                return BA414E_STS_PNCU_MASK;
+            }
+            sx_hostsim_pk_read(k, ptr_b, &op);
+            sx_hostsim_point_mult(&p, k, &p, &curve);
+            return sx_hostsim_pk_write_point(ptr_c, &p, &curve, &op);
+        }
+        case BA414E_OPTYPE_ECC_CHECK_POINTONCURVE:
+        {
+            return sx_hostsim_pk_read_point(&p, ptr_a, &curve, &op) ? 0 : BA414E_STS_PNCU_MASK;
+        }
+        case BA414E_OPTYPE_ECDSA_SIGN_GEN:
+        {
+            return sx_hostsim_pk_ecdsa_sign(&curve, &op);
+        }
+        default:
+        {
+            return sx_hostsim_pk_ecdsa_verify(&curve, &op);
+        }
+    }
+}
+
+static void sx_hostsim_pk_start(void)
+{
+    uint64_t start = sx_hostsim_get_time_ns();
+    uint32_t status;
+
+    sx_hostsim_stats.pk_ops++;
+    if(!sx_hostsim_clocked())
+    {
+        sx_hostsim_stats.errors++;
+        return;
+    }
+    status = sx_hostsim_pk_run();
+    if(status & ~(BA414E_STS_SINV_MASK | BA414E_STS_PINF_MASK | BA414E_STS_PNCU_MASK))
+    {
+        sx_hostsim_stats.errors++;
+    }
+    sx_hostsim_pk->StatusReg = (status & BA414E_STS_ERROR_MASK) | BA414E_STS_IRQ_MASK;
+    sx_hostsim_stats.engine_ns += sx_hostsim_get_time_ns() - start;
+}
+
+/*****************************************************************************
+ *                    Public Function Definitions
+ *****************************************************************************/
+
+void sx_hostsim_write_reg(volatile uint32_t *reg, uint32_t value)
+{
+    sx_hostsim_stats.reg_writes++;
+    if(sx_hostsim_sbox[0] == 0)
+    {
+        sx_hostsim_aes_init_tables();
+    }
+
+    if(reg == &sx_hostsim_dma->start)
+    {
+        if(value & (DMA_AXI_STARTREG_FETCH | DMA_AXI_STARTREG_PUSH))
+        {
+            sx_hostsim_dma_start();
+        }
+    }
+    else if(reg == &sx_hostsim_dma->int_stat_clr)
+    {
+        sx_hostsim_dma->int_stat_raw &= ~value;
+        sx_hostsim_dma->int_stat = sx_hostsim_dma->int_stat_raw & sx_hostsim_dma->int_en;
+    }
+    else if(reg == &sx_hostsim_dma->int_en_set)
+    {
+        sx_hostsim_dma->int_en |= value;
+    }
+    else if(reg == &sx_hostsim_dma->int_en_clr)
+    {
+        sx_hostsim_dma->int_en &= ~value;
+    }
+    else if(reg == &sx_hostsim_dma->config)
+    {
+        // The soft reset completes immediately
+        if(value & DMA_AXI_CONFIGREG_SOFTRESET)
+        {
+            sx_hostsim_dma->status = 0;
+            sx_hostsim_dma->int_stat_raw = 0;
+            sx_hostsim_dma->int_stat = 0;
+        }
+        *reg = value;
+    }
+    else if(reg == &sx_hostsim_pk->ControlReg)
+    {
+        if(value & BA414E_CTL_CLIRQ_MASK)
+        {
+            sx_hostsim_pk->StatusReg &= ~BA414E_STS_IRQ_MASK;
+        }
+        if(value & BA414E_CTL_START_MASK)
+        {
+            sx_hostsim_pk_start();
+        }
+    }
+    else
+    {
+        *reg = value;
+    }
+}
+
+uint32_t sx_hostsim_read_reg(volatile uint32_t *reg)
+{
+    sx_hostsim_stats.reg_reads++;
+    return *reg;
+}
+
+void sx_hostsim_init(void)
+{
+    memset((void *)sx_hostsim_cryptomaster_regs, 0, sizeof(sx_hostsim_cryptomaster_regs));
+    memset((void *)sx_hostsim_ba414e_regs, 0, sizeof(sx_hostsim_ba414e_regs));
+    memset((void *)sx_hostsim_ba431_regs, 0, sizeof(sx_hostsim_ba431_regs));
+    memset((void *)sx_hostsim_ba431_fifo, 0, sizeof(sx_hostsim_ba431_fifo));
+    memset(sx_hostsim_ba414e_cryptoram, 0, sizeof(sx_hostsim_ba414e_cryptoram));
+    memset(sx_hostsim_ba414e_ucode, 0, sizeof(sx_hostsim_ba414e_ucode));
+    sx_hostsim_aes_init_tables();
+    sx_hostsim_reset_stats();
+}
+
+void sx_hostsim_get_stats(sx_hostsim_stats_t *stats)
+{
+    *stats = sx_hostsim_stats;
+}
+
+void sx_hostsim_reset_stats(void)
+{
+    memset(&sx_hostsim_stats, 0, sizeof(sx_hostsim_stats));
+}
+
+#endif //GP_SILEXCRYPTOSOC_DIVERSITY_HOST_SIM
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2026, Qorvo Inc
+ *
+ * This software is owned by Qorvo Inc
+ * and protected under applicable copyright laws.
+ * It is delivered under the terms of the license
+ * and is intended and supplied for use solely and
+ * exclusively with products manufactured by
+ * Qorvo Inc.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED IN AN "AS IS"
+ * CONDITION. NO WARRANTIES, WHETHER EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING, BUT NOT
+ * LIMITED TO, IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ * QORVO INC. SHALL NOT, IN ANY
+ * CIRCUMSTANCES, BE LIABLE FOR SPECIAL,
+ * INCIDENTAL OR CONSEQUENTIAL DAMAGES,
+ * FOR ANY REASON WHATSOEVER.
+ *
+ * $Header$
+ * $Change$
+ * $DateTime$
+ *
+ */
+/**
+ * @file
+ * @brief Host model of the cryptosoc engines (GP_SILEXCRYPTOSOC_DIVERSITY_HOST_SIM)
+ *
+ * Runs libcryptosoc and the mbedtls_alt layer on a Linux host, e.g. to measure the cost of the block_t handling and
+ * descriptor building. The register blocks and the CryptoRAM are host arrays and the register accesses of
+ * cryptodma.c and ba414e_config.c (WR_REG32()/RD_REG32()) go through this model:
+ * - Writing the cryptomaster start register walks the fetch and push descriptors (or the direct transfer registers)
+ *   and runs the selected engine: bypass, BA411 (AES ECB and CCM) or BA413 (SHA-224/SHA-256 hash, HMAC and partial
+ *   hash). Unsupported modes flag a fetcher error, as a bus error would.
+ * - Writing the BA414 start bit runs the operation on the CryptoRAM operands. Point multiplication, point addition,
+ *   point on curve check and ECDSA signature generation and verification are modelled on prime field curves up to
+ *   P-521. Other operations report ::BA414E_STS_NOTIMPL_MASK.
+ * - The BA431 registers and FIFO are plain memory: the RNG is not modelled.
+ *
+ * The engine clock gate is the SEC_PROC_ENABLE register of the simulated register space (HAL_DIVERSITY_MM_SIM):
+ * starting an engine outside sx_enable_clock()/sx_disable_clock() is counted as an error and does nothing.
+ *
+ * The ROM sources are built from source, as GP_DIVERSITY_ROM_CODE is not set for this model. sx_async.c and the ROM
+ * patches of cryptosoc_patch.c are not part of a host build.
+ *
+ * The cryptomaster is a 32-bit DMA master: the address registers hold 32-bit addresses, as cryptodma.c writes them.
+ * On a 64-bit host, the descriptors and the buffers of direct transfers need to be below 4 GiB
+ * (e.g. a non-PIE executable, with the stack of the crypto caller mapped with MAP_32BIT).
+ */
+
+#ifndef SX_HOSTSIM_H
+#define SX_HOSTSIM_H
+
+#include <stdint.h>
+
+/** @brief Size of the cryptomaster register block, in words */
+#define SX_HOSTSIM_CRYPTOMASTER_REGS_WORDS  16
+/** @brief Size of the BA414 register block, in words */
+#define SX_HOSTSIM_BA414E_REGS_WORDS        8
+/** @brief Size of the BA431 register block, in words */
+#define SX_HOSTSIM_BA431_REGS_WORDS         32
+/** @brief Size of the BA414 CryptoRAM: 16 operand locations of 512 bytes */
+#define SX_HOSTSIM_BA414E_CRYPTORAM_SIZE    (16 * 512)
+/** @brief Size of the BA414 microcode memory, in words */
+#define SX_HOSTSIM_BA414E_UCODE_WORDS       2048
+
+/** @brief Backing memory of the engines, see ADDR_CRYPTOMASTER_REGS and friends */
+extern volatile uint32_t sx_hostsim_cryptomaster_regs[SX_HOSTSIM_CRYPTOMASTER_REGS_WORDS];
+extern volatile uint32_t sx_hostsim_ba414e_regs[SX_HOSTSIM_BA414E_REGS_WORDS];
+extern volatile uint32_t sx_hostsim_ba431_regs[SX_HOSTSIM_BA431_REGS_WORDS];
+extern volatile uint32_t sx_hostsim_ba431_fifo[1];
+extern uint8_t sx_hostsim_ba414e_cryptoram[SX_HOSTSIM_BA414E_CRYPTORAM_SIZE];
+extern uint32_t sx_hostsim_ba414e_ucode[SX_HOSTSIM_BA414E_UCODE_WORDS];
+
+/** @brief Counters of the host model */
+typedef struct sx_hostsim_stats_s {
+   uint32_t reg_writes;          /**< register writes through WR_REG32() */
+   uint32_t reg_reads;           /**< register reads through RD_REG32() */
+   uint32_t dma_runs;            /**< scatter-gather runs of the cryptomaster */
+   uint32_t dma_direct;          /**< direct transfers of the cryptomaster, e.g. memcpy_blk() */
+   uint32_t fetch_descr;         /**< fetch descriptors walked */
+   uint32_t push_descr;          /**< push descriptors walked */
+   uint32_t fetch_bytes;         /**< bytes fetched, including configuration and padding */
+   uint32_t push_bytes;          /**< bytes pushed, including discarded bytes */
+   uint32_t config_bytes;        /**< bytes fetched to engine configuration registers */
+   uint32_t invalid_bytes;       /**< bytes fetched as padding (invalid bytes of a data descriptor) */
+   uint32_t discard_bytes;       /**< bytes pushed to discard descriptors */
+   uint32_t aes_blocks;          /**< blocks processed by the BA411 */
+   uint32_t hash_blocks;         /**< compression function calls of the BA413 */
+   uint32_t pk_ops;              /**< operations started on the BA414 */
+   uint32_t errors;              /**< engine starts that failed: unclocked, unsupported or bad descriptors */
+   uint64_t engine_ns;           /**< host time spent in the engine models */
+} sx_hostsim_stats_t;
+
+/**
+ * @brief Register write, see WR_REG32(). Starts the engine on a write to its start register.
+ * @param reg register in one of the register blocks
+ * @param value value to write
+ */
+void sx_hostsim_write_reg(volatile uint32_t *reg, uint32_t value);
+
+/**
+ * @brief Register read, see RD_REG32()
+ * @param reg register in one of the register blocks
+ * @return register value
+ */
+uint32_t sx_hostsim_read_reg(volatile uint32_t *reg);
+
+/** @brief Clear the registers, the CryptoRAM and the counters */
+void sx_hostsim_init(void);
+
+/** @brief Copy the counters of the model to @p stats */
+void sx_hostsim_get_stats(sx_hostsim_stats_t *stats);
+
+/** @brief Clear the counters of the model */
+void sx_hostsim_reset_stats(void);
+
+#endif //SX_HOSTSIM_H
@@ -1,6 +1,6 @@
-#ifdef GP_DIVERSITY_JUMPTABLES
+#if defined(GP_DIVERSITY_JUMPTABLES) && !defined(GP_SILEXCRYPTOSOC_DIVERSITY_HOST_SIM)
 #define GP_DIVERSITY_ROM_CODE
-#endif //def GP_DIVERSITY_JUMPTABLES
+#endif //defined(GP_DIVERSITY_JUMPTABLES) && !defined(GP_SILEXCRYPTOSOC_DIVERSITY_HOST_SIM)
 
 #include "global.h"
 
@@ -11,7 +11,14 @@
 
 #include <stdint.h>
 
+#if defined(GP_SILEXCRYPTOSOC_DIVERSITY_HOST_SIM)
+#include "sx_hostsim.h"
+
+#define WR_REG32(reg, value) sx_hostsim_write_reg(&(reg), (value))
+#define RD_REG32(reg)        sx_hostsim_read_reg(&(reg))
+#else
 #define WR_REG32(reg, value) (reg) = (value)
 #define RD_REG32(reg)        (reg)
+#endif
 
 #endif
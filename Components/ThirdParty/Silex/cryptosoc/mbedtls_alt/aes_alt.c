@@ -194,6 +194,8 @@ int mbedtls_aes_crypt_cfb128( mbedtls_aes_context *ctx,
     int c;
     size_t n = *iv_off;
 
+    /* Keep the engine clocked for all blocks of the buffer */
+    sx_enable_clock();
     if( mode == MBEDTLS_AES_DECRYPT )
     {
         while( length-- )
@@ -220,6 +222,7 @@ int mbedtls_aes_crypt_cfb128( mbedtls_aes_context *ctx,
             n = ( n + 1 ) & 0x0F;
         }
     }
+    sx_disable_clock();
 
     *iv_off = n;
 
@@ -239,6 +242,7 @@ int mbedtls_aes_crypt_cfb8( mbedtls_aes_context *ctx,
     unsigned char c;
     unsigned char ov[17];
 
+    sx_enable_clock();
     while( length-- )
     {
         memcpy( ov, iv, 16 );
@@ -254,6 +258,7 @@ int mbedtls_aes_crypt_cfb8( mbedtls_aes_context *ctx,
 
         memcpy( iv, ov + 1, 16 );
     }
+    sx_disable_clock();
 
     return( 0 );
 }
@@ -274,6 +279,7 @@ int mbedtls_aes_crypt_ctr( mbedtls_aes_context *ctx,
     int c, i;
     size_t n = *nc_off;
 
+    sx_enable_clock();
     while( length-- )
     {
         if( n == 0 ) {
@@ -288,6 +294,7 @@ int mbedtls_aes_crypt_ctr( mbedtls_aes_context *ctx,
 
         n = ( n + 1 ) & 0x0F;
     }
+    sx_disable_clock();
 
     *nc_off = n;
 
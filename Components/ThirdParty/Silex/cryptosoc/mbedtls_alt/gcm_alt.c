@@ -43,6 +43,7 @@
 
 #include "mbedtls/gcm.h"
 #include <sx_aes.h>
+#include <sx_generic.h>
 #include <cryptolib_def.h>
 #include <string.h>
 
@@ -416,6 +417,8 @@ int mbedtls_gcm_update( mbedtls_gcm_context *ctx,
 
         ctx->len += length;
 
+        /* Keep the engine clocked for all counter blocks */
+        sx_enable_clock();
         p = input;
         while( length > 0 )
         {
@@ -428,6 +431,7 @@ int mbedtls_gcm_update( mbedtls_gcm_context *ctx,
             if( ( ret = mbedtls_cipher_update( &ctx->cipher_ctx, ctx->y, 16, ectr,
                                     &olen ) ) != 0 )
             {
+                sx_disable_clock();
                 return( ret );
             }
 
@@ -446,6 +450,7 @@ int mbedtls_gcm_update( mbedtls_gcm_context *ctx,
             p += use_len;
             out_p += use_len;
         }
+        sx_disable_clock();
 
         return( 0 );
     }
@@ -164,7 +164,16 @@ int mbedtls_sha256_update_ret( mbedtls_sha256_context *ctx, const unsigned char
     if( ctx->total[0] < (uint32_t) ilen )
         ctx->total[1]++;
 
-    if( left && ilen >= fill )
+    if( ilen < fill )
+    {
+        memcpy( (void *) (ctx->buffer + left), input, ilen );
+        return 0;
+    }
+
+    /* One session for the buffered block and the full blocks of the input */
+    sx_enable_clock();
+
+    if( left )
     {
         memcpy( (void *) (ctx->buffer + left), input, fill );
         mbedtls_sha256_process( ctx, ctx->buffer );
@@ -173,8 +182,6 @@ int mbedtls_sha256_update_ret( mbedtls_sha256_context *ctx, const unsigned char
         left = 0;
     }
 
-    sx_enable_clock();
-
     while( ilen >= 64 )
     {
         size_t steplen = ilen;
@@ -232,8 +239,10 @@ int mbedtls_sha256_finish_ret( mbedtls_sha256_context *ctx, unsigned char output
     last = ctx->total[0] & 0x3F;
     padn = ( last < 56 ) ? ( 56 - last ) : ( 120 - last );
 
+    sx_enable_clock();
     ret = mbedtls_sha256_update_ret( ctx, sha256_padding, padn );
     ret |= mbedtls_sha256_update_ret( ctx, msglen, 8 );
+    sx_disable_clock();
 
     memcpy(output,
         ctx->state,
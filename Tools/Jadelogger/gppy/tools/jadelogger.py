@@ -18,6 +18,7 @@
       'ble' - uses the BLE-UART protocol
       'file=<file_prefix>'- route output to a logfile - <file_prefix>_YYMMDD_HHMMSS.txt or log_YYMMDD_HHMMSS.txt when nothing specified
       'reconnect' - keeps trying to connect untill successful. Useful in case a USB connection is only available after some delay.
+      'elf=<file>' - ELF file of the running firmware, to resolve format strings of deferred logging (GP_LOG_DIVERSITY_DEFERRED)
   Examples:
 
   To use jadelogger on COM1 - 57600 baudrate:
@@ -41,6 +42,7 @@ import sys
 import os
 import time
 import datetime
+import struct
 
 # do the regular path stuff - drop down to v... to get to testEnv
 try:
@@ -110,6 +112,56 @@ def formatParse(logPacket):
 
     return formatted
 
+class ElfStrings(object):
+    """ Resolve format strings of deferred logging from the firmware ELF file.
+
+    :param path: ELF file of the firmware running on the device
+    :type path: str
+    """
+    SHT_NOBITS = 8
+    SHF_ALLOC = 0x2
+
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            self.image = f.read()
+        if self.image[0:4] != b'\x7fELF':
+            raise Exception("Not an ELF file: %s" % path)
+        is64 = (self.image[4] == 2)
+        endian = '<' if self.image[5] == 1 else '>'
+        if is64:
+            shoff, = struct.unpack_from(endian + 'Q', self.image, 0x28)
+            shentsize, shnum = struct.unpack_from(endian + 'HH', self.image, 0x3A)
+            shdr = endian + 'IIQQQQ'
+        else:
+            shoff, = struct.unpack_from(endian + 'I', self.image, 0x20)
+            shentsize, shnum = struct.unpack_from(endian + 'HH', self.image, 0x2E)
+            shdr = endian + 'IIIIII'
+        # (address, size, file offset) of all sections loaded on the target with file content
+        self.sections = []
+        for i in range(shnum):
+            _name, shtype, flags, addr, offset, size = struct.unpack_from(shdr, self.image, shoff + i * shentsize)
+            if (flags & self.SHF_ALLOC) and shtype != self.SHT_NOBITS and size:
+                self.sections.append((addr, size, offset))
+        self.cache = {}
+
+    def lookup(self, address):
+        """ Return the NULL terminated string at a target address as a list of bytes, None if unknown """
+        if address in self.cache:
+            return self.cache[address]
+        result = None
+        for (addr, size, offset) in self.sections:
+            if addr <= address < addr + size:
+                start = offset + address - addr
+                end = self.image.find(b'\x00', start, offset + size)
+                if end != -1:
+                    result = list(bytearray(self.image[start:end]))
+                break
+        self.cache[address] = result
+        return result
+
+# Set with the 'elf=<file>' option
+elfStrings = None
+
 def gpLog(data):
     """ Parse a gLog printf indication
 
@@ -118,14 +170,15 @@ def gpLog(data):
     """
 
     # Parse Log header
-    # 0x02 | module ID | endianness | reserved | count | time0 | time1 | time2 | time3 |
+    # 0x02 | module ID | mode | reserved | count | time0 | time1 | time2 | time3 |
+    # mode bit 0 set: format string replaced by its 4 byte address (deferred logging)
     logPacket =data[:]
     if logPacket.pop(0) != 0x02:
         print ("Not a printf!")
         return [0, 0, 0, 0, ""]
 
     compId = logPacket.pop(0)
-    logPacket.pop(0) # 0x2 - big endian - not used currently
+    mode = logPacket.pop(0) # bit 1 - big endian - not used currently
     logPacket.pop(0) # reserved byte
     cnt = logPacket.pop(0)
     time = logPacket[0] +  \
@@ -135,6 +188,12 @@ def gpLog(data):
 
     # Format formatstring
     logPacket = logPacket[4:]
+    if mode & 0x1:
+        address = logPacket[0] + (logPacket[1] << 8) + (logPacket[2] << 16) + (logPacket[3] << 24)
+        formatstring = elfStrings.lookup(address) if elfStrings is not None else None
+        if formatstring is None:
+            return [compId, cnt, time, "<fmt@0x%08X> [%s]" % (address, ",".join(map(lambda x: "%02X" % x, logPacket[4:])))]
+        logPacket = formatstring + [0] + logPacket[4:]
     formatted = formatParse(logPacket)
 
     return [compId, cnt, time, formatted]
@@ -381,6 +440,7 @@ def handleInput(command, peak, logger):
 
 import traceback
 def mainJadeLogger():
+    global elfStrings
     from testEnv.scripts.gpAPI_2 import keyInput
     import peakconnect
 
@@ -430,6 +490,8 @@ def mainJadeLogger():
 
             loggerfile = jadelogger(peak, logfile)
             loggerfile.Start()
+        if arg.startswith("elf="):
+            elfStrings = ElfStrings(arg.split("=", 1)[1])
         if arg.find("wakeup") != -1:
             #Activate pre-amble addition
             print ("Adding wakeup pre-amble")